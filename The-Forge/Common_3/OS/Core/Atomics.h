@@ -83,6 +83,13 @@ static inline uint32_t tfrg_atomic32_store_release(tfrg_atomic32_t* pVar, uint32
 	return tfrg_atomic32_store_relaxed(pVar, val);
 }
 
+// Publishes the writes made before the add to a thread that reads the result with tfrg_atomic32_load_acquire
+static inline uint32_t tfrg_atomic32_add_release(tfrg_atomic32_t* pVar, int32_t val)
+{
+	tfrg_memorybarrier_release();
+	return tfrg_atomic32_add_relaxed(pVar, val);
+}
+
 static inline uint32_t tfrg_atomic32_max_relaxed(tfrg_atomic32_t* dst, uint32_t val)
 {
     uint32_t prev_val = val;
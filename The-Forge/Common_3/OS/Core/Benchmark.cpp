@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "../../ThirdParty/OpenSource/EASTL/vector.h"
+#include "../../ThirdParty/OpenSource/EASTL/sort.h"
+#include "../../ThirdParty/OpenSource/EASTL/string.h"
+
+#include "../Interfaces/IBenchmark.h"
+#include "../Interfaces/IFileSystem.h"
+#include "../Interfaces/IInput.h"
+#include "../Interfaces/IProfiler.h"
+#include "../Interfaces/ITime.h"
+#include "../Interfaces/ILog.h"
+#include "../Interfaces/IMemory.h"
+
+#define BENCHMARK_DEFAULT_TIME_STEP (1.0f / 60.0f)
+#define BENCHMARK_MAX_GPU_PROFILERS 8
+#define BENCHMARK_DEFAULT_LUA_ASYNC_SCRIPTS 64
+
+typedef struct BenchmarkFrame
+{
+	float    mCpuTime;
+	float    mFrameTime;
+	float    mGpuTimes[BENCHMARK_MAX_GPU_PROFILERS];
+	uint32_t mGpuCount;
+	float    mLuaAsyncTime;
+} BenchmarkFrame;
+
+typedef struct Benchmark
+{
+	BenchmarkDesc                 mDesc;
+	eastl::vector<BenchmarkFrame> mFrames;
+	Path*                         pOutputPath;
+	Path*                         pLuaAsyncScriptPath;
+	HiresTimer                    mFrameTimer;
+	float                         mLuaAsyncTime;
+	uint32_t                      mFrameIndex;
+	bool                          mWriteReport;
+	bool                          mReplaying;
+} Benchmark;
+
+static Benchmark* pBenchmark = NULL;
+
+static Path* copyPathForArgument(const char* pArgument)
+{
+	// Command line paths are either absolute or relative to the working directory
+	const bool absolute = pArgument[0] == '/' || pArgument[0] == '\\' || (pArgument[0] && pArgument[1] == ':');
+	if (absolute)
+		return fsCreatePath(fsGetSystemFileSystem(), pArgument);
+
+	PathHandle workingDirectory = fsCopyWorkingDirectoryPath();
+	return fsAppendPathComponent(workingDirectory, pArgument);
+}
+
+bool parseBenchmarkArgs(int argc, const char** argv, BenchmarkDesc* pDesc)
+{
+	ASSERT(pDesc);
+
+	*pDesc = {};
+	pDesc->mFixedTimeStep = BENCHMARK_DEFAULT_TIME_STEP;
+	pDesc->mLuaAsyncScriptCount = BENCHMARK_DEFAULT_LUA_ASYNC_SCRIPTS;
+
+	bool found = false;
+	for (int i = 1; i < argc; ++i)
+	{
+		const char* pArg = argv[i];
+		const char* pValue = i + 1 < argc ? argv[i + 1] : NULL;
+		bool        consumed = true;
+
+		if (!strcmp(pArg, "--benchmark") && pValue)
+			pDesc->mFrameCount = (uint32_t)strtoul(pValue, NULL, 10);
+		else if (!strcmp(pArg, "--benchmark-warmup") && pValue)
+			pDesc->mWarmupFrameCount = (uint32_t)strtoul(pValue, NULL, 10);
+		else if (!strcmp(pArg, "--benchmark-output") && pValue)
+			pDesc->pOutputFile = pValue;
+		else if (!strcmp(pArg, "--fixed-timestep") && pValue)
+			pDesc->mFixedTimeStep = (float)strtod(pValue, NULL);
+		else if (!strcmp(pArg, "--record-input") && pValue)
+			pDesc->pRecordInputFile = pValue;
+		else if (!strcmp(pArg, "--replay-input") && pValue)
+			pDesc->pReplayInputFile = pValue;
+		else if (!strcmp(pArg, "--lua-async") && pValue)
+			pDesc->pLuaAsyncScript = pValue;
+		else if (!strcmp(pArg, "--lua-async-count") && pValue)
+			pDesc->mLuaAsyncScriptCount = (uint32_t)strtoul(pValue, NULL, 10);
+		else
+			consumed = false;
+
+		if (consumed)
+		{
+			found = true;
+			++i;
+		}
+	}
+
+	return found;
+}
+
+bool initBenchmark(const char* pAppName, const BenchmarkDesc* pDesc)
+{
+	ASSERT(pDesc);
+	ASSERT(!pBenchmark);
+
+	if (pDesc->pRecordInputFile && pDesc->pReplayInputFile)
+	{
+		LOGF(LogLevel::eERROR, "--record-input and --replay-input cannot be used together");
+		return false;
+	}
+
+	pBenchmark = conf_new(Benchmark);
+	pBenchmark->mDesc = *pDesc;
+	pBenchmark->pOutputPath = NULL;
+	pBenchmark->pLuaAsyncScriptPath = NULL;
+	pBenchmark->mLuaAsyncTime = -1.0f;
+	pBenchmark->mFrameIndex = 0;
+	pBenchmark->mWriteReport = pDesc->mFrameCount || pDesc->pOutputFile || pDesc->pLuaAsyncScript;
+	pBenchmark->mReplaying = pDesc->pReplayInputFile != NULL;
+
+	if (pDesc->pRecordInputFile)
+	{
+		PathHandle recordPath = copyPathForArgument(pDesc->pRecordInputFile);
+		if (!recordPath || !beginInputRecording(recordPath))
+		{
+			exitBenchmark();
+			return false;
+		}
+	}
+	else if (pDesc->pReplayInputFile)
+	{
+		PathHandle replayPath = copyPathForArgument(pDesc->pReplayInputFile);
+		if (!replayPath || !beginInputReplay(replayPath))
+		{
+			exitBenchmark();
+			return false;
+		}
+	}
+
+	if (pDesc->pLuaAsyncScript && pDesc->mLuaAsyncScriptCount)
+	{
+		pBenchmark->pLuaAsyncScriptPath = copyPathForArgument(pDesc->pLuaAsyncScript);
+		if (!pBenchmark->pLuaAsyncScriptPath)
+		{
+			exitBenchmark();
+			return false;
+		}
+	}
+
+	if (pBenchmark->mWriteReport)
+	{
+		if (pDesc->pOutputFile)
+		{
+			pBenchmark->pOutputPath = copyPathForArgument(pDesc->pOutputFile);
+		}
+		else
+		{
+			time_t        t = time(0);
+			eastl::string nameFormat = eastl::string().sprintf("%s", pAppName) + "Benchmark-%Y-%m-%d-%H.%M.%S.json";
+			char          name[128] = {};
+			strftime(name, sizeof(name), nameFormat.c_str(), localtime(&t));
+			pBenchmark->pOutputPath = fsAppendPathComponent(PathHandle(fsCopyLogFileDirectoryPath()), name);
+		}
+
+		if (!pBenchmark->pOutputPath)
+		{
+			exitBenchmark();
+			return false;
+		}
+
+		pBenchmark->mFrames.reserve(pDesc->mFrameCount);
+	}
+
+	LOGF(LogLevel::eINFO, "Benchmark: %u frames (%u warmup), time step %f", pDesc->mFrameCount, pDesc->mWarmupFrameCount,
+		 pDesc->mFixedTimeStep);
+	return true;
+}
+
+typedef struct BenchmarkStats
+{
+	float mAverage;
+	float mMin;
+	float mMax;
+	float mPercentiles[4];
+} BenchmarkStats;
+
+static const uint32_t gBenchmarkPercentiles[4] = { 50, 90, 95, 99 };
+
+static bool calculateStats(eastl::vector<float>& samples, BenchmarkStats* pStats)
+{
+	if (samples.empty())
+		return false;
+
+	eastl::sort(samples.begin(), samples.end());
+
+	double sum = 0.0;
+	for (float sample : samples)
+		sum += sample;
+
+	const uint32_t count = (uint32_t)samples.size();
+	pStats->mAverage = (float)(sum / count);
+	pStats->mMin = samples.front();
+	pStats->mMax = samples.back();
+	// Nearest-rank percentiles
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		uint32_t rank = (gBenchmarkPercentiles[i] * count + 99) / 100;
+		pStats->mPercentiles[i] = samples[rank ? rank - 1 : 0];
+	}
+	return true;
+}
+
+static void writeStats(FileStream* pFile, const char* pName, eastl::vector<float>& samples, bool last)
+{
+	BenchmarkStats stats = {};
+	if (!calculateStats(samples, &stats))
+	{
+		fsPrintToStream(pFile, "\t\t\"%s\": null%s\n", pName, last ? "" : ",");
+		return;
+	}
+
+	fsPrintToStream(pFile, "\t\t\"%s\": { \"avg\": %.4f, \"min\": %.4f, \"max\": %.4f", pName, stats.mAverage, stats.mMin, stats.mMax);
+	for (uint32_t i = 0; i < 4; ++i)
+		fsPrintToStream(pFile, ", \"p%u\": %.4f", gBenchmarkPercentiles[i], stats.mPercentiles[i]);
+	fsPrintToStream(pFile, " }%s\n", last ? "" : ",");
+}
+
+static void writeSample(FileStream* pFile, const char* pPrefix, float sample)
+{
+	if (sample >= 0.0f)
+		fsPrintToStream(pFile, "%s%.4f", pPrefix, sample);
+	else
+		fsPrintToStream(pFile, "%snull", pPrefix);
+}
+
+static void writeBenchmarkReport(Benchmark* pBench)
+{
+	FileStream* pFile = fsOpenFile(pBench->pOutputPath, FM_WRITE);
+	if (!pFile)
+	{
+		LOGF(LogLevel::eERROR, "Failed to write benchmark report '%s'", fsGetPathAsNativeString(pBench->pOutputPath));
+		return;
+	}
+
+	const uint32_t frameCount = (uint32_t)pBench->mFrames.size();
+	const uint32_t warmupCount = pBench->mDesc.mWarmupFrameCount < frameCount ? pBench->mDesc.mWarmupFrameCount : frameCount;
+	uint32_t       gpuCount = 0;
+	for (const BenchmarkFrame& frame : pBench->mFrames)
+		gpuCount = frame.mGpuCount > gpuCount ? frame.mGpuCount : gpuCount;
+
+	fsPrintToStream(pFile, "{\n");
+	fsPrintToStream(pFile, "\t\"frames\": %u,\n", frameCount);
+	fsPrintToStream(pFile, "\t\"warmupFrames\": %u,\n", warmupCount);
+	fsPrintToStream(pFile, "\t\"fixedTimeStep\": %f,\n", pBench->mDesc.mFixedTimeStep);
+	fsPrintToStream(pFile, "\t\"inputReplay\": %s,\n", pBench->mReplaying ? "true" : "false");
+	fsPrintToStream(pFile, "\t\"luaAsyncScripts\": %u,\n", pBench->pLuaAsyncScriptPath ? pBench->mDesc.mLuaAsyncScriptCount : 0);
+
+	// Percentiles over the frames after warmup. Negative samples mean the profiler had no data for that frame
+	eastl::vector<float> samples;
+	samples.reserve(frameCount);
+	fsPrintToStream(pFile, "\t\"summary\": {\n");
+	for (uint32_t i = warmupCount; i < frameCount; ++i)
+		samples.push_back(pBench->mFrames[i].mCpuTime);
+	writeStats(pFile, "cpuMs", samples, false);
+
+	samples.clear();
+	for (uint32_t i = warmupCount; i < frameCount; ++i)
+		if (pBench->mFrames[i].mFrameTime >= 0.0f)
+			samples.push_back(pBench->mFrames[i].mFrameTime);
+	writeStats(pFile, "frameMs", samples, gpuCount == 0 && !pBench->pLuaAsyncScriptPath);
+
+	for (uint32_t gpu = 0; gpu < gpuCount; ++gpu)
+	{
+		samples.clear();
+		for (uint32_t i = warmupCount; i < frameCount; ++i)
+		{
+			const BenchmarkFrame& frame = pBench->mFrames[i];
+			if (gpu < frame.mGpuCount && frame.mGpuTimes[gpu] >= 0.0f)
+				samples.push_back(frame.mGpuTimes[gpu]);
+		}
+		char name[32] = {};
+		snprintf(name, sizeof(name), "gpu%uMs", gpu);
+		writeStats(pFile, name, samples, gpu + 1 == gpuCount && !pBench->pLuaAsyncScriptPath);
+	}
+
+	// Wall time of all Lua async scripts of a frame, which is the throughput of the concurrent Lua states
+	if (pBench->pLuaAsyncScriptPath)
+	{
+		samples.clear();
+		for (uint32_t i = warmupCount; i < frameCount; ++i)
+			if (pBench->mFrames[i].mLuaAsyncTime >= 0.0f)
+				samples.push_back(pBench->mFrames[i].mLuaAsyncTime);
+		writeStats(pFile, "luaAsyncMs", samples, true);
+	}
+	fsPrintToStream(pFile, "\t},\n");
+
+	fsPrintToStream(pFile, "\t\"perFrame\": [\n");
+	for (uint32_t i = 0; i < frameCount; ++i)
+	{
+		const BenchmarkFrame& frame = pBench->mFrames[i];
+		fsPrintToStream(pFile, "\t\t{ \"cpuMs\": %.4f, ", frame.mCpuTime);
+		writeSample(pFile, "\"frameMs\": ", frame.mFrameTime);
+		fsPrintToStream(pFile, ", \"gpuMs\": [");
+		for (uint32_t gpu = 0; gpu < frame.mGpuCount; ++gpu)
+			writeSample(pFile, gpu ? ", " : "", frame.mGpuTimes[gpu]);
+		fsPrintToStream(pFile, "]");
+		if (pBench->pLuaAsyncScriptPath)
+			writeSample(pFile, ", \"luaAsyncMs\": ", frame.mLuaAsyncTime);
+		fsPrintToStream(pFile, " }%s\n", i + 1 == frameCount ? "" : ",");
+	}
+	fsPrintToStream(pFile, "\t]\n}\n");
+	fsCloseStream(pFile);
+
+	LOGF(LogLevel::eINFO, "Benchmark report written to '%s'", fsGetPathAsNativeString(pBench->pOutputPath));
+}
+
+void exitBenchmark()
+{
+	if (!pBenchmark)
+		return;
+
+	if (pBenchmark->mWriteReport && pBenchmark->pOutputPath)
+		writeBenchmarkReport(pBenchmark);
+
+	endInputRecording();
+
+	if (pBenchmark->pOutputPath)
+		fsFreePath(pBenchmark->pOutputPath);
+	if (pBenchmark->pLuaAsyncScriptPath)
+		fsFreePath(pBenchmark->pLuaAsyncScriptPath);
+	conf_delete(pBenchmark);
+	pBenchmark = NULL;
+}
+
+float beginBenchmarkFrame(float deltaTime)
+{
+	ASSERT(pBenchmark);
+
+	pBenchmark->mFrameTimer.Reset();
+	pBenchmark->mLuaAsyncTime = -1.0f;
+	return pBenchmark->mDesc.mFixedTimeStep > 0.0f ? pBenchmark->mDesc.mFixedTimeStep : deltaTime;
+}
+
+bool endBenchmarkFrame()
+{
+	ASSERT(pBenchmark);
+
+	const float cpuTime = (float)pBenchmark->mFrameTimer.GetUSec(false) / 1000.0f;
+	++pBenchmark->mFrameIndex;
+
+	if (pBenchmark->mWriteReport)
+	{
+		// Gpu timestamps are read back with a latency of a few frames, so these trail the Cpu time of the same frame
+		ProfileToken gpuTokens[BENCHMARK_MAX_GPU_PROFILERS] = {};
+		uint32_t     gpuCount = getGpuProfileFrameTokens(gpuTokens, BENCHMARK_MAX_GPU_PROFILERS);
+		gpuCount = gpuCount < BENCHMARK_MAX_GPU_PROFILERS ? gpuCount : BENCHMARK_MAX_GPU_PROFILERS;
+
+		BenchmarkFrame frame = {};
+		frame.mCpuTime = cpuTime;
+		frame.mFrameTime = getCpuFrameTime();
+		frame.mGpuCount = gpuCount;
+		frame.mLuaAsyncTime = pBenchmark->mLuaAsyncTime;
+		for (uint32_t i = 0; i < gpuCount; ++i)
+			frame.mGpuTimes[i] = getGpuProfileTime(gpuTokens[i]);
+		pBenchmark->mFrames.push_back(frame);
+	}
+
+	if (pBenchmark->mDesc.mFrameCount)
+		return pBenchmark->mFrameIndex < pBenchmark->mDesc.mFrameCount;
+
+	// Without a frame count a replay runs until all recorded input has been dispatched
+	return !pBenchmark->mReplaying || !isInputReplayFinished();
+}
+
+const Path* getBenchmarkLuaAsyncScript(uint32_t* pScriptCount)
+{
+	if (!pBenchmark || !pBenchmark->pLuaAsyncScriptPath)
+		return NULL;
+
+	*pScriptCount = pBenchmark->mDesc.mLuaAsyncScriptCount;
+	return pBenchmark->pLuaAsyncScriptPath;
+}
+
+void setBenchmarkLuaAsyncTime(float ms)
+{
+	if (pBenchmark)
+		pBenchmark->mLuaAsyncTime = ms;
+}
@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include <errno.h>
+#include <stdio.h>
+
+#include "FileMapping.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "../Interfaces/ILog.h"
+#include "../Interfaces/IMemory.h"
+
+#if defined(_WIN32)
+// widePath must hold path->mPathLength + 1 characters
+static void toWidePath(const Path* path, wchar_t* widePath)
+{
+	size_t widePathLength =
+		MultiByteToWideChar(CP_UTF8, 0, fsGetPathAsNativeString(path), (int)path->mPathLength, widePath, (int)path->mPathLength);
+	widePath[widePathLength] = 0;
+}
+#endif
+
+bool fsMapFileReadOnly(const Path* filePath, FileMapping* mapping)
+{
+	memset(mapping, 0, sizeof(FileMapping));
+
+#if defined(_WIN32)
+	wchar_t* widePath = (wchar_t*)alloca((filePath->mPathLength + 1) * sizeof(wchar_t));
+	toWidePath(filePath, widePath);
+
+	HANDLE file = CreateFileW(widePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		LOGF(LogLevel::eERROR, "Error %u opening %s for mapping", GetLastError(), fsGetPathAsNativeString(filePath));
+		return false;
+	}
+
+	LARGE_INTEGER fileSize = {};
+	GetFileSizeEx(file, &fileSize);
+	if (fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE fileMapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	// The mapping object keeps its own reference to the file.
+	CloseHandle(file);
+	if (!fileMapping)
+	{
+		LOGF(LogLevel::eERROR, "Error %u mapping %s", GetLastError(), fsGetPathAsNativeString(filePath));
+		return false;
+	}
+
+	void* data = MapViewOfFile(fileMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data)
+	{
+		LOGF(LogLevel::eERROR, "Error %u mapping %s", GetLastError(), fsGetPathAsNativeString(filePath));
+		CloseHandle(fileMapping);
+		return false;
+	}
+
+	mapping->pData = (const uint8_t*)data;
+	mapping->mSize = (size_t)fileSize.QuadPart;
+	mapping->pPlatformHandle = fileMapping;
+	return true;
+#else
+	int file = open(fsGetPathAsNativeString(filePath), O_RDONLY);
+	if (file == -1)
+	{
+		LOGF(LogLevel::eERROR, "Error opening %s for mapping: %s", fsGetPathAsNativeString(filePath), strerror(errno));
+		return false;
+	}
+
+	struct stat fileStat;
+	if (fstat(file, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(file);
+		return false;
+	}
+
+	void* data = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+	// The mapping keeps its own reference to the file.
+	close(file);
+	if (data == MAP_FAILED)
+	{
+		LOGF(LogLevel::eERROR, "Error mapping %s: %s", fsGetPathAsNativeString(filePath), strerror(errno));
+		return false;
+	}
+
+	mapping->pData = (const uint8_t*)data;
+	mapping->mSize = (size_t)fileStat.st_size;
+	return true;
+#endif
+}
+
+void fsUnmapFile(FileMapping* mapping)
+{
+	if (!mapping->pData)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile(mapping->pData);
+	CloseHandle((HANDLE)mapping->pPlatformHandle);
+#else
+	munmap((void*)mapping->pData, mapping->mSize);
+#endif
+
+	memset(mapping, 0, sizeof(FileMapping));
+}
+
+bool fsReplaceFile(const Path* sourcePath, const Path* destinationPath)
+{
+#if defined(_WIN32)
+	wchar_t* wideSource = (wchar_t*)alloca((sourcePath->mPathLength + 1) * sizeof(wchar_t));
+	wchar_t* wideDestination = (wchar_t*)alloca((destinationPath->mPathLength + 1) * sizeof(wchar_t));
+	toWidePath(sourcePath, wideSource);
+	toWidePath(destinationPath, wideDestination);
+	if (!MoveFileExW(wideSource, wideDestination, MOVEFILE_REPLACE_EXISTING))
+	{
+		LOGF(LogLevel::eERROR, "Error %u replacing %s", GetLastError(), fsGetPathAsNativeString(destinationPath));
+		return false;
+	}
+#else
+	if (rename(fsGetPathAsNativeString(sourcePath), fsGetPathAsNativeString(destinationPath)) != 0)
+	{
+		LOGF(LogLevel::eERROR, "Error replacing %s: %s", fsGetPathAsNativeString(destinationPath), strerror(errno));
+		return false;
+	}
+#endif
+	return true;
+}
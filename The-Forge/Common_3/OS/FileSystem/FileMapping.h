@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "FileSystemInternal.h"
+
+/// A read-only view of a whole file mapped into the address space.
+/// The view can be read from any thread until it is unmapped.
+typedef struct FileMapping
+{
+	const uint8_t* pData;
+	size_t         mSize;
+	void*          pPlatformHandle;
+} FileMapping;
+
+/// Maps the file at filePath, which must belong to the system file system.
+/// Returns false and leaves mapping zeroed on failure.
+bool fsMapFileReadOnly(const Path* filePath, FileMapping* mapping);
+
+/// Releases a mapping created by fsMapFileReadOnly. Safe to call on a zeroed mapping.
+void fsUnmapFile(FileMapping* mapping);
+
+/// Moves the file at sourcePath over destinationPath in a single step, both must belong to the system file system.
+/// Existing mappings of destinationPath keep seeing the old contents.
+bool fsReplaceFile(const Path* sourcePath, const Path* destinationPath);
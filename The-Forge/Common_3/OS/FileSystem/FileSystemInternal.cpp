@@ -26,6 +26,7 @@
 #ifndef FORGE_DISABLE_ZIP
 #include "ZipFileSystem.h"
 #endif
+#include "PackFileSystem.h"
 
 #include "../Interfaces/ILog.h"
 #include "../Interfaces/IMemory.h"
@@ -591,6 +592,10 @@ eastl::string fsGetPathFileNameAndExtension(const Path* path)
 	PathComponent component;
 	PathComponent ext;
 	fsGetPathComponents(path, NULL, &component, &ext);
+	if (ext.length == 0)
+	{
+		return fsPathComponentToString(component);
+	}
 	return fsPathComponentToString(component) + "." + fsPathComponentToString(ext);
 }
 
@@ -640,13 +645,17 @@ FileSystem* fsCreateFileSystemFromFileAtPath(const Path* rootPath, FileSystemFla
 {
 	if (!rootPath) { return NULL; }
 
-#ifndef FORGE_DISABLE_ZIP
 	PathComponent extension = fsGetPathExtension(rootPath);
+#ifndef FORGE_DISABLE_ZIP
 	if (extension.length == 3 && stricmp("zip", extension.buffer) == 0)
 	{
 		return ZipFileSystem::CreateWithRootAtPath(rootPath, flags);
 	}
 #endif
+	if (extension.length == 3 && stricmp("pak", extension.buffer) == 0)
+	{
+		return PackFileSystem::CreateWithRootAtPath(rootPath, flags);
+	}
 	return NULL;
 }
 
@@ -692,6 +701,9 @@ bool fsFileSystemIsReadOnly(const FileSystem* fileSystem)
 #define SHADER_DIR "Shaders/D3D11"
 #elif defined(VULKAN)
 #define SHADER_DIR "Shaders/Vulkan"
+#elif defined(NULL_RENDERER)
+// The null renderer reflects the Vulkan GLSL sources
+#define SHADER_DIR "Shaders/Vulkan"
 #elif defined(__APPLE__)
 #define SHADER_DIR "Shaders/Metal"
 #else
@@ -105,6 +105,7 @@ typedef enum FileStreamType
 	FileStreamType_System,
 	FileStreamType_MemoryStream,
 	FileStreamType_Zip,
+	FileStreamType_Pack,
 	FileStreamType_BundleAsset
 } FileStreamType;
 
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include <string.h>
+
+#include "PackFileFormat.h"
+
+// LZ4 block format: a sequence is a token (literal length << 4 | match length - 4),
+// optional literal length bytes, the literals, a 16 bit match offset and optional
+// match length bytes. The last sequence carries literals only.
+#define PACK_MIN_MATCH 4
+#define PACK_LAST_LITERALS 5    // The last 5 bytes are always literals.
+#define PACK_MF_LIMIT 12        // The last match must start at least 12 bytes before the end.
+#define PACK_MAX_DISTANCE 65535
+#define PACK_HASH_LOG 12
+
+static inline uint32_t packRead32(const uint8_t* p)
+{
+	uint32_t value;
+	memcpy(&value, p, sizeof(value));
+	return value;
+}
+
+static inline uint32_t packHash32(uint32_t sequence) { return (sequence * 2654435761u) >> (32 - PACK_HASH_LOG); }
+
+static inline uint8_t* packWriteLength(uint8_t* op, size_t length)
+{
+	while (length >= 255)
+	{
+		*op++ = 255;
+		length -= 255;
+	}
+	*op++ = (uint8_t)length;
+	return op;
+}
+
+size_t packCompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity)
+{
+	uint32_t       hashTable[1 << PACK_HASH_LOG] = {};
+	const uint8_t* anchor = src;
+	const uint8_t* ip = src;
+	uint8_t*       op = dst;
+	uint8_t* const opEnd = dst + dstCapacity;
+
+	if (srcSize > PACK_MF_LIMIT)
+	{
+		const uint8_t* const ipLimit = src + srcSize - PACK_MF_LIMIT;
+		const uint8_t* const matchLimit = src + srcSize - PACK_LAST_LITERALS;
+
+		while (ip < ipLimit)
+		{
+			uint32_t       sequence = packRead32(ip);
+			uint32_t       hash = packHash32(sequence);
+			const uint8_t* ref = src + hashTable[hash];
+			hashTable[hash] = (uint32_t)(ip - src);
+
+			if (ref >= ip || ip - ref > PACK_MAX_DISTANCE || packRead32(ref) != sequence)
+			{
+				// Skip faster through data that does not compress.
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+
+			while (ip > anchor && ref > src && ip[-1] == ref[-1])
+			{
+				--ip;
+				--ref;
+			}
+
+			size_t matchLength = PACK_MIN_MATCH;
+			while (ip + matchLength < matchLimit && ip[matchLength] == ref[matchLength])
+			{
+				++matchLength;
+			}
+
+			size_t literalLength = (size_t)(ip - anchor);
+			if ((size_t)(opEnd - op) < 1 + literalLength + literalLength / 255 + 1 + 2 + matchLength / 255 + 1)
+			{
+				return 0;
+			}
+
+			uint8_t* token = op++;
+			if (literalLength >= 15)
+			{
+				*token = 15 << 4;
+				op = packWriteLength(op, literalLength - 15);
+			}
+			else
+			{
+				*token = (uint8_t)(literalLength << 4);
+			}
+			memcpy(op, anchor, literalLength);
+			op += literalLength;
+
+			uint16_t offset = (uint16_t)(ip - ref);
+			*op++ = (uint8_t)offset;
+			*op++ = (uint8_t)(offset >> 8);
+
+			size_t extraMatchLength = matchLength - PACK_MIN_MATCH;
+			if (extraMatchLength >= 15)
+			{
+				*token |= 15;
+				op = packWriteLength(op, extraMatchLength - 15);
+			}
+			else
+			{
+				*token |= (uint8_t)extraMatchLength;
+			}
+
+			ip += matchLength;
+			anchor = ip;
+			if (ip < ipLimit)
+			{
+				hashTable[packHash32(packRead32(ip - 2))] = (uint32_t)(ip - 2 - src);
+			}
+		}
+	}
+
+	size_t literalLength = (size_t)(src + srcSize - anchor);
+	if ((size_t)(opEnd - op) < 1 + literalLength + literalLength / 255 + 1)
+	{
+		return 0;
+	}
+
+	if (literalLength >= 15)
+	{
+		*op++ = 15 << 4;
+		op = packWriteLength(op, literalLength - 15);
+	}
+	else
+	{
+		*op++ = (uint8_t)(literalLength << 4);
+	}
+	memcpy(op, anchor, literalLength);
+	op += literalLength;
+
+	return (size_t)(op - dst);
+}
+
+bool packDecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize)
+{
+	const uint8_t*       ip = src;
+	const uint8_t* const ipEnd = src + srcSize;
+	uint8_t*             op = dst;
+	uint8_t* const       opEnd = dst + dstSize;
+
+	for (;;)
+	{
+		if (ip >= ipEnd)
+		{
+			return false;
+		}
+
+		uint8_t token = *ip++;
+		size_t  literalLength = token >> 4;
+		if (literalLength == 15)
+		{
+			uint8_t extra;
+			do
+			{
+				if (ip >= ipEnd)
+				{
+					return false;
+				}
+				extra = *ip++;
+				literalLength += extra;
+			} while (extra == 255);
+		}
+
+		if (literalLength > (size_t)(ipEnd - ip) || literalLength > (size_t)(opEnd - op))
+		{
+			return false;
+		}
+		memcpy(op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		if (ip == ipEnd)
+		{
+			return op == opEnd;
+		}
+
+		if (ipEnd - ip < 2)
+		{
+			return false;
+		}
+		size_t offset = (size_t)ip[0] | ((size_t)ip[1] << 8);
+		ip += 2;
+		if (offset == 0 || offset > (size_t)(op - dst))
+		{
+			return false;
+		}
+
+		size_t matchLength = token & 15;
+		if (matchLength == 15)
+		{
+			uint8_t extra;
+			do
+			{
+				if (ip >= ipEnd)
+				{
+					return false;
+				}
+				extra = *ip++;
+				matchLength += extra;
+			} while (extra == 255);
+		}
+		matchLength += PACK_MIN_MATCH;
+
+		if (matchLength > (size_t)(opEnd - op))
+		{
+			return false;
+		}
+
+		const uint8_t* match = op - offset;
+		if (offset >= 8)
+		{
+			// Each 8 byte chunk only reads bytes that were written before it.
+			uint8_t* const copyEnd = op + matchLength;
+			while (copyEnd - op >= 8)
+			{
+				memcpy(op, match, 8);
+				op += 8;
+				match += 8;
+			}
+			while (op < copyEnd)
+			{
+				*op++ = *match++;
+			}
+		}
+		else
+		{
+			for (size_t i = 0; i < matchLength; ++i)
+			{
+				op[i] = match[i];
+			}
+			op += matchLength;
+		}
+	}
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+// On-disk layout of a .pak file, all fields little-endian:
+//
+//   PackHeader
+//   PackEntry[mEntryCount]   sorted by mPathHash, then by name
+//   PackBlock[mBlockCount]
+//   name table               null-terminated UTF-8 paths relative to the pack root, '/' separated
+//   block data               every block starts on a multiple of mDataAlignment
+//
+// File contents are split into mBlockSize chunks that are compressed independently with
+// the LZ4 block format, so any block can be decoded without touching the others.
+// Blocks that do not shrink are stored as is. Files whose blocks are all stored are
+// laid out contiguously and flagged PACK_ENTRY_STORED so they can be read in place.
+
+#define PACK_MAGIC 0x4B415046u    // 'FPAK'
+#define PACK_VERSION 1u
+#define PACK_DEFAULT_BLOCK_SIZE (64u * 1024u)
+#define PACK_DEFAULT_DATA_ALIGNMENT 16u
+
+typedef enum PackEntryFlags
+{
+	PACK_ENTRY_DIRECTORY = 1 << 0,
+	PACK_ENTRY_STORED = 1 << 1,
+} PackEntryFlags;
+
+typedef struct PackHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mBlockSize;
+	uint32_t mDataAlignment;
+	uint32_t mEntryCount;
+	uint32_t mBlockCount;
+	uint64_t mEntryTableOffset;
+	uint64_t mBlockTableOffset;
+	uint64_t mNameTableOffset;
+	uint64_t mNameTableSize;
+} PackHeader;
+
+typedef struct PackEntry
+{
+	uint64_t mPathHash;
+	uint64_t mSize;
+	int64_t  mModifiedTime;
+	uint32_t mNameOffset;
+	uint32_t mNameLength;
+	uint32_t mFirstBlock;
+	uint32_t mFlags;
+} PackEntry;
+
+typedef struct PackBlock
+{
+	uint64_t mOffset;
+	uint32_t mCompressedSize;
+	uint32_t mSize;    // Equal to mCompressedSize for stored blocks.
+} PackBlock;
+
+static_assert(sizeof(PackHeader) == 56, "PackHeader layout must match the file format");
+static_assert(sizeof(PackEntry) == 40, "PackEntry layout must match the file format");
+static_assert(sizeof(PackBlock) == 16, "PackBlock layout must match the file format");
+
+/// FNV-1a hash of a path inside a pack.
+static inline uint64_t packHashPath(const char* path, size_t length)
+{
+	uint64_t hash = 0xcbf29ce484222325ull;
+	for (size_t i = 0; i < length; ++i)
+	{
+		hash ^= (uint8_t)path[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+static inline uint32_t packBlockCount(uint64_t fileSize, uint32_t blockSize)
+{
+	return (uint32_t)((fileSize + blockSize - 1) / blockSize);
+}
+
+/// Upper bound of the compressed size of srcSize bytes.
+static inline size_t packCompressBound(size_t srcSize) { return srcSize + srcSize / 255 + 16; }
+
+/// Compresses src into dst using the LZ4 block format.
+/// Returns the compressed size, or 0 if the result does not fit in dstCapacity.
+size_t packCompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+/// Decompresses an LZ4 block that must expand to exactly dstSize bytes.
+/// Malformed input is rejected without reading or writing out of bounds.
+bool packDecompressBlock(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "PackFileStream.h"
+
+#include "../Interfaces/ILog.h"
+#include "../Interfaces/IMemory.h"
+
+PackFileStream::PackFileStream(
+	const uint8_t* archive, const PackBlock* blocks, uint32_t blockSize, size_t fileSize, bool stored, FileMode mode,
+	const Path* path):
+	FileStream(FileStreamType_Pack, path),
+	pArchive(archive),
+	pBlocks(blocks),
+	pStoredData(stored && fileSize ? archive + blocks[0].mOffset : NULL),
+	mBlockSize(blockSize),
+	mFileSize(fileSize),
+	mCursor(0),
+	pBlockCache(NULL),
+	mCachedBlock(UINT32_MAX)
+{
+}
+
+const uint8_t* PackFileStream::DecompressBlockToCache(uint32_t blockIndex)
+{
+	if (mCachedBlock == blockIndex)
+	{
+		return pBlockCache;
+	}
+
+	if (!pBlockCache)
+	{
+		pBlockCache = (uint8_t*)conf_malloc(mBlockSize);
+	}
+
+	const PackBlock& block = pBlocks[blockIndex];
+	if (!packDecompressBlock(pArchive + block.mOffset, block.mCompressedSize, pBlockCache, block.mSize))
+	{
+		LOGF(LogLevel::eERROR, "Error decompressing block %u of %s", blockIndex, fsGetPathAsNativeString(pPath));
+		mCachedBlock = UINT32_MAX;
+		return NULL;
+	}
+
+	mCachedBlock = blockIndex;
+	return pBlockCache;
+}
+
+size_t PackFileStream::Read(void* outputBuffer, size_t bufferSizeInBytes)
+{
+	size_t   bytesToRead = min(bufferSizeInBytes, mFileSize - mCursor);
+	uint8_t* output = (uint8_t*)outputBuffer;
+
+	if (pStoredData)
+	{
+		memcpy(output, pStoredData + mCursor, bytesToRead);
+		mCursor += bytesToRead;
+		return bytesToRead;
+	}
+
+	size_t bytesRead = 0;
+	while (bytesRead < bytesToRead)
+	{
+		uint32_t         blockIndex = (uint32_t)(mCursor / mBlockSize);
+		size_t           blockOffset = mCursor % mBlockSize;
+		const PackBlock& block = pBlocks[blockIndex];
+		size_t           bytesToCopy = min(bytesToRead - bytesRead, (size_t)block.mSize - blockOffset);
+
+		if (block.mCompressedSize == block.mSize)
+		{
+			memcpy(output + bytesRead, pArchive + block.mOffset + blockOffset, bytesToCopy);
+		}
+		else if (bytesToCopy == block.mSize)
+		{
+			// The read covers the whole block: decompress straight into the caller's buffer.
+			if (!packDecompressBlock(pArchive + block.mOffset, block.mCompressedSize, output + bytesRead, block.mSize))
+			{
+				LOGF(LogLevel::eERROR, "Error decompressing block %u of %s", blockIndex, fsGetPathAsNativeString(pPath));
+				break;
+			}
+		}
+		else
+		{
+			const uint8_t* blockData = DecompressBlockToCache(blockIndex);
+			if (!blockData)
+			{
+				break;
+			}
+			memcpy(output + bytesRead, blockData + blockOffset, bytesToCopy);
+		}
+
+		bytesRead += bytesToCopy;
+		mCursor += bytesToCopy;
+	}
+
+	return bytesRead;
+}
+
+size_t PackFileStream::Scan(const char* format, va_list args, int* bytesRead)
+{
+	LOGF(LogLevel::eWARNING, "fsScanFromStream is unimplemented for PackFileStreams.");
+	*bytesRead = 0;
+	return 0;
+}
+
+size_t PackFileStream::Write(const void* sourceBuffer, size_t byteCount)
+{
+	LOGF(LogLevel::eERROR, "Attempting to write to file %s in a read-only pack", fsGetPathAsNativeString(pPath));
+	return 0;
+}
+
+size_t PackFileStream::Print(const char* format, va_list args)
+{
+	LOGF(LogLevel::eERROR, "Attempting to write to file %s in a read-only pack", fsGetPathAsNativeString(pPath));
+	return 0;
+}
+
+bool PackFileStream::Seek(SeekBaseOffset baseOffset, ssize_t seekOffset)
+{
+	ssize_t newPosition = 0;
+	switch (baseOffset)
+	{
+		case SBO_START_OF_FILE: newPosition = seekOffset; break;
+		case SBO_CURRENT_POSITION: newPosition = (ssize_t)mCursor + seekOffset; break;
+		case SBO_END_OF_FILE: newPosition = (ssize_t)mFileSize + seekOffset; break;
+	}
+
+	if (newPosition < 0 || (size_t)newPosition > mFileSize)
+	{
+		return false;
+	}
+
+	// Blocks are independent, so seeking never needs to decode anything.
+	mCursor = (size_t)newPosition;
+	return true;
+}
+
+ssize_t PackFileStream::GetSeekPosition() const
+{
+	return (ssize_t)mCursor;
+}
+
+ssize_t PackFileStream::GetFileSize() const
+{
+	return (ssize_t)mFileSize;
+}
+
+void* PackFileStream::GetUnderlyingBuffer() const
+{
+	return (void*)pStoredData;
+}
+
+void PackFileStream::Flush()
+{
+}
+
+bool PackFileStream::IsAtEnd() const
+{
+	return mCursor == mFileSize;
+}
+
+bool PackFileStream::Close()
+{
+	conf_free(pBlockCache);
+	conf_delete(this);
+	return true;
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "FileSystemInternal.h"
+#include "PackFileFormat.h"
+
+class PackFileStream: public FileStream
+{
+	// Everything read through these pointers lives in the mapped pack and is
+	// immutable, so streams share nothing and can be read from different threads.
+	const uint8_t*   pArchive;
+	const PackBlock* pBlocks;
+	const uint8_t*   pStoredData;     // Contiguous file contents when the entry is stored, otherwise NULL.
+	uint32_t         mBlockSize;
+	size_t           mFileSize;
+	size_t           mCursor;
+	uint8_t*         pBlockCache;     // Last decompressed block, for reads that do not cover a whole block.
+	uint32_t         mCachedBlock;
+
+	const uint8_t* DecompressBlockToCache(uint32_t blockIndex);
+
+public:
+	PackFileStream(
+		const uint8_t* archive, const PackBlock* blocks, uint32_t blockSize, size_t fileSize, bool stored, FileMode mode,
+		const Path* path);
+
+    size_t  Read(void* outputBuffer, size_t bufferSizeInBytes) override;
+    size_t  Scan(const char* format, va_list args, int* bytesRead) override;
+    size_t  Write(const void* sourceBuffer, size_t byteCount) override;
+    size_t  Print(const char* format, va_list args) override;
+    bool    Seek(SeekBaseOffset baseOffset, ssize_t seekOffset) override;
+    ssize_t GetSeekPosition() const override;
+    ssize_t GetFileSize() const override;
+    void*   GetUnderlyingBuffer() const override;
+    void    Flush() override;
+    bool    IsAtEnd() const override;
+    bool    Close() override;
+};
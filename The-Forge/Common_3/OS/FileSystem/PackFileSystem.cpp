@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "PackFileSystem.h"
+#include "PackFileStream.h"
+
+#include "../Interfaces/IOperatingSystem.h"
+#include "../Interfaces/ILog.h"
+#include "../Interfaces/IMemory.h"
+
+static bool PackRangeIsValid(uint64_t offset, uint64_t size, uint64_t fileSize)
+{
+	return offset <= fileSize && size <= fileSize - offset;
+}
+
+// Checks every table and block once so reads never have to bounds check the pack.
+static bool ValidatePack(const FileMapping* mapping, const char* packPath)
+{
+	if (mapping->mSize < sizeof(PackHeader))
+	{
+		LOGF(LogLevel::eERROR, "Pack file %s is too small", packPath);
+		return false;
+	}
+
+	const PackHeader* header = (const PackHeader*)mapping->pData;
+	if (header->mMagic != PACK_MAGIC || header->mVersion != PACK_VERSION)
+	{
+		LOGF(LogLevel::eERROR, "%s is not a version %u pack file", packPath, PACK_VERSION);
+		return false;
+	}
+
+	// A pack of an empty directory has no entries and therefore no names.
+	if (header->mBlockSize == 0 || header->mDataAlignment == 0 || (header->mNameTableSize == 0 && header->mEntryCount != 0) ||
+		(header->mEntryTableOffset | header->mBlockTableOffset) % sizeof(uint64_t) != 0 ||
+		!PackRangeIsValid(header->mEntryTableOffset, (uint64_t)header->mEntryCount * sizeof(PackEntry), mapping->mSize) ||
+		!PackRangeIsValid(header->mBlockTableOffset, (uint64_t)header->mBlockCount * sizeof(PackBlock), mapping->mSize) ||
+		!PackRangeIsValid(header->mNameTableOffset, header->mNameTableSize, mapping->mSize))
+	{
+		LOGF(LogLevel::eERROR, "Pack file %s has a corrupt header", packPath);
+		return false;
+	}
+
+	const PackBlock* blocks = (const PackBlock*)(mapping->pData + header->mBlockTableOffset);
+	for (uint32_t i = 0; i < header->mBlockCount; ++i)
+	{
+		if (blocks[i].mSize == 0 || blocks[i].mSize > header->mBlockSize || blocks[i].mCompressedSize > blocks[i].mSize ||
+			!PackRangeIsValid(blocks[i].mOffset, blocks[i].mCompressedSize, mapping->mSize))
+		{
+			LOGF(LogLevel::eERROR, "Pack file %s has a corrupt block %u", packPath, i);
+			return false;
+		}
+	}
+
+	const PackEntry* entries = (const PackEntry*)(mapping->pData + header->mEntryTableOffset);
+	const char*      names = (const char*)(mapping->pData + header->mNameTableOffset);
+	for (uint32_t i = 0; i < header->mEntryCount; ++i)
+	{
+		const PackEntry& entry = entries[i];
+		uint32_t         blockCount = packBlockCount(entry.mSize, header->mBlockSize);
+		bool             valid = PackRangeIsValid(entry.mNameOffset, (uint64_t)entry.mNameLength + 1, header->mNameTableSize) &&
+						 names[entry.mNameOffset + entry.mNameLength] == 0 &&
+						 entry.mPathHash == packHashPath(names + entry.mNameOffset, entry.mNameLength) &&
+						 (i == 0 || entries[i - 1].mPathHash <= entry.mPathHash) &&
+						 PackRangeIsValid(entry.mFirstBlock, blockCount, header->mBlockCount);
+
+		// Every block but the last one of a file is full, which is what lets reads find blocks by division.
+		for (uint32_t b = 0; valid && b < blockCount; ++b)
+		{
+			const PackBlock& block = blocks[entry.mFirstBlock + b];
+			valid = block.mSize == (b + 1 < blockCount ? header->mBlockSize : entry.mSize - (uint64_t)b * header->mBlockSize);
+			if (entry.mFlags & PACK_ENTRY_STORED)
+			{
+				valid = valid && block.mCompressedSize == block.mSize &&
+						block.mOffset == blocks[entry.mFirstBlock].mOffset + (uint64_t)b * header->mBlockSize;
+			}
+		}
+
+		if (!valid)
+		{
+			LOGF(LogLevel::eERROR, "Pack file %s has a corrupt entry %u", packPath, i);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+PackFileSystem* PackFileSystem::CreateWithRootAtPath(const Path* rootPath, FileSystemFlags flags)
+{
+	if (flags & (FSF_CREATE_IF_NECESSARY | FSF_OVERWRITE))
+	{
+		LOGF(LogLevel::eERROR, "Pack file %s can only be opened read-only; build packs with the AssetPipeline",
+			fsGetPathAsNativeString(rootPath));
+		return NULL;
+	}
+
+	FileMapping mapping = {};
+	if (!fsMapFileReadOnly(rootPath, &mapping))
+	{
+		LOGF(LogLevel::eERROR, "Error creating file system from pack file at %s", fsGetPathAsNativeString(rootPath));
+		return NULL;
+	}
+
+	if (!ValidatePack(&mapping, fsGetPathAsNativeString(rootPath)))
+	{
+		fsUnmapFile(&mapping);
+		return NULL;
+	}
+
+	time_t creationTime = fsGetCreationTime(rootPath);
+	time_t accessedTime = fsGetLastAccessedTime(rootPath);
+	return conf_new(PackFileSystem, rootPath, &mapping, creationTime, accessedTime);
+}
+
+PackFileSystem::PackFileSystem(const Path* pathInParent, const FileMapping* mapping, time_t creationTime, time_t lastAccessedTime):
+	FileSystem(FSK_PACK),
+	pPathInParent(fsCopyPath(pathInParent)),
+	mCreationTime(creationTime),
+	mLastAccessedTime(lastAccessedTime),
+	mArchiveMapping(*mapping)
+{
+	pHeader = (const PackHeader*)mArchiveMapping.pData;
+	pEntries = (const PackEntry*)(mArchiveMapping.pData + pHeader->mEntryTableOffset);
+	pBlocks = (const PackBlock*)(mArchiveMapping.pData + pHeader->mBlockTableOffset);
+	pNames = (const char*)(mArchiveMapping.pData + pHeader->mNameTableOffset);
+}
+
+PackFileSystem::~PackFileSystem()
+{
+	fsUnmapFile(&mArchiveMapping);
+	fsFreePath(pPathInParent);
+}
+
+const PackEntry* PackFileSystem::FindEntry(const Path* path) const
+{
+	const char* name = fsGetPathAsNativeString(path);
+	uint64_t    hash = packHashPath(name, path->mPathLength);
+
+	// Lower bound on the hash, then walk the (almost always single) entries sharing it.
+	uint32_t first = 0;
+	uint32_t count = pHeader->mEntryCount;
+	while (count > 0)
+	{
+		uint32_t step = count / 2;
+		if (pEntries[first + step].mPathHash < hash)
+		{
+			first += step + 1;
+			count -= step + 1;
+		}
+		else
+		{
+			count = step;
+		}
+	}
+
+	for (uint32_t i = first; i < pHeader->mEntryCount && pEntries[i].mPathHash == hash; ++i)
+	{
+		if (pEntries[i].mNameLength == path->mPathLength && memcmp(pNames + pEntries[i].mNameOffset, name, path->mPathLength) == 0)
+		{
+			return &pEntries[i];
+		}
+	}
+
+	return NULL;
+}
+
+Path* PackFileSystem::CopyPathInParent() const { return fsCopyPath(pPathInParent); }
+
+bool PackFileSystem::IsReadOnly() const { return true; }
+
+bool PackFileSystem::IsCaseSensitive() const { return true; }
+
+char PackFileSystem::GetPathDirectorySeparator() const { return '/'; }
+
+size_t PackFileSystem::GetRootPathLength() const { return 0; }
+
+bool PackFileSystem::FormRootPath(const char* absolutePathString, Path* path, size_t* pathComponentOffset) const
+{
+	(&path->mPathBufferOffset)[0] = 0;
+	path->mPathLength = 0;
+
+	if (absolutePathString[0] == GetPathDirectorySeparator())
+	{
+		*pathComponentOffset = 1;
+	}
+	else
+	{
+		*pathComponentOffset = 0;
+	}
+
+	return true;
+}
+
+FileStream* PackFileSystem::OpenFile(const Path* filePath, FileMode mode) const
+{
+	if (mode & (FM_WRITE | FM_APPEND))
+	{
+		LOGF(LogLevel::eERROR, "File %s cannot be opened for writing in read-only pack %s", fsGetPathAsNativeString(filePath),
+			fsGetPathAsNativeString(pPathInParent));
+		return NULL;
+	}
+
+	const PackEntry* entry = FindEntry(filePath);
+	if (!entry || (entry->mFlags & PACK_ENTRY_DIRECTORY))
+	{
+		LOGF(LogLevel::eINFO, "Error finding file %s for opening in pack: %s", fsGetPathAsNativeString(filePath),
+			fsGetPathAsNativeString(pPathInParent));
+		return NULL;
+	}
+
+	return conf_new(
+		PackFileStream, mArchiveMapping.pData, pBlocks + entry->mFirstBlock, pHeader->mBlockSize, (size_t)entry->mSize,
+		(entry->mFlags & PACK_ENTRY_STORED) != 0, mode, filePath);
+}
+
+time_t PackFileSystem::GetCreationTime(const Path* filePath) const { return mCreationTime; }
+
+time_t PackFileSystem::GetLastAccessedTime(const Path* filePath) const { return mLastAccessedTime; }
+
+time_t PackFileSystem::GetLastModifiedTime(const Path* filePath) const
+{
+	const PackEntry* entry = FindEntry(filePath);
+	return entry ? (time_t)entry->mModifiedTime : 0;
+}
+
+bool PackFileSystem::CreateDirectory(const Path* directoryPath) const
+{
+	LOGF(LogLevel::eWARNING, "PackFileSystem is read-only; cannot create %s", fsGetPathAsNativeString(directoryPath));
+	return false;
+}
+
+bool PackFileSystem::DeleteFile(const Path* path) const
+{
+	LOGF(LogLevel::eWARNING, "PackFileSystem is read-only; cannot delete %s", fsGetPathAsNativeString(path));
+	return false;
+}
+
+bool PackFileSystem::CopyFile(const Path* sourcePath, const Path* destinationPath, bool overwriteIfExists) const
+{
+	LOGF(LogLevel::eWARNING, "PackFileSystem::CopyFile is unimplemented.");
+	return false;
+}
+
+bool PackFileSystem::FileExists(const Path* path) const { return FindEntry(path) != NULL; }
+
+bool PackFileSystem::IsDirectory(const Path* path) const
+{
+	const PackEntry* entry = FindEntry(path);
+	return entry && (entry->mFlags & PACK_ENTRY_DIRECTORY);
+}
+
+// Returns the name of entry relative to directory if it is a direct child of it, otherwise NULL.
+static const char* PackChildName(const char* entryName, uint32_t entryNameLength, const Path* directory)
+{
+	size_t directoryLength = directory->mPathLength;
+	if (directoryLength == 0)
+	{
+		return strchr(entryName, '/') ? NULL : entryName;
+	}
+
+	if (entryNameLength <= directoryLength + 1 || entryName[directoryLength] != '/' ||
+		memcmp(entryName, fsGetPathAsNativeString(directory), directoryLength) != 0)
+	{
+		return NULL;
+	}
+
+	const char* childName = entryName + directoryLength + 1;
+	return strchr(childName, '/') ? NULL : childName;
+}
+
+void PackFileSystem::EnumerateFilesWithExtension(
+	const Path* directory, const char* extension, bool (*processFile)(const Path*, void* userData), void* userData) const
+{
+	if (extension && extension[0] == '.')
+	{
+		extension += 1;
+	}
+
+	for (uint32_t i = 0; i < pHeader->mEntryCount; ++i)
+	{
+		const PackEntry& entry = pEntries[i];
+		const char*      childName = PackChildName(pNames + entry.mNameOffset, entry.mNameLength, directory);
+		if (!childName || (entry.mFlags & PACK_ENTRY_DIRECTORY))
+		{
+			continue;
+		}
+
+		if (extension)
+		{
+			const char* fileExtension = strrchr(childName, '.');
+			if (extension[0] == 0 ? fileExtension != NULL : (!fileExtension || stricmp(fileExtension + 1, extension) != 0))
+			{
+				continue;
+			}
+		}
+
+		Path* path = fsAppendPathComponent(directory, childName);
+		bool  shouldContinue = processFile(path, userData);
+		fsFreePath(path);
+
+		if (!shouldContinue)
+		{
+			break;
+		}
+	}
+}
+
+void PackFileSystem::EnumerateSubDirectories(
+	const Path* directory, bool (*processDirectory)(const Path*, void* userData), void* userData) const
+{
+	for (uint32_t i = 0; i < pHeader->mEntryCount; ++i)
+	{
+		const PackEntry& entry = pEntries[i];
+		const char*      childName = PackChildName(pNames + entry.mNameOffset, entry.mNameLength, directory);
+		if (!childName || !(entry.mFlags & PACK_ENTRY_DIRECTORY))
+		{
+			continue;
+		}
+
+		Path* path = fsAppendPathComponent(directory, childName);
+		bool  shouldContinue = processDirectory(path, userData);
+		fsFreePath(path);
+
+		if (!shouldContinue)
+		{
+			break;
+		}
+	}
+}
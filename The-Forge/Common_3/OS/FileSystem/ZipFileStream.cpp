@@ -22,6 +22,8 @@
  * under the License.
 */
 
+#define MINIZ_HEADER_FILE_ONLY
+#include "../../ThirdParty/OpenSource/zip/miniz.h"
 #include "../../ThirdParty/OpenSource/zip/zip.h"
 
 #include "ZipFileStream.h"
@@ -29,22 +31,156 @@
 #include "../Interfaces/ILog.h"
 #include "../Interfaces/IMemory.h"
 
+// Per stream inflate state. Inflated bytes go through the 32KB window the
+// deflate stream references, and are copied out to the reader from there.
+struct ZipInflateState
+{
+	tinfl_decompressor mDecompressor;
+	tinfl_status       mStatus;
+	size_t             mInputOffset;
+	size_t             mWindowOffset;     // Where the next inflated bytes are written in mWindow.
+	size_t             mPendingOffset;    // Inflated bytes not yet returned to the reader.
+	size_t             mPendingSize;
+	uint8_t            mWindow[TINFL_LZ_DICT_SIZE];
+};
+
 ZipFileStream::ZipFileStream(zip_t* source, FileMode mode, const Path* path):
 	FileStream(FileStreamType_Zip, path),
 	pSource(source),
-	mMode(mode)
+	mMode(mode),
+	pData(NULL),
+	pOwnedData(NULL),
+	mDataSize(0),
+	mFileSize(0),
+	mCursor(0),
+	pInflateState(NULL)
+{
+}
+
+ZipFileStream::ZipFileStream(
+	const uint8_t* data, size_t dataSize, size_t fileSize, bool compressed, uint8_t* ownedData, FileMode mode, const Path* path):
+	FileStream(FileStreamType_Zip, path),
+	pSource(NULL),
+	mMode(mode),
+	pData(data),
+	pOwnedData(ownedData),
+	mDataSize(dataSize),
+	mFileSize(fileSize),
+	mCursor(0),
+	pInflateState(NULL)
+{
+	if (compressed)
+	{
+		pInflateState = (ZipInflateState*)conf_malloc(sizeof(ZipInflateState));
+		ResetInflate();
+	}
+}
+
+void ZipFileStream::ResetInflate()
+{
+	tinfl_init(&pInflateState->mDecompressor);
+	pInflateState->mStatus = TINFL_STATUS_HAS_MORE_OUTPUT;
+	pInflateState->mInputOffset = 0;
+	pInflateState->mWindowOffset = 0;
+	pInflateState->mPendingOffset = 0;
+	pInflateState->mPendingSize = 0;
+	mCursor = 0;
+}
+
+size_t ZipFileStream::Inflate(void* outputBuffer, size_t bufferSizeInBytes)
 {
+	ZipInflateState* state = pInflateState;
+	uint8_t*         output = (uint8_t*)outputBuffer;
+
+	// Whole file read from the start: inflate straight into the caller's buffer.
+	if (output && mCursor == 0 && state->mInputOffset == 0 && bufferSizeInBytes >= mFileSize)
+	{
+		size_t inputSize = mDataSize;
+		size_t outputSize = mFileSize;
+		state->mStatus = tinfl_decompress(
+			&state->mDecompressor, pData, &inputSize, output, output, &outputSize, TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF);
+		state->mInputOffset = inputSize;
+		if (state->mStatus < 0)
+		{
+			LOGF(LogLevel::eERROR, "Error %i inflating %s", (int)state->mStatus, fsGetPathAsNativeString(pPath));
+			ResetInflate();
+			return 0;
+		}
+		// Any later read has to restart from the beginning since mWindow was bypassed.
+		state->mStatus = TINFL_STATUS_DONE;
+		mCursor = outputSize;
+		return outputSize;
+	}
+
+	size_t bytesRead = 0;
+	while (bytesRead < bufferSizeInBytes)
+	{
+		if (state->mPendingSize == 0)
+		{
+			if (state->mStatus != TINFL_STATUS_HAS_MORE_OUTPUT)
+			{
+				break;
+			}
+
+			size_t inputSize = mDataSize - state->mInputOffset;
+			size_t outputSize = TINFL_LZ_DICT_SIZE - state->mWindowOffset;
+			state->mStatus = tinfl_decompress(
+				&state->mDecompressor, pData + state->mInputOffset, &inputSize, state->mWindow,
+				state->mWindow + state->mWindowOffset, &outputSize, 0);
+			state->mInputOffset += inputSize;
+			state->mPendingOffset = state->mWindowOffset;
+			state->mPendingSize = outputSize;
+			state->mWindowOffset = (state->mWindowOffset + outputSize) & (TINFL_LZ_DICT_SIZE - 1);
+
+			if (state->mStatus < 0)
+			{
+				LOGF(LogLevel::eERROR, "Error %i inflating %s", (int)state->mStatus, fsGetPathAsNativeString(pPath));
+				break;
+			}
+			if (outputSize == 0)
+			{
+				break;
+			}
+		}
+
+		size_t bytesToCopy = min(bufferSizeInBytes - bytesRead, state->mPendingSize);
+		if (output)
+		{
+			memcpy(output + bytesRead, state->mWindow + state->mPendingOffset, bytesToCopy);
+		}
+		state->mPendingOffset += bytesToCopy;
+		state->mPendingSize -= bytesToCopy;
+		bytesRead += bytesToCopy;
+	}
+
+	mCursor += bytesRead;
+	return bytesRead;
 }
 
 size_t ZipFileStream::Read(void* outputBuffer, size_t bufferSizeInBytes)
 {
-	ssize_t bytesRead = zip_entry_noallocread(pSource, outputBuffer, (ssize_t)bufferSizeInBytes);
-	if (bytesRead == -1)
+	if (pSource)
 	{
-		LOGF(LogLevel::eERROR, "Error reading from file %s", fsGetPathAsNativeString(pPath));
+		LOGF(LogLevel::eERROR, "Attempting to read from file %s opened for writing", fsGetPathAsNativeString(pPath));
 		return 0;
 	}
-	return bytesRead;
+
+	if (pInflateState)
+	{
+		if (pInflateState->mStatus == TINFL_STATUS_DONE && mCursor < mFileSize && pInflateState->mPendingSize == 0)
+		{
+			// The whole file was inflated directly into a previous output buffer; start over.
+			size_t cursor = mCursor;
+			ResetInflate();
+			Inflate(NULL, cursor);
+		}
+		return Inflate(outputBuffer, min(bufferSizeInBytes, mFileSize - mCursor));
+	}
+
+	size_t bytesToRead = min(bufferSizeInBytes, mFileSize - mCursor);
+	memcpy(outputBuffer, pData + mCursor, bytesToRead);
+	mCursor += bytesToRead;
+	return bytesToRead;
 }
 
 size_t ZipFileStream::Scan(const char* format, va_list args, int* bytesRead)
@@ -56,6 +192,12 @@ size_t ZipFileStream::Scan(const char* format, va_list args, int* bytesRead)
 
 size_t ZipFileStream::Write(const void* sourceBuffer, size_t byteCount)
 {
+	if (!pSource)
+	{
+		LOGF(LogLevel::eERROR, "Attempting to write to file %s opened for reading", fsGetPathAsNativeString(pPath));
+		return 0;
+	}
+
 	int64_t bytesWritten = zip_entry_write(pSource, sourceBuffer, (ssize_t)byteCount);
 	if (bytesWritten == -1)
 	{
@@ -76,20 +218,63 @@ size_t ZipFileStream::Print(const char* format, va_list args)
 
 bool ZipFileStream::Seek(SeekBaseOffset baseOffset, ssize_t seekOffset)
 {
-	return false;
+	if (pSource)
+	{
+		return false;
+	}
+
+	ssize_t newPosition = 0;
+	switch (baseOffset)
+	{
+		case SBO_START_OF_FILE: newPosition = seekOffset; break;
+		case SBO_CURRENT_POSITION: newPosition = (ssize_t)mCursor + seekOffset; break;
+		case SBO_END_OF_FILE: newPosition = (ssize_t)mFileSize + seekOffset; break;
+	}
+
+	if (newPosition < 0 || (size_t)newPosition > mFileSize)
+	{
+		return false;
+	}
+
+	if (!pInflateState)
+	{
+		mCursor = (size_t)newPosition;
+		return true;
+	}
+
+	// Deflate streams can only be decoded forward: seeking backwards restarts
+	// from the beginning of the entry.
+	if ((size_t)newPosition < mCursor)
+	{
+		ResetInflate();
+	}
+	Inflate(NULL, (size_t)newPosition - mCursor);
+	return mCursor == (size_t)newPosition;
 }
 
 ssize_t ZipFileStream::GetSeekPosition() const
 {
-	return 0;
+	return (ssize_t)mCursor;
 }
 
 ssize_t ZipFileStream::GetFileSize() const
 {
-	return zip_entry_size(pSource);
+	if (pSource)
+	{
+		return zip_entry_size(pSource);
+	}
+	return (ssize_t)mFileSize;
 }
 
-void* ZipFileStream::GetUnderlyingBuffer() const { return NULL; }
+void* ZipFileStream::GetUnderlyingBuffer() const
+{
+	// Stored entries are served as a view of the archive.
+	if (!pSource && !pInflateState)
+	{
+		return (void*)pData;
+	}
+	return NULL;
+}
 
 void ZipFileStream::Flush()
 {
@@ -102,15 +287,21 @@ bool ZipFileStream::IsAtEnd() const
 
 bool ZipFileStream::Close()
 {
-	int status = zip_entry_close(pSource);
+	bool success = true;
 
-	bool success = status == 0;
-	if (!success)
+	if (pSource)
 	{
-		LOGF(LogLevel::eWARNING, "Error %i closing file %s", status, fsGetPathAsNativeString(pPath));
-		success = false;
+		int status = zip_entry_close(pSource);
+		if (status != 0)
+		{
+			LOGF(LogLevel::eWARNING, "Error %i closing file %s", status, fsGetPathAsNativeString(pPath));
+			success = false;
+		}
 	}
 
+	conf_free(pInflateState);
+	conf_free(pOwnedData);
+
 	conf_delete(this);
 	return success;
 }
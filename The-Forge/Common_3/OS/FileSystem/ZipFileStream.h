@@ -27,14 +27,33 @@
 #include "FileSystemInternal.h"
 
 typedef struct zip_t zip_t;
+struct ZipInflateState;
 
 class ZipFileStream: public FileStream
 {
-	zip_t*        pSource;
-    FileMode      mMode;
+	// Write streams go through the archive handle; only one can be open per archive.
+	zip_t*           pSource;
+	FileMode         mMode;
+
+	// Read streams own their state and never touch the archive handle, so any
+	// number of them can be used concurrently from different threads.
+	const uint8_t*   pData;           // Raw entry data: deflate stream, or file contents for stored entries.
+	uint8_t*         pOwnedData;      // Freed on close when the entry was extracted to the heap.
+	size_t           mDataSize;
+	size_t           mFileSize;
+	size_t           mCursor;
+	ZipInflateState* pInflateState;   // NULL for stored entries.
+
+	void   ResetInflate();
+	size_t Inflate(void* outputBuffer, size_t bufferSizeInBytes);
 
 public:
     ZipFileStream(zip_t* file, FileMode mode, const Path* path);
+	/// Read stream over entry data living in memory (usually a view of the mapped archive).
+	/// If compressed is true, data is a raw deflate stream inflating to fileSize bytes.
+	/// ownedData, if not NULL, is freed with conf_free when the stream is closed.
+	ZipFileStream(
+		const uint8_t* data, size_t dataSize, size_t fileSize, bool compressed, uint8_t* ownedData, FileMode mode, const Path* path);
 
     size_t  Read(void* outputBuffer, size_t bufferSizeInBytes) override;
     size_t  Scan(const char* format, va_list args, int* bytesRead) override;
@@ -22,6 +22,8 @@
  * under the License.
 */
 
+#define MINIZ_HEADER_FILE_ONLY
+#include "../../ThirdParty/OpenSource/zip/miniz.h"
 #include "../../ThirdParty/OpenSource/zip/zip.h"
 
 #include "ZipFileSystem.h"
@@ -65,10 +67,27 @@ ZipFileSystem* ZipFileSystem::CreateWithRootAtPath(const Path* rootPath, FileSys
 		uint32_t dir = zip_entry_isdir(zipFile);
 		ssize_t size = zip_entry_size(zipFile);
 		time_t time = zip_entry_time(zipFile);
-		system->mEntries[zip_entry_name(zipFile)] = { time, size, i, dir };
+
+		unsigned long long dataOffset = 0;
+		unsigned long long compressedSize = 0;
+		int method = 0;
+		uint32_t hasDataLocation = 0;
+		if (mode == 'r' && !dir)
+		{
+			// Only stored and deflated entries can be read without the zip handle.
+			hasDataLocation = zip_entry_data_location(zipFile, i, &dataOffset, &compressedSize, &method) == 0 &&
+				(method == 0 || method == MZ_DEFLATED);
+		}
+
+		system->mEntries[zip_entry_name(zipFile)] = { time, size, dataOffset, compressedSize, i, dir, method != 0, hasDataLocation };
 		zip_entry_close(zipFile);
 	}
 
+	if (mode == 'r' && !fsMapFileReadOnly(rootPath, &system->mArchiveMapping))
+	{
+		LOGF(LogLevel::eWARNING, "Could not map zip file %s; reads will be serialized", fsGetPathAsNativeString(rootPath));
+	}
+
 	return system;
 }
 
@@ -80,11 +99,15 @@ ZipFileSystem::ZipFileSystem(const Path* pathInParent, zip_t* zipFile, FileSyste
 	mCreationTime(creationTime),
 	mLastAccessedTime(lastAccessedTime)
 {
+	memset(&mArchiveMapping, 0, sizeof(mArchiveMapping));
+	mZipFileMutex.Init();
 }
 
 ZipFileSystem::~ZipFileSystem()
 {
+	fsUnmapFile(&mArchiveMapping);
 	zip_close(pZipFile);
+	mZipFileMutex.Destroy();
 	fsFreePath(pPathInParent);
 }
 
@@ -130,6 +153,8 @@ FileStream* ZipFileSystem::OpenFile(const Path* filePath, FileMode mode) const
 			return NULL;
 		}
 
+		// The write stream keeps the entry open on pZipFile until it is closed.
+		MutexLock lock(mZipFileMutex);
 		int error = zip_entry_open(pZipFile, fsGetPathAsNativeString(filePath));
 		if (error)
 		{
@@ -155,15 +180,41 @@ FileStream* ZipFileSystem::OpenFile(const Path* filePath, FileMode mode) const
 			fsGetPathAsNativeString(pPathInParent));
 	}
 
-	int error = zip_entry_open(pZipFile, fsGetPathAsNativeString(filePath));
-	if (error)
+	const ZipEntry& entry = it->second;
+	if (mArchiveMapping.pData && entry.mHasDataLocation)
 	{
-		LOGF(LogLevel::eINFO, "Error %i finding file %s for opening in zip: %s", error, fsGetPathAsNativeString(filePath),
-			fsGetPathAsNativeString(pPathInParent));
-		return NULL;
+		return conf_new(
+			ZipFileStream, mArchiveMapping.pData + entry.mDataOffset, (size_t)entry.mCompressedSize, (size_t)entry.mSize,
+			entry.mCompressed == 1, (uint8_t*)NULL, mode, filePath);
+	}
+
+	// Fall back to extracting the whole entry through the shared zip handle. The stream frees the data with conf_free,
+	// so it is read into our own allocation rather than one made by miniz.
+	void*  data = NULL;
+	size_t dataSize = 0;
+	{
+		MutexLock lock(mZipFileMutex);
+		int error = zip_entry_openbyindex(pZipFile, (int)entry.mIndex);
+		if (error)
+		{
+			LOGF(LogLevel::eINFO, "Error %i finding file %s for opening in zip: %s", error, fsGetPathAsNativeString(filePath),
+				fsGetPathAsNativeString(pPathInParent));
+			return NULL;
+		}
+		dataSize = (size_t)zip_entry_size(pZipFile);
+		data = conf_malloc(dataSize);
+		ssize_t bytesRead = dataSize ? zip_entry_noallocread(pZipFile, data, dataSize) : 0;
+		zip_entry_close(pZipFile);
+		if (bytesRead != (ssize_t)dataSize)
+		{
+			conf_free(data);
+			LOGF(LogLevel::eERROR, "Error reading file %s in zip: %s", fsGetPathAsNativeString(filePath),
+				fsGetPathAsNativeString(pPathInParent));
+			return NULL;
+		}
 	}
 
-	return conf_new(ZipFileStream, pZipFile, mode, filePath);
+	return conf_new(ZipFileStream, (const uint8_t*)data, dataSize, dataSize, false, (uint8_t*)data, mode, filePath);
 }
 
 time_t ZipFileSystem::GetCreationTime(const Path* filePath) const { return mCreationTime; }
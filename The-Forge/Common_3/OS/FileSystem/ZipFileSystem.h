@@ -26,6 +26,8 @@
 #define ZipFileSystem_h
 
 #include "FileSystemInternal.h"
+#include "FileMapping.h"
+#include "../Interfaces/IThread.h"
 #include "../../ThirdParty/OpenSource/EASTL/string_hash_map.h"
 
 typedef struct zip_t zip_t;
@@ -36,16 +38,25 @@ class ZipFileSystem: public FileSystem
 	{
 		time_t   mTime;
 		ssize_t  mSize;
-		uint32_t mIndex : 31;
+		uint64_t mDataOffset;
+		uint64_t mCompressedSize;
+		uint32_t mIndex : 29;
 		uint32_t mDirectory : 1;
+		uint32_t mCompressed : 1;
+		uint32_t mHasDataLocation : 1;
 	};
 
 	zip_t*                           pZipFile;
 	Path*                            pPathInParent;
 	FileSystemFlags                  mFlags;
 	time_t                           mCreationTime;
+	// Built once at creation and never modified afterwards, so lookups need no locking.
 	eastl::string_hash_map<ZipEntry> mEntries;
 	time_t                           mLastAccessedTime;
+	// Read-only archives are mapped so every read stream inflates straight from memory.
+	FileMapping                      mArchiveMapping;
+	// Guards pZipFile, used for writes and for reads when the archive could not be mapped.
+	mutable Mutex                    mZipFileMutex;
 
 public:
     ZipFileSystem(const Path* pathInParent, zip_t* zipFile, FileSystemFlags flags, time_t creationTime, time_t lastAccessedTime);
@@ -73,6 +73,11 @@
 #include "ImageHelper.h"
 
 #include "../FileSystem/MemoryStream.h"
+#include "../FileSystem/FileMapping.h"
+
+#include "../Core/Atomics.h"
+#include "../Core/ThreadSystem.h"
+#include "../Interfaces/IThread.h"
 
 #include "../Interfaces/IMemory.h"
 
@@ -880,8 +885,10 @@ ImageLoadingResult iLoadSTBFromStream(Image* pImage,
 }
 #endif
 
-ImageLoadingResult iLoadDDSFromStream(Image* pImage,
-	FileStream* pStream, memoryAllocationFunc pAllocator, void* pUserData)
+// Loads mips [firstMip, firstMip + mipCount) into an image whose mip 0 is firstMip. Each mip is read from the file on its own.
+// mipCount == 0 only reads the header, the image then describes every mip of the file and has no pixels
+static ImageLoadingResult iLoadDDSMipsFromStream(Image* pImage,
+	FileStream* pStream, memoryAllocationFunc pAllocator, void* pUserData, uint32_t firstMip, uint32_t mipCount)
 {
 	if (pStream == NULL || fsGetStreamFileSize(pStream) == 0)
 		return IMAGE_LOADING_RESULT_DECODING_FAILED;
@@ -920,8 +927,26 @@ ImageLoadingResult iLoadDDSFromStream(Image* pImage,
 	else
 		d = d ? d : 1;
 	s = s ? s : 1;
+	mm = mm ? mm : 1;
+
+	if (mipCount == 0)
+	{
+		pImage->RedefineDimensions(fmt, w, h, d, mm, s);
+		TinyDDS_DestroyContext(ctx);
+		return IMAGE_LOADING_RESULT_SUCCESS;
+	}
 
-	pImage->RedefineDimensions(fmt, w, h, d, mm, s);
+	if (firstMip >= mm)
+	{
+		TinyDDS_DestroyContext(ctx);
+		return IMAGE_LOADING_RESULT_DECODING_FAILED;
+	}
+	mipCount = min(mipCount, mm - firstMip);
+	w = max(w >> firstMip, 1u);
+	h = max(h >> firstMip, 1u);
+	d = d ? max(d >> firstMip, 1u) : 0;
+
+	pImage->RedefineDimensions(fmt, w, h, d, mipCount, s);
 	pImage->SetMipsAfterSlices(true); // tinyDDS API is mips after slices even if DDS traditionally weren't
 
 	if (d == 0)
@@ -942,6 +967,7 @@ ImageLoadingResult iLoadDDSFromStream(Image* pImage,
 	
 	for (uint mipMapLevel = 0; mipMapLevel < pImage->GetMipMapCount(); mipMapLevel++)
 	{
+		uint32_t fileMip = firstMip + mipMapLevel;
 		size_t blocksPerRow = (w + TinyImageFormat_WidthOfBlock(fmt) - 1) / TinyImageFormat_WidthOfBlock(fmt);
 		size_t sourceBytesPerRow = TinyImageFormat_BitSizeOfBlock(fmt) / 8 * blocksPerRow;
 		size_t destinationBytesPerRow = pImage->GetBytesPerRow(mipMapLevel);
@@ -949,14 +975,20 @@ ImageLoadingResult iLoadDDSFromStream(Image* pImage,
 		size_t depthCount = d == 0 ? 1 : (TinyDDS_IsCubemap(ctx) ? 1 : d);
 
 		size_t const expectedSize = sourceBytesPerRow * rowCount * depthCount * s;
-		size_t const fileSize = TinyDDS_ImageSize(ctx, mipMapLevel);
+		size_t const fileSize = TinyDDS_ImageSize(ctx, fileMip);
 		if (expectedSize != fileSize)
 		{
-			LOGF(LogLevel::eERROR, "DDS file %s mipmap %i size error %liu < %liu", fsGetPathAsNativeString(pImage->GetPath()), mipMapLevel, expectedSize, fileSize);
+			LOGF(LogLevel::eERROR, "DDS file %s mipmap %i size error %liu < %liu", fsGetPathAsNativeString(pImage->GetPath()), fileMip, expectedSize, fileSize);
+			TinyDDS_DestroyContext(ctx);
 			return IMAGE_LOADING_RESULT_DECODING_FAILED;
 		}
 		
-		const unsigned char* src = (const unsigned char*)TinyDDS_ImageRawData(ctx, mipMapLevel);
+		const unsigned char* src = (const unsigned char*)TinyDDS_ImageRawData(ctx, fileMip);
+		if (!src)
+		{
+			TinyDDS_DestroyContext(ctx);
+			return IMAGE_LOADING_RESULT_DECODING_FAILED;
+		}
 		
 		for (uint slice = 0; slice < s; slice += 1)
 		{
@@ -979,6 +1011,12 @@ ImageLoadingResult iLoadDDSFromStream(Image* pImage,
 	return IMAGE_LOADING_RESULT_SUCCESS;
 }
 
+ImageLoadingResult iLoadDDSFromStream(Image* pImage,
+	FileStream* pStream, memoryAllocationFunc pAllocator, void* pUserData)
+{
+	return iLoadDDSMipsFromStream(pImage, pStream, pAllocator, pUserData, 0, UINT32_MAX);
+}
+
 ImageLoadingResult iLoadPVRFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator, void* pUserData)
 {
 #ifndef TARGET_IOS
@@ -1066,7 +1104,8 @@ ImageLoadingResult iLoadPVRFromStream(Image* pImage, FileStream* pStream, memory
 }
 
 #ifndef IMAGE_DISABLE_KTX
-ImageLoadingResult iLoadKTXFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator /*= NULL*/, void* pUserData /*= NULL*/)
+// Same contract as iLoadDDSMipsFromStream
+static ImageLoadingResult iLoadKTXMipsFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator, void* pUserData, uint32_t firstMip, uint32_t mipCount)
 {
 	TinyKtx_Callbacks callbacks {
 			&tinyktxddsCallbackError,
@@ -1102,8 +1141,26 @@ ImageLoadingResult iLoadKTXFromStream(Image* pImage, FileStream* pStream, memory
 	
 	if (d == 0)
 		s *= 6;
+	mm = mm ? mm : 1;
+
+	if (mipCount == 0)
+	{
+		pImage->RedefineDimensions(fmt, w, h, d, mm, s);
+		TinyKtx_DestroyContext(ctx);
+		return IMAGE_LOADING_RESULT_SUCCESS;
+	}
 
-	pImage->RedefineDimensions(fmt, w, h, d, mm, s);
+	if (firstMip >= mm)
+	{
+		TinyKtx_DestroyContext(ctx);
+		return IMAGE_LOADING_RESULT_DECODING_FAILED;
+	}
+	mipCount = min(mipCount, mm - firstMip);
+	w = max(w >> firstMip, 1u);
+	h = max(h >> firstMip, 1u);
+	d = d ? max(d >> firstMip, 1u) : 0;
+
+	pImage->RedefineDimensions(fmt, w, h, d, mipCount, s);
     pImage->SetMipsAfterSlices(true); // tinyDDS API is mips after slices even if DDS traditionally weren't
 
 	size_t size = pImage->GetSizeInBytes();
@@ -1123,10 +1180,16 @@ ImageLoadingResult iLoadKTXFromStream(Image* pImage, FileStream* pStream, memory
     {
 		uint blocksPerRow = (w + TinyImageFormat_WidthOfBlock(fmt) - 1) / TinyImageFormat_WidthOfBlock(fmt);
 		uint rowCount = pImage->GetRowCount(mipMapLevel);
-		uint8_t const* src = (uint8_t const*) TinyKtx_ImageRawData(ctx, mipMapLevel);
+		uint32_t fileMip = firstMip + mipMapLevel;
+		uint8_t const* src = (uint8_t const*) TinyKtx_ImageRawData(ctx, fileMip);
+		if (!src)
+		{
+			TinyKtx_DestroyContext(ctx);
+			return IMAGE_LOADING_RESULT_DECODING_FAILED;
+		}
 
-		uint32_t srcStride = TinyKtx_UnpackedRowStride(ctx, mipMapLevel);
-		if (!TinyKtx_IsMipMapLevelUnpacked(ctx, mipMapLevel))
+		uint32_t srcStride = TinyKtx_UnpackedRowStride(ctx, fileMip);
+		if (!TinyKtx_IsMipMapLevelUnpacked(ctx, fileMip))
 			srcStride = (TinyImageFormat_BitSizeOfBlock(fmt) / 8) * blocksPerRow;
 		
 		uint32_t const dstStride = pImage->GetBytesPerRow(mipMapLevel);
@@ -1150,16 +1213,82 @@ ImageLoadingResult iLoadKTXFromStream(Image* pImage, FileStream* pStream, memory
 	TinyKtx_DestroyContext(ctx);
 	return IMAGE_LOADING_RESULT_SUCCESS;
 }
+
+ImageLoadingResult iLoadKTXFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator /*= NULL*/, void* pUserData /*= NULL*/)
+{
+	return iLoadKTXMipsFromStream(pImage, pStream, pAllocator, pUserData, 0, UINT32_MAX);
+}
 #endif
 
 #if defined(ORBIS)
 ImageLoadingResult iLoadGNFFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator /*= NULL*/, void* pUserData /*= NULL*/);
 #endif
 
+// Set by Image::Init, lets loaders spread decoding over worker threads
+static ThreadSystem* gImageLoaderThreadSystem = NULL;
+
+typedef void (*ImageTileFunc)(void* pUserData, uint32_t tile, float* pScratch);
+static void processImageTiles(ThreadSystem* pThreadSystem, ImageTileFunc pFunc, void* pUserData, uint32_t tileCount, size_t scratchSize);
+
 //------------------------------------------------------------------------------
 #ifndef IMAGE_DISABLE_GOOGLE_BASIS
 //  Loads a Basis data from memory.
 //
+typedef struct BasisTranscodeJob
+{
+	basist::basisu_transcoder*        pDecoder;
+	const void*                       pData;
+	uint32_t                          mDataSize;
+	Image*                            pImage;
+	basist::transcoder_texture_format mFormat;
+	uint32_t                          mBlockByteSize;
+	uint32_t                          mImageCount;
+	const uint32_t*                   pImageLevelCounts;
+	tfrg_atomic32_t                   mFailed;
+} BasisTranscodeJob;
+
+// Transcodes one (level, image) pair. Tiles walk the levels from the largest so the biggest jobs start first
+static void transcodeBasisLevel(void* pUserData, uint32_t tile, float*)
+{
+	BasisTranscodeJob* pJob = (BasisTranscodeJob*)pUserData;
+	const uint32_t     imageIndex = tile % pJob->mImageCount;
+	const uint32_t     levelIndex = tile / pJob->mImageCount;
+	if (levelIndex >= pJob->pImageLevelCounts[imageIndex] || tfrg_atomic32_load_relaxed(&pJob->mFailed))
+		return;
+
+	basist::basisu_image_level_info levelInfo;
+	if (!pJob->pDecoder->get_image_level_info(pJob->pData, pJob->mDataSize, levelInfo, imageIndex, levelIndex))
+	{
+		LOGF(LogLevel::eERROR, "Failed retrieving image level information (%u %u)!\n", imageIndex, levelIndex);
+		tfrg_atomic32_store_relaxed(&pJob->mFailed, 1);
+		return;
+	}
+
+	if (pJob->mFormat == basist::transcoder_texture_format::cTFPVRTC1_4_RGB)
+	{
+		if (!isPowerOf2(levelInfo.m_width) || !isPowerOf2(levelInfo.m_height))
+		{
+			LOGF(LogLevel::eWARNING, "Warning: Will not transcode image %u level %u res %ux%u to PVRTC1 (one or more dimension is not a power of 2)\n", imageIndex, levelIndex, levelInfo.m_width, levelInfo.m_height);
+
+			// Can't transcode this image level to PVRTC because it's not a pow2 (we're going to support transcoding non-pow2 to the next larger pow2 soon)
+			return;
+		}
+	}
+
+	ASSERT(pJob->pImage->GetBytesPerRow(levelIndex) % pJob->mBlockByteSize == 0);
+	uint32_t rowPitchInBlocks = pJob->pImage->GetBytesPerRow(levelIndex) / pJob->mBlockByteSize;
+
+	// The transcoder's own state is shared, every task needs its own
+	basist::basisu_transcoder_state state;
+	if (!pJob->pDecoder->transcode_image_level(
+			pJob->pData, pJob->mDataSize, imageIndex, levelIndex, pJob->pImage->GetPixels(levelIndex, imageIndex),
+			rowPitchInBlocks * levelInfo.m_num_blocks_y, pJob->mFormat, 0, rowPitchInBlocks, &state))
+	{
+		LOGF(LogLevel::eERROR, "Failed transcoding image level (%u %u)!\n", imageIndex, levelIndex);
+		tfrg_atomic32_store_relaxed(&pJob->mFailed, 1);
+	}
+}
+
 ImageLoadingResult iLoadBASISFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator /*= NULL*/, void* pUserData /*= NULL*/)
 {
 	if (pStream == NULL || fsGetStreamFileSize(pStream) <= 0)
@@ -1170,10 +1299,25 @@ ImageLoadingResult iLoadBASISFromStream(Image* pImage, FileStream* pStream, memo
 	void* basisData = fsGetStreamBufferIfPresent(pStream);
 	size_t memSize = (size_t)fsGetStreamFileSize(pStream);
 
+	// Files on disk are mapped instead of being copied into a temporary buffer
+	FileMapping mapping = {};
 	if (!basisData)
 	{
-		basisData = conf_malloc(memSize);
-		fsReadFromStream(pStream, basisData, memSize);
+		const Path* filePath = pImage->GetPath();
+		if (filePath && fsGetFileSystemKind(fsGetPathFileSystem(filePath)) == FSK_SYSTEM && fsMapFileReadOnly(filePath, &mapping))
+		{
+			if (mapping.mSize == memSize)
+				basisData = (void*)mapping.pData;
+			else
+				fsUnmapFile(&mapping);
+		}
+	}
+	void* basisCopy = NULL;
+	if (!basisData)
+	{
+		basisCopy = conf_malloc(memSize);
+		fsReadFromStream(pStream, basisCopy, memSize);
+		basisData = basisCopy;
 	}
 
 	basist::basisu_transcoder decoder(&sel_codebook);
@@ -1182,6 +1326,9 @@ ImageLoadingResult iLoadBASISFromStream(Image* pImage, FileStream* pStream, memo
 	if (!decoder.get_file_info(basisData, (uint32_t)memSize, fileinfo))
 	{
 		LOGF(LogLevel::eERROR, "Failed retrieving Basis file information!");
+		if (basisCopy)
+			conf_free(basisCopy);
+		fsUnmapFile(&mapping);
 		return IMAGE_LOADING_RESULT_DECODING_FAILED;
 	}
 
@@ -1252,75 +1399,100 @@ ImageLoadingResult iLoadBASISFromStream(Image* pImage, FileStream* pStream, memo
 
 	size_t size = pImage->GetSizeInBytes();
 
+	// The transcoder writes straight into this memory, which is staging memory when the resource loader supplies pAllocator
 	if (pAllocator)
 		pImage->SetPixels((unsigned char*)pAllocator(pImage, size, pImage->GetSubtextureAlignment(), pUserData));
 	else
 		pImage->SetPixels((unsigned char*)conf_malloc(sizeof(unsigned char) * size), true);
 	
 	if (!pImage->GetPixels())
+	{
+		if (basisCopy)
+			conf_free(basisCopy);
+		fsUnmapFile(&mapping);
 		return IMAGE_LOADING_RESULT_ALLOCATION_FAILED;
+	}
 
 	decoder.start_transcoding(basisData, (uint32_t)memSize);
-	
-	for (uint32_t image_index = 0; image_index < fileinfo.m_total_images; image_index++)
-	{
-		for (uint32_t level_index = 0; level_index < fileinfo.m_image_mipmap_levels[image_index]; level_index++)
-		{
-			uint rowPitchInBlocks = pImage->GetBytesPerRow(level_index) / (TinyImageFormat_BitSizeOfBlock(pImage->GetFormat()) / 8);
-			ASSERT(pImage->GetBytesPerRow(level_index) % (TinyImageFormat_BitSizeOfBlock(pImage->GetFormat()) / 8) == 0);
-			
-			basist::basisu_image_level_info level_info;
 
-			if (!decoder.get_image_level_info(basisData, (uint32_t)memSize, level_info, image_index, level_index))
-			{
-				LOGF(LogLevel::eERROR, "Failed retrieving image level information (%u %u)!\n", image_index, level_index);
-				if (!fsGetStreamBufferIfPresent(pStream)) { conf_free(basisData); }
-				return IMAGE_LOADING_RESULT_DECODING_FAILED;
-			}
+	BasisTranscodeJob job = {};
+	job.pDecoder = &decoder;
+	job.pData = basisData;
+	job.mDataSize = (uint32_t)memSize;
+	job.pImage = pImage;
+	job.mFormat = basisTextureFormat;
+	job.mBlockByteSize = TinyImageFormat_BitSizeOfBlock(imageFormat) / 8;
+	job.mImageCount = fileinfo.m_total_images;
+	job.pImageLevelCounts = fileinfo.m_image_mipmap_levels.data();
+	job.mFailed = 0;
+
+	// Every level of every image is its own task. Levels past the ones of the first image have no storage and are skipped
+	processImageTiles(gImageLoaderThreadSystem, transcodeBasisLevel, &job, mipMapCount * arrayCount, 0);
+
+	if (basisCopy)
+		conf_free(basisCopy);
+	fsUnmapFile(&mapping);
+
+	return tfrg_atomic32_load_relaxed(&job.mFailed) ? IMAGE_LOADING_RESULT_DECODING_FAILED : IMAGE_LOADING_RESULT_SUCCESS;
+}
+#endif
 
-			if (basisTextureFormat == basist::transcoder_texture_format::cTFPVRTC1_4_RGB)
-			{
-				if (!isPowerOf2(level_info.m_width) || !isPowerOf2(level_info.m_height))
-				{
-					LOGF(LogLevel::eWARNING, "Warning: Will not transcode image %u level %u res %ux%u to PVRTC1 (one or more dimension is not a power of 2)\n", image_index, level_index, level_info.m_width, level_info.m_height);
 
-					// Can't transcode this image level to PVRTC because it's not a pow2 (we're going to support transcoding non-pow2 to the next larger pow2 soon)
-					continue;
-				}
-			}
+// Number of pages in the mips above the mip tail
+static uint32_t svtPageCount(uint32_t width, uint32_t height, uint32_t mipMapCount, uint32_t pageSize)
+{
+	const uint32_t pageMipLevels = (uint32_t)log2f((float)pageSize);
+	if (pageSize == 0 || mipMapCount <= pageMipLevels)
+		return 0;
+
+	uint32_t pageCount = 0;
+	for (uint32_t i = 0; i < mipMapCount - pageMipLevels; ++i)
+		pageCount += ((width >> i) / pageSize) * ((height >> i) / pageSize);
+	return pageCount;
+}
 
-			if (!decoder.transcode_image_level(basisData, (uint32_t)memSize, image_index, level_index, pImage->GetPixels(level_index, image_index), (uint32_t)(rowPitchInBlocks * imageinfo.m_num_blocks_y), basisTextureFormat, 0, rowPitchInBlocks))
-			{
-				LOGF(LogLevel::eERROR, "Failed transcoding image level (%u %u)!\n", image_index, level_index);
-				
-				if (!fsGetStreamBufferIfPresent(pStream)) { conf_free(basisData); }
-				return IMAGE_LOADING_RESULT_DECODING_FAILED;
-			}
-		}
+bool readSVTHeader(FileStream* pStream, SVTHeader* pHeader, eastl::vector<uint64_t>* pPageOffsets)
+{
+	memset(pHeader, 0, sizeof(SVTHeader));
+	if (pStream == NULL || fsGetStreamFileSize(pStream) < (ssize_t)(5 * sizeof(uint32_t)))
+		return false;
+
+	uint32_t first = fsReadFromStreamUInt32(pStream);
+	if (first == SVT_FILE_MAGIC)
+	{
+		pHeader->mMagic = first;
+		if (fsReadFromStream(pStream, &pHeader->mVersion, sizeof(SVTHeader) - sizeof(uint32_t)) != sizeof(SVTHeader) - sizeof(uint32_t) ||
+			pHeader->mVersion != SVT_FILE_VERSION)
+			return false;
+
+		pPageOffsets->resize(pHeader->mPageCount + 1);
+		size_t tableSize = pPageOffsets->size() * sizeof(uint64_t);
+		return fsReadFromStream(pStream, pPageOffsets->data(), tableSize) == tableSize;
 	}
 
-	if (!fsGetStreamBufferIfPresent(pStream)) { conf_free(basisData); }
+	// Layout without page table: pages are stored back to back after the header
+	pHeader->mWidth = first;
+	pHeader->mHeight = fsReadFromStreamUInt32(pStream);
+	pHeader->mMipMapCount = fsReadFromStreamUInt32(pStream);
+	pHeader->mPageSize = fsReadFromStreamUInt32(pStream);
+	pHeader->mComponentCount = fsReadFromStreamUInt32(pStream);
+	pHeader->mPageCount = svtPageCount(pHeader->mWidth, pHeader->mHeight, pHeader->mMipMapCount, pHeader->mPageSize);
 
-	return IMAGE_LOADING_RESULT_SUCCESS;
+	const uint64_t pageByteSize = (uint64_t)pHeader->mPageSize * pHeader->mPageSize * pHeader->mComponentCount;
+	pPageOffsets->resize(pHeader->mPageCount + 1);
+	for (uint32_t i = 0; i <= pHeader->mPageCount; ++i)
+		(*pPageOffsets)[i] = 5 * sizeof(uint32_t) + i * pageByteSize;
+	return true;
 }
-#endif
-
 
 ImageLoadingResult iLoadSVTFromStream(Image* pImage, FileStream* pStream, memoryAllocationFunc pAllocator /*= NULL*/, void* pUserData /*= NULL*/)
 {
-	if (pStream == NULL || fsGetStreamFileSize(pStream) == 0)
+	SVTHeader header = {};
+	eastl::vector<uint64_t> pageOffsets;
+	if (!readSVTHeader(pStream, &header, &pageOffsets))
 		return IMAGE_LOADING_RESULT_DECODING_FAILED;
 
-	uint width = fsReadFromStreamUInt32(pStream);
-	uint height = fsReadFromStreamUInt32(pStream);
-	uint mipMapCount = fsReadFromStreamUInt32(pStream);
-	/* uint pageSize = */ fsReadFromStreamUInt32(pStream);
-	uint numberOfComponents = fsReadFromStreamUInt32(pStream);
-
-	if(numberOfComponents == 4)
-		pImage->RedefineDimensions(TinyImageFormat_R8G8B8A8_UNORM, width, height, 1, mipMapCount, 1);
-	else
-		pImage->RedefineDimensions(TinyImageFormat_R8G8B8A8_UNORM, width, height, 1, mipMapCount, 1);
+	pImage->RedefineDimensions(TinyImageFormat_R8G8B8A8_UNORM, header.mWidth, header.mHeight, 1, header.mMipMapCount, 1);
 
 	size_t size = pImage->GetSizeInBytes();
 	
@@ -1332,6 +1504,7 @@ ImageLoadingResult iLoadSVTFromStream(Image* pImage, FileStream* pStream, memory
 	if (!pImage->GetPixels())
 		return IMAGE_LOADING_RESULT_ALLOCATION_FAILED;
 
+	fsSeekStream(pStream, SBO_START_OF_FILE, (ssize_t)pageOffsets[0]);
 	fsReadFromStream(pStream, pImage->GetPixels(), size);
 
 	return IMAGE_LOADING_RESULT_SUCCESS;
@@ -1350,8 +1523,10 @@ static ImageLoaderDefinition gImageLoaders[MAX_IMAGE_LOADERS];
 uint32_t gImageLoaderCount = 0;
 
 // One time call to initialize all loaders
-void Image::Init()
+void Image::Init(ThreadSystem* pThreadSystem)
 {
+	gImageLoaderThreadSystem = pThreadSystem;
+
 #ifndef IMAGE_DISABLE_STB
 	gImageLoaders[gImageLoaderCount++] = {"png", iLoadSTBFromStream};
 	gImageLoaders[gImageLoaderCount++] = {"jpg", iLoadSTBFromStream};
@@ -1372,6 +1547,7 @@ void Image::Init()
 
 void Image::Exit()
 {
+	gImageLoaderThreadSystem = NULL;
 }
 
 void Image::AddImageLoader(const char* pExtension, ImageLoaderFunction pFunc) {
@@ -1520,37 +1696,331 @@ ImageLoadingResult Image::LoadFromFile(const Path* filePath, memoryAllocationFun
 	return result;
 }
 
-bool Image::Convert(const TinyImageFormat newFormat)
+ImageLoadingResult Image::LoadMipsFromFile(const Path* filePath, uint32_t firstMip, uint32_t mipCount, uint rowAlignment, uint subtextureAlignment)
+{
+	Clear();
+	mRowAlignment = rowAlignment;
+	mSubtextureAlignment = subtextureAlignment;
+
+	PathComponent extension = fsGetPathExtension(filePath);
+	bool dds = extension.length && stricmp(extension.buffer, "dds") == 0;
+#ifndef IMAGE_DISABLE_KTX
+	bool ktx = extension.length && stricmp(extension.buffer, "ktx") == 0;
+#else
+	bool ktx = false;
+#endif
+	// Other containers cannot be read mip by mip
+	if (!dds && !ktx)
+		return IMAGE_LOADING_RESULT_DECODING_FAILED;
+
+	FileStream* fh = fsOpenFile(filePath, FM_READ_BINARY);
+	if (!fh)
+	{
+		LOGF(LogLevel::eERROR, "\"%s\": Image file not found.", fsGetPathAsNativeString(filePath));
+		return IMAGE_LOADING_RESULT_DECODING_FAILED;
+	}
+
+	// Zip streams cannot seek, the file is read into memory like LoadFromFile does
+	void* zipBuffer = NULL;
+	if (FSK_ZIP == fsGetFileSystemKind(fsGetPathFileSystem(filePath)))
+	{
+		ssize_t size = fsGetStreamFileSize(fh);
+		zipBuffer = conf_malloc(size);
+		fsReadFromStream(fh, zipBuffer, size);
+		fsCloseStream(fh);
+		fh = fsOpenReadOnlyMemory(zipBuffer, size);
+	}
+
+	mLoadFilePath = fsCopyPath(filePath);
+
+	ImageLoadingResult result = IMAGE_LOADING_RESULT_DECODING_FAILED;
+	if (dds)
+		result = iLoadDDSMipsFromStream(this, fh, NULL, NULL, firstMip, mipCount);
+#ifndef IMAGE_DISABLE_KTX
+	else
+		result = iLoadKTXMipsFromStream(this, fh, NULL, NULL, firstMip, mipCount);
+#endif
+
+	fsCloseStream(fh);
+	if (zipBuffer)
+		conf_free(zipBuffer);
+
+	return result;
+}
+
+// -- TILED PROCESSING --
+
+// Pixels per conversion tile. Every worker owns a single float4 scratch tile, so Convert needs
+// IMAGE_TILE_PIXEL_COUNT * 16 bytes of temporary memory per thread regardless of the image size
+#define IMAGE_TILE_PIXEL_COUNT (64 * 1024)
+
+typedef struct ImageTileJob
+{
+	ImageTileFunc   pFunc;
+	void*           pUserData;
+	size_t          mScratchSize;
+	uint32_t        mTileCount;
+	tfrg_atomic32_t mNextTile;
+	tfrg_atomic32_t mRemainingTasks;
+} ImageTileJob;
+
+static void runImageTiles(ImageTileJob* pJob)
+{
+	float* pScratch = (float*)conf_malloc(pJob->mScratchSize);
+	for (;;)
+	{
+		const uint32_t tile = (uint32_t)tfrg_atomic32_add_relaxed(&pJob->mNextTile, 1);
+		if (tile >= pJob->mTileCount)
+			break;
+
+		pJob->pFunc(pJob->pUserData, tile, pScratch);
+	}
+	conf_free(pScratch);
+}
+
+static void imageTileTask(void* pUser, uintptr_t)
+{
+	ImageTileJob* pJob = (ImageTileJob*)pUser;
+	runImageTiles(pJob);
+	// The tiles written by this task must be visible once the caller sees the count drop
+	tfrg_atomic32_add_release(&pJob->mRemainingTasks, -1);
+}
+
+// Runs pFunc for every tile. Tiles are pulled by one task per core, so the scratch memory is bounded by the core count
+static void processImageTiles(ThreadSystem* pThreadSystem, ImageTileFunc pFunc, void* pUserData, uint32_t tileCount, size_t scratchSize)
+{
+	if (!tileCount)
+		return;
+
+	const uint32_t concurrency = pThreadSystem ? min(tileCount, Thread::GetNumCPUCores()) : 1;
+
+	ImageTileJob job = {};
+	job.pFunc = pFunc;
+	job.pUserData = pUserData;
+	job.mScratchSize = scratchSize;
+	job.mTileCount = tileCount;
+	job.mNextTile = 0;
+	job.mRemainingTasks = concurrency - 1;
+
+	if (concurrency > 1)
+		addThreadSystemRangeTask(pThreadSystem, imageTileTask, &job, concurrency - 1);
+
+	runImageTiles(&job);
+	while (tfrg_atomic32_load_acquire(&job.mRemainingTasks))
+	{
+		if (!assistThreadSystem(pThreadSystem))
+			Thread::Sleep(0);
+	}
+}
+
+// Tiled processing walks whole rows of pixels, which sub-byte and block compressed formats don't have
+static bool canProcessImageTiles(TinyImageFormat fmt)
+{
+	return TinyImageFormat_CanDecodeLogicalPixelsF(fmt) && TinyImageFormat_CanEncodeLogicalPixelsF(fmt) &&
+		   TinyImageFormat_PixelCountOfBlock(fmt) == 1 && TinyImageFormat_BitSizeOfBlock(fmt) % 8 == 0;
+}
+
+typedef struct ImageConvertJob
+{
+	const unsigned char* pSrc;
+	unsigned char*       pDst;
+	TinyImageFormat      mSrcFormat;
+	TinyImageFormat      mDstFormat;
+	uint32_t             mSrcBytesPerPixel;
+	uint32_t             mDstBytesPerPixel;
+	uint64_t             mPixelCount;
+} ImageConvertJob;
+
+static void convertImageTile(void* pUserData, uint32_t tile, float* pScratch)
 {
+	const ImageConvertJob* pJob = (const ImageConvertJob*)pUserData;
+	const uint64_t         firstPixel = (uint64_t)tile * IMAGE_TILE_PIXEL_COUNT;
+	const uint32_t         pixelCount = (uint32_t)min((uint64_t)IMAGE_TILE_PIXEL_COUNT, pJob->mPixelCount - firstPixel);
+
+	TinyImageFormat_DecodeInput input{};
+	input.pixel = pJob->pSrc + firstPixel * pJob->mSrcBytesPerPixel;
+	TinyImageFormat_EncodeOutput output{};
+	output.pixel = pJob->pDst + firstPixel * pJob->mDstBytesPerPixel;
+
+	TinyImageFormat_DecodeLogicalPixelsF(pJob->mSrcFormat, &input, pixelCount, pScratch);
+	TinyImageFormat_EncodeLogicalPixelsF(pJob->mDstFormat, pScratch, pixelCount, &output);
+}
+
+// Subresource of a 2D slice, a cube face or a whole 3D volume
+static unsigned char* getImageSubresourcePixels(const Image* pImage, uint32_t level, uint32_t slice)
+{
+	if (pImage->AreMipsAfterSlices() || !pImage->IsCube())
+		return pImage->GetPixels(level, slice);
+
+	return pImage->GetPixels(level, slice / 6) + (slice % 6) * (pImage->GetMipMappedSize(level, 1) / 6);
+}
+
+bool Image::Convert(const TinyImageFormat newFormat, ThreadSystem* pThreadSystem)
+{
+	if (TinyImageFormat_IsCompressed(newFormat))
+		return iCompressBlocks(newFormat, pThreadSystem);
+
 	// TODO add RGBE8 to tiny image format
 	if(!TinyImageFormat_CanDecodeLogicalPixelsF(mFormat)) return false;
 	if(!TinyImageFormat_CanEncodeLogicalPixelsF(newFormat)) return false;
 
-	int pixelCount = GetNumberOfPixels(0, mMipMapCount);
+	const uint32_t srcBitsPerPixel = TinyImageFormat_BitSizeOfBlock(mFormat);
+	const uint32_t dstBitsPerPixel = TinyImageFormat_BitSizeOfBlock(newFormat);
+	if (srcBitsPerPixel % 8 || dstBitsPerPixel % 8)
+	{
+		LOGF(LogLevel::eERROR, "Image::Convert: %s to %s needs whole byte pixels", TinyImageFormat_Name(mFormat), TinyImageFormat_Name(newFormat));
+		return false;
+	}
 
-	ubyte* newPixels;
-	newPixels = (unsigned char*)conf_malloc(GetSizeInBytes());
+	// Tiles treat all subresources as one stream of pixels. Padded rows or subtextures of either format are
+	// converted row by row on the calling thread instead
+	bool padded = GetSubtextureAlignment() > 1;
+	for (uint32_t level = 0; level < mMipMapCount && !padded; ++level)
+	{
+		const uint32_t width = GetWidth(level);
+		padded = getBytesPerRow(width, mFormat, mRowAlignment) != getBytesPerRow(width, mFormat, 1) ||
+				 getBytesPerRow(width, newFormat, mRowAlignment) != getBytesPerRow(width, newFormat, 1);
+	}
 
-	TinyImageFormat_DecodeInput input{};
-	input.pixel = pData;
-	TinyImageFormat_EncodeOutput output{};
-	output.pixel = newPixels;
+	if (padded)
+	{
+		const uint32_t        sliceCount = mArrayCount * (IsCube() ? 6 : 1);
+		const TinyImageFormat srcFormat = mFormat;
+		float*                pRow = (float*)conf_malloc(mWidth * 4 * sizeof(float));
 
-	float* tmp = (float*)conf_malloc(sizeof(float) * 4 * pixelCount);
+		// The new layout comes from the same queries answered for the new format
+		mFormat = newFormat;
+		unsigned char* pNewData = (unsigned char*)conf_calloc(1, GetSizeInBytes());
+		mFormat = srcFormat;
 
-	TinyImageFormat_DecodeLogicalPixelsF(mFormat, &input, pixelCount, tmp);
-	TinyImageFormat_EncodeLogicalPixelsF(newFormat, tmp, pixelCount, &output);
+		for (uint32_t level = 0; level < mMipMapCount; ++level)
+		{
+			const uint32_t width = GetWidth(level);
+			const uint32_t rowCount = GetHeight(level) * max(1U, GetDepth(level));
+			const uint32_t srcRowPitch = getBytesPerRow(width, srcFormat, mRowAlignment);
+			const uint32_t dstRowPitch = getBytesPerRow(width, newFormat, mRowAlignment);
+			for (uint32_t slice = 0; slice < sliceCount; ++slice)
+			{
+				const unsigned char* pSrc = getImageSubresourcePixels(this, level, slice);
+				mFormat = newFormat;
+				unsigned char* pDst = pNewData + (getImageSubresourcePixels(this, level, slice) - pData);
+				mFormat = srcFormat;
 
-	conf_free(tmp);
+				for (uint32_t row = 0; row < rowCount; ++row)
+				{
+					TinyImageFormat_DecodeInput input{};
+					input.pixel = pSrc + (size_t)row * srcRowPitch;
+					TinyImageFormat_EncodeOutput output{};
+					output.pixel = pDst + (size_t)row * dstRowPitch;
+					TinyImageFormat_DecodeLogicalPixelsF(srcFormat, &input, width, pRow);
+					TinyImageFormat_EncodeLogicalPixelsF(newFormat, pRow, width, &output);
+				}
+			}
+		}
+		conf_free(pRow);
 
-	conf_free(pData);
-	pData = newPixels;
+		if (mOwnsMemory)
+			conf_free(pData);
+		pData = pNewData;
+		mOwnsMemory = true;
+		mFormat = newFormat;
+		return true;
+	}
+
+	ImageConvertJob job = {};
+	job.mSrcFormat = mFormat;
+	job.mDstFormat = newFormat;
+	job.mSrcBytesPerPixel = srcBitsPerPixel / 8;
+	job.mDstBytesPerPixel = dstBitsPerPixel / 8;
+	job.mPixelCount = (uint64_t)GetNumberOfPixels(0, mMipMapCount) * mArrayCount;
+	job.pSrc = pData;
+
+	// Every tile is decoded to scratch before it is encoded, so formats of the same size convert in place
+	if (job.mSrcBytesPerPixel == job.mDstBytesPerPixel && mOwnsMemory)
+		job.pDst = pData;
+	else
+		job.pDst = (unsigned char*)conf_malloc((size_t)(job.mPixelCount * job.mDstBytesPerPixel));
+
+	const uint32_t tileCount = (uint32_t)((job.mPixelCount + IMAGE_TILE_PIXEL_COUNT - 1) / IMAGE_TILE_PIXEL_COUNT);
+	processImageTiles(pThreadSystem, convertImageTile, &job, tileCount, IMAGE_TILE_PIXEL_COUNT * 4 * sizeof(float));
+
+	if (job.pDst != pData)
+	{
+		if (mOwnsMemory)
+			conf_free(pData);
+		pData = job.pDst;
+		mOwnsMemory = true;
+	}
 	mFormat = newFormat;
 
 	return true;
 }
 
-bool Image::GenerateMipMaps(const uint32_t mipMaps)
+typedef struct ImageMipJob
+{
+	const Image*    pImage;
+	TinyImageFormat mFormat;
+	uint32_t        mLevel;
+	uint32_t        mSrcWidth, mSrcHeight, mSrcDepth;
+	uint32_t        mDstWidth, mDstHeight, mDstDepth;
+	uint32_t        mSrcRowPitch, mDstRowPitch;
+	uint32_t        mRowsPerBand;
+	uint32_t        mBandsPerSlice;
+} ImageMipJob;
+
+// Box filters a band of destination rows from the 2x2 (2x2x2 for volumes) source footprint.
+// Pixels are averaged as decoded floats, which keeps sRGB formats in linear space and works for any decodable layout
+static void generateImageMipBand(void* pUserData, uint32_t tile, float* pScratch)
+{
+	const ImageMipJob* pJob = (const ImageMipJob*)pUserData;
+	const uint32_t     slice = tile / pJob->mBandsPerSlice;
+	const uint32_t     band = tile % pJob->mBandsPerSlice;
+	const uint32_t     dstRowCount = pJob->mDstHeight * pJob->mDstDepth;
+	const uint32_t     firstRow = band * pJob->mRowsPerBand;
+	const uint32_t     lastRow = min(firstRow + pJob->mRowsPerBand, dstRowCount);
+
+	const unsigned char* pSrc = getImageSubresourcePixels(pJob->pImage, pJob->mLevel - 1, slice);
+	unsigned char*       pDst = getImageSubresourcePixels(pJob->pImage, pJob->mLevel, slice);
+
+	float* pSrcRows[4];
+	for (uint32_t i = 0; i < 4; ++i)
+		pSrcRows[i] = pScratch + i * pJob->mSrcWidth * 4;
+	float* pDstRow = pScratch + 4 * pJob->mSrcWidth * 4;
+
+	for (uint32_t row = firstRow; row < lastRow; ++row)
+	{
+		const uint32_t z = row / pJob->mDstHeight;
+		const uint32_t y = row % pJob->mDstHeight;
+		const uint32_t srcZ[2] = { min(2 * z, pJob->mSrcDepth - 1), min(2 * z + 1, pJob->mSrcDepth - 1) };
+		const uint32_t srcY[2] = { min(2 * y, pJob->mSrcHeight - 1), min(2 * y + 1, pJob->mSrcHeight - 1) };
+
+		for (uint32_t i = 0; i < 4; ++i)
+		{
+			const uint32_t srcRow = srcZ[i >> 1] * pJob->mSrcHeight + srcY[i & 1];
+			TinyImageFormat_DecodeInput input{};
+			input.pixel = pSrc + (size_t)srcRow * pJob->mSrcRowPitch;
+			TinyImageFormat_DecodeLogicalPixelsF(pJob->mFormat, &input, pJob->mSrcWidth, pSrcRows[i]);
+		}
+
+		for (uint32_t x = 0; x < pJob->mDstWidth; ++x)
+		{
+			const uint32_t srcX[2] = { min(2 * x, pJob->mSrcWidth - 1), min(2 * x + 1, pJob->mSrcWidth - 1) };
+			for (uint32_t c = 0; c < 4; ++c)
+			{
+				float sum = 0.0f;
+				for (uint32_t i = 0; i < 4; ++i)
+					sum += pSrcRows[i][srcX[0] * 4 + c] + pSrcRows[i][srcX[1] * 4 + c];
+				pDstRow[x * 4 + c] = sum * 0.125f;
+			}
+		}
+
+		TinyImageFormat_EncodeOutput output{};
+		output.pixel = pDst + (size_t)row * pJob->mDstRowPitch;
+		TinyImageFormat_EncodeLogicalPixelsF(pJob->mFormat, pDstRow, pJob->mDstWidth, &output);
+	}
+}
+
+bool Image::GenerateMipMaps(const uint32_t mipMaps, ThreadSystem* pThreadSystem)
 {
 	if (TinyImageFormat_IsCompressed(mFormat))
 		return false;
@@ -1558,6 +2028,11 @@ bool Image::GenerateMipMaps(const uint32_t mipMaps)
 		return false;
 	if (!mOwnsMemory)
 		return false;
+	if (!canProcessImageTiles(mFormat))
+	{
+		LOGF(LogLevel::eERROR, "Image::GenerateMipMaps: unsupported format %s", TinyImageFormat_Name(mFormat));
+		return false;
+	}
 
 	uint actualMipMaps = min(mipMaps, GetMipMapCountFromDimensions());
 
@@ -1587,74 +2062,546 @@ bool Image::GenerateMipMaps(const uint32_t mipMaps)
 		mMipMapCount = actualMipMaps;
 	}
 
-	int nChannels = TinyImageFormat_ChannelCount(mFormat);
+	const uint32_t sliceCount = mArrayCount * (IsCube() ? 6 : 1);
+
+	// Levels depend on the previous one, the slices, faces and row bands of a level are independent
+	for (uint level = 1; level < mMipMapCount; level++)
+	{
+		ImageMipJob job = {};
+		job.pImage = this;
+		job.mFormat = mFormat;
+		job.mLevel = level;
+		job.mSrcWidth = GetWidth(level - 1);
+		job.mSrcHeight = GetHeight(level - 1);
+		job.mSrcDepth = GetDepth(level - 1);
+		job.mDstWidth = GetWidth(level);
+		job.mDstHeight = GetHeight(level);
+		job.mDstDepth = GetDepth(level);
+		job.mSrcRowPitch = GetBytesPerRow(level - 1);
+		job.mDstRowPitch = GetBytesPerRow(level);
+		job.mRowsPerBand = max(1u, IMAGE_TILE_PIXEL_COUNT / job.mDstWidth);
+		job.mBandsPerSlice = (job.mDstHeight * job.mDstDepth + job.mRowsPerBand - 1) / job.mRowsPerBand;
+
+		const size_t scratchSize = (4 * job.mSrcWidth + job.mDstWidth) * 4 * sizeof(float);
+		processImageTiles(pThreadSystem, generateImageMipBand, &job, sliceCount * job.mBandsPerSlice, scratchSize);
+	}
+
+	return true;
+}
+
+// -- BLOCK ENCODING --
+
+// Blocks are gathered as 16 float4 texels in the storage space of the target format, so sRGB targets are
+// encoded after the linear to sRGB transfer and every palette below matches what the hardware decodes
+
+static inline float clampUnorm(float v) { return v < 0.0f ? 0.0f : (v > 1.0f ? 1.0f : v); }
+
+static inline float linearToSRGB(float v)
+{
+	v = clampUnorm(v);
+	return v < 0.0031308f ? v * 12.92f : 1.055f * powf(v, 1.0f / 2.4f) - 0.055f;
+}
+
+static void writeBlockBits(uint8_t* pBlock, uint32_t& bitOffset, uint32_t value, uint32_t bitCount)
+{
+	for (uint32_t i = 0; i < bitCount; ++i, ++bitOffset)
+	{
+		if (value & (1u << i))
+			pBlock[bitOffset >> 3] |= (uint8_t)(1u << (bitOffset & 7));
+	}
+}
+
+// Fits a line through the selected texels along their principal axis (power iteration on the covariance)
+// and returns the endpoints spanned by the projections of those texels
+static void fitBlockEndpoints(const float block[16][4], uint32_t channelCount, const bool* pSelected, float e0[4], float e1[4])
+{
+	float    mean[4] = {};
+	float    minV[4] = { 1.0f, 1.0f, 1.0f, 1.0f };
+	float    maxV[4] = {};
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		if (pSelected && !pSelected[i])
+			continue;
+		for (uint32_t c = 0; c < channelCount; ++c)
+		{
+			mean[c] += block[i][c];
+			minV[c] = min(minV[c], block[i][c]);
+			maxV[c] = max(maxV[c], block[i][c]);
+		}
+		++count;
+	}
+	for (uint32_t c = 0; c < channelCount; ++c)
+		mean[c] /= (float)count;
 
-	int n = IsCube() ? 6 : 1;
+	float cov[4][4] = {};
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		if (pSelected && !pSelected[i])
+			continue;
+		for (uint32_t a = 0; a < channelCount; ++a)
+			for (uint32_t b = 0; b < channelCount; ++b)
+				cov[a][b] += (block[i][a] - mean[a]) * (block[i][b] - mean[b]);
+	}
 
-	for (uint arraySlice = 0; arraySlice < mArrayCount; arraySlice++)
+	// The bounding box diagonal is a good first guess and converges in a few iterations
+	float axis[4] = {};
+	for (uint32_t c = 0; c < channelCount; ++c)
+		axis[c] = maxV[c] - minV[c];
+	for (uint32_t iteration = 0; iteration < 8; ++iteration)
 	{
-		for (uint level = 1; level < mMipMapCount; level++)
+		float next[4] = {};
+		float scale = 0.0f;
+		for (uint32_t a = 0; a < channelCount; ++a)
 		{
-			// TODO: downscale 3D textures using an appropriate filter.
-			
-			uint srcWidth = GetWidth(level - 1);
-			uint srcHeight = GetHeight(level - 1);
-			uint dstWidth = GetWidth(level - 1);
-			uint dstHeight = GetHeight(level - 1);
+			for (uint32_t b = 0; b < channelCount; ++b)
+				next[a] += cov[a][b] * axis[b];
+			scale = max(scale, fabsf(next[a]));
+		}
+		if (scale < 1e-12f)
+			break;
+		for (uint32_t c = 0; c < channelCount; ++c)
+			axis[c] = next[c] / scale;
+	}
 
-			uint srcSize = GetMipMappedSize(level - 1, 1) / n;
-			uint dstSize = GetMipMappedSize(level, 1) / n;
+	float lengthSq = 0.0f;
+	for (uint32_t c = 0; c < channelCount; ++c)
+		lengthSq += axis[c] * axis[c];
+	if (lengthSq < 1e-12f)
+	{
+		for (uint32_t c = 0; c < channelCount; ++c)
+			e0[c] = e1[c] = mean[c];
+		return;
+	}
 
-			uint srcStride = GetBytesPerRow(level - 1);
-			uint dstStride = GetBytesPerRow(level);
-			
-			for (int i = 0; i < n; i++)
+	float tMin = 1e30f, tMax = -1e30f;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		if (pSelected && !pSelected[i])
+			continue;
+		float t = 0.0f;
+		for (uint32_t c = 0; c < channelCount; ++c)
+			t += (block[i][c] - mean[c]) * axis[c];
+		tMin = min(tMin, t);
+		tMax = max(tMax, t);
+	}
+	for (uint32_t c = 0; c < channelCount; ++c)
+	{
+		e0[c] = clampUnorm(mean[c] + axis[c] * tMin / lengthSq);
+		e1[c] = clampUnorm(mean[c] + axis[c] * tMax / lengthSq);
+	}
+}
+
+static inline uint16_t packRGB565(const float c[4])
+{
+	return (uint16_t)(((uint32_t)(c[0] * 31.0f + 0.5f) << 11) | ((uint32_t)(c[1] * 63.0f + 0.5f) << 5) | (uint32_t)(c[2] * 31.0f + 0.5f));
+}
+
+static inline void unpackRGB565(uint16_t v, float c[4])
+{
+	const uint32_t r = (v >> 11) & 31, g = (v >> 5) & 63, b = v & 31;
+	c[0] = (float)((r << 3) | (r >> 2)) / 255.0f;
+	c[1] = (float)((g << 2) | (g >> 4)) / 255.0f;
+	c[2] = (float)((b << 3) | (b >> 2)) / 255.0f;
+}
+
+static uint32_t findClosestColor(const float texel[4], const float (*palette)[4], uint32_t paletteSize)
+{
+	uint32_t best = 0;
+	float    bestError = 1e30f;
+	for (uint32_t p = 0; p < paletteSize; ++p)
+	{
+		const float dr = texel[0] - palette[p][0], dg = texel[1] - palette[p][1], db = texel[2] - palette[p][2];
+		const float error = dr * dr + dg * dg + db * db;
+		if (error < bestError)
+		{
+			bestError = error;
+			best = p;
+		}
+	}
+	return best;
+}
+
+// BC1 color block. Blocks with texels below half alpha use the three color mode with index 3 as transparent black,
+// which is only legal for DXBC1_RGBA, BC2/BC3 always decode the color block in four color mode
+static void encodeBC1Block(const float block[16][4], bool punchThroughAlpha, uint8_t* pDst)
+{
+	bool     opaque[16];
+	uint32_t opaqueCount = 0;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		opaque[i] = !punchThroughAlpha || block[i][3] >= 0.5f;
+		opaqueCount += opaque[i];
+	}
+
+	uint16_t c0 = 0, c1 = 0;
+	uint32_t indices = 0;
+	if (opaqueCount)
+	{
+		float e0[4], e1[4];
+		fitBlockEndpoints(block, 3, opaque, e0, e1);
+		c0 = packRGB565(e1);
+		c1 = packRGB565(e0);
+
+		const bool threeColor = opaqueCount < 16;
+		if (threeColor ? c0 > c1 : c0 < c1)
+		{
+			const uint16_t t = c0;
+			c0 = c1;
+			c1 = t;
+		}
+
+		float palette[4][4] = {};
+		unpackRGB565(c0, palette[0]);
+		unpackRGB565(c1, palette[1]);
+		for (uint32_t c = 0; c < 3; ++c)
+		{
+			if (threeColor)
 			{
-				unsigned char* srcPixels = GetPixels(level - 1, arraySlice) + n * srcSize;
-				unsigned char* dstPixels = GetPixels(level, arraySlice) + n * dstSize;
-
-				int8_t physicalChannel = TinyImageFormat_LogicalChannelToPhysical(mFormat, TinyImageFormat_LC_Alpha);
-				int alphaChannel = physicalChannel;
-				if (physicalChannel == TinyImageFormat_PC_CONST_0 || physicalChannel == TinyImageFormat_PC_CONST_1)
-					alphaChannel = STBIR_ALPHA_CHANNEL_NONE;
-				
-				// only homogoenous is supported via this method
-				// TODO use decode/encode for the others
-				// TODO check these methods work for SNORM
-				if(TinyImageFormat_IsHomogenous(mFormat)) {
-					uint32 redChanWidth = TinyImageFormat_ChannelBitWidth(mFormat, TinyImageFormat_LC_Red);
-					if (redChanWidth == 32 && TinyImageFormat_IsFloat(mFormat))
-					{
-						stbir_resize_float((float*)srcPixels, srcWidth, srcHeight, srcStride,
-										   (float*)dstPixels, dstWidth, dstHeight, dstStride,
-										   nChannels);
-					}
-					else if (redChanWidth == 16)
-					{
-						stbir_colorspace colorSpace = TinyImageFormat_IsSRGB(mFormat) ? STBIR_COLORSPACE_SRGB : STBIR_COLORSPACE_LINEAR;
-						stbir_resize_uint16_generic((uint16_t*)srcPixels, srcWidth, srcHeight, srcStride,
-													(uint16_t*)dstPixels, dstWidth, dstHeight, dstStride,
-													nChannels, alphaChannel, 0,
-													STBIR_EDGE_WRAP, STBIR_FILTER_DEFAULT, colorSpace, NULL);
-					}
-					else if (redChanWidth == 8)
-					{
-						
-						if (TinyImageFormat_IsSRGB(mFormat))
-							stbir_resize_uint8_srgb(srcPixels, srcWidth, srcHeight, srcStride,
-													dstPixels, dstWidth, dstHeight, dstStride,
-													nChannels, alphaChannel, 0);
-						else
-							stbir_resize_uint8(srcPixels, srcWidth, srcHeight, srcStride,
-											   dstPixels, dstWidth, dstHeight, dstStride,
-											   nChannels);
-					}
-					// TODO: fall back to to be written generic downsizer
-				}
+				palette[2][c] = (palette[0][c] + palette[1][c]) * 0.5f;
+			}
+			else
+			{
+				palette[2][c] = (2.0f * palette[0][c] + palette[1][c]) / 3.0f;
+				palette[3][c] = (palette[0][c] + 2.0f * palette[1][c]) / 3.0f;
+			}
+		}
+
+		// Equal endpoints select index 0 everywhere
+		const uint32_t paletteSize = (c0 == c1) ? 1 : (threeColor ? 3 : 4);
+		for (uint32_t i = 0; i < 16; ++i)
+			indices |= (opaque[i] ? findClosestColor(block[i], palette, paletteSize) : 3u) << (2 * i);
+	}
+	else
+	{
+		indices = 0xFFFFFFFF;
+	}
+
+	memcpy(pDst + 0, &c0, sizeof(c0));
+	memcpy(pDst + 2, &c1, sizeof(c1));
+	memcpy(pDst + 4, &indices, sizeof(indices));
+}
+
+// BC4 single channel block in the eight value mode (a0 > a1). BC3 alpha and both BC5 channels use the same layout
+static void encodeBC4Block(const float block[16][4], uint32_t channel, uint8_t* pDst)
+{
+	float minV = 1.0f, maxV = 0.0f;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		minV = min(minV, clampUnorm(block[i][channel]));
+		maxV = max(maxV, clampUnorm(block[i][channel]));
+	}
+
+	const uint32_t a0 = (uint32_t)(maxV * 255.0f + 0.5f);
+	const uint32_t a1 = (uint32_t)(minV * 255.0f + 0.5f);
+
+	memset(pDst, 0, 8);
+	pDst[0] = (uint8_t)a0;
+	pDst[1] = (uint8_t)a1;
+	if (a0 == a1)
+		return;
+
+	float palette[8];
+	palette[0] = (float)a0;
+	palette[1] = (float)a1;
+	for (uint32_t i = 0; i < 6; ++i)
+		palette[2 + i] = (float)((6 - i) * a0 + (1 + i) * a1) / 7.0f;
+
+	uint32_t bitOffset = 16;
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		const float value = clampUnorm(block[i][channel]) * 255.0f;
+		uint32_t    best = 0;
+		float       bestError = 1e30f;
+		for (uint32_t p = 0; p < 8; ++p)
+		{
+			const float error = fabsf(value - palette[p]);
+			if (error < bestError)
+			{
+				bestError = error;
+				best = p;
+			}
+		}
+		writeBlockBits(pDst, bitOffset, best, 3);
+	}
+}
+
+// Quantizes an endpoint to 7 bits per channel and picks the shared p-bit that reconstructs it best
+static void quantizeBC7Endpoint(const float e[4], uint32_t quantized[4], uint32_t& pBit)
+{
+	float bestError = 1e30f;
+	for (uint32_t p = 0; p < 2; ++p)
+	{
+		uint32_t q[4];
+		float    error = 0.0f;
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			const int v = (int)((e[c] * 255.0f - (float)p) * 0.5f + 0.5f);
+			q[c] = (uint32_t)(v < 0 ? 0 : (v > 127 ? 127 : v));
+			const float d = (float)((q[c] << 1) | p) - e[c] * 255.0f;
+			error += d * d;
+		}
+		if (error < bestError)
+		{
+			bestError = error;
+			pBit = p;
+			memcpy(quantized, q, sizeof(q));
+		}
+	}
+}
+
+// BC7 mode 6: a single RGBA subset with 7.7.7.7 endpoints, a p-bit per endpoint and 4-bit indices.
+// It covers opaque and alpha blocks alike, the partitioned modes are not searched
+static void encodeBC7Block(const float block[16][4], uint8_t* pDst)
+{
+	static const uint32_t weights[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+	float e[2][4];
+	fitBlockEndpoints(block, 4, NULL, e[0], e[1]);
+
+	uint32_t q[2][4];
+	uint32_t p[2] = {};
+	quantizeBC7Endpoint(e[0], q[0], p[0]);
+	quantizeBC7Endpoint(e[1], q[1], p[1]);
+
+	float palette[16][4];
+	for (uint32_t w = 0; w < 16; ++w)
+	{
+		for (uint32_t c = 0; c < 4; ++c)
+		{
+			const uint32_t v0 = (q[0][c] << 1) | p[0];
+			const uint32_t v1 = (q[1][c] << 1) | p[1];
+			palette[w][c] = (float)(((64 - weights[w]) * v0 + weights[w] * v1 + 32) >> 6);
+		}
+	}
+
+	uint32_t indices[16];
+	for (uint32_t i = 0; i < 16; ++i)
+	{
+		float bestError = 1e30f;
+		for (uint32_t w = 0; w < 16; ++w)
+		{
+			float error = 0.0f;
+			for (uint32_t c = 0; c < 4; ++c)
+			{
+				const float d = clampUnorm(block[i][c]) * 255.0f - palette[w][c];
+				error += d * d;
 			}
+			if (error < bestError)
+			{
+				bestError = error;
+				indices[i] = w;
+			}
+		}
+	}
+
+	// The anchor index drops its top bit, so swap the endpoints when the first texel needs it
+	uint32_t first = 0;
+	if (indices[0] & 8)
+	{
+		first = 1;
+		for (uint32_t i = 0; i < 16; ++i)
+			indices[i] = 15 - indices[i];
+	}
+
+	memset(pDst, 0, 16);
+	uint32_t bitOffset = 0;
+	writeBlockBits(pDst, bitOffset, 1u << 6, 7);
+	for (uint32_t c = 0; c < 4; ++c)
+	{
+		writeBlockBits(pDst, bitOffset, q[first][c], 7);
+		writeBlockBits(pDst, bitOffset, q[1 - first][c], 7);
+	}
+	writeBlockBits(pDst, bitOffset, p[first], 1);
+	writeBlockBits(pDst, bitOffset, p[1 - first], 1);
+	writeBlockBits(pDst, bitOffset, indices[0], 3);
+	for (uint32_t i = 1; i < 16; ++i)
+		writeBlockBits(pDst, bitOffset, indices[i], 4);
+}
+
+static bool canEncodeImageBlocks(TinyImageFormat fmt)
+{
+	switch (fmt)
+	{
+		case TinyImageFormat_DXBC1_RGB_UNORM:
+		case TinyImageFormat_DXBC1_RGB_SRGB:
+		case TinyImageFormat_DXBC1_RGBA_UNORM:
+		case TinyImageFormat_DXBC1_RGBA_SRGB:
+		case TinyImageFormat_DXBC3_UNORM:
+		case TinyImageFormat_DXBC3_SRGB:
+		case TinyImageFormat_DXBC4_UNORM:
+		case TinyImageFormat_DXBC5_UNORM:
+		case TinyImageFormat_DXBC7_UNORM:
+		case TinyImageFormat_DXBC7_SRGB: return true;
+		default: return false;
+	}
+}
+
+static void encodeImageBlock(TinyImageFormat fmt, const float block[16][4], uint8_t* pDst)
+{
+	switch (fmt)
+	{
+		case TinyImageFormat_DXBC1_RGB_UNORM:
+		case TinyImageFormat_DXBC1_RGB_SRGB: encodeBC1Block(block, false, pDst); break;
+		case TinyImageFormat_DXBC1_RGBA_UNORM:
+		case TinyImageFormat_DXBC1_RGBA_SRGB: encodeBC1Block(block, true, pDst); break;
+		case TinyImageFormat_DXBC3_UNORM:
+		case TinyImageFormat_DXBC3_SRGB:
+			encodeBC4Block(block, 3, pDst);
+			encodeBC1Block(block, false, pDst + 8);
+			break;
+		case TinyImageFormat_DXBC4_UNORM: encodeBC4Block(block, 0, pDst); break;
+		case TinyImageFormat_DXBC5_UNORM:
+			encodeBC4Block(block, 0, pDst);
+			encodeBC4Block(block, 1, pDst + 8);
+			break;
+		case TinyImageFormat_DXBC7_UNORM:
+		case TinyImageFormat_DXBC7_SRGB: encodeBC7Block(block, pDst); break;
+		default: ASSERT(false); break;
+	}
+}
+
+typedef struct ImageBlockSubresource
+{
+	const unsigned char* pSrc;
+	unsigned char*       pDst;
+	uint32_t             mWidth, mHeight, mDepth;
+	uint32_t             mSrcRowPitch, mDstRowPitch;
+	uint32_t             mFirstBlockRow;
+} ImageBlockSubresource;
+
+typedef struct ImageBlockJob
+{
+	const ImageBlockSubresource* pSubresources;
+	uint32_t                     mSubresourceCount;
+	TinyImageFormat              mSrcFormat;
+	TinyImageFormat              mDstFormat;
+	uint32_t                     mBlockSize;
+	/// The decoded source texels are linear and the target stores sRGB
+	bool                         mEncodeSrgb;
+} ImageBlockJob;
+
+// Encodes one row of 4x4 blocks. Edge blocks of non multiple of four sizes replicate the last texel
+static void compressImageBlockRow(void* pUserData, uint32_t tile, float* pScratch)
+{
+	const ImageBlockJob* pJob = (const ImageBlockJob*)pUserData;
+
+	uint32_t first = 0, last = pJob->mSubresourceCount;
+	while (last - first > 1)
+	{
+		const uint32_t middle = (first + last) / 2;
+		if (pJob->pSubresources[middle].mFirstBlockRow <= tile)
+			first = middle;
+		else
+			last = middle;
+	}
+	const ImageBlockSubresource& sub = pJob->pSubresources[first];
+
+	const uint32_t blockRows = (sub.mHeight + 3) / 4;
+	const uint32_t blockColumns = (sub.mWidth + 3) / 4;
+	const uint32_t z = (tile - sub.mFirstBlockRow) / blockRows;
+	const uint32_t blockY = (tile - sub.mFirstBlockRow) % blockRows;
+
+	float* pRows[4];
+	for (uint32_t i = 0; i < 4; ++i)
+	{
+		const uint32_t y = min(blockY * 4 + i, sub.mHeight - 1);
+		pRows[i] = pScratch + i * sub.mWidth * 4;
+
+		TinyImageFormat_DecodeInput input{};
+		input.pixel = sub.pSrc + ((size_t)z * sub.mHeight + y) * sub.mSrcRowPitch;
+		TinyImageFormat_DecodeLogicalPixelsF(pJob->mSrcFormat, &input, sub.mWidth, pRows[i]);
+
+		if (pJob->mEncodeSrgb)
+		{
+			for (uint32_t x = 0; x < sub.mWidth; ++x)
+				for (uint32_t c = 0; c < 3; ++c)
+					pRows[i][x * 4 + c] = linearToSRGB(pRows[i][x * 4 + c]);
+		}
+	}
+
+	unsigned char* pDst = sub.pDst + ((size_t)z * blockRows + blockY) * sub.mDstRowPitch;
+	for (uint32_t blockX = 0; blockX < blockColumns; ++blockX)
+	{
+		float block[16][4];
+		for (uint32_t i = 0; i < 16; ++i)
+		{
+			const uint32_t x = min(blockX * 4 + (i & 3), sub.mWidth - 1);
+			memcpy(block[i], pRows[i >> 2] + x * 4, sizeof(block[i]));
+		}
+		encodeImageBlock(pJob->mDstFormat, block, pDst + blockX * pJob->mBlockSize);
+	}
+}
+
+bool Image::iCompressBlocks(const TinyImageFormat newFormat, ThreadSystem* pThreadSystem)
+{
+	if (!canEncodeImageBlocks(newFormat))
+	{
+		LOGF(LogLevel::eERROR, "Image::Convert: no block encoder for %s", TinyImageFormat_Name(newFormat));
+		return false;
+	}
+	if (!TinyImageFormat_CanDecodeLogicalPixelsF(mFormat) || TinyImageFormat_PixelCountOfBlock(mFormat) != 1 ||
+		TinyImageFormat_BitSizeOfBlock(mFormat) % 8)
+	{
+		LOGF(LogLevel::eERROR, "Image::Convert: can't compress %s to %s", TinyImageFormat_Name(mFormat), TinyImageFormat_Name(newFormat));
+		return false;
+	}
+
+	const uint32_t         sliceCount = mArrayCount * (IsCube() ? 6 : 1);
+	const uint32_t         subresourceCount = mMipMapCount * sliceCount;
+	ImageBlockSubresource* pSubresources = (ImageBlockSubresource*)conf_calloc(subresourceCount, sizeof(ImageBlockSubresource));
+
+	uint32_t blockRowCount = 0;
+	for (uint32_t level = 0; level < mMipMapCount; ++level)
+	{
+		for (uint32_t slice = 0; slice < sliceCount; ++slice)
+		{
+			ImageBlockSubresource& sub = pSubresources[level * sliceCount + slice];
+			sub.pSrc = getImageSubresourcePixels(this, level, slice);
+			sub.mWidth = GetWidth(level);
+			sub.mHeight = GetHeight(level);
+			sub.mDepth = GetDepth(level);
+			sub.mSrcRowPitch = GetBytesPerRow(level);
+			sub.mFirstBlockRow = blockRowCount;
+			blockRowCount += (sub.mHeight + 3) / 4 * sub.mDepth;
 		}
 	}
 
+	// The compressed layout comes from the same queries answered for the new format
+	const TinyImageFormat srcFormat = mFormat;
+	mFormat = newFormat;
+	unsigned char* pNewData = (unsigned char*)conf_calloc(1, GetSizeInBytes());
+	for (uint32_t level = 0; level < mMipMapCount; ++level)
+	{
+		for (uint32_t slice = 0; slice < sliceCount; ++slice)
+		{
+			ImageBlockSubresource& sub = pSubresources[level * sliceCount + slice];
+			sub.pDst = pNewData + (getImageSubresourcePixels(this, level, slice) - pData);
+			sub.mDstRowPitch = GetBytesPerRow(level);
+		}
+	}
+	mFormat = srcFormat;
+
+	ImageBlockJob job = {};
+	job.pSubresources = pSubresources;
+	job.mSubresourceCount = subresourceCount;
+	job.mSrcFormat = mFormat;
+	job.mDstFormat = newFormat;
+	job.mBlockSize = TinyImageFormat_BitSizeOfBlock(newFormat) / 8;
+	// sRGB and float sources decode to linear values. Integer UNORM sources decode to the values they store, which are
+	// already in the color space of an sRGB target and are kept as they are
+	const bool srcLinear = TinyImageFormat_IsSRGB(mFormat) || TinyImageFormat_IsFloat(mFormat);
+	job.mEncodeSrgb = srcLinear && TinyImageFormat_IsSRGB(newFormat);
+	processImageTiles(pThreadSystem, compressImageBlockRow, &job, blockRowCount, 4 * mWidth * 4 * sizeof(float));
+
+	conf_free(pSubresources);
+
+	if (mOwnsMemory)
+		conf_free(pData);
+	pData = pNewData;
+	mOwnsMemory = true;
+	mFormat = newFormat;
+
 	return true;
 }
 
@@ -1685,7 +2632,7 @@ bool Image::iSaveDDS(const Path* filePath) {
 	memset(mipmaps, 0, sizeof(void const*) * TINYDDS_MAX_MIPMAPLEVELS);
 
 	for (unsigned int i = 0; i < mMipMapCount; ++i) {
-		mipmapsizes[i] = (uint32_t)Image_GetMipMappedSize(mWidth, mHeight, mDepth, mMipMapCount, mFormat);
+		mipmapsizes[i] = GetMipMappedSize(i, 1);
 		mipmaps[i] = GetPixels(i);
 	}
 
@@ -1736,7 +2683,7 @@ bool Image::iSaveKTX(const Path* filePath) {
 	memset(mipmaps, 0, sizeof(void const*) * TINYKTX_MAX_MIPMAPLEVELS);
 
 	for (unsigned int i = 0; i < mMipMapCount; ++i) {
-		mipmapsizes[i] = (uint32_t)Image_GetMipMappedSize(mWidth, mHeight, mDepth, mMipMapCount, mFormat);
+		mipmapsizes[i] = GetMipMappedSize(i, 1);
 		mipmaps[i] = GetPixels(i);
 	}
 
@@ -1923,18 +2870,22 @@ bool Image::iSaveSVT(const Path* filePath, uint pageSize)
 	const uint numberOfComponents = 4;
 
 	//Header
-
-	fsWriteToStream(fh, &mWidth, sizeof(uint));
-	fsWriteToStream(fh, &mHeight, sizeof(uint));
-
-	//mip count
-	fsWriteToStream(fh, &mMipMapCount, sizeof(uint));
-
-	//Page size
-	fsWriteToStream(fh, &pageSize, sizeof(uint));
-
-	//number of components
-	fsWriteToStream(fh, &numberOfComponents, sizeof(uint));
+	SVTHeader header = {};
+	header.mMagic = SVT_FILE_MAGIC;
+	header.mVersion = SVT_FILE_VERSION;
+	header.mWidth = mWidth;
+	header.mHeight = mHeight;
+	header.mMipMapCount = mMipMapCount;
+	header.mPageSize = pageSize;
+	header.mComponentCount = numberOfComponents;
+	header.mPageCount = svtPageCount(mWidth, mHeight, mMipMapCount, pageSize);
+	fsWriteToStream(fh, &header, sizeof(header));
+
+	//Page offsets, so a streaming reader can fetch any page without reading the ones before it
+	const uint64_t pageByteSize = (uint64_t)pageSize * pageSize * numberOfComponents;
+	const uint64_t pageDataOffset = sizeof(header) + (header.mPageCount + 1) * sizeof(uint64_t);
+	for (uint i = 0; i <= header.mPageCount; ++i)
+		fsWriteToStreamUInt64(fh, pageDataOffset + i * pageByteSize);
 
 	uint mipPageCount = mMipMapCount - (uint)log2f((float)pageSize);
 
@@ -34,6 +34,7 @@ static_assert(false, "Image.h can only be included by ResourceLoader.cpp and Ima
 #include "../Interfaces/IFileSystem.h"
 #include "../Interfaces/ILog.h"
 #include "../../ThirdParty/OpenSource/EASTL/string.h"
+#include "../../ThirdParty/OpenSource/EASTL/vector.h"
 
 #ifndef IMAGE_DISABLE_GOOGLE_BASIS
 //Google basis Transcoder
@@ -48,6 +49,8 @@ static_assert(false, "Image.h can only be included by ResourceLoader.cpp and Ima
 
 /*************************************************************************************/
 
+struct ThreadSystem;
+
 typedef void* (*memoryAllocationFunc)(class Image* pImage, uint64_t byteCount, uint64_t alignment, void* pUserData);
 
 typedef enum ImageLoadingResult
@@ -74,12 +77,18 @@ private:
 
 	void Clear();
 
+	bool iCompressBlocks(const TinyImageFormat newFormat, ThreadSystem* pThreadSystem);
+
     //load image
     ImageLoadingResult LoadFromFile(
                       const Path* filePath, memoryAllocationFunc pAllocator = NULL, void* pUserData = NULL, uint rowAlignment = 1, uint subtextureAlignment = 1);
     ImageLoadingResult LoadFromStream(
                         FileStream* pStream, char const* extension, memoryAllocationFunc pAllocator = NULL,
                         void* pUserData = NULL, uint rowAlignment = 0, uint subtextureAlignment = 1);
+    // Reads mips [firstMip, firstMip + mipCount) of a DDS or KTX file into an image whose mip 0 is firstMip, one mip at a time.
+    // mipCount == 0 only reads the header: the image then describes every mip of the file and has no pixels
+    ImageLoadingResult LoadMipsFromFile(
+                        const Path* filePath, uint32_t firstMip, uint32_t mipCount, uint rowAlignment = 1, uint subtextureAlignment = 1);
 
 public:
 
@@ -142,8 +151,10 @@ public:
 	bool                 Uncompress(uint newRowAlignment = 1, uint newSubtextureAlignment = 1);
 	bool                 Unpack();
 
-	bool                 Convert(const TinyImageFormat newFormat);
-	bool                 GenerateMipMaps(const uint32_t mipMaps = ALL_MIPLEVELS);
+	// Both work on bounded tiles of pixels and spread them over pThreadSystem when one is given.
+	// Convert also encodes BC1/BC3/BC4/BC5/BC7 when newFormat is one of those block compressed formats
+	bool                 Convert(const TinyImageFormat newFormat, ThreadSystem* pThreadSystem = NULL);
+	bool                 GenerateMipMaps(const uint32_t mipMaps = ALL_MIPLEVELS, ThreadSystem* pThreadSystem = NULL);
 
 	bool                 iSwap(const int c0, const int c1);
 
@@ -197,7 +208,8 @@ protected:
 	// mipmaps * (w*h*d*s) with s being constant for all mipmaps
 	bool				 mMipsAfterSlices;
 	
-	static void Init();
+	// pThreadSystem, when given, is used by the loaders to decode in parallel (Basis transcodes every mip and slice as its own task)
+	static void Init(ThreadSystem* pThreadSystem = NULL);
 	static void Exit();
 
 public:
@@ -206,6 +218,30 @@ public:
 	static void AddImageLoader(const char* pExtension, ImageLoaderFunction pFunc);
 };
 
+// Sparse virtual texture (.svt) file layout:
+//   SVTHeader
+//   uint64_t mPageOffsets[mPageCount + 1] - file offset of each page, the last entry is where the mip tail starts
+//   pages of the mips above the mip tail, mip by mip and row by row inside a mip, then the packed mip tail
+// Older files have no magic: five uints (width, height, mips, page size, components) followed by the pages.
+#define SVT_FILE_MAGIC MAKE_CHAR4('S', 'V', 'T', 'F')
+#define SVT_FILE_VERSION 1
+
+typedef struct SVTHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mWidth;
+	uint32_t mHeight;
+	uint32_t mMipMapCount;
+	uint32_t mPageSize;
+	uint32_t mComponentCount;
+	/// Pages outside of the mip tail
+	uint32_t mPageCount;
+} SVTHeader;
+
+// Reads the header and page offset table of either .svt layout. pPageOffsets receives mPageCount + 1 entries
+bool readSVTHeader(FileStream* pStream, SVTHeader* pHeader, eastl::vector<uint64_t>* pPageOffsets);
+
 static inline uint32_t calculateMipMapLevels(uint32_t width, uint32_t height)
 {
 	if (width == 0 || height == 0)
@@ -83,6 +83,83 @@ uint32_t MAX_INPUT_GAMEPADS = 1;
 uint32_t MAX_INPUT_MULTI_TOUCHES = 4;
 uint32_t MAX_INPUT_ACTIONS = 128;
 
+/************************************************************************/
+// Input Record / Replay
+/************************************************************************/
+#define INPUT_RECORDING_MAGIC 0x52494654u    // 'TFIR'
+#define INPUT_RECORDING_VERSION 1u
+
+typedef enum InputRecordMode
+{
+	INPUT_RECORD_MODE_CAPTURE = 0,
+	INPUT_RECORD_MODE_REPLAY,
+} InputRecordMode;
+
+typedef enum InputRecordFlags
+{
+	INPUT_RECORD_FLAG_POSITION = 0x1,
+	INPUT_RECORD_FLAG_CAPTURE_STATE = 0x2,
+	INPUT_RECORD_FLAG_CAPTURED = 0x4,
+} InputRecordFlags;
+
+typedef struct InputRecordHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mEventSize;
+	uint32_t mEventCount;
+} InputRecordHeader;
+
+typedef struct InputRecordEvent
+{
+	uint32_t mFrame;
+	uint32_t mActionIndex;
+	uint32_t mBinding;
+	float    mValue[4];
+	float    mPosition[2];
+	uint8_t  mPhase;
+	uint8_t  mDeviceType;
+	uint8_t  mFlags;
+	uint8_t  mPadding;
+} InputRecordEvent;
+
+typedef struct InputRecorder
+{
+	eastl::vector<InputRecordEvent> mEvents;
+	Path*                           pFilePath;
+	InputRecordMode                 mMode;
+	uint32_t                        mFrame;
+	uint32_t                        mReplayCursor;
+} InputRecorder;
+
+static InputRecorder* pInputRecorder = NULL;
+
+static const bool gReplayCaptureStates[2] = { false, true };
+
+static void recordInputAction(InputRecorder* pRecorder, uint32_t actionIndex, const InputActionContext* pCtx)
+{
+	InputRecordEvent event = {};
+	event.mFrame = pRecorder->mFrame;
+	event.mActionIndex = actionIndex;
+	event.mBinding = pCtx->mBinding;
+	memcpy(event.mValue, &pCtx->mFloat4, sizeof(event.mValue));
+	event.mPhase = pCtx->mPhase;
+	event.mDeviceType = pCtx->mDeviceType;
+	if (pCtx->pPosition)
+	{
+		event.mFlags |= INPUT_RECORD_FLAG_POSITION;
+		event.mPosition[0] = pCtx->pPosition->x;
+		event.mPosition[1] = pCtx->pPosition->y;
+	}
+	if (pCtx->pCaptured)
+	{
+		event.mFlags |= INPUT_RECORD_FLAG_CAPTURE_STATE;
+		if (*pCtx->pCaptured)
+			event.mFlags |= INPUT_RECORD_FLAG_CAPTURED;
+	}
+	pRecorder->mEvents.push_back(event);
+}
+
 /**
 //List of TODO:
 //Change HandleButtonBool to mirror HandleButtonFloat and unify GetButtonData + HandleButton common logic for detecting which buttons need to be queried.
@@ -392,6 +469,14 @@ struct InputSystemImpl : public gainput::InputListener
 	{
 		ASSERT(pInputManager);
 
+		if (pInputRecorder && pInputRecorder->mMode == INPUT_RECORD_MODE_REPLAY)
+		{
+			pInputManager->SetDisplaySize(width, height);
+			ReplayActions(pInputRecorder);
+			++pInputRecorder->mFrame;
+			return;
+		}
+
 		for (FloatControl* pControl : mFloatDeltaControlCancelQueue)
 		{
 			pControl->mStarted = 0;
@@ -409,7 +494,7 @@ struct InputSystemImpl : public gainput::InputListener
 #else
 				ctx.pPosition = &mMousePosition;
 #endif
-				pControl->pAction->mDesc.pFunction(&ctx);
+				InvokeAction(&pControl->pAction->mDesc, &ctx);
 			}
 		}
 		
@@ -424,7 +509,7 @@ struct InputSystemImpl : public gainput::InputListener
 			ctx.mBinding = InputBindings::BUTTON_SOUTH;
 			ctx.pPosition = &mTouchPositions[pControl->pAction->mDesc.mUserId];
 			ctx.mBool = true;
-			pControl->pAction->mDesc.pFunction(&ctx);
+			InvokeAction(&pControl->pAction->mDesc, &ctx);
 		}
 #endif
 		
@@ -471,6 +556,57 @@ struct InputSystemImpl : public gainput::InputListener
 			XFlush(pWindow->handle.display);
 		}
 #endif
+
+		if (pInputRecorder)
+			++pInputRecorder->mFrame;
+	}
+
+	bool InvokeAction(const InputActionDesc* pDesc, InputActionContext* pCtx)
+	{
+		if (pInputRecorder && pInputRecorder->mMode == INPUT_RECORD_MODE_CAPTURE)
+		{
+			// Every desc lives in mActions, so its index identifies the action across runs
+			const uint32_t actionIndex = (uint32_t)((const InputAction*)pDesc - mActions.data());
+			recordInputAction(pInputRecorder, actionIndex, pCtx);
+		}
+
+		return pDesc->pFunction(pCtx);
+	}
+
+	void ReplayActions(InputRecorder* pRecorder)
+	{
+		while (pRecorder->mReplayCursor < (uint32_t)pRecorder->mEvents.size())
+		{
+			InputRecordEvent* pEvent = &pRecorder->mEvents[pRecorder->mReplayCursor];
+			if (pEvent->mFrame > pRecorder->mFrame)
+				break;
+
+			++pRecorder->mReplayCursor;
+
+			if (pEvent->mActionIndex >= (uint32_t)mActions.size())
+			{
+				LOGF(LogLevel::eWARNING, "Input replay references action %u but only %u actions were added", pEvent->mActionIndex,
+					 (uint32_t)mActions.size());
+				continue;
+			}
+
+			const InputActionDesc* pDesc = &mActions[pEvent->mActionIndex].mDesc;
+			if (!pDesc->pFunction)
+				continue;
+
+			InputActionContext ctx = {};
+			ctx.pUserData = pDesc->pUserData;
+			ctx.mFloat4 = float4(pEvent->mValue[0], pEvent->mValue[1], pEvent->mValue[2], pEvent->mValue[3]);
+			ctx.mBinding = pEvent->mBinding;
+			ctx.mPhase = pEvent->mPhase;
+			ctx.mDeviceType = pEvent->mDeviceType;
+			if (pEvent->mFlags & INPUT_RECORD_FLAG_POSITION)
+				ctx.pPosition = (float2*)pEvent->mPosition;
+			if (pEvent->mFlags & INPUT_RECORD_FLAG_CAPTURE_STATE)
+				ctx.pCaptured = &gReplayCaptureStates[(pEvent->mFlags & INPUT_RECORD_FLAG_CAPTURED) ? 1 : 0];
+
+			pDesc->pFunction(&ctx);
+		}
 	}
 	
 	template<typename T>
@@ -940,18 +1076,18 @@ struct InputSystemImpl : public gainput::InputListener
 						if (newValue && !oldValue)
 						{
 							ctx.mPhase = INPUT_ACTION_PHASE_STARTED;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 #if TOUCH_INPUT
 							mButtonControlPerformQueue.insert(control);
 #else
 							ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 #endif
 						}
 						else if (oldValue && !newValue)
 						{
 							ctx.mPhase = INPUT_ACTION_PHASE_CANCELED;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 					}
 					break;
@@ -989,7 +1125,7 @@ struct InputSystemImpl : public gainput::InputListener
 						pControl->mStarted = 1;
 						ctx.mPhase = INPUT_ACTION_PHASE_STARTED;
 						if (pDesc->pFunction)
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 					}
 					// Action Performed
 					if (pControl->mStarted && newValue && !pControl->mPerformed[index])
@@ -997,7 +1133,7 @@ struct InputSystemImpl : public gainput::InputListener
 						pControl->mPerformed[index] = 1;
 						ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
 						if (pDesc->pFunction)
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 					}
 					// Action Canceled
 					if (oldValue && !newValue)
@@ -1020,14 +1156,14 @@ struct InputSystemImpl : public gainput::InputListener
 							ctx.mFloat2 = pControl->mValue;
 							ctx.mPhase = INPUT_ACTION_PHASE_CANCELED;
 							if (pDesc->pFunction)
-								executeNext = pDesc->pFunction(&ctx) && executeNext;
+								executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 						else if (pDesc->pFunction)
 						{
 							ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
 							pControl->mValue[axis] = (float)pControl->mPressedVal[axis * 2 + 0] - (float)pControl->mPressedVal[axis * 2 + 1];
 							ctx.mFloat2 = pControl->mValue;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 					}
 
@@ -1045,7 +1181,7 @@ struct InputSystemImpl : public gainput::InputListener
 						if (pDesc->pFunction)
 						{
 							ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 
 						mFloatDeltaControlCancelQueue.insert(pControl);
@@ -1071,7 +1207,7 @@ struct InputSystemImpl : public gainput::InputListener
 								ctx.mPhase = INPUT_ACTION_PHASE_STARTED;
 								ctx.mFloat2 = float2(0.0f);
 								ctx.pPosition = &pControl->mCurrPos;
-								executeNext = pDesc->pFunction(&ctx) && executeNext;
+								executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 							}
 						}
 						else
@@ -1092,7 +1228,7 @@ struct InputSystemImpl : public gainput::InputListener
 							{
 								ctx.mFloat2 = float2(0.0f);
 								ctx.mPhase = INPUT_ACTION_PHASE_CANCELED;
-								executeNext = pDesc->pFunction(&ctx) && executeNext;
+								executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 							}
 						}
 					}
@@ -1110,7 +1246,7 @@ struct InputSystemImpl : public gainput::InputListener
 					{
 						ctx.mBool = true;
 						ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
-						pDesc->pFunction(&ctx);
+						InvokeAction(pDesc, &ctx);
 					}
 					break;
 				}
@@ -1178,7 +1314,7 @@ struct InputSystemImpl : public gainput::InputListener
 							if (pControl->mStarted == pControl->mTarget && pDesc->pFunction)
 							{
 								ctx.mPhase = INPUT_ACTION_PHASE_STARTED;
-								executeNext = pDesc->pFunction(&ctx) && executeNext;
+								executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 							}
 
 							mFloatDeltaControlCancelQueue.insert(pControl);
@@ -1191,7 +1327,7 @@ struct InputSystemImpl : public gainput::InputListener
 							pControl->mPerformed = 0;
 							ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
 							if (pDesc->pFunction)
-								executeNext = pDesc->pFunction(&ctx) && executeNext;
+								executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 					}
 					else if (pDesc->pFunction)
@@ -1203,7 +1339,7 @@ struct InputSystemImpl : public gainput::InputListener
 							ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
 							pControl->mPerformed = 0;
 							ctx.mFloat3 = pControl->mValue;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 					}
 					break;
@@ -1229,7 +1365,7 @@ struct InputSystemImpl : public gainput::InputListener
 						{
 							ctx.mPhase = INPUT_ACTION_PHASE_STARTED;
 							ctx.mFloat3 = pControl->mValue;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 					}
 
@@ -1252,13 +1388,13 @@ struct InputSystemImpl : public gainput::InputListener
 							pControl->mNewValue = float3(0.0f);
 							ctx.mPhase = INPUT_ACTION_PHASE_CANCELED;
 							if (pDesc->pFunction)
-								executeNext = pDesc->pFunction(&ctx) && executeNext;
+								executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 						else if (pDesc->pFunction)
 						{
 							ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
 							ctx.mFloat3 = pControl->mValue;
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 						}
 					}
 					break;
@@ -1288,7 +1424,7 @@ struct InputSystemImpl : public gainput::InputListener
 						ctx.mFloat2 = float2(dir[0], -dir[1]);
 						ctx.pPosition = &pControl->mCurrPos;
 						if (pDesc->pFunction)
-							executeNext = pDesc->pFunction(&ctx) && executeNext;
+							executeNext = InvokeAction(pDesc, &ctx) && executeNext;
 					}
 					break;
 				}
@@ -1328,7 +1464,7 @@ struct InputSystemImpl : public gainput::InputListener
 			}
 
 			ctx.mPhase = INPUT_ACTION_PHASE_PERFORMED;
-			pDesc->pFunction(&ctx);
+			InvokeAction(pDesc, &ctx);
 		}
 #endif
 
@@ -1406,3 +1542,106 @@ void setVirtualKeyboard(uint32_t type)
 	pInputSystem->SetVirtualKeyboard(type);
 }
 
+static InputRecorder* createInputRecorder(const Path* pFilePath, InputRecordMode mode)
+{
+	ASSERT(pFilePath);
+
+	if (pInputRecorder)
+	{
+		LOGF(LogLevel::eERROR, "Input recording or replay is already running");
+		return NULL;
+	}
+
+	pInputRecorder = conf_new(InputRecorder);
+	pInputRecorder->pFilePath = fsCopyPath(pFilePath);
+	pInputRecorder->mMode = mode;
+	pInputRecorder->mFrame = 0;
+	pInputRecorder->mReplayCursor = 0;
+	return pInputRecorder;
+}
+
+bool beginInputRecording(const Path* pFilePath)
+{
+	return createInputRecorder(pFilePath, INPUT_RECORD_MODE_CAPTURE) != NULL;
+}
+
+bool beginInputReplay(const Path* pFilePath)
+{
+	FileStream* pFile = fsOpenFile(pFilePath, FM_READ_BINARY);
+	if (!pFile)
+	{
+		LOGF(LogLevel::eERROR, "Failed to open input recording '%s'", fsGetPathAsNativeString(pFilePath));
+		return false;
+	}
+
+	InputRecordHeader header = {};
+	const bool validHeader = fsReadFromStream(pFile, &header, sizeof(header)) == sizeof(header) &&
+							 header.mMagic == INPUT_RECORDING_MAGIC && header.mVersion == INPUT_RECORDING_VERSION &&
+							 header.mEventSize == sizeof(InputRecordEvent);
+	if (!validHeader)
+	{
+		LOGF(LogLevel::eERROR, "'%s' is not a compatible input recording", fsGetPathAsNativeString(pFilePath));
+		fsCloseStream(pFile);
+		return false;
+	}
+
+	InputRecorder* pRecorder = createInputRecorder(pFilePath, INPUT_RECORD_MODE_REPLAY);
+	if (!pRecorder)
+	{
+		fsCloseStream(pFile);
+		return false;
+	}
+
+	pRecorder->mEvents.resize(header.mEventCount);
+	const size_t eventBytes = header.mEventCount * sizeof(InputRecordEvent);
+	if (eventBytes && fsReadFromStream(pFile, pRecorder->mEvents.data(), eventBytes) != eventBytes)
+	{
+		LOGF(LogLevel::eERROR, "Input recording '%s' is truncated", fsGetPathAsNativeString(pFilePath));
+		fsCloseStream(pFile);
+		endInputRecording();
+		return false;
+	}
+
+	fsCloseStream(pFile);
+	LOGF(LogLevel::eINFO, "Replaying %u input events from '%s'", header.mEventCount, fsGetPathAsNativeString(pFilePath));
+	return true;
+}
+
+void endInputRecording()
+{
+	if (!pInputRecorder)
+		return;
+
+	if (pInputRecorder->mMode == INPUT_RECORD_MODE_CAPTURE)
+	{
+		FileStream* pFile = fsOpenFile(pInputRecorder->pFilePath, FM_WRITE_BINARY);
+		if (pFile)
+		{
+			InputRecordHeader header = {};
+			header.mMagic = INPUT_RECORDING_MAGIC;
+			header.mVersion = INPUT_RECORDING_VERSION;
+			header.mEventSize = sizeof(InputRecordEvent);
+			header.mEventCount = (uint32_t)pInputRecorder->mEvents.size();
+			fsWriteToStream(pFile, &header, sizeof(header));
+			fsWriteToStream(pFile, pInputRecorder->mEvents.data(), header.mEventCount * sizeof(InputRecordEvent));
+			fsCloseStream(pFile);
+			LOGF(LogLevel::eINFO, "Recorded %u input events over %u frames to '%s'", header.mEventCount, pInputRecorder->mFrame,
+				 fsGetPathAsNativeString(pInputRecorder->pFilePath));
+		}
+		else
+		{
+			LOGF(LogLevel::eERROR, "Failed to write input recording '%s'", fsGetPathAsNativeString(pInputRecorder->pFilePath));
+		}
+	}
+
+	fsFreePath(pInputRecorder->pFilePath);
+	conf_delete(pInputRecorder);
+	pInputRecorder = NULL;
+}
+
+bool isInputReplayFinished()
+{
+	return !pInputRecorder || pInputRecorder->mMode != INPUT_RECORD_MODE_REPLAY ||
+		   pInputRecorder->mReplayCursor >= (uint32_t)pInputRecorder->mEvents.size();
+}
+
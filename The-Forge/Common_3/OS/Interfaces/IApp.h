@@ -92,6 +92,11 @@ public:
 	virtual void Update(float deltaTime) = 0;
 	virtual void Draw() = 0;
 
+	/// Called on the main thread once Update and Draw of a frame have both finished.
+	/// With mPipelinedUpdate this is the only point where the two are not running concurrently,
+	/// so apps swap their PipelinedState here.
+	virtual void SyncFrame() {}
+
 	virtual const char* GetName() = 0;
 
 	struct Settings
@@ -104,6 +109,9 @@ public:
 		bool     mFullScreen = false;
 		/// Set to true if app wants to use an external window
 		bool     mExternalWindow = false;
+		/// Set to true to run Update for the next frame on a worker thread while Draw records the current one.
+		/// Draw must then only read state published through SyncFrame (see PipelinedState)
+		bool     mPipelinedUpdate = false;
 #if defined(TARGET_IOS)
 		bool     mShowStatusBar = false;
 		float    mContentScaleFactor = 0.f;
@@ -117,6 +125,30 @@ public:
 	static const char** argv;
 };
 
+/// Double-buffered app state for IApp::Settings::mPipelinedUpdate.
+/// Update writes GetUpdateState() while Draw reads GetDrawState() of the previous frame.
+/// Call Swap() from IApp::SyncFrame to hand the latest update over to Draw.
+template <typename T>
+class PipelinedState
+{
+	public:
+	PipelinedState(): mUpdateIndex(0) {}
+
+	T&       GetUpdateState() { return mStates[mUpdateIndex]; }
+	const T& GetDrawState() const { return mStates[mUpdateIndex ^ 1]; }
+
+	/// Publishes the update state to Draw and seeds the next update with a copy of it
+	void Swap()
+	{
+		mUpdateIndex ^= 1;
+		mStates[mUpdateIndex] = mStates[mUpdateIndex ^ 1];
+	}
+
+	private:
+	T        mStates[2];
+	uint32_t mUpdateIndex;
+};
+
 #if defined(_DURANGO)
 #define DEFINE_APPLICATION_MAIN(appClass)                     \
 	int IApp::argc;                                           \
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "stdint.h"
+
+// Deterministic benchmark runs driven from the platform main loop.
+// The Linux and Windows entry points of DEFINE_APPLICATION_MAIN parse these command line flags:
+//   --benchmark <frames>           run for a fixed number of frames, then quit and write the report
+//   --benchmark-warmup <frames>    leading frames left out of the statistics
+//   --benchmark-output <file>      timing report path, defaults to "<app>Benchmark-<date>.json" in the log directory
+//   --fixed-timestep <seconds>     delta time passed to IApp::Update, defaults to 1/60 (0 uses the measured delta time)
+//   --record-input <file>          record all input actions to <file>
+//   --replay-input <file>          replay input actions from <file> instead of live input
+//   --lua-async <file>             Lua async mode: every LuaManager::Update also runs <file> as async scripts and times them
+//   --lua-async-count <scripts>    scripts queued per frame in Lua async mode, defaults to 64
+typedef struct BenchmarkDesc
+{
+	const char* pRecordInputFile;
+	const char* pReplayInputFile;
+	const char* pOutputFile;
+	const char* pLuaAsyncScript;
+	float       mFixedTimeStep;
+	uint32_t    mFrameCount;
+	uint32_t    mWarmupFrameCount;
+	uint32_t    mLuaAsyncScriptCount;
+} BenchmarkDesc;
+
+typedef struct Path Path;
+
+/// Returns true if any benchmark flag was found in argv
+bool parseBenchmarkArgs(int argc, const char** argv, BenchmarkDesc* pDesc);
+
+/// Call after fsInitAPI and before IApp::Init so input recording covers the whole run
+bool initBenchmark(const char* pAppName, const BenchmarkDesc* pDesc);
+/// Writes the timing report and input recording. Call before IApp::Unload while the profiler is still alive
+void exitBenchmark();
+
+/// Returns the delta time to pass to IApp::Update
+float beginBenchmarkFrame(float deltaTime);
+/// Samples the frame timings, returns false once the run is complete
+bool  endBenchmarkFrame();
+
+/// Returns the script of the Lua async mode and the number of copies to run per frame, NULL if the mode is off
+const Path* getBenchmarkLuaAsyncScript(uint32_t* pScriptCount);
+/// Records the time the Lua async scripts of the current frame took to finish
+void        setBenchmarkLuaAsyncTime(float ms);
@@ -440,6 +440,7 @@ typedef enum FileSystemKind
     FSK_SYSTEM = 0,
     FSK_ZIP,
     FSK_RESOURCE_BUNDLE,
+    FSK_PACK,
     
     FSK_DEFAULT = FSK_SYSTEM
 } FileSystemKind;
@@ -455,6 +456,7 @@ typedef enum FileSystemFlags {
 
 /// Creates a new file-system with its root at rootPath.
 /// If rootPath is a compressed zip file, the file system will be the contents of the zip file.
+/// If rootPath is a .pak file built by the AssetPipeline, the file system will be the read-only contents of the pack.
 FileSystem* fsCreateFileSystemFromFileAtPath(const Path* rootPath, FileSystemFlags flags);
 
 /// If `fileSystem` is parented under another file system (e.g. is a zip file system), returns the path
@@ -149,3 +149,14 @@ void          removeInputAction(InputAction* pAction);
 bool          setEnableCaptureInput(bool enable);
 /// Used to enable/disable text input for non-keyboard setups (virtual keyboards for console/mobile, ...)
 void          setVirtualKeyboard(uint32_t type);
+
+/// Input record / replay for deterministic benchmark runs (see IBenchmark.h)
+/// Recording captures every dispatched action callback together with the updateInputSystem frame it happened in.
+/// Replay ignores live device input and dispatches the captured callbacks on the same frames.
+/// Actions are identified by the order they were added, so the app has to add them deterministically. Text input is not recorded.
+/// Can be called before initInputSystem so the very first frame is covered.
+bool          beginInputRecording(const struct Path* pFilePath);
+bool          beginInputReplay(const struct Path* pFilePath);
+/// Stops recording or replay. A recording is written to the path passed to beginInputRecording
+void          endInputRecording();
+bool          isInputReplayFinished();
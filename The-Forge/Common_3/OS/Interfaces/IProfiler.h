@@ -5,7 +5,7 @@
 #endif
 
 #if (PROFILE_ENABLED)
-#if defined(DIRECT3D12) || defined(VULKAN) || defined(DIRECT3D11) || defined(METAL) || defined(ORBIS)
+#if defined(DIRECT3D12) || defined(VULKAN) || defined(DIRECT3D11) || defined(METAL) || defined(ORBIS) || defined(NULL_RENDERER)
 #define GPU_PROFILER_SUPPORTED 1
 #endif
 
@@ -43,6 +43,11 @@ void setAggregateFrames(uint32_t nFrames);
 // Dump profile data to "profile-(date).html" of recorded frames, until a maximum amount of frames
 void dumpProfileData(const char* appName = "" , uint32_t nMaxFrames = 64);
 
+// Stream every profiled frame to "(appName)Trace-(date).json" in the Chrome trace event format (chrome://tracing, Perfetto) until stopped
+void beginProfileTraceCapture(const char* appName = "");
+void endProfileTraceCapture();
+bool isProfileTraceCaptureRunning();
+
 //------ Profiler UI Widget --------//
 
 // Call on application load to generate the resources needed for UI drawing
@@ -92,6 +97,10 @@ float getGpuProfileMaxTime(ProfileToken nProfileToken);
 
 uint64_t getGpuProfileTicksPerSecond(ProfileToken nProfileToken);
 
+// Writes the frame tokens of all added Gpu Profilers to pTokens (up to nMaxTokens), returns the number of Gpu Profilers
+// Lets tools such as the benchmark harness sample Gpu frame times without knowing the app's tokens
+uint32_t getGpuProfileFrameTokens(ProfileToken* pTokens, uint32_t nMaxTokens);
+
 //------ Cpu profiler ------------//
 
 uint64_t cpuProfileEnter(ProfileToken nToken);
@@ -129,4 +138,11 @@ float getCpuProfileMaxTime(const char* pGroup, const char* pName, ThreadID* pThr
 float getCpuFrameTime();
 float getCpuAvgFrameTime();
 float getCpuMinFrameTime();
-float getCpuMaxFrameTime();
\ No newline at end of file
+float getCpuMaxFrameTime();
+
+//------ Counters ------------//
+// Counters are shown next to the timers in the profile dump. '/' in the name nests them, e.g. "ResourceLoader/QueueDepth"
+ProfileToken getProfileCounterToken(const char* pName, bool bBytes = false);
+void setProfileCounter(ProfileToken nToken, int64_t nValue);
+// Changes every time the profiler is initialized, which invalidates all counter tokens. 0 until the first initProfiler
+uint32_t getProfileCounterGeneration();
\ No newline at end of file
@@ -36,6 +36,7 @@
 #include "../Interfaces/ILog.h"
 #include "../Interfaces/ITime.h"
 #include "../Interfaces/IThread.h"
+#include "../Interfaces/IBenchmark.h"
 
 #include "../Interfaces/IMemory.h"
 
@@ -235,6 +236,85 @@ bool handleMessages(WindowsDesc* winDesc)
 	return quit;
 }
 
+/************************************************************************/
+// Pipelined Update
+/************************************************************************/
+// Runs IApp::Update for the next frame while the main thread runs IApp::Draw.
+// The main thread keeps ownership of the window and event pump.
+typedef struct UpdateWorker
+{
+	ThreadDesc        mThreadDesc;
+	ThreadHandle      mThread;
+	Mutex             mMutex;
+	ConditionVariable mCondition;
+	float             mDeltaTime;
+	bool              mPending;
+	bool              mQuit;
+} UpdateWorker;
+
+static void updateWorkerFunc(void* pData)
+{
+	UpdateWorker* pWorker = (UpdateWorker*)pData;
+	Thread::SetCurrentThreadName("UpdateWorker");
+
+	MutexLock lock(pWorker->mMutex);
+	for (;;)
+	{
+		while (!pWorker->mPending && !pWorker->mQuit)
+			pWorker->mCondition.Wait(pWorker->mMutex);
+
+		if (!pWorker->mPending)
+			return;
+
+		float deltaTime = pWorker->mDeltaTime;
+		pWorker->mMutex.Release();
+		pApp->Update(deltaTime);
+		pWorker->mMutex.Acquire();
+
+		pWorker->mPending = false;
+		pWorker->mCondition.WakeAll();
+	}
+}
+
+static void initUpdateWorker(UpdateWorker* pWorker)
+{
+	pWorker->mMutex.Init();
+	pWorker->mCondition.Init();
+	pWorker->mDeltaTime = 0.0f;
+	pWorker->mPending = false;
+	pWorker->mQuit = false;
+	pWorker->mThreadDesc.pFunc = updateWorkerFunc;
+	pWorker->mThreadDesc.pData = pWorker;
+	pWorker->mThread = create_thread(&pWorker->mThreadDesc);
+}
+
+static void exitUpdateWorker(UpdateWorker* pWorker)
+{
+	pWorker->mMutex.Acquire();
+	pWorker->mQuit = true;
+	pWorker->mCondition.WakeAll();
+	pWorker->mMutex.Release();
+
+	join_thread(pWorker->mThread);
+	pWorker->mCondition.Destroy();
+	pWorker->mMutex.Destroy();
+}
+
+static void kickUpdateWorker(UpdateWorker* pWorker, float deltaTime)
+{
+	MutexLock lock(pWorker->mMutex);
+	pWorker->mDeltaTime = deltaTime;
+	pWorker->mPending = true;
+	pWorker->mCondition.WakeAll();
+}
+
+static void waitUpdateWorker(UpdateWorker* pWorker)
+{
+	MutexLock lock(pWorker->mMutex);
+	while (pWorker->mPending)
+		pWorker->mCondition.Wait(pWorker->mMutex);
+}
+
 int LinuxMain(int argc, char** argv, IApp* app)
 {
 	extern bool MemAllocInit();
@@ -250,6 +330,16 @@ int LinuxMain(int argc, char** argv, IApp* app)
 	
 	pApp = app;
 
+	BenchmarkDesc benchmarkDesc = {};
+	const bool    benchmark = parseBenchmarkArgs(argc, (const char**)argv, &benchmarkDesc);
+	if (benchmark && !initBenchmark(pApp->GetName(), &benchmarkDesc))
+	{
+		Log::Exit();
+		fsDeinitAPI();
+		MemAllocExit();
+		return EXIT_FAILURE;
+	}
+
 	//Used for automated testing, if enabled app will exit after 120 frames
 #ifdef AUTOMATED_TESTING
 	uint32_t       testingFrameCount = 0;
@@ -257,7 +347,7 @@ int LinuxMain(int argc, char** argv, IApp* app)
 #endif
 
 	IApp::Settings* pSettings = &pApp->mSettings;
-	Timer           deltaTimer;
+	HiresTimer      deltaTimer;
 
     RectDesc rect = {};
     getRecommendedResolution(&rect);
@@ -290,17 +380,46 @@ int LinuxMain(int argc, char** argv, IApp* app)
 
 	bool quit = false;
 
+	// In pipelined mode Draw of frame N overlaps Update of frame N + 1, so prime the first frame serially.
+	UpdateWorker updateWorker;
+	const bool   pipelined = pSettings->mPipelinedUpdate;
+	if (pipelined)
+	{
+		initUpdateWorker(&updateWorker);
+		pApp->Update(0.0f);
+		pApp->SyncFrame();
+	}
+
+	deltaTimer.Reset();
+
 	while (!quit)
 	{
-		float deltaTime = deltaTimer.GetMSec(true) / 1000.0f;
+		float deltaTime = deltaTimer.GetSeconds(true);
 		// if framerate appears to drop below about 6, assume we're at a breakpoint and simulate 20fps.
 		if (deltaTime > 0.15f)
 			deltaTime = 0.05f;
 
 		quit = handleMessages(&gWindow);
 
-		pApp->Update(deltaTime);
-		pApp->Draw();
+		if (benchmark)
+			deltaTime = beginBenchmarkFrame(deltaTime);
+
+		if (pipelined)
+		{
+			kickUpdateWorker(&updateWorker, deltaTime);
+			pApp->Draw();
+			waitUpdateWorker(&updateWorker);
+		}
+		else
+		{
+			pApp->Update(deltaTime);
+			pApp->Draw();
+		}
+
+		pApp->SyncFrame();
+
+		if (benchmark && !endBenchmarkFrame())
+			quit = true;
 
 #ifdef AUTOMATED_TESTING
 		//used in automated tests only.
@@ -310,6 +429,12 @@ int LinuxMain(int argc, char** argv, IApp* app)
 #endif
 	}
 
+	if (pipelined)
+		exitUpdateWorker(&updateWorker);
+
+	if (benchmark)
+		exitBenchmark();
+
 	pApp->Unload();
 	pApp->Exit();
 	
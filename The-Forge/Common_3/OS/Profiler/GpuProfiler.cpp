@@ -36,6 +36,7 @@ float getGpuProfileAvgTime(ProfileToken nProfileToken) { return -1.0f; }
 float getGpuProfileMinTime(ProfileToken nProfileToken) { return -1.0f; }
 float getGpuProfileMaxTime(ProfileToken nProfileToken) { return -1.0f; }
 uint64_t getGpuProfileTicksPerSecond(ProfileToken nProfileToken) { return 0; }
+uint32_t getGpuProfileFrameTokens(ProfileToken* pTokens, uint32_t nMaxTokens) { return 0; }
 GpuProfiler* getGpuProfiler(ProfileToken nProfileToken) { return NULL; }
 #else
 
@@ -503,4 +504,22 @@ uint64_t getGpuProfileTicksPerSecond(ProfileToken nProfileToken)
         return 0;
     return (uint64_t)pGpuProfiler->mGpuTimeStampFrequency;
 }
+
+uint32_t getGpuProfileFrameTokens(ProfileToken* pTokens, uint32_t nMaxTokens)
+{
+    if (!gGpuProfilerContainer)
+        return 0;
+
+    uint32_t nCount = 0;
+    for (uint32_t i = 0; i < GpuProfilerContainer::MAX_GPU_PROFILERS; ++i)
+    {
+        if (!gGpuProfilerContainer->mProfilers[i])
+            continue;
+
+        if (nCount < nMaxTokens)
+            pTokens[nCount] = getProfileToken(i, 0);
+        ++nCount;
+    }
+    return nCount;
+}
 #endif
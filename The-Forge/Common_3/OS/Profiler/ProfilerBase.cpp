@@ -4,6 +4,9 @@ void initProfiler(Renderer* pRenderer, Queue** ppQueue, const char** ppProfilerN
 void exitProfiler() {}
 void flipProfiler() {}
 void dumpProfileData(const char* appName, uint32_t nMaxFrames) {}
+void beginProfileTraceCapture(const char* appName) {}
+void endProfileTraceCapture() {}
+bool isProfileTraceCaptureRunning() { return false; }
 void setAggregateFrames(uint32_t nFrames) {}
 float getCpuProfileTime(const char* pGroup, const char* pName, ThreadID* pThreadID) { return -1.0f; }
 float getCpuProfileAvgTime(const char* pGroup, const char* pName, ThreadID* pThreadID) { return -1.0f; }
@@ -19,8 +22,13 @@ uint64_t cpuProfileEnter(ProfileToken nToken) { return 0; }
 void cpuProfileLeave(ProfileToken nToken, uint64_t nTick) {}
 ProfileToken getCpuProfileToken(const char* pGroup, const char* pName, uint32_t nColor) { return PROFILE_INVALID_TOKEN; }
 
+ProfileToken getProfileCounterToken(const char* pName, bool bBytes) { return PROFILE_INVALID_TOKEN; }
+void setProfileCounter(ProfileToken nToken, int64_t nValue) {}
+uint32_t getProfileCounterGeneration() { return 0; }
+
 #else
 #include "../Interfaces/IFileSystem.h"
+#include "../Interfaces/ILog.h"
 #include "../Interfaces/IMemory.h"
 
 void initGpuProfilers();
@@ -116,6 +124,9 @@ Profile g_Profile;
 
 static bool g_bUseLock = false; /// This is used because windows does not support using mutexes under dll init(which is where global initialization is handled)
 static bool g_bOnce = true;
+/// Bumped by every ProfileInit so holders of counter tokens know to fetch new ones. 0 while the state is reset or shut down
+static tfrg_atomic32_t g_nCounterGeneration = 0;
+static uint32_t g_nCounterSession = 0;
 
 #ifndef P_THREAD_LOCAL
 static pthread_key_t g_ProfileThreadLogKey;
@@ -175,6 +186,8 @@ void ProfileInit()
 	{
 		g_bOnce = false;
         mutex.Init();
+		// Counters of the previous session must not be set while the state is cleared
+		tfrg_atomic32_store_release(&g_nCounterGeneration, 0);
 		memset(&S, 0, sizeof(S));
 		S.nMemUsage = sizeof(S);
 		for (int i = 0; i < PROFILE_MAX_GROUPS; ++i)
@@ -230,6 +243,9 @@ void ProfileInit()
 			S.nCounterMax[i] = 0x8000000000000000;
 		}
 #endif
+		if (++g_nCounterSession == 0)
+			++g_nCounterSession;
+		tfrg_atomic32_store_release(&g_nCounterGeneration, g_nCounterSession);
 	}
 	if (bUseLock)
 		mutex.Release();
@@ -264,7 +280,9 @@ void exitCpuProfiler()
 	ProfileOnThreadExit();
 	ProfileWebServerStop();
 	ProfileContextSwitchTraceStop();
+	ProfileTraceStop();
 
+	tfrg_atomic32_store_release(&g_nCounterGeneration, 0);
     g_bOnce = true;
     g_bUseLock = false;
 }
@@ -796,7 +814,7 @@ uint64_t ProfileAllocateLabel(const char* pName)
 			pLabelBuffer = static_cast<char *>(conf_malloc(PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN));
 			memset(pLabelBuffer, 0, PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN);
 			S.nMemUsage += PROFILE_LABEL_BUFFER_SIZE + PROFILE_LABEL_MAX_LEN;
-            tfrg_atomicptr_store_release((tfrg_atomic64_t*)&S.LabelBuffer, *pLabelBuffer);
+            tfrg_atomicptr_store_release(&S.LabelBuffer, (uintptr_t)pLabelBuffer);
 		}
 	}
 
@@ -1002,6 +1020,7 @@ void ProfileGetRange(uint32_t nPut, uint32_t nGet, uint32_t nRange[2][2])
 }
 
 void ProfileDumpToFile();
+static void ProfileTraceFlip(uint32_t nFrame, uint32_t nFrameNext);
 
 void ProfileFlipCpu()
 {
@@ -1101,6 +1120,8 @@ void ProfileFlipCpu()
 			}
 		}
 
+		ProfileTraceFlip(S.nFrameCurrent, nFrameNext);
+
 		if (S.nRunning)
 		{
 			uint64_t* pFrameGroup = &S.FrameGroup[0];
@@ -1724,6 +1745,25 @@ float getCpuFrameTime()
     return fToMs * (S.nFlipTicks);
 }
 
+ProfileToken getProfileCounterToken(const char* pName, bool bBytes)
+{
+    ProfileToken nToken = ProfileGetCounterToken(pName);
+    if (bBytes)
+        ProfileCounterConfig(pName, PROFILE_COUNTER_FORMAT_BYTES, 0, 0);
+    return nToken;
+}
+
+void setProfileCounter(ProfileToken nToken, int64_t nValue)
+{
+    if (nToken != PROFILE_INVALID_TOKEN)
+        ProfileCounterSet(nToken, nValue);
+}
+
+uint32_t getProfileCounterGeneration()
+{
+    return tfrg_atomic32_load_acquire(&g_nCounterGeneration);
+}
+
 
 int ProfileFormatCounter(int eFormat, int64_t nCounter, char* pOut, uint32_t nBufferSize)
 {
@@ -2558,6 +2598,535 @@ void dumpProfileData(const char* appName, uint32_t nMaxFrames)
     }
 }
 
+// Trace capture streams every flipped frame to disk in the Chrome trace event format (JSON array flavour),
+// which chrome://tracing and Perfetto load directly. The flip only copies the frame's raw log
+// entries and label strings into a heap block; formatting and file IO happen on a dedicated writer thread.
+// Pending blocks are bounded by PROFILE_TRACE_MAX_PENDING_BYTES, frames arriving while the writer is behind
+// are dropped and reported through the "Trace Dropped Frames" counter track.
+struct ProfileTraceThread
+{
+	uint32_t nLogIndex;
+	uint32_t nGpu;
+	uint32_t nFirstEntry;
+	uint32_t nNumEntries;
+	int64_t nTickStart;
+	int64_t nTicksPerSecond;
+	char ThreadName[ProfileThreadLog::THREAD_MAX_LEN];
+};
+
+struct ProfileTraceFrame
+{
+	ProfileTraceFrame* pNext;
+	size_t nSize;
+	int64_t nFrameStartCpu;
+	int64_t nFrameEndCpu;
+	uint32_t nNumThreads;
+	uint32_t nNumCounters;
+	uint32_t nNumEntries;
+	uint32_t nDroppedFrames;
+	ProfileTraceThread* pThreads;
+	int64_t* pCounters;
+	ProfileLogEntry* pEntries;
+	char* pLabels;
+};
+
+struct ProfileTraceState
+{
+	Mutex mMutex;
+	ConditionVariable mCond;
+	ThreadDesc mThreadDesc;
+	ThreadHandle mThread;
+	FileStream* pFile;
+
+	// Shared with the flip, guarded by mMutex
+	ProfileTraceFrame* pHead;
+	ProfileTraceFrame* pTail;
+	size_t nPendingBytes;
+	uint32_t nDroppedFrames;
+	bool bStop;
+
+	// Owned by the flip, guarded by ProfileMutex
+	int64_t nTickStart;
+	uint32_t nForceEnable;
+	uint32_t nAllGroupsWanted;
+
+	// Owned by the writer thread
+	char* pWriteBuffer;
+	uint32_t nWritePut;
+	uint32_t nNumEvents;
+	uint32_t nProcessId;
+	double fLastTimeUs;
+	uint32_t nStackDepth[PROFILE_MAX_THREADS];
+	char ThreadNames[PROFILE_MAX_THREADS][ProfileThreadLog::THREAD_MAX_LEN];
+	int64_t Counters[PROFILE_MAX_COUNTERS];
+	uint32_t nNumCounters;
+	uint32_t nLastDroppedFrames;
+};
+
+static ProfileTraceState* g_pProfileTrace = NULL;
+
+static ProfileTraceFrame* ProfileTraceCaptureFrame(ProfileTraceState* pTrace, uint32_t nFrame, uint32_t nFrameNext)
+{
+	Profile & S = g_Profile;
+	ProfileFrameState* pFrameCurrent = &S.Frames[nFrame];
+	ProfileFrameState* pFrameNext = &S.Frames[nFrameNext];
+
+	uint32_t nNumThreads = 0;
+	uint32_t nNumEntries = 0;
+	size_t nLabelSize = 0;
+	for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+	{
+		ProfileThreadLog* pLog = S.Pool[i];
+		if (!pLog || !pLog->Log)
+			continue;
+		uint32_t nGet = pFrameCurrent->nLogStart[i];
+		uint32_t nPut = pFrameNext->nLogStart[i];
+		if (nGet == nPut)
+			continue;
+		++nNumThreads;
+		for (uint32_t k = nGet; k != nPut; k = (k + 1) % PROFILE_BUFFER_SIZE)
+		{
+			++nNumEntries;
+			uint32_t nLogType = (uint32_t)ProfileLogType(pLog->Log[k]);
+			if (nLogType == P_LOG_LABEL || nLogType == P_LOG_LABEL_LITERAL)
+			{
+				const char* pLabel = ProfileGetLabel(nLogType, ProfileLogGetTick(pLog->Log[k]));
+				nLabelSize += (pLabel ? strlen(pLabel) : 0) + 1;
+			}
+		}
+	}
+
+	size_t nSize = sizeof(ProfileTraceFrame) + nNumThreads * sizeof(ProfileTraceThread) + S.nNumCounters * sizeof(int64_t) +
+				   nNumEntries * sizeof(ProfileLogEntry) + nLabelSize;
+	{
+		MutexLock lock(pTrace->mMutex);
+		if (pTrace->nPendingBytes + nSize > PROFILE_TRACE_MAX_PENDING_BYTES)
+		{
+			pTrace->nDroppedFrames++;
+			return NULL;
+		}
+		pTrace->nPendingBytes += nSize;
+	}
+
+	ProfileTraceFrame* pFrame = (ProfileTraceFrame*)conf_malloc(nSize);
+	pFrame->pNext = NULL;
+	pFrame->nSize = nSize;
+	pFrame->nFrameStartCpu = pFrameCurrent->nFrameStartCpu;
+	pFrame->nFrameEndCpu = pFrameNext->nFrameStartCpu;
+	pFrame->nNumThreads = nNumThreads;
+	pFrame->nNumCounters = S.nNumCounters;
+	pFrame->nNumEntries = nNumEntries;
+	pFrame->pThreads = (ProfileTraceThread*)(pFrame + 1);
+	pFrame->pCounters = (int64_t*)(pFrame->pThreads + nNumThreads);
+	pFrame->pEntries = (ProfileLogEntry*)(pFrame->pCounters + S.nNumCounters);
+	pFrame->pLabels = (char*)(pFrame->pEntries + nNumEntries);
+
+	for (uint32_t i = 0; i < S.nNumCounters; ++i)
+	{
+		pFrame->pCounters[i] = tfrg_atomic64_load_relaxed(&S.Counters[i]);
+	}
+
+	ProfileTraceThread* pThread = pFrame->pThreads;
+	ProfileLogEntry* pEntry = pFrame->pEntries;
+	char* pLabels = pFrame->pLabels;
+	for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+	{
+		ProfileThreadLog* pLog = S.Pool[i];
+		if (!pLog || !pLog->Log)
+			continue;
+		uint32_t nGet = pFrameCurrent->nLogStart[i];
+		uint32_t nPut = pFrameNext->nLogStart[i];
+		if (nGet == nPut)
+			continue;
+
+		pThread->nLogIndex = i;
+		pThread->nGpu = pLog->nGpu;
+		pThread->nFirstEntry = (uint32_t)(pEntry - pFrame->pEntries);
+		pThread->nNumEntries = 0;
+		// Gpu ticks are in their own timebase, so each frame is aligned with the cpu frame start that recorded it
+		pThread->nTickStart = pLog->nGpu ? pFrameCurrent->nFrameStartGpu[i] : pFrame->nFrameStartCpu;
+		pThread->nTicksPerSecond = pLog->nGpu ? (int64_t)getGpuProfileTicksPerSecond(pLog->nGpuToken) : ProfileTicksPerSecondCpu();
+		if (pLog->nGpu && !pThread->nTickStart)
+			pThread->nTickStart = ProfileLogGetTick(pLog->Log[nGet]);
+		memcpy(pThread->ThreadName, pLog->ThreadName, sizeof(pThread->ThreadName));
+		pThread->ThreadName[sizeof(pThread->ThreadName) - 1] = '\0';
+
+		for (uint32_t k = nGet; k != nPut; k = (k + 1) % PROFILE_BUFFER_SIZE)
+		{
+			ProfileLogEntry e = pLog->Log[k];
+			uint32_t nLogType = (uint32_t)ProfileLogType(e);
+			if (nLogType == P_LOG_LABEL || nLogType == P_LOG_LABEL_LITERAL)
+			{
+				// Labels live in a ring buffer that keeps getting reused, so store a copy and point the entry at it
+				const char* pLabel = ProfileGetLabel(nLogType, ProfileLogGetTick(e));
+				size_t nLen = pLabel ? strlen(pLabel) : 0;
+				memcpy(pLabels, pLabel ? pLabel : "", nLen + 1);
+				e = ProfileLogSetTick(e, (int64_t)(pLabels - pFrame->pLabels));
+				pLabels += nLen + 1;
+			}
+			*pEntry++ = e;
+			pThread->nNumEntries++;
+		}
+		++pThread;
+	}
+
+	return pFrame;
+}
+
+static void ProfileTraceFlush(ProfileTraceState* pTrace)
+{
+	if (pTrace->nWritePut)
+	{
+		fsWriteToStream(pTrace->pFile, pTrace->pWriteBuffer, pTrace->nWritePut);
+		pTrace->nWritePut = 0;
+	}
+}
+
+static void ProfileTraceWrite(ProfileTraceState* pTrace, const char* pData, size_t nSize)
+{
+	if (pTrace->nWritePut + nSize > PROFILE_TRACE_WRITE_BUFFER_SIZE)
+	{
+		ProfileTraceFlush(pTrace);
+		if (nSize > PROFILE_TRACE_WRITE_BUFFER_SIZE)
+		{
+			fsWriteToStream(pTrace->pFile, pData, nSize);
+			return;
+		}
+	}
+	memcpy(pTrace->pWriteBuffer + pTrace->nWritePut, pData, nSize);
+	pTrace->nWritePut += (uint32_t)nSize;
+}
+
+PROFILE_FORMAT(2, 3) static void ProfileTracePrintf(ProfileTraceState* pTrace, const char* pFmt, ...)
+{
+	char buffer[512];
+	va_list args;
+	va_start(args, pFmt);
+	int nSize = vsnprintf(buffer, sizeof(buffer), pFmt, args);
+	va_end(args);
+	if (nSize > 0)
+		ProfileTraceWrite(pTrace, buffer, ProfileMin((size_t)nSize, sizeof(buffer) - 1));
+}
+
+static void ProfileTraceWriteString(ProfileTraceState* pTrace, const char* pString)
+{
+	char buffer[PROFILE_LABEL_MAX_LEN * 6 + 2];
+	uint32_t nPut = 0;
+	buffer[nPut++] = '"';
+	for (const char* p = pString; *p && nPut < sizeof(buffer) - 7; ++p)
+	{
+		unsigned char c = (unsigned char)*p;
+		if (c == '"' || c == '\\')
+		{
+			buffer[nPut++] = '\\';
+			buffer[nPut++] = (char)c;
+		}
+		else if (c < 0x20)
+		{
+			nPut += snprintf(&buffer[nPut], 7, "\\u%04x", c);
+		}
+		else
+		{
+			buffer[nPut++] = (char)c;
+		}
+	}
+	buffer[nPut++] = '"';
+	ProfileTraceWrite(pTrace, buffer, nPut);
+}
+
+// Starts a new event object, events are separated up front so the file stays loadable if the process dies mid capture
+static void ProfileTraceBeginEvent(ProfileTraceState* pTrace, const char* pPhase, uint32_t nTid, double fTimeUs)
+{
+	ProfileTracePrintf(pTrace, "%s{\"ph\":\"%s\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f", pTrace->nNumEvents ? ",\n" : "", pPhase,
+					   pTrace->nProcessId, nTid, fTimeUs);
+	pTrace->nNumEvents++;
+}
+
+static double ProfileTraceTimeUs(ProfileTraceState* pTrace, int64_t nTick)
+{
+	return (double)(nTick - pTrace->nTickStart) * 1000000.0 / (double)ProfileTicksPerSecondCpu();
+}
+
+static void ProfileTraceWriteFrame(ProfileTraceState* pTrace, ProfileTraceFrame* pFrame)
+{
+	Profile & S = g_Profile;
+	const double fFrameStartUs = ProfileTraceTimeUs(pTrace, pFrame->nFrameStartCpu);
+	const double fFrameEndUs = ProfileTraceTimeUs(pTrace, pFrame->nFrameEndCpu);
+
+	ProfileTraceBeginEvent(pTrace, "i", 0, fFrameStartUs);
+	ProfileTracePrintf(pTrace, ",\"s\":\"g\",\"name\":\"Frame\"}");
+	ProfileTraceBeginEvent(pTrace, "C", 0, fFrameStartUs);
+	ProfileTracePrintf(pTrace, ",\"name\":\"Frame Time (ms)\",\"args\":{\"ms\":%.3f}}", (fFrameEndUs - fFrameStartUs) * 0.001);
+
+	if (pFrame->nDroppedFrames != pTrace->nLastDroppedFrames)
+	{
+		pTrace->nLastDroppedFrames = pFrame->nDroppedFrames;
+		ProfileTraceBeginEvent(pTrace, "C", 0, fFrameStartUs);
+		ProfileTracePrintf(pTrace, ",\"name\":\"Trace Dropped Frames\",\"args\":{\"frames\":%u}}", pFrame->nDroppedFrames);
+	}
+
+	for (uint32_t i = 0; i < pFrame->nNumCounters; ++i)
+	{
+		// Only leaves hold values, group counters are just path components
+		if (!(S.CounterInfo[i].nFlags & PROFILE_COUNTER_FLAG_LEAF))
+			continue;
+		if (i < pTrace->nNumCounters && pTrace->Counters[i] == pFrame->pCounters[i])
+			continue;
+		pTrace->Counters[i] = pFrame->pCounters[i];
+
+		int nPath[PROFILE_STACK_MAX];
+		uint32_t nPathLen = 0;
+		for (int nCounter = (int)i; nCounter >= 0 && nPathLen < PROFILE_STACK_MAX; nCounter = S.CounterInfo[nCounter].nParent)
+			nPath[nPathLen++] = nCounter;
+		char name[PROFILE_LABEL_MAX_LEN];
+		uint32_t nNamePut = 0;
+		while (nPathLen-- > 0 && nNamePut < sizeof(name) - 1)
+			nNamePut += snprintf(&name[nNamePut], sizeof(name) - nNamePut, nNamePut ? "/%s" : "%s", S.CounterInfo[nPath[nPathLen]].pName);
+
+		ProfileTraceBeginEvent(pTrace, "C", 0, fFrameStartUs);
+		ProfileTracePrintf(pTrace, ",\"name\":");
+		ProfileTraceWriteString(pTrace, name);
+		ProfileTracePrintf(pTrace, ",\"args\":{\"value\":%lld}}", (long long)pFrame->pCounters[i]);
+	}
+	pTrace->nNumCounters = ProfileMax(pTrace->nNumCounters, pFrame->nNumCounters);
+
+	for (uint32_t i = 0; i < pFrame->nNumThreads; ++i)
+	{
+		ProfileTraceThread* pThread = &pFrame->pThreads[i];
+		// tid 0 is reserved for the frame and counter tracks
+		const uint32_t nTid = pThread->nLogIndex + 1;
+		const double fTickToUs = pThread->nTicksPerSecond ? 1000000.0 / (double)pThread->nTicksPerSecond : 0.0;
+
+		if (strcmp(pTrace->ThreadNames[pThread->nLogIndex], pThread->ThreadName) != 0)
+		{
+			// New thread or a log that got reused by another thread
+			strcpy(pTrace->ThreadNames[pThread->nLogIndex], pThread->ThreadName);
+			pTrace->nStackDepth[pThread->nLogIndex] = 0;
+			char name[ProfileThreadLog::THREAD_MAX_LEN + 8];
+			snprintf(name, sizeof(name), "%s%s", pThread->nGpu ? "GPU " : "", pThread->ThreadName);
+			ProfileTraceBeginEvent(pTrace, "M", nTid, 0.0);
+			ProfileTracePrintf(pTrace, ",\"name\":\"thread_name\",\"args\":{\"name\":");
+			ProfileTraceWriteString(pTrace, name);
+			ProfileTraceWrite(pTrace, "}}", 2);
+		}
+
+		uint32_t& nDepth = pTrace->nStackDepth[pThread->nLogIndex];
+		double fTimeUs = fFrameStartUs;
+		ProfileLogEntry* pEntries = &pFrame->pEntries[pThread->nFirstEntry];
+		for (uint32_t k = 0; k < pThread->nNumEntries; ++k)
+		{
+			ProfileLogEntry e = pEntries[k];
+			uint32_t nLogType = (uint32_t)ProfileLogType(e);
+			if (nLogType == P_LOG_ENTER || nLogType == P_LOG_LEAVE)
+			{
+				fTimeUs = fFrameStartUs + (double)ProfileLogTickDifference(pThread->nTickStart, e) * fTickToUs;
+				pTrace->fLastTimeUs = ProfileMax(pTrace->fLastTimeUs, fTimeUs);
+			}
+
+			if (nLogType == P_LOG_ENTER)
+			{
+				uint32_t nTimerIndex = (uint32_t)ProfileLogTimerIndex(e);
+				ProfileTimerInfo& TI = S.TimerInfo[nTimerIndex];
+				ProfileTraceBeginEvent(pTrace, "B", nTid, fTimeUs);
+				ProfileTracePrintf(pTrace, ",\"name\":");
+				ProfileTraceWriteString(pTrace, TI.pName);
+				ProfileTracePrintf(pTrace, ",\"cat\":");
+				ProfileTraceWriteString(pTrace, S.GroupInfo[TI.nGroupIndex].pName);
+				ProfileTraceWrite(pTrace, "}", 1);
+				++nDepth;
+			}
+			else if (nLogType == P_LOG_LEAVE)
+			{
+				// Scopes opened before the capture started are not closed either
+				if (nDepth)
+				{
+					ProfileTraceBeginEvent(pTrace, "E", nTid, fTimeUs);
+					ProfileTraceWrite(pTrace, "}", 1);
+					--nDepth;
+				}
+			}
+			else if (nLogType == P_LOG_LABEL || nLogType == P_LOG_LABEL_LITERAL)
+			{
+				ProfileTraceBeginEvent(pTrace, "i", nTid, fTimeUs);
+				ProfileTracePrintf(pTrace, ",\"s\":\"t\",\"name\":");
+				ProfileTraceWriteString(pTrace, &pFrame->pLabels[ProfileLogGetTick(e)]);
+				ProfileTraceWrite(pTrace, "}", 1);
+			}
+		}
+	}
+}
+
+static void ProfileTraceThreadFunc(void* pData)
+{
+	ProfileTraceState* pTrace = (ProfileTraceState*)pData;
+	Thread::SetCurrentThreadName("ProfileTrace");
+
+	ProfileTracePrintf(pTrace, "[\n");
+	ProfileTraceBeginEvent(pTrace, "M", 0, 0.0);
+	ProfileTracePrintf(pTrace, ",\"name\":\"thread_name\",\"args\":{\"name\":\"Frames\"}}");
+
+	for (;;)
+	{
+		ProfileTraceFrame* pFrames = NULL;
+		bool bStop = false;
+		{
+			MutexLock lock(pTrace->mMutex);
+			while (!pTrace->pHead && !pTrace->bStop)
+				pTrace->mCond.Wait(pTrace->mMutex);
+			pFrames = pTrace->pHead;
+			pTrace->pHead = pTrace->pTail = NULL;
+			bStop = pTrace->bStop;
+		}
+
+		while (pFrames)
+		{
+			ProfileTraceFrame* pNext = pFrames->pNext;
+			ProfileTraceWriteFrame(pTrace, pFrames);
+			{
+				MutexLock lock(pTrace->mMutex);
+				pTrace->nPendingBytes -= pFrames->nSize;
+			}
+			conf_free(pFrames);
+			pFrames = pNext;
+		}
+		ProfileTraceFlush(pTrace);
+		fsFlushStream(pTrace->pFile);
+
+		if (bStop)
+			break;
+	}
+
+	// Close scopes that are still open so viewers don't extend them to the end of the trace
+	for (uint32_t i = 0; i < PROFILE_MAX_THREADS; ++i)
+	{
+		for (; pTrace->nStackDepth[i]; --pTrace->nStackDepth[i])
+		{
+			ProfileTraceBeginEvent(pTrace, "E", i + 1, pTrace->fLastTimeUs);
+			ProfileTraceWrite(pTrace, "}", 1);
+		}
+	}
+	ProfileTracePrintf(pTrace, "\n]\n");
+	ProfileTraceFlush(pTrace);
+}
+
+bool ProfileTraceStart(const Path* pPath)
+{
+	MutexLock lock(ProfileMutex());
+	Profile & S = g_Profile;
+
+	if (g_pProfileTrace)
+	{
+		LOGF(LogLevel::eWARNING, "Profile trace capture is already running");
+		return false;
+	}
+
+	FileStream* pFile = fsOpenFile(pPath, FM_WRITE);
+	if (!pFile)
+	{
+		LOGF(LogLevel::eERROR, "Failed to open profile trace file %s", fsGetPathAsNativeString(pPath));
+		return false;
+	}
+
+	ProfileTraceState* pTrace = conf_new(ProfileTraceState);
+	pTrace->pFile = pFile;
+	pTrace->pWriteBuffer = (char*)conf_malloc(PROFILE_TRACE_WRITE_BUFFER_SIZE);
+	pTrace->nProcessId = (uint32_t)P_GETCURRENTPROCESSID();
+	pTrace->nTickStart = P_TICK();
+	pTrace->mMutex.Init();
+	pTrace->mCond.Init();
+
+	// Frames only advance while running or force enabled, and only active groups record anything
+	pTrace->nForceEnable = S.nForceEnable;
+	pTrace->nAllGroupsWanted = S.nAllGroupsWanted;
+	S.nForceEnable = 1;
+	S.nAllGroupsWanted = 1;
+
+	pTrace->mThreadDesc.pFunc = ProfileTraceThreadFunc;
+	pTrace->mThreadDesc.pData = pTrace;
+	pTrace->mThread = create_thread(&pTrace->mThreadDesc);
+
+	g_pProfileTrace = pTrace;
+	return true;
+}
+
+void ProfileTraceStop()
+{
+	ProfileTraceState* pTrace = NULL;
+	{
+		MutexLock lock(ProfileMutex());
+		Profile & S = g_Profile;
+		pTrace = g_pProfileTrace;
+		if (!pTrace)
+			return;
+		g_pProfileTrace = NULL;
+		S.nForceEnable = pTrace->nForceEnable;
+		S.nAllGroupsWanted = pTrace->nAllGroupsWanted;
+	}
+
+	{
+		MutexLock lock(pTrace->mMutex);
+		pTrace->bStop = true;
+		pTrace->mCond.WakeAll();
+	}
+	join_thread(pTrace->mThread);
+	destroy_thread(pTrace->mThread);
+
+	fsCloseStream(pTrace->pFile);
+	conf_free(pTrace->pWriteBuffer);
+	pTrace->mCond.Destroy();
+	pTrace->mMutex.Destroy();
+	conf_delete(pTrace);
+}
+
+bool ProfileTraceIsRunning()
+{
+	MutexLock lock(ProfileMutex());
+	return g_pProfileTrace != NULL;
+}
+
+// Called from the flip with ProfileMutex held, once the frame's gpu timers have been resolved
+static void ProfileTraceFlip(uint32_t nFrame, uint32_t nFrameNext)
+{
+	Profile & S = g_Profile;
+	ProfileTraceState* pTrace = g_pProfileTrace;
+	// Frames recorded before the capture started would end up with negative timestamps
+	if (!pTrace || S.Frames[nFrame].nFrameStartCpu < pTrace->nTickStart)
+		return;
+
+	ProfileTraceFrame* pFrame = ProfileTraceCaptureFrame(pTrace, nFrame, nFrameNext);
+	if (!pFrame)
+		return;
+
+	MutexLock lock(pTrace->mMutex);
+	pFrame->nDroppedFrames = pTrace->nDroppedFrames;
+	if (pTrace->pTail)
+		pTrace->pTail->pNext = pFrame;
+	else
+		pTrace->pHead = pFrame;
+	pTrace->pTail = pFrame;
+	pTrace->mCond.WakeOne();
+}
+
+void beginProfileTraceCapture(const char* appName)
+{
+	time_t t = time(0);
+	eastl::string tempName = eastl::string().sprintf("%s", appName) + eastl::string(R"(Trace-%Y-%m-%d-%H.%M.%S.json)");
+	char name[128] = {};
+	strftime(name, sizeof(name), tempName.c_str(), localtime(&t));
+	PathHandle tracePath = fsAppendPathComponent(PathHandle(fsCopyLogFileDirectoryPath()), name);
+	ProfileTraceStart(tracePath);
+}
+
+void endProfileTraceCapture()
+{
+	ProfileTraceStop();
+}
+
+bool isProfileTraceCaptureRunning()
+{
+	return ProfileTraceIsRunning();
+}
+
 #if PROFILE_WEBSERVER
 uint32_t ProfileWebServerPort()
 {
@@ -120,6 +120,9 @@
 #define ProfileContextSwitchTraceStop() do{} while(0)
 #define ProfileDumpFile(path,type,frames) do{} while(0)
 #define ProfileDumpHtml(cb,handle,frames,host) do{} while(0)
+#define ProfileTraceStart(path) false
+#define ProfileTraceStop() do{} while(0)
+#define ProfileTraceIsRunning() false
 #define ProfileWebServerStart() do{} while(0)
 #define ProfileWebServerStop() do{} while(0)
 #define ProfileWebServerPort() 0
@@ -308,6 +311,14 @@ typedef uint16_t ProfileGroupId;
 #define PROFILE_EMBED_HTML 1
 #endif
 
+#ifndef PROFILE_TRACE_MAX_PENDING_BYTES
+#define PROFILE_TRACE_MAX_PENDING_BYTES (32<<20)
+#endif
+
+#ifndef PROFILE_TRACE_WRITE_BUFFER_SIZE
+#define PROFILE_TRACE_WRITE_BUFFER_SIZE (64<<10)
+#endif
+
 #ifndef PROFILE_GPU_TIMERS_MULTITHREADED
 #define PROFILE_GPU_TIMERS_MULTITHREADED 0
 #endif
@@ -402,6 +413,11 @@ PROFILE_API const char* ProfileGetProcessName(ProfileProcessIdType nId, char* Bu
 
 PROFILE_API void ProfileDumpFile(const Path* pPath, ProfileDumpType eType, uint32_t nFrames);
 
+// Streams every flipped frame to pPath as Chrome trace event JSON until ProfileTraceStop
+PROFILE_API bool ProfileTraceStart(const Path* pPath);
+PROFILE_API void ProfileTraceStop();
+PROFILE_API bool ProfileTraceIsRunning();
+
 typedef void ProfileWriteCallback(void* Handle, size_t size, const char* pData);
 PROFILE_API void ProfileDumpHtml(ProfileWriteCallback CB, void* Handle, int nMaxFrames, const char* pHost);
 
@@ -255,6 +255,7 @@ ProfileReferenceTimes gReferenceTime = PROFILE_REFTIME_MS_15;
 ProfileDumpFramesFile gDumpFramesToFile = PROFILE_DUMPFILE_NUM_32;
 ProfileDumpFramesDetailedMode gDumpFramesDetailedMode = PROFILE_DUMPFRAME_NUM_4;
 bool gProfilerPaused = false;
+bool gCaptureTrace = false;
 float gMinPlotReferenceTime = 0.f;
 float gFrameTime = 0.f;
 float gFrameTimeData[FRAME_HISTORY_LEN] = { 0.f };
@@ -425,6 +426,16 @@ void profileCallbkDumpFramesToFile()
     dumpProfileData(pAppUIRef->pImpl->pRenderer->pName, profileUtilDumpFramesFromFileEnum(gDumpFramesToFile));
 }
 
+void profileCallbkCaptureTrace()
+{
+    ASSERT(pAppUIRef);
+    if (gCaptureTrace)
+        beginProfileTraceCapture(pAppUIRef->pImpl->pRenderer->pName);
+    else
+        endProfileTraceCapture();
+    gCaptureTrace = isProfileTraceCaptureRunning();
+}
+
 void profileCallbkDumpFrames()
 {
   // Dump fresh frames to detailed mode and clear any old data.
@@ -1291,6 +1302,9 @@ void loadProfilerUI(UIApp* uiApp, int32_t width, int32_t height)
   ButtonWidget dumpButtonWidget("Dump Profile");
   dumpButtonWidget.pOnDeactivatedAfterEdit = profileCallbkDumpFramesToFile;
   pMenuGuiComponent->AddWidget(dumpButtonWidget);
+  CheckboxWidget captureTraceWidget("Capture Trace", &gCaptureTrace);
+  captureTraceWidget.pOnEdited = profileCallbkCaptureTrace;
+  pMenuGuiComponent->AddWidget(captureTraceWidget);
   pMenuGuiComponent->AddWidget(SeparatorWidget());
   pMenuGuiComponent->AddWidget(SliderFloatWidget("Transparency", &gGuiTransparency, 0.0f, 0.9f, 0.01f, "%.2f"));
 }
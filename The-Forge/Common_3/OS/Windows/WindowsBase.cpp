@@ -41,6 +41,7 @@
 #include "../Interfaces/ILog.h"
 #include "../Interfaces/ITime.h"
 #include "../Interfaces/IThread.h"
+#include "../Interfaces/IBenchmark.h"
 #include "../Interfaces/IApp.h"
 #include "../Interfaces/IFileSystem.h"
 #include "../Interfaces/IMemory.h"
@@ -593,6 +594,16 @@ int WindowsMain(int argc, char** argv, IApp* app)
 
 	pApp = app;
 
+	BenchmarkDesc benchmarkDesc = {};
+	const bool    benchmark = parseBenchmarkArgs(argc, (const char**)argv, &benchmarkDesc);
+	if (benchmark && !initBenchmark(pApp->GetName(), &benchmarkDesc))
+	{
+		Log::Exit();
+		fsDeinitAPI();
+		MemAllocExit();
+		return EXIT_FAILURE;
+	}
+
 	wnd.Init();
 
 	//Used for automated testing, if enabled app will exit after 120 frames
@@ -657,9 +668,15 @@ int WindowsMain(int argc, char** argv, IApp* app)
 			continue;
 		}
 
+		if (benchmark)
+			deltaTime = beginBenchmarkFrame(deltaTime);
+
 		pApp->Update(deltaTime);
 		pApp->Draw();
 
+		if (benchmark && !endBenchmarkFrame())
+			quit = true;
+
 #ifdef AUTOMATED_TESTING
 		//used in automated tests only.
 		testingFrameCount++;
@@ -668,6 +685,9 @@ int WindowsMain(int argc, char** argv, IApp* app)
 #endif
 	}
 
+	if (benchmark)
+		exitBenchmark();
+
 	pApp->Unload();
 	pApp->Exit();
 
@@ -203,7 +203,11 @@ struct WindowsFileSystem: public FileSystem
 	void EnumerateFilesWithExtension(
 		const Path* directory, const char* extension, bool (*processFile)(const Path*, void* userData), void* userData) const override
 	{
-		if (extension[0] == '.')
+		if (!extension)
+		{
+			extension = "*";
+		}
+		else if (extension[0] == '.')
 		{
 			extension += 1;
 		}
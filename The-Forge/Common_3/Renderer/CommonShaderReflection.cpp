@@ -279,3 +279,194 @@ void destroyPipelineReflection(PipelineReflection* pReflection)
 	conf_free(pReflection->pShaderResources);
 	conf_free(pReflection->pVariables);
 }
+
+/************************************************************************/
+// Reflection Serialization
+/************************************************************************/
+#define SHADER_REFLECTION_MAGIC   0x52534654u    // 'TFSR'
+#define SHADER_REFLECTION_VERSION 1u
+
+typedef struct ShaderReflectionHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	// Struct sizes reject data written by a build with a different layout
+	uint32_t mVertexInputSize;
+	uint32_t mShaderResourceSize;
+	uint32_t mShaderVariableSize;
+	uint32_t mShaderStage;
+	uint32_t mNamePoolSize;
+	uint32_t mVertexInputsCount;
+	uint32_t mShaderResourceCount;
+	uint32_t mVariableCount;
+	uint32_t mNumThreadsPerGroup[3];
+	uint32_t mNumControlPoint;
+	uint32_t mEntryPointOffset;
+	uint32_t mPadA;
+} ShaderReflectionHeader;
+
+static inline size_t util_align_reflection_offset(size_t offset) { return (offset + 7) & ~(size_t)7; }
+
+static size_t util_reflection_data_size(const ShaderReflectionHeader* pHeader)
+{
+	size_t size = util_align_reflection_offset(sizeof(ShaderReflectionHeader) + pHeader->mNamePoolSize);
+	size += util_align_reflection_offset((size_t)pHeader->mVertexInputsCount * sizeof(VertexInput));
+	size += util_align_reflection_offset((size_t)pHeader->mShaderResourceCount * sizeof(ShaderResource));
+	size += util_align_reflection_offset((size_t)pHeader->mVariableCount * sizeof(ShaderVariable));
+	return size;
+}
+
+static bool util_name_to_offset(const char* pName, const ShaderReflection* pReflection, uint32_t* pOffset)
+{
+	if (pName < pReflection->pNamePool || pName >= pReflection->pNamePool + pReflection->mNamePoolSize)
+		return false;
+	*pOffset = (uint32_t)(pName - pReflection->pNamePool);
+	return true;
+}
+
+// Copies the array and replaces each name pointer with its offset in the name pool
+template <typename T>
+static bool util_write_reflection_array(uint8_t* pDst, const T* pSrc, uint32_t count, const ShaderReflection* pReflection)
+{
+	T* pItems = (T*)pDst;
+	if (count)
+		memcpy(pItems, pSrc, count * sizeof(T));
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		uint32_t offset = 0;
+		if (!util_name_to_offset(pSrc[i].name, pReflection, &offset))
+			return false;
+		pItems[i].name = (const char*)(uintptr_t)offset;
+	}
+	return true;
+}
+
+template <typename T>
+static bool util_read_reflection_array(const uint8_t* pSrc, uint32_t count, char* pNamePool, uint32_t namePoolSize, T** ppOut)
+{
+	*ppOut = NULL;
+	if (!count)
+		return true;
+
+	T* pItems = (T*)conf_malloc(count * sizeof(T));
+	memcpy(pItems, pSrc, count * sizeof(T));
+	*ppOut = pItems;
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const uintptr_t offset = (uintptr_t)pItems[i].name;
+		if (offset >= namePoolSize)
+			return false;
+		pItems[i].name = pNamePool + offset;
+	}
+	return true;
+}
+
+void serializeShaderReflection(const ShaderReflection* pReflection, size_t* pSize, void* pData)
+{
+	ASSERT(pReflection);
+	ASSERT(pSize);
+
+	ShaderReflectionHeader header = {};
+	header.mMagic = SHADER_REFLECTION_MAGIC;
+	header.mVersion = SHADER_REFLECTION_VERSION;
+	header.mVertexInputSize = sizeof(VertexInput);
+	header.mShaderResourceSize = sizeof(ShaderResource);
+	header.mShaderVariableSize = sizeof(ShaderVariable);
+	header.mShaderStage = (uint32_t)pReflection->mShaderStage;
+	header.mNamePoolSize = pReflection->mNamePoolSize;
+	header.mVertexInputsCount = pReflection->mVertexInputsCount;
+	header.mShaderResourceCount = pReflection->mShaderResourceCount;
+	header.mVariableCount = pReflection->mVariableCount;
+	memcpy(header.mNumThreadsPerGroup, pReflection->mNumThreadsPerGroup, sizeof(header.mNumThreadsPerGroup));
+	header.mNumControlPoint = pReflection->mNumControlPoint;
+	header.mEntryPointOffset = ~0u;
+#if defined(VULKAN)
+	if (pReflection->pEntryPoint && !util_name_to_offset(pReflection->pEntryPoint, pReflection, &header.mEntryPointOffset))
+	{
+		*pSize = 0;
+		return;
+	}
+#endif
+
+	*pSize = util_reflection_data_size(&header);
+	if (!pData)
+		return;
+
+	uint8_t* pDst = (uint8_t*)pData;
+	memset(pDst, 0, *pSize);
+	memcpy(pDst, &header, sizeof(header));
+	if (header.mNamePoolSize)
+		memcpy(pDst + sizeof(header), pReflection->pNamePool, header.mNamePoolSize);
+	pDst += util_align_reflection_offset(sizeof(header) + header.mNamePoolSize);
+
+	bool valid = util_write_reflection_array(pDst, pReflection->pVertexInputs, header.mVertexInputsCount, pReflection);
+	pDst += util_align_reflection_offset((size_t)header.mVertexInputsCount * sizeof(VertexInput));
+	valid = valid && util_write_reflection_array(pDst, pReflection->pShaderResources, header.mShaderResourceCount, pReflection);
+	pDst += util_align_reflection_offset((size_t)header.mShaderResourceCount * sizeof(ShaderResource));
+	valid = valid && util_write_reflection_array(pDst, pReflection->pVariables, header.mVariableCount, pReflection);
+
+	// Names outside the pool cannot be relocated so there is nothing worth caching
+	if (!valid)
+	{
+		LOGF(LogLevel::eWARNING, "Shader reflection has names outside of its name pool and cannot be serialized");
+		*pSize = 0;
+	}
+}
+
+bool deserializeShaderReflection(const void* pData, size_t size, ShaderStage shaderStage, ShaderReflection* pOutReflection)
+{
+	ASSERT(pOutReflection);
+
+	if (!pData || size < sizeof(ShaderReflectionHeader))
+		return false;
+
+	ShaderReflectionHeader header;
+	memcpy(&header, pData, sizeof(header));
+	if (header.mMagic != SHADER_REFLECTION_MAGIC || header.mVersion != SHADER_REFLECTION_VERSION ||
+		header.mVertexInputSize != sizeof(VertexInput) || header.mShaderResourceSize != sizeof(ShaderResource) ||
+		header.mShaderVariableSize != sizeof(ShaderVariable) || header.mShaderStage != (uint32_t)shaderStage ||
+		util_reflection_data_size(&header) != size)
+	{
+		return false;
+	}
+
+	ShaderReflection reflection = {};
+	reflection.mShaderStage = shaderStage;
+	reflection.mNamePoolSize = header.mNamePoolSize;
+	reflection.mVertexInputsCount = header.mVertexInputsCount;
+	reflection.mShaderResourceCount = header.mShaderResourceCount;
+	reflection.mVariableCount = header.mVariableCount;
+	memcpy(reflection.mNumThreadsPerGroup, header.mNumThreadsPerGroup, sizeof(header.mNumThreadsPerGroup));
+	reflection.mNumControlPoint = header.mNumControlPoint;
+
+	const uint8_t* pSrc = (const uint8_t*)pData + sizeof(header);
+	if (header.mNamePoolSize)
+	{
+		reflection.pNamePool = (char*)conf_malloc(header.mNamePoolSize);
+		memcpy(reflection.pNamePool, pSrc, header.mNamePoolSize);
+	}
+	pSrc = (const uint8_t*)pData + util_align_reflection_offset(sizeof(header) + header.mNamePoolSize);
+
+	bool valid = util_read_reflection_array(pSrc, header.mVertexInputsCount, reflection.pNamePool, header.mNamePoolSize, &reflection.pVertexInputs);
+	pSrc += util_align_reflection_offset((size_t)header.mVertexInputsCount * sizeof(VertexInput));
+	valid = valid && util_read_reflection_array(pSrc, header.mShaderResourceCount, reflection.pNamePool, header.mNamePoolSize, &reflection.pShaderResources);
+	pSrc += util_align_reflection_offset((size_t)header.mShaderResourceCount * sizeof(ShaderResource));
+	valid = valid && util_read_reflection_array(pSrc, header.mVariableCount, reflection.pNamePool, header.mNamePoolSize, &reflection.pVariables);
+
+#if defined(VULKAN)
+	if (header.mEntryPointOffset != ~0u)
+	{
+		valid = valid && header.mEntryPointOffset < header.mNamePoolSize;
+		reflection.pEntryPoint = valid ? reflection.pNamePool + header.mEntryPointOffset : NULL;
+	}
+#endif
+
+	if (!valid)
+	{
+		destroyShaderReflection(&reflection);
+		return false;
+	}
+
+	*pOutReflection = reflection;
+	return true;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+// Descriptor name lookup shared by the renderer backends.
+// Root signatures store pre-hashed descriptor names in a flat open-addressed table placed inline after the
+// descriptor array, so updateDescriptorSet and cmdBindPushConstants resolve names without hashing strings.
+
+#include "../ThirdParty/OpenSource/EASTL/string_hash_map.h"
+#include "IRenderer.h"
+
+typedef eastl::string_hash_map<uint32_t> DescriptorNameToIndexMap;
+
+typedef struct DescriptorIndexMap
+{
+	/// Copies of the names so a hash match is only accepted for the same name
+	const char** ppNames;
+	uint32_t*    pHashes;
+	/// (uint32_t)-1 marks an empty slot
+	uint32_t*    pIndices;
+	uint32_t     mMask;
+} DescriptorIndexMap;
+
+static inline uint32_t descriptor_index_map_capacity(uint32_t count)
+{
+	// Load factor of at most 0.5 keeps probe sequences short and guarantees an empty slot to terminate lookups
+	uint32_t capacity = 1;
+	while (capacity < count * 2)
+		capacity <<= 1;
+	return capacity;
+}
+
+/// Size of the DescriptorIndexMap and its table storage which directly follows it in memory
+static inline size_t descriptor_index_map_size(const DescriptorNameToIndexMap& names)
+{
+	const size_t capacity = descriptor_index_map_capacity((uint32_t)names.size());
+	size_t       size = sizeof(DescriptorIndexMap) + capacity * (2 * sizeof(uint32_t) + sizeof(const char*));
+	for (const auto& it : names)
+		size += strlen(it.first) + 1;
+	return size;
+}
+
+/// Builds the table from the name to descriptor index map gathered in addRootSignature
+/// pMap must point to descriptor_index_map_size(names) bytes of zeroed memory
+static inline void init_descriptor_index_map(DescriptorIndexMap* pMap, const DescriptorNameToIndexMap& names)
+{
+	const uint32_t capacity = descriptor_index_map_capacity((uint32_t)names.size());
+	uint8_t*       pMem = (uint8_t*)(pMap + 1);
+	pMap->ppNames = (const char**)pMem;
+	pMem += capacity * sizeof(const char*);
+	pMap->pHashes = (uint32_t*)pMem;
+	pMap->pIndices = pMap->pHashes + capacity;
+	pMap->mMask = capacity - 1;
+	memset(pMap->pIndices, 0xFF, capacity * sizeof(uint32_t));
+	char* pNameData = (char*)(pMap->pIndices + capacity);
+
+	for (const auto& it : names)
+	{
+		const uint32_t hash = descriptor_name_hash(it.first);
+		uint32_t       slot = hash & pMap->mMask;
+		// Names with the same hash end up in later slots of the same probe sequence and are told apart by name
+		while (pMap->pIndices[slot] != (uint32_t)-1)
+			slot = (slot + 1) & pMap->mMask;
+
+		pMap->pHashes[slot] = hash;
+		pMap->pIndices[slot] = it.second;
+		const size_t nameSize = strlen(it.first) + 1;
+		memcpy(pNameData, it.first, nameSize);
+		pMap->ppNames[slot] = pNameData;
+		pNameData += nameSize;
+	}
+}
+
+/// Returns the index in RootSignature::pDescriptors for name or (uint32_t)-1 if there is no such descriptor
+static inline uint32_t find_descriptor_index(const DescriptorIndexMap* pMap, const DescriptorName& name)
+{
+	uint32_t slot = name.mHash & pMap->mMask;
+	for (;;)
+	{
+		const uint32_t index = pMap->pIndices[slot];
+		if (index == (uint32_t)-1)
+			return index;
+
+		// The hash only narrows the search, a name missing from the root signature may share it
+		if (pMap->pHashes[slot] == name.mHash && name.pName && strcmp(pMap->ppNames[slot], name.pName) == 0)
+			return index;
+
+		slot = (slot + 1) & pMap->mMask;
+	}
+}
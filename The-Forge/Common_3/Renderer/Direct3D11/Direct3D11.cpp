@@ -37,6 +37,7 @@
 #include "../../ThirdParty/OpenSource/EASTL/string_hash_map.h"
 #include "../../OS/Interfaces/ILog.h"
 #include "../IRenderer.h"
+#include "../DescriptorIndexMap.h"
 #include "../../OS/Core/RingBuffer.h"
 #include "../../ThirdParty/OpenSource/EASTL/functional.h"
 #include "../../ThirdParty/OpenSource/winpixeventruntime/Include/WinPixEventRuntime/pix3.h"
@@ -377,10 +378,6 @@ static const uint32_t gRootDescriptorDWORDS = 2;
 
 static uint32_t gMaxRootConstantsPerRootParam = 4U;
 
-typedef struct DescriptorIndexMap
-{
-	eastl::string_hash_map<uint32_t> mMap;
-} DescriptorIndexMap;
 /************************************************************************/
 // Logging functions
 /************************************************************************/
@@ -1810,9 +1807,14 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 				break;
 			}
 
-			d3d11_createShaderReflection(
-				(uint8_t*)(pStage->pByteCode), (uint32_t)pStage->mByteCodeSize, stage_mask,
-				&pShaderProgram->pReflection->mStageReflections[reflectionCount]);
+			if (!deserializeShaderReflection(
+					pStage->pReflection, pStage->mReflectionSize, stage_mask,
+					&pShaderProgram->pReflection->mStageReflections[reflectionCount]))
+			{
+				d3d11_createShaderReflection(
+					(uint8_t*)(pStage->pByteCode), (uint32_t)pStage->mByteCodeSize, stage_mask,
+					&pShaderProgram->pReflection->mStageReflections[reflectionCount]);
+			}
 
 			reflectionCount++;
 		}
@@ -2431,7 +2433,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	eastl::vector<eastl::pair<DescriptorInfo*, Sampler*> >   staticSamplers;
 	ShaderStage                                              shaderStages = SHADER_STAGE_NONE;
 	bool                                                     useInputLayout = false;
-	DescriptorIndexMap                                       indexMap;
+	DescriptorNameToIndexMap                                 indexMap;
 	PipelineType                                             pipelineType = PIPELINE_TYPE_UNDEFINED;
 
 	eastl::unordered_map<eastl::string, Sampler*> staticSamplerMap;
@@ -2470,11 +2472,11 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 				setIndex = 0;
 
 			// Find all unique resources
-			decltype(indexMap.mMap)::iterator pNode =
-				indexMap.mMap.find(pRes->name);
-			if (pNode == indexMap.mMap.end())
+			decltype(indexMap)::iterator pNode =
+				indexMap.find(pRes->name);
+			if (pNode == indexMap.end())
 			{
-				indexMap.mMap.insert(pRes->name, (uint32_t)shaderResources.size());
+				indexMap.insert(pRes->name, (uint32_t)shaderResources.size());
 				shaderResources.push_back(*pRes);
 
 				uint32_t constantSize = 0;
@@ -2530,7 +2532,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 
 	size_t totalSize = sizeof(RootSignature);
 	totalSize += shaderResources.size() * sizeof(DescriptorInfo);
-	totalSize += sizeof(DescriptorIndexMap);
+	totalSize += descriptor_index_map_size(indexMap);
 
 	RootSignature* pRootSignature = (RootSignature*)conf_calloc(1, totalSize);
 	ASSERT(pRootSignature);
@@ -2543,10 +2545,9 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	pRootSignature->pDescriptors = (DescriptorInfo*)(pRootSignature + 1);
 	pRootSignature->pDescriptorNameToIndexMap = (DescriptorIndexMap*)(pRootSignature->pDescriptors + pRootSignature->mDescriptorCount);
 	ASSERT(pRootSignature->pDescriptorNameToIndexMap);
-	conf_placement_new<DescriptorIndexMap>(pRootSignature->pDescriptorNameToIndexMap);
+	init_descriptor_index_map(pRootSignature->pDescriptorNameToIndexMap, indexMap);
 
 	pRootSignature->mPipelineType = pipelineType;
-	pRootSignature->pDescriptorNameToIndexMap->mMap = indexMap.mMap;
 
 	uint32_t srvCount = 0;
 	uint32_t uavCount = 0;
@@ -2654,8 +2655,6 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 
 void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
 {
-	pRootSignature->pDescriptorNameToIndexMap->mMap.clear(true);
-
 	SAFE_FREE(pRootSignature->ppStaticSamplers);
 	SAFE_FREE(pRootSignature->pStaticSamplerStages);
 	SAFE_FREE(pRootSignature->pStaticSamplerSlots);
@@ -2874,19 +2873,47 @@ void removePipeline(Renderer* pRenderer, Pipeline* pPipeline)
 	SAFE_FREE(pPipeline);
 }
 /************************************************************************/
+// Pipeline Cache Functions
+/************************************************************************/
+// D3D11 drivers cache compiled shaders on their own, the cache object only exists for API parity
+void addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipelineCache);
+
+	PipelineCache* pPipelineCache = (PipelineCache*)conf_calloc(1, sizeof(PipelineCache));
+	ASSERT(pPipelineCache);
+
+	*ppPipelineCache = pPipelineCache;
+}
+
+void removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+
+	SAFE_FREE(pPipelineCache);
+}
+
+void getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData)
+{
+	ASSERT(pSize);
+	*pSize = 0;
+}
+/************************************************************************/
 // Descriptor Set Implementation
 /************************************************************************/
-const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const char* pResName)
+const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const DescriptorName& name)
 {
-	using DescriptorNameToIndexMap = eastl::string_hash_map<uint32_t>;
-	DescriptorNameToIndexMap::const_iterator it = pRootSignature->pDescriptorNameToIndexMap->mMap.find(pResName);
-	if (it != pRootSignature->pDescriptorNameToIndexMap->mMap.end())
+	const uint32_t index = find_descriptor_index(pRootSignature->pDescriptorNameToIndexMap, name);
+	if (index != (uint32_t)-1)
 	{
-		return &pRootSignature->pDescriptors[it->second];
+		return &pRootSignature->pDescriptors[index];
 	}
 	else
 	{
-		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", pResName);
+		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", name.pName);
 		return NULL;
 	}
 }
@@ -3387,10 +3414,10 @@ void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorS
 	cachedCmdsIter->second.push_back(cmd);
 }
 
-void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char* pName, const void* pConstants)
+void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, DescriptorName name, const void* pConstants)
 {
 	ASSERT(pCmd);
-	ASSERT(pName);
+	ASSERT(name.pName);
 	ASSERT(pConstants);
 	ASSERT(pRootSignature);
 
@@ -3403,7 +3430,7 @@ void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char*
 		return;
 	}
 
-	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, name);
 	ASSERT(pDesc);
 	ASSERT(DESCRIPTOR_TYPE_ROOT_CONSTANT == pDesc->mType);
 
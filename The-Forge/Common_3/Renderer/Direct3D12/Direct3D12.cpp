@@ -42,6 +42,7 @@
 #include <Windows.h>
 
 #include "../IRenderer.h"
+#include "../DescriptorIndexMap.h"
 
 #define D3D12MA_IMPLEMENTATION
 #define D3D12MA_D3D12_HEADERS_ALREADY_INCLUDED
@@ -62,6 +63,8 @@
 #include "../../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_base.h"
 #include "../../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_query.h"
 
+#include "../../ThirdParty/OpenSource/murmurhash3/MurmurHash3_32.h"
+
 #include "../../OS/Interfaces/ILog.h"
 #include "../../OS/Core/RingBuffer.h"
 #include "../../OS/Core/GPUConfig.h"
@@ -87,6 +90,10 @@
 #define D3D12_GPU_VIRTUAL_ADDRESS_UNKNOWN ((D3D12_GPU_VIRTUAL_ADDRESS)-1)
 
 extern void d3d12_createShaderReflection(const uint8_t* shaderCode, uint32_t shaderSize, ShaderStage shaderStage, ShaderReflection* pOutReflection);
+// Virtual texture pages are streamed from disk by the resource loader
+extern bool requestVirtualTexturePage(void* pPageCache, uint32_t pageIndex);
+extern bool readVirtualTexturePage(void* pPageCache, uint32_t pageIndex, void* pDst, uint64_t size, bool waitForRead);
+extern void removeVirtualTexturePageCache(void* pPageCache);
 
 //stubs for durango because Direct3D12Raytracing.cpp is not used on XBOX
 #if defined(ENABLE_RAYTRACING)
@@ -308,10 +315,6 @@ typedef struct DescriptorHeap
 	tfrg_atomic32_t                 mUsedDescriptors;
 } DescriptorHeap;
 
-typedef struct DescriptorIndexMap
-{
-	eastl::string_hash_map<uint32_t> mMap;
-} DescriptorIndexMap;
 /************************************************************************/
 // Static Descriptor Heap Implementation
 /************************************************************************/
@@ -565,18 +568,16 @@ constexpr D3D12_RASTERIZER_DESC util_to_rasterizer_desc(const RasterizerStateDes
 }
 /************************************************************************/
 /************************************************************************/
-using DescriptorNameToIndexMap = eastl::string_hash_map<uint32_t>;
-
-const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const char* pResName)
+const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const DescriptorName& name)
 {
-	DescriptorNameToIndexMap::const_iterator it = pRootSignature->pDescriptorNameToIndexMap->mMap.find(pResName);
-	if (it != pRootSignature->pDescriptorNameToIndexMap->mMap.end())
+	const uint32_t index = find_descriptor_index(pRootSignature->pDescriptorNameToIndexMap, name);
+	if (index != (uint32_t)-1)
 	{
-		return &pRootSignature->pDescriptors[it->second];
+		return &pRootSignature->pDescriptors[index];
 	}
 	else
 	{
-		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", pResName);
+		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", name.pName);
 		return NULL;
 	}
 }
@@ -1954,6 +1955,9 @@ void initRenderer(const char* appName, const RendererDesc* pDesc, Renderer** ppR
 		pRenderer->pBuiltinShaderDefines[i] = rendererShaderDefines[i];
 	}
 
+	PipelineCacheDesc pipelineCacheDesc = {};
+	addPipelineCache(pRenderer, pDesc->pPipelineCacheDesc ? pDesc->pPipelineCacheDesc : &pipelineCacheDesc, &pRenderer->pPipelineCache);
+
 	// Renderer is good!
 	*ppRenderer = pRenderer;
 }
@@ -1966,6 +1970,8 @@ void removeRenderer(Renderer* pRenderer)
 		pRenderer->pBuiltinShaderDefines[i].~ShaderMacro();
 	SAFE_FREE(pRenderer->pBuiltinShaderDefines);
 
+	removePipelineCache(pRenderer, pRenderer->pPipelineCache);
+
 #ifndef _DURANGO
 	if (gDxcDllHelper.IsEnabled())
 	{
@@ -3598,10 +3604,15 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 			D3DCreateBlob(pStage->mByteCodeSize, &pShaderProgram->pShaderBlobs[reflectionCount]);
 			memcpy(pShaderProgram->pShaderBlobs[reflectionCount]->GetBufferPointer(), pStage->pByteCode, pStage->mByteCodeSize);
 
-			d3d12_createShaderReflection(
-				(uint8_t*)(pShaderProgram->pShaderBlobs[reflectionCount]->GetBufferPointer()),
-				(uint32_t)pShaderProgram->pShaderBlobs[reflectionCount]->GetBufferSize(), stage_mask,
-				&pShaderProgram->pReflection->mStageReflections[reflectionCount]);
+			if (!deserializeShaderReflection(
+					pStage->pReflection, pStage->mReflectionSize, stage_mask,
+					&pShaderProgram->pReflection->mStageReflections[reflectionCount]))
+			{
+				d3d12_createShaderReflection(
+					(uint8_t*)(pShaderProgram->pShaderBlobs[reflectionCount]->GetBufferPointer()),
+					(uint32_t)pShaderProgram->pShaderBlobs[reflectionCount]->GetBufferSize(), stage_mask,
+					&pShaderProgram->pReflection->mStageReflections[reflectionCount]);
+			}
 
 			WCHAR* entryPointName = (WCHAR*)mem;
 			mbstowcs((WCHAR*)entryPointName, pStage->pEntryPoint, strlen(pStage->pEntryPoint));
@@ -3646,7 +3657,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	bool                                                   useInputLayout = false;
 	eastl::string_hash_map<Sampler*>                       staticSamplerMap;
 	PipelineType                                           pipelineType = PIPELINE_TYPE_UNDEFINED;
-	DescriptorIndexMap                                     indexMap;
+	DescriptorNameToIndexMap                               indexMap;
 
 	for (uint32_t i = 0; i < pRootSignatureDesc->mStaticSamplerCount; ++i)
 	{
@@ -3690,9 +3701,9 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 				setIndex = 0;
 
 			// Find all unique resources
-			decltype(indexMap.mMap)::iterator it =
-				indexMap.mMap.find(pRes->name);
-			if (it == indexMap.mMap.end())
+			decltype(indexMap)::iterator it =
+				indexMap.find(pRes->name);
+			if (it == indexMap.end())
 			{
 				decltype(shaderResources)::iterator it = eastl::find(shaderResources.begin(), shaderResources.end(), *pRes,
 					[](const ShaderResource& a, const ShaderResource& b)
@@ -3702,7 +3713,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 				});
 				if (it == shaderResources.end())
 				{
-					indexMap.mMap.insert(pRes->name, (uint32_t)shaderResources.size());
+					indexMap.insert(pRes->name, (uint32_t)shaderResources.size());
 
 					shaderResources.push_back(*pRes);
 
@@ -3734,8 +3745,8 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 						return;
 					}
 
-					indexMap.mMap.insert(pRes->name,
-						indexMap.mMap[it->name]);
+					indexMap.insert(pRes->name,
+						indexMap[it->name]);
 
 					it->used_stages |= pRes->used_stages;
 				}
@@ -3779,7 +3790,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 
 	size_t totalSize = sizeof(RootSignature);
 	totalSize += shaderResources.size() * sizeof(DescriptorInfo);
-	totalSize += sizeof(DescriptorIndexMap);
+	totalSize += descriptor_index_map_size(indexMap);
 
 	RootSignature* pRootSignature = (RootSignature*)conf_calloc(1, totalSize);
 	ASSERT(pRootSignature);
@@ -3792,10 +3803,9 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	pRootSignature->pDescriptors = (DescriptorInfo*)(pRootSignature + 1);
 	pRootSignature->pDescriptorNameToIndexMap = (DescriptorIndexMap*)(pRootSignature->pDescriptors + pRootSignature->mDescriptorCount);
 	ASSERT(pRootSignature->pDescriptorNameToIndexMap);
-	conf_placement_new<DescriptorIndexMap>(pRootSignature->pDescriptorNameToIndexMap);
+	init_descriptor_index_map(pRootSignature->pDescriptorNameToIndexMap, indexMap);
 
 	pRootSignature->mPipelineType = pipelineType;
-	pRootSignature->pDescriptorNameToIndexMap->mMap = indexMap.mMap;
 
 	// Fill the descriptor array to be stored in the root signature
 	for (uint32_t i = 0; i < (uint32_t)shaderResources.size(); ++i)
@@ -4173,7 +4183,6 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 
 void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
 {
-	pRootSignature->pDescriptorNameToIndexMap->mMap.clear(true);
 	SAFE_RELEASE(pRootSignature->pDxRootSignature);
 	SAFE_RELEASE(pRootSignature->pDxSerializedRootSignatureString);
 
@@ -4323,7 +4332,7 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 		}
 		else
 		{
-			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName);
+			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName.pName);
 		}
 
 		const DescriptorType type = (DescriptorType)pDesc->mType;
@@ -4565,17 +4574,17 @@ void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorS
 	}
 }
 
-void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char* pName, const void* pConstants)
+void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, DescriptorName name, const void* pConstants)
 {
 	ASSERT(pCmd);
 	ASSERT(pConstants);
 	ASSERT(pRootSignature);
-	ASSERT(pName);
+	ASSERT(name.pName);
 	
 	// Set root signature if the current one differs from pRootSignature
 	reset_root_signature(pCmd, pRootSignature->mPipelineType, pRootSignature->pDxRootSignature);
 
-	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, name);
 	ASSERT(pDesc);
 	ASSERT(DESCRIPTOR_TYPE_ROOT_CONSTANT == pDesc->mType);
 	
@@ -4607,7 +4616,62 @@ void cmdBindPushConstantsByIndex(Cmd* pCmd, RootSignature* pRootSignature, uint3
 /************************************************************************/
 // Pipeline State Functions
 /************************************************************************/
-void addPipeline(Renderer* pRenderer, const GraphicsPipelineDesc* pDesc, Pipeline** ppPipeline)
+#ifndef _DURANGO
+// Pipelines are stored in the library under a name derived from everything that goes into the pipeline state.
+// Two chained 32 bit hashes keep collisions between the pipelines of an application unlikely
+typedef struct PipelineCacheKey
+{
+	uint32_t mHash[2];
+} PipelineCacheKey;
+
+static void util_hash_pipeline_data(PipelineCacheKey* pKey, const void* pData, size_t size)
+{
+	if (!pData || !size)
+		return;
+	MurmurHash3_x86_32(pData, (int)size, pKey->mHash[0], &pKey->mHash[0]);
+	MurmurHash3_x86_32(pData, (int)size, pKey->mHash[1] ^ 0x9747b28c, &pKey->mHash[1]);
+}
+
+static void util_hash_pipeline_bytecode(PipelineCacheKey* pKey, const D3D12_SHADER_BYTECODE* pByteCode)
+{
+	util_hash_pipeline_data(pKey, &pByteCode->BytecodeLength, sizeof(pByteCode->BytecodeLength));
+	util_hash_pipeline_data(pKey, pByteCode->pShaderBytecode, pByteCode->BytecodeLength);
+}
+
+static void util_hash_pipeline_root_signature(PipelineCacheKey* pKey, const RootSignature* pRootSignature)
+{
+	ID3DBlob* pBlob = pRootSignature->pDxSerializedRootSignatureString;
+	if (pBlob)
+		util_hash_pipeline_data(pKey, pBlob->GetBufferPointer(), pBlob->GetBufferSize());
+}
+
+// A name whose stored pipeline does not match the desc, because of a hash collision or a stale entry, can never be
+// loaded or stored again. Such pipelines move on to the next variant of the name so they are still cached
+#define PIPELINE_CACHE_NAME_VARIANTS 4
+
+static void util_pipeline_cache_name(const PipelineCacheKey* pKey, uint32_t variant, wchar_t* pName, size_t nameLength)
+{
+	if (variant)
+		swprintf(pName, nameLength, L"%08x%08x-%u", pKey->mHash[0], pKey->mHash[1], variant);
+	else
+		swprintf(pName, nameLength, L"%08x%08x", pKey->mHash[0], pKey->mHash[1]);
+}
+
+static void util_store_pipeline(ID3D12PipelineLibrary* pLibrary, const PipelineCacheKey* pKey, ID3D12PipelineState* pPipelineState)
+{
+	// StorePipeline fails with E_INVALIDARG if the name is taken. If another thread stored the same pipeline in the meantime
+	// this leaves a harmless duplicate under the next variant
+	wchar_t pipelineName[MAX_PATH] = {};
+	for (uint32_t variant = 0; variant < PIPELINE_CACHE_NAME_VARIANTS; ++variant)
+	{
+		util_pipeline_cache_name(pKey, variant, pipelineName, MAX_PATH);
+		if (SUCCEEDED(pLibrary->StorePipeline(pipelineName, pPipelineState)))
+			return;
+	}
+}
+#endif
+
+void addPipeline(Renderer* pRenderer, const GraphicsPipelineDesc* pDesc, PipelineCache* pCache, Pipeline** ppPipeline)
 {
 	ASSERT(pRenderer);
 	ASSERT(ppPipeline);
@@ -4799,9 +4863,53 @@ void addPipeline(Renderer* pRenderer, const GraphicsPipelineDesc* pDesc, Pipelin
 	// #NOTE : In non SLI mode, mNodeCount will be 0 which sets nodeMask to default value
 	pipeline_state_desc.NodeMask = util_calculate_shared_node_mask(pRenderer);
 
-	HRESULT hres = pRenderer->pDxDevice->CreateGraphicsPipelineState(
-		&pipeline_state_desc, __uuidof(pPipeline->pDxPipelineState), (void**)&(pPipeline->pDxPipelineState));
-	ASSERT(SUCCEEDED(hres));
+	HRESULT hres = E_FAIL;
+#ifndef _DURANGO
+	PipelineCacheKey key = {};
+	if (pCache && pCache->pLibrary)
+	{
+		util_hash_pipeline_bytecode(&key, &VS);
+		util_hash_pipeline_bytecode(&key, &PS);
+		util_hash_pipeline_bytecode(&key, &DS);
+		util_hash_pipeline_bytecode(&key, &HS);
+		util_hash_pipeline_bytecode(&key, &GS);
+		util_hash_pipeline_root_signature(&key, pDesc->pRootSignature);
+		for (uint32_t i = 0; i < input_elementCount; ++i)
+		{
+			const D3D12_INPUT_ELEMENT_DESC* pElement = &input_elements[i];
+			util_hash_pipeline_data(&key, pElement->SemanticName, strlen(pElement->SemanticName));
+			util_hash_pipeline_data(&key, &pElement->SemanticIndex, sizeof(D3D12_INPUT_ELEMENT_DESC) - offsetof(D3D12_INPUT_ELEMENT_DESC, SemanticIndex));
+		}
+		util_hash_pipeline_data(&key, &pipeline_state_desc.BlendState, sizeof(pipeline_state_desc.BlendState));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.RasterizerState, sizeof(pipeline_state_desc.RasterizerState));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.DepthStencilState, sizeof(pipeline_state_desc.DepthStencilState));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.PrimitiveTopologyType, sizeof(pipeline_state_desc.PrimitiveTopologyType));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.NumRenderTargets, sizeof(pipeline_state_desc.NumRenderTargets));
+		util_hash_pipeline_data(&key, pipeline_state_desc.RTVFormats, sizeof(pipeline_state_desc.RTVFormats));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.DSVFormat, sizeof(pipeline_state_desc.DSVFormat));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.SampleDesc, sizeof(pipeline_state_desc.SampleDesc));
+		util_hash_pipeline_data(&key, &pipeline_state_desc.NodeMask, sizeof(pipeline_state_desc.NodeMask));
+
+		wchar_t pipelineName[MAX_PATH] = {};
+		for (uint32_t variant = 0; FAILED(hres) && variant < PIPELINE_CACHE_NAME_VARIANTS; ++variant)
+		{
+			util_pipeline_cache_name(&key, variant, pipelineName, MAX_PATH);
+			hres = pCache->pLibrary->LoadGraphicsPipeline(pipelineName, &pipeline_state_desc, IID_ARGS(&pPipeline->pDxPipelineState));
+		}
+	}
+#endif
+
+	if (FAILED(hres))
+	{
+		hres = pRenderer->pDxDevice->CreateGraphicsPipelineState(
+			&pipeline_state_desc, __uuidof(pPipeline->pDxPipelineState), (void**)&(pPipeline->pDxPipelineState));
+		ASSERT(SUCCEEDED(hres));
+
+#ifndef _DURANGO
+		if (pCache && pCache->pLibrary)
+			util_store_pipeline(pCache->pLibrary, &key, pPipeline->pDxPipelineState);
+#endif
+	}
 
 	D3D_PRIMITIVE_TOPOLOGY topology = D3D_PRIMITIVE_TOPOLOGY_UNDEFINED;
 	switch (pDesc->mPrimitiveTopo)
@@ -4827,7 +4935,7 @@ void addPipeline(Renderer* pRenderer, const GraphicsPipelineDesc* pDesc, Pipelin
 	*ppPipeline = pPipeline;
 }
 
-void addComputePipeline(Renderer* pRenderer, const ComputePipelineDesc* pDesc, Pipeline** ppPipeline)
+void addComputePipeline(Renderer* pRenderer, const ComputePipelineDesc* pDesc, PipelineCache* pCache, Pipeline** ppPipeline)
 {
 	ASSERT(pRenderer);
 	ASSERT(ppPipeline);
@@ -4864,25 +4972,53 @@ void addComputePipeline(Renderer* pRenderer, const ComputePipelineDesc* pDesc, P
 	// #NOTE : In non SLI mode, mNodeCount will be 0 which sets nodeMask to default value
 	pipeline_state_desc.NodeMask = util_calculate_shared_node_mask(pRenderer);
 
-	HRESULT hres = pRenderer->pDxDevice->CreateComputePipelineState(
-		&pipeline_state_desc, __uuidof(pPipeline->pDxPipelineState), (void**)&(pPipeline->pDxPipelineState));
-	ASSERT(SUCCEEDED(hres));
+	HRESULT hres = E_FAIL;
+#ifndef _DURANGO
+	PipelineCacheKey key = {};
+	if (pCache && pCache->pLibrary)
+	{
+		util_hash_pipeline_bytecode(&key, &CS);
+		util_hash_pipeline_root_signature(&key, pDesc->pRootSignature);
+		util_hash_pipeline_data(&key, &pipeline_state_desc.NodeMask, sizeof(pipeline_state_desc.NodeMask));
+
+		wchar_t pipelineName[MAX_PATH] = {};
+		for (uint32_t variant = 0; FAILED(hres) && variant < PIPELINE_CACHE_NAME_VARIANTS; ++variant)
+		{
+			util_pipeline_cache_name(&key, variant, pipelineName, MAX_PATH);
+			hres = pCache->pLibrary->LoadComputePipeline(pipelineName, &pipeline_state_desc, IID_ARGS(&pPipeline->pDxPipelineState));
+		}
+	}
+#endif
+
+	if (FAILED(hres))
+	{
+		hres = pRenderer->pDxDevice->CreateComputePipelineState(
+			&pipeline_state_desc, __uuidof(pPipeline->pDxPipelineState), (void**)&(pPipeline->pDxPipelineState));
+		ASSERT(SUCCEEDED(hres));
+
+#ifndef _DURANGO
+		if (pCache && pCache->pLibrary)
+			util_store_pipeline(pCache->pLibrary, &key, pPipeline->pDxPipelineState);
+#endif
+	}
 
 	*ppPipeline = pPipeline;
 }
 
 void addPipeline(Renderer* pRenderer, const PipelineDesc* pDesc, Pipeline** ppPipeline)
 {
+	PipelineCache* pCache = pDesc->pCache ? pDesc->pCache : pRenderer->pPipelineCache;
+
 	switch (pDesc->mType)
 	{
 		case (PIPELINE_TYPE_COMPUTE):
 		{
-			addComputePipeline(pRenderer, &pDesc->mComputeDesc, ppPipeline);
+			addComputePipeline(pRenderer, &pDesc->mComputeDesc, pCache, ppPipeline);
 			break;
 		}
 		case (PIPELINE_TYPE_GRAPHICS):
 		{
-			addPipeline(pRenderer, &pDesc->mGraphicsDesc, ppPipeline);
+			addPipeline(pRenderer, &pDesc->mGraphicsDesc, pCache, ppPipeline);
 			break;
 		}
 #ifdef ENABLE_RAYTRACING
@@ -4915,6 +5051,160 @@ void removePipeline(Renderer* pRenderer, Pipeline* pPipeline)
 	SAFE_FREE(pPipeline);
 }
 /************************************************************************/
+// Pipeline Cache Functions
+/************************************************************************/
+#ifndef _DURANGO
+// Written in front of the library data so a cache from a different adapter or driver is rejected before it reaches the runtime
+typedef struct PipelineCacheHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mVendorId;
+	uint32_t mDeviceId;
+	uint32_t mSubSysId;
+	uint32_t mRevision;
+	uint64_t mDriverVersion;
+	uint64_t mDataSize;
+} PipelineCacheHeader;
+
+static const uint32_t gPipelineCacheMagic = 0x43504654;    // "TFPC"
+static const uint32_t gPipelineCacheVersion = 1;
+
+static void util_fill_pipeline_cache_header(Renderer* pRenderer, PipelineCacheHeader* pHeader)
+{
+	DECLARE_ZERO(DXGI_ADAPTER_DESC, adapterDesc);
+	pRenderer->pDxActiveGPU->GetDesc(&adapterDesc);
+
+	// User mode driver version
+	LARGE_INTEGER driverVersion = {};
+	pRenderer->pDxActiveGPU->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion);
+
+	pHeader->mMagic = gPipelineCacheMagic;
+	pHeader->mVersion = gPipelineCacheVersion;
+	pHeader->mVendorId = adapterDesc.VendorId;
+	pHeader->mDeviceId = adapterDesc.DeviceId;
+	pHeader->mSubSysId = adapterDesc.SubSysId;
+	pHeader->mRevision = adapterDesc.Revision;
+	pHeader->mDriverVersion = (uint64_t)driverVersion.QuadPart;
+}
+#endif
+
+void addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipelineCache);
+
+	PipelineCache* pPipelineCache = (PipelineCache*)conf_calloc(1, sizeof(PipelineCache));
+	ASSERT(pPipelineCache);
+
+#ifndef _DURANGO
+	ID3D12Device1* pDevice1 = NULL;
+	HRESULT        hres = pRenderer->pDxDevice->QueryInterface(IID_ARGS(&pDevice1));
+	if (FAILED(hres))
+	{
+		LOGF(LogLevel::eWARNING, "Pipeline libraries are not supported by this runtime. Pipelines will not be cached");
+		*ppPipelineCache = pPipelineCache;
+		return;
+	}
+
+	size_t dataSize = 0;
+	if (pDesc->pData && pDesc->mSize)
+	{
+		DECLARE_ZERO(PipelineCacheHeader, expected);
+		util_fill_pipeline_cache_header(pRenderer, &expected);
+
+		const PipelineCacheHeader* pHeader = (const PipelineCacheHeader*)pDesc->pData;
+		if (pDesc->mSize < sizeof(PipelineCacheHeader) || pHeader->mDataSize > pDesc->mSize - sizeof(PipelineCacheHeader) ||
+			pHeader->mMagic != expected.mMagic || pHeader->mVersion != expected.mVersion)
+		{
+			LOGF(LogLevel::eWARNING, "Pipeline cache data is invalid and will be ignored");
+		}
+		else if (
+			pHeader->mVendorId != expected.mVendorId || pHeader->mDeviceId != expected.mDeviceId ||
+			pHeader->mSubSysId != expected.mSubSysId || pHeader->mRevision != expected.mRevision ||
+			pHeader->mDriverVersion != expected.mDriverVersion)
+		{
+			LOGF(LogLevel::eINFO, "Pipeline cache was written by a different adapter or driver and will be rebuilt");
+		}
+		else if (pHeader->mDataSize)
+		{
+			dataSize = (size_t)pHeader->mDataSize;
+			pPipelineCache->pData = conf_malloc(dataSize);
+			memcpy(pPipelineCache->pData, pHeader + 1, dataSize);
+		}
+	}
+
+	hres = pDevice1->CreatePipelineLibrary(pPipelineCache->pData, dataSize, IID_ARGS(&pPipelineCache->pLibrary));
+	if (FAILED(hres) && dataSize)
+	{
+		// D3D12_ERROR_DRIVER_VERSION_MISMATCH, D3D12_ERROR_ADAPTER_NOT_FOUND or corrupt data
+		LOGF(LogLevel::eWARNING, "Runtime rejected the pipeline library data (0x%08x). Creating an empty library", hres);
+		SAFE_FREE(pPipelineCache->pData);
+		hres = pDevice1->CreatePipelineLibrary(NULL, 0, IID_ARGS(&pPipelineCache->pLibrary));
+	}
+	ASSERT(SUCCEEDED(hres));
+
+	SAFE_RELEASE(pDevice1);
+#endif
+
+	*ppPipelineCache = pPipelineCache;
+}
+
+void removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+
+#ifndef _DURANGO
+	SAFE_RELEASE(pPipelineCache->pLibrary);
+	SAFE_FREE(pPipelineCache->pData);
+#endif
+
+	SAFE_FREE(pPipelineCache);
+}
+
+void getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+	ASSERT(pSize);
+
+#ifndef _DURANGO
+	if (!pPipelineCache->pLibrary)
+	{
+		*pSize = 0;
+		return;
+	}
+
+	const size_t dataSize = pPipelineCache->pLibrary->GetSerializedSize();
+	if (!pData)
+	{
+		*pSize = sizeof(PipelineCacheHeader) + dataSize;
+		return;
+	}
+
+	if (*pSize < sizeof(PipelineCacheHeader) + dataSize)
+	{
+		LOGF(LogLevel::eERROR, "Pipeline cache data needs %llu bytes but only %llu were provided", (unsigned long long)(sizeof(PipelineCacheHeader) + dataSize), (unsigned long long)*pSize);
+		*pSize = 0;
+		return;
+	}
+
+	PipelineCacheHeader* pHeader = (PipelineCacheHeader*)pData;
+	memset(pHeader, 0, sizeof(PipelineCacheHeader));
+	util_fill_pipeline_cache_header(pRenderer, pHeader);
+	pHeader->mDataSize = dataSize;
+
+	HRESULT hres = pPipelineCache->pLibrary->Serialize(pHeader + 1, dataSize);
+	ASSERT(SUCCEEDED(hres));
+
+	*pSize = sizeof(PipelineCacheHeader) + dataSize;
+#else
+	*pSize = 0;
+#endif
+}
+/************************************************************************/
 // Command buffer Functions
 /************************************************************************/
 void beginCmd(Cmd* pCmd)
@@ -6130,17 +6420,26 @@ void fillVirtualTexture(Cmd* pCmd, Texture* pTexture, Fence* pFence)
 		uint pageIndex = VisibilityData[i];
 		VirtualTexturePage* pPage = &(*pPageTable)[pageIndex];
 
+		// Pages that are not cached yet are read by the resource loader and filled on a later frame
+		if (pPage->pIntermediateBuffer == NULL && !requestVirtualTexturePage(pTexture->pSvt->pPageCache, pageIndex))
+			continue;
+
 		if (allocateVirtualPage(pRenderer, pTexture, *pPage))
 		{
-			void* pData = (void*)((unsigned char*)pTexture->pSvt->mVirtualImageData + (pageIndex * pPage->size));
-
 			map = !pPage->pIntermediateBuffer->pCpuMappedAddress;
 			if (map)
 			{
 				mapBuffer(pRenderer, pPage->pIntermediateBuffer, NULL);
 			}
 
-			memcpy(pPage->pIntermediateBuffer->pCpuMappedAddress, pData, pPage->size);
+			// The page may have been evicted since it was requested
+			if (!readVirtualTexturePage(pTexture->pSvt->pPageCache, pageIndex, pPage->pIntermediateBuffer->pCpuMappedAddress, pPage->size, false))
+			{
+				if (map)
+					unmapBuffer(pRenderer, pPage->pIntermediateBuffer);
+				releaseVirtualPage(pRenderer, *pPage, true);
+				continue;
+			}
 
 
 			D3D12_TILED_RESOURCE_COORDINATE startCoord;
@@ -6231,8 +6530,6 @@ void fillVirtualTextureLevel(Cmd* pCmd, Texture* pTexture, uint32_t mipLevel)
 		{
 			if (allocateVirtualPage(renderer, pTexture, *pPage))
 			{
-				void* pData = (void*)((unsigned char*)pTexture->pSvt->mVirtualImageData + (pageIndex * (uint32_t)pPage->size));
-
 				//CPU to GPU
 				bool map = !pPage->pIntermediateBuffer->pCpuMappedAddress;
 				if (map)
@@ -6240,7 +6537,8 @@ void fillVirtualTextureLevel(Cmd* pCmd, Texture* pTexture, uint32_t mipLevel)
 					mapBuffer(renderer, pPage->pIntermediateBuffer, NULL);
 				}
 
-				memcpy(pPage->pIntermediateBuffer->pCpuMappedAddress, pData, pPage->size);
+				// Only filled when the texture is created by the resource loader, so the page is read right away
+				readVirtualTexturePage(pTexture->pSvt->pPageCache, pageIndex, pPage->pIntermediateBuffer->pCpuMappedAddress, pPage->size, true);
 
 				D3D12_TILED_RESOURCE_COORDINATE startCoord;
 				startCoord.X = pPage->offset.X / (uint)pTexture->pSvt->mSparseVirtualTexturePageWidth;
@@ -6302,7 +6600,7 @@ void fillVirtualTextureLevel(Cmd* pCmd, Texture* pTexture, uint32_t mipLevel)
 	tileCounts.set_capacity(0);
 }
 
-void addVirtualTexture(Renderer * pRenderer, const TextureDesc * pDesc, Texture ** ppTexture, void* pImageData)
+void addVirtualTexture(Renderer * pRenderer, const TextureDesc * pDesc, Texture ** ppTexture, void* pPageCache)
 {
 	ASSERT(pRenderer);
 	Texture* pTexture = (Texture*)conf_calloc(1, sizeof(*pTexture) + sizeof(VirtualTexture));
@@ -6319,8 +6617,7 @@ void addVirtualTexture(Renderer * pRenderer, const TextureDesc * pDesc, Texture
 		mipSize /= 4;
 	}
 
-	pTexture->pSvt->mVirtualImageData = (char*)conf_malloc(imageSize * sizeof(uint32_t));
-	memcpy(pTexture->pSvt->mVirtualImageData, pImageData, imageSize * sizeof(uint32_t));
+	pTexture->pSvt->pPageCache = pPageCache;
 
 	// Create command buffer to transition resources to the correct state
 	Queue*   graphicsQueue = NULL;
@@ -6543,8 +6840,8 @@ void removeVirtualTexture(Renderer* pRenderer, VirtualTexture* pSvt)
 	if (pSvt->mPageCounts)
 		removeBuffer(pRenderer, pSvt->mPageCounts);
 
-	if (pSvt->mVirtualImageData)
-		conf_free(pSvt->mVirtualImageData);
+	if (pSvt->pPageCache)
+		removeVirtualTexturePageCache(pSvt->pPageCache);
 }
 
 void cmdUpdateVirtualTexture(Cmd* cmd, Texture* pTexture)
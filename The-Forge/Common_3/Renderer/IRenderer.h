@@ -140,7 +140,8 @@ typedef enum RendererApi
 	RENDERER_API_METAL,
 	RENDERER_API_XBOX_D3D12,
 	RENDERER_API_D3D11,
-	RENDERER_API_ORBIS
+	RENDERER_API_ORBIS,
+	RENDERER_API_NULL
 } RendererApi;
 
 typedef enum LogType
@@ -228,6 +229,7 @@ typedef enum ResourceMemoryUsage
 typedef struct Renderer              Renderer;
 typedef struct Queue                 Queue;
 typedef struct Pipeline              Pipeline;
+typedef struct PipelineCache         PipelineCache;
 typedef struct Buffer                Buffer;
 typedef struct Texture               Texture;
 typedef struct RenderTarget          RenderTarget;
@@ -723,6 +725,11 @@ typedef struct DEFINE_ALIGNED(QueryPool, 16)
 	uint32_t         mType;
 	uint32_t         mCount;
 #endif
+#if defined(NULL_RENDERER)
+	uint64_t*        pNullQueryData;
+	QueryType        mType;
+	uint32_t         mCount;
+#endif
 } QueryPool;
 
 /// Data structure holding necessary info to create a Buffer
@@ -811,6 +818,14 @@ typedef struct DEFINE_ALIGNED(Buffer, 64)
 #endif
 #if defined(ORBIS)
 	OrbisBuffer                      mStruct;
+#endif
+#if defined(NULL_RENDERER)
+	/// Host memory backing the buffer contents (always mapped)
+	uint8_t*                         pNullData;
+	uint64_t                         mPadA;
+	uint64_t                         mPadB;
+	uint64_t                         mPadC;
+	uint64_t                         mPadD;
 #endif
 	uint64_t                         mSize : 32;
 	uint64_t                         mDescriptors : 20;
@@ -942,8 +957,8 @@ typedef struct VirtualTexture
 	Buffer*  mRemovePage;
 	/// a { uint alive; uint remove; } count of pages which are alive or should be removed
 	Buffer*  mPageCounts;
-	/// Original Pixel image data
-	void*    mVirtualImageData;
+	/// CPU cache streaming the page data from the .svt file (owned by the texture)
+	void*    pPageCache;
 	///  Total pages count
 	uint32_t mVirtualPageTotalCount;
 	/// Sparse Virtual Texture Width
@@ -998,6 +1013,15 @@ typedef struct DEFINE_ALIGNED(Texture, 64)
 #if defined(ORBIS)
 	OrbisTexture                 mStruct;
 	/// Contains resource allocation info such as parent heap, offset in heap
+#endif
+#if defined(NULL_RENDERER)
+	/// Host memory backing the texels, laid out layer by layer with the full mip chain per layer (NULL for render targets)
+	uint8_t*                     pNullData;
+	uint64_t                     mNullDataSize;
+	uint64_t                     mFormat : 16;
+	uint64_t                     mArraySize : 16;
+	uint64_t                     mPadA;
+	uint64_t                     mPadB;
 #endif
 	VirtualTexture*              pSvt;
 
@@ -1091,6 +1115,9 @@ typedef struct DEFINE_ALIGNED(RenderTarget, 64)
 #endif
 #if defined(ORBIS)
 	OrbisRenderTarget             mStruct;
+#endif
+#if defined(NULL_RENDERER)
+	uint64_t                      mPadA[3];
 #endif
 	ClearValue                    mClearValue;
 	uint32_t                      mArraySize : 16;
@@ -1151,6 +1178,9 @@ typedef struct DEFINE_ALIGNED(Sampler, 16)
 #if defined(ORBIS)
 	OrbisSampler                mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	uint64_t                    mPadA;
+#endif
 } Sampler;
 #if defined(DIRECT3D12)
 COMPILE_ASSERT(sizeof(Sampler) == 8 * sizeof(uint64_t));
@@ -1191,6 +1221,10 @@ typedef struct DEFINE_ALIGNED(DescriptorInfo, 16)
 	uint32_t                  mUsedStages : 6;
 	uint32_t                  mReg : 20;
 	uint32_t                  mPadA;
+#elif defined(NULL_RENDERER)
+	uint32_t                  mUsedStages : 7;
+	uint32_t                  mReg : 20;
+	uint32_t                  mPadA;
 #elif defined(DIRECT3D12)
 	uint64_t                  mPadA;
 #endif
@@ -1241,7 +1275,7 @@ typedef struct DEFINE_ALIGNED(RootSignature, 64)
 	PipelineType               mPipelineType;
 	/// Array of all descriptors declared in the root signature layout
 	DescriptorInfo*            pDescriptors;
-	/// Translates hash of descriptor name to descriptor index in pDescriptors array
+	/// Flat table translating pre-hashed descriptor names to indices in the pDescriptors array
 	DescriptorIndexMap*        pDescriptorNameToIndexMap;
 #if defined(DIRECT3D12)
 	ID3D12RootSignature*       pDxRootSignature;
@@ -1302,11 +1336,16 @@ typedef struct DEFINE_ALIGNED(RootSignature, 64)
 #if defined(ORBIS)
 	OrbisRootSignature         mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	/// Number of descriptor handles in one descriptor set of each update frequency
+	uint32_t                   mNullDescriptorCounts[DESCRIPTOR_UPDATE_FREQ_COUNT];
+	uint64_t                   mPadA[3];
+#endif
 } RootSignature;
 #if defined(VULKAN)
 // 4 cache lines
 COMPILE_ASSERT(sizeof(RootSignature) == 32 * sizeof(uint64_t));
-#elif defined(DIRECT3D11) || defined(METAL)
+#elif defined(DIRECT3D11) || defined(METAL) || defined(NULL_RENDERER)
 // 1 cache line
 COMPILE_ASSERT(sizeof(RootSignature) == 8 * sizeof(uint64_t));
 #else
@@ -1314,11 +1353,35 @@ COMPILE_ASSERT(sizeof(RootSignature) == 8 * sizeof(uint64_t));
 COMPILE_ASSERT(sizeof(RootSignature) == 16 * sizeof(uint64_t));
 #endif
 
+/// FNV-1a hash of a descriptor name. Evaluated at compile time when the name is a literal
+constexpr uint32_t descriptor_name_hash(const char* pName)
+{
+	uint32_t hash = 2166136261u;
+	while (pName && *pName)
+	{
+		hash = (hash ^ (uint8_t)*pName++) * 16777619u;
+	}
+	return hash;
+}
+
+/// Descriptor or push constant name paired with its pre-computed hash
+/// Implicitly constructible from a string so existing call sites keep working. Declaring the name as a
+/// static constexpr DescriptorName guarantees no string hashing happens when binding
+typedef struct DescriptorName
+{
+	constexpr DescriptorName() : pName(NULL), mHash(0) {}
+	constexpr DescriptorName(const char* name) : pName(name), mHash(descriptor_name_hash(name)) {}
+	constexpr operator const char*() const { return pName; }
+
+	const char* pName;
+	uint32_t    mHash;
+} DescriptorName;
+
 typedef struct DescriptorData
 {
 	/// User can either set name of descriptor or index (index in pRootSignature->pDescriptors array)
 	/// Name of descriptor
-	const char* pName;
+	DescriptorName pName;
 	union
 	{
 		struct
@@ -1406,6 +1469,13 @@ typedef struct DEFINE_ALIGNED(DescriptorSet, 64)
 	uint16_t                      mMaxSets;
 #elif defined(ORBIS)
 	OrbisDescriptorSet            mStruct;
+#elif defined(NULL_RENDERER)
+	/// mMaxSets tables of pRootSignature->mNullDescriptorCounts[mUpdateFrequency] handles
+	struct NullDescriptorHandle*  pHandles;
+	const RootSignature*          pRootSignature;
+	uint32_t                      mMaxSets;
+	uint8_t                       mUpdateFrequency;
+	uint8_t                       mNodeIndex;
 #endif
 } DescriptorSet;
 
@@ -1496,6 +1566,16 @@ typedef struct DEFINE_ALIGNED(Cmd, 64)
 #endif
 #if defined(ORBIS)
 	OrbisCmd                     mStruct;
+#endif
+#if defined(NULL_RENDERER)
+	/// Recorded command packets (see NullCommands.h), executed on the host at queueSubmit
+	uint8_t*                     pNullCmdData;
+	uint32_t                     mNullCmdSize;
+	uint32_t                     mNullCmdCapacity;
+	uint32_t                     mNullCmdCount;
+	uint32_t                     mNodeIndex : 4;
+	uint32_t                     mType : 3;
+	CmdPool*                     pCmdPool;
 #endif
 	Renderer*                    pRenderer;
 	Queue*                       pQueue;
@@ -1540,6 +1620,14 @@ typedef struct DEFINE_ALIGNED(Fence, 32)
 #if defined(ORBIS)
 	OrbisFence           mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	/// Simulated time (getUSec) at which the last submission signaling this fence completes
+	int64_t              mNullCompletionTime;
+	uint32_t             mSubmitted : 1;
+	uint32_t             mPadA;
+	uint64_t             mPadB;
+	uint64_t             mPadC;
+#endif
 } Fence;
 COMPILE_ASSERT(sizeof(Fence) == 4 * sizeof(uint64_t));
 
@@ -1583,6 +1671,14 @@ typedef struct DEFINE_ALIGNED(Semaphore, 32)
 #if defined(ORBIS)
 	OrbisFence           mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	/// Simulated time (getUSec) at which the signaling submission completes
+	int64_t              mNullSignalTime;
+	uint32_t             mSignaled : 1;
+	uint32_t             mPadA;
+	uint64_t             mPadB;
+	uint64_t             mPadC;
+#endif
 } Semaphore;
 COMPILE_ASSERT(sizeof(Semaphore) == 4 * sizeof(uint64_t));
 
@@ -1635,6 +1731,14 @@ typedef struct DEFINE_ALIGNED(Queue, 64)
 	uint32_t             mNodeIndex : 4;
 	Extent3D             mUploadGranularity;
 #endif
+#if defined(NULL_RENDERER)
+	uint32_t             mType : 3;
+	uint32_t             mNodeIndex : 4;
+	Extent3D             mUploadGranularity;
+	/// Simulated time (getUSec) at which the last submission on this queue completes
+	int64_t              mNullLastCompletion;
+	uint32_t             mNullGpuLatency;
+#endif
 } Queue;
 COMPILE_ASSERT(sizeof(Queue) <= 32 * sizeof(uint64_t));
 
@@ -1672,6 +1776,9 @@ typedef struct BinaryShaderStageDesc
 	const char*    pByteCode;
 	uint32_t       mByteCodeSize;
 	const char*    pEntryPoint;
+	/// Optional reflection written by serializeShaderReflection. When valid the byte code is not reflected again
+	const void*    pReflection;
+	uint32_t       mReflectionSize;
 #if defined(METAL)
 	// Shader source is needed for reflection
 	char*          pSource;
@@ -1874,8 +1981,29 @@ typedef struct PipelineDesc
 		GraphicsPipelineDesc	mGraphicsDesc;
 		RaytracingPipelineDesc	mRaytracingDesc;
 	};
+	/// Cache used to create the pipeline. The renderer pipeline cache is used if NULL
+	PipelineCache* pCache;
 } PipelineDesc;
 
+typedef struct PipelineCacheDesc
+{
+	/// Data returned by getPipelineCacheData in a previous run. Data written by a different device or driver is discarded
+	void*  pData;
+	size_t mSize;
+} PipelineCacheDesc;
+
+typedef struct PipelineCache
+{
+#if defined(DIRECT3D12) && !defined(_DURANGO)
+	ID3D12PipelineLibrary* pLibrary;
+	/// The library references the data it was created from until it is released
+	void*                  pData;
+#endif
+#if defined(VULKAN)
+	VkPipelineCache        pCache;
+#endif
+} PipelineCache;
+
 #ifdef METAL
 typedef struct RaytracingPipeline RaytracingPipeline;
 #endif
@@ -1935,6 +2063,12 @@ typedef struct DEFINE_ALIGNED(Pipeline, 64)
 #if defined(ORBIS)
 	OrbisPipeline               mStruct;
 #endif
+#if defined(NULL_RENDERER)
+	RootSignature*              pRootSignature;
+	PipelineType                mType;
+	uint32_t                    mPadA;
+	uint64_t                    mPadB[6];
+#endif
 } Pipeline;
 #if defined(DIRECT3D11) || defined(ORBIS)
 // Requires more cache lines due to no concept of an encapsulated pipeline state object
@@ -2045,6 +2179,11 @@ typedef struct DEFINE_ALIGNED(SwapChain, 64)
 	uint32_t                 mImageCount : 3;
 	uint32_t                 mEnableVsync : 1;
 #endif
+#if defined(NULL_RENDERER)
+	uint32_t                 mImageCount : 3;
+	uint32_t                 mEnableVsync : 1;
+	uint32_t                 mIndex;
+#endif
 } SwapChain;
 
 typedef enum ShaderTarget
@@ -2075,6 +2214,8 @@ typedef struct RendererDesc
 	RendererApi                  mApi;
 	ShaderTarget                 mShaderTarget;
 	GpuMode                      mGpuMode;
+	/// Initial contents of the renderer pipeline cache (Vulkan, D3D12). See loadPipelineCache in IResourceLoader.h
+	const PipelineCacheDesc*     pPipelineCacheDesc;
 #if defined(VULKAN)
 	const char**                 ppInstanceLayers;
 	uint32_t                     mInstanceLayerCount;
@@ -2085,6 +2226,10 @@ typedef struct RendererDesc
 #endif
 #if defined(DIRECT3D12)
 	D3D_FEATURE_LEVEL            mDxFeatureLevel;
+#endif
+#if defined(NULL_RENDERER)
+	/// Simulated GPU time (in microseconds) each queue submission takes to complete. Zero completes submissions immediately
+	uint32_t                     mNullGpuLatency;
 #endif
 	/// This results in new validation not possible during API calls on the CPU, by creating patched shaders that have validation added directly to the shader.
 	/// However, it can slow things down a lot, especially for applications with numerous PSOs. Time to see the first render frame may take several minutes
@@ -2148,7 +2293,8 @@ typedef struct DEFINE_ALIGNED(Renderer, 64)
 	uint64_t                        mPadA;
 #endif
 	ID3D12Debug*                    pDXDebug;
-	uint64_t                        mPadB;
+	/// Used by every pipeline which is not created with its own cache
+	PipelineCache*                  pPipelineCache;
 #endif
 #if defined(DIRECT3D11)
 	IDXGIFactory1*                  pDXGIFactory;
@@ -2178,7 +2324,8 @@ typedef struct DEFINE_ALIGNED(Renderer, 64)
 	struct VmaAllocator_T*          pVmaAllocator;
 	uint32_t                        mRaytracingExtension : 1;
 	uint32_t                        mPadA;
-	uint64_t                        mPadB;
+	/// Used by every pipeline which is not created with its own cache
+	PipelineCache*                  pPipelineCache;
 #endif
 #if defined(METAL)
 	id<MTLDevice>                   pDevice;
@@ -2188,6 +2335,14 @@ typedef struct DEFINE_ALIGNED(Renderer, 64)
 #if defined(ORBIS)
 	uint64_t                        mPadA;
 	uint64_t                        mPadB;
+#endif
+#if defined(NULL_RENDERER)
+	uint32_t                        mNullGpuLatency;
+	uint32_t                        mPadA;
+	/// Host memory currently held by buffers and textures (updated atomically)
+	uint64_t                        mNullBufferMemory;
+	uint64_t                        mNullTextureMemory;
+	uint64_t                        mPadB[7];
 #endif
 	struct NullDescriptors*         pNullDescriptors;
 	char*                           pName;
@@ -2244,6 +2399,10 @@ typedef struct CommandSignature
 	IndirectArgumentType    mDrawType;
 	uint32_t                mStride;
 #endif
+#if defined(NULL_RENDERER)
+	IndirectArgumentType    mDrawType;
+	uint32_t                mStride;
+#endif
 } CommandSignature;
 
 typedef struct DescriptorSetDesc
@@ -2327,6 +2486,10 @@ API_INTERFACE void FORGE_CALLCONV removeRootSignature(Renderer* pRenderer, RootS
 // pipeline functions
 API_INTERFACE void FORGE_CALLCONV addPipeline(Renderer* pRenderer, const PipelineDesc* p_pipeline_settings, Pipeline** p_pipeline); 
 API_INTERFACE void FORGE_CALLCONV removePipeline(Renderer* pRenderer, Pipeline* p_pipeline);
+API_INTERFACE void FORGE_CALLCONV addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache);
+API_INTERFACE void FORGE_CALLCONV removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache);
+/// Serializes the cache. If pData is NULL only the required size is written to pSize, otherwise pSize holds the capacity of pData
+API_INTERFACE void FORGE_CALLCONV getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData);
 
 // Descriptor Set functions
 API_INTERFACE void FORGE_CALLCONV addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, DescriptorSet** pDescriptorSet);
@@ -2341,7 +2504,7 @@ API_INTERFACE void FORGE_CALLCONV cmdSetViewport(Cmd* p_cmd, float x, float y, f
 API_INTERFACE void FORGE_CALLCONV cmdSetScissor(Cmd* p_cmd, uint32_t x, uint32_t y, uint32_t width, uint32_t height);
 API_INTERFACE void FORGE_CALLCONV cmdBindPipeline(Cmd* p_cmd, Pipeline* p_pipeline);
 API_INTERFACE void FORGE_CALLCONV cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorSet);
-API_INTERFACE void FORGE_CALLCONV cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char* pName, const void* pConstants);
+API_INTERFACE void FORGE_CALLCONV cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, DescriptorName name, const void* pConstants);
 API_INTERFACE void FORGE_CALLCONV cmdBindPushConstantsByIndex(Cmd* pCmd, RootSignature* pRootSignature, uint32_t paramIndex, const void* pConstants);
 API_INTERFACE void FORGE_CALLCONV cmdBindIndexBuffer(Cmd* p_cmd, Buffer* p_buffer, uint32_t indexType, uint64_t offset);
 API_INTERFACE void FORGE_CALLCONV cmdBindVertexBuffer(Cmd* p_cmd, uint32_t buffer_count, Buffer** pp_buffers, const uint32_t* pStrides, const uint64_t* pOffsets);
@@ -38,6 +38,7 @@
 typedef struct BufferUpdateDesc BufferUpdateDesc;
 typedef struct BufferLoadDesc BufferLoadDesc;
 typedef struct RenderMesh RenderMesh;
+struct ThreadSystem;
 
 // MARK: - Resource Loading
 
@@ -110,6 +111,12 @@ typedef struct TextureLoadDesc
 
 	// Following is ignored if pDesc != NULL.  pDesc->mFlags will be considered instead.
 	TextureCreationFlags mCreationFlag;
+	/// Only for DDS / KTX pFilePath. Create the texture with the smallest mips only so it can be used right away and
+	/// stream the detailed mips in later. See updateTextureStreaming
+	bool mProgressive = false;
+	/// Only for pFilePath. Share the texture with the other shared loads of the same path and parameters instead of
+	/// loading it again. Every holder gets the same Texture*, so nothing may write to it after the load
+	bool mShared = false;
 
 	struct
 	{
@@ -172,6 +179,9 @@ typedef enum GeometryLoadFlags
 	GEOMETRY_LOAD_FLAG_SHADOWED = 0x1,
 	/// Use structured buffers instead of raw buffers
 	GEOMETRY_LOAD_FLAG_STRUCTURED_BUFFERS = 0x2,
+	/// Share the geometry with the other shared loads of the same path, flags and vertex layout instead of loading it
+	/// again. Every holder gets the same Geometry*, so nothing may write to its buffers or shadow copy after the load
+	GEOMETRY_LOAD_FLAG_SHARED = 0x4,
 } GeometryLoadFlags;
 MAKE_ENUM_FLAG(uint32_t, GeometryLoadFlags)
 
@@ -211,6 +221,10 @@ typedef struct BufferUpdateDesc
 	///   for (uint32_t i = 0; i < particleCount; ++i)
 	///	    vertices[i] = { rand() };
 	/// endUpdateResource(&update, &token);
+	/// CPU_ONLY and CPU_TO_GPU buffers hand out their own memory instead of staging memory. The write is visible to the
+	/// GPU right away, so per-frame data needs a separate buffer or range per frame in flight.
+	/// Other buffers are staged, since the GPU may still be reading them. Only addResource writes them in place when
+	/// they are host visible (UMA or persistently mapped), and never GPU_TO_CPU buffers
 	void*                    pMappedData;
 
 	// Internal
@@ -252,10 +266,48 @@ typedef struct ResourceLoaderDesc
 {
 	uint64_t mBufferSize;
 	uint32_t mBufferCount;
+	/// CPU memory all sparse virtual textures share to cache the pages the streamer read from their .svt files.
+	/// 0 selects the default
+	uint64_t mVirtualTexturePageCacheSize;
+	/// Worker threads the image loaders may use to decode a texture in parallel (Basis transcoding). NULL decodes on the streamer thread
+	ThreadSystem* pThreadSystem;
+	/// GPU memory the streamed mips of all progressive textures may occupy, including replacements that are being
+	/// uploaded and retired ones that are still in flight. 0 selects the default
+	uint64_t mTextureStreamingBudget;
 } ResourceLoaderDesc;
 
 extern ResourceLoaderDesc gDefaultResourceLoaderDesc;
 
+#define RESOURCE_LOADER_HISTOGRAM_BUCKET_COUNT 24
+
+/// Distribution of a duration in microseconds. Bucket i counts the samples in [2^(i-1), 2^i), the last one everything above
+typedef struct ResourceLoaderHistogram
+{
+	uint32_t mBuckets[RESOURCE_LOADER_HISTOGRAM_BUCKET_COUNT];
+	uint64_t mCount;
+	uint64_t mTotalUs;
+	uint64_t mMaxUs;
+} ResourceLoaderHistogram;
+
+typedef struct ResourceLoaderStats
+{
+	/// Requests waiting to be processed
+	uint32_t mQueueDepth[LOAD_PRIORITY_COUNT];
+	/// Time from queueing a request to the streamer processing it
+	ResourceLoaderHistogram mQueueWait[LOAD_PRIORITY_COUNT];
+	/// Reading and decoding texture and geometry files
+	ResourceLoaderHistogram mDecode;
+	/// Writing staging memory and recording the copies of a request
+	ResourceLoaderHistogram mUpload;
+	/// Staging memory submitted to the copy queues
+	uint64_t mUploadedBytes;
+	/// mUploadedBytes over the time the streamer spent processing requests
+	double   mUploadBytesPerSecond;
+	/// Allocations that did not fit the staging buffer and got a temporary buffer instead
+	uint64_t mStagingOverflowCount;
+	uint64_t mStagingOverflowBytes;
+} ResourceLoaderStats;
+
 // MARK: - Resource Loader Functions
 
 void initResourceLoaderInterface(Renderer* pRenderer, ResourceLoaderDesc* pDesc = nullptr);
@@ -270,6 +322,9 @@ void exitResourceLoaderInterface(Renderer* pRenderer);
 
 /// If token is NULL, the resource will be available when allResourceLoadsCompleted() returns true.
 /// If token is non NULL, the resource will be available after isTokenCompleted(token) returns true.
+/// Textures and geometry loaded from a file with TextureLoadDesc::mShared or GEOMETRY_LOAD_FLAG_SHARED alias the earlier
+/// shared requests for the same path and parameters, including ones still in flight. Each addResource needs its own
+/// removeResource, the last one releases the resource.
 void addResource(BufferLoadDesc* pBufferDesc, SyncToken* token, LoadPriority priority);
 void addResource(TextureLoadDesc* pTextureDesc, SyncToken* token, LoadPriority priority);
 void addResource(GeometryLoadDesc* pGeomDesc, SyncToken* token, LoadPriority priority);
@@ -285,6 +340,22 @@ void removeResource(Buffer* pBuffer);
 void removeResource(Texture* pTexture);
 void removeResource(Geometry* pGeom);
 
+// MARK: Texture Streaming
+
+/// A progressive texture only allocates the file mips from its resident mip on: mip 0 of the texture is file mip
+/// getTextureResidentMip. Changing that builds a new texture with the new mip range off to the side, which
+/// updateTextureStreaming then swaps into the Texture the app holds. Rebind the descriptors of a texture whenever its
+/// resident mip changed.
+
+/// File mip that is mip 0 of a progressive texture. Returns 0 for textures that are not streamed
+uint32_t getTextureResidentMip(Texture* pTexture);
+/// Sets the most detailed file mip a progressive texture should hold. More detailed mips are streamed in one at a
+/// time as the budget allows, less detailed ones drop the top mips on the next update
+void requestTextureMip(Texture* pTexture, uint32_t mostDetailedMip);
+/// Call once per frame from the render thread after waiting for the oldest frame in flight. Publishes the progressive
+/// textures whose new mips were uploaded and frees the resources they replaced once framesInFlight updates passed
+void updateTextureStreaming(uint32_t framesInFlight);
+
 // MARK: Waiting for Loads
 
 /// Returns whether all submitted resource loads and updates have been completed.
@@ -303,5 +374,28 @@ SyncToken getLastTokenCompleted();
 bool isTokenCompleted(const SyncToken* token);
 void waitForToken(const SyncToken* token);
 
+// MARK: Telemetry
+
+/// Counters since the loader was created or resetResourceLoaderStats was called. They are also published to the
+/// profiler counters under "ResourceLoader/"
+void getResourceLoaderStats(ResourceLoaderStats* pStats);
+void resetResourceLoaderStats();
+
 /// Either loads the cached shader bytecode or compiles the shader to create new bytecode depending on whether source is newer than binary
 void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** pShader);
+/// Loads, compiles and reflects the shaders on the workers of pThreadSystem and the calling thread.
+/// At most maxConcurrency shaders are processed at the same time (0 uses the CPU core count). Stages shared by several
+/// descs are compiled once. Falls back to addShader for each desc if pThreadSystem is NULL
+void addShaders(Renderer* pRenderer, uint32_t count, const ShaderLoadDesc* pDescs, Shader** ppShaders, ThreadSystem* pThreadSystem, uint32_t maxConcurrency);
+
+// MARK: Pipelines
+
+/// Reads a pipeline cache written by savePipelineCache from the shader binary directory. pOutDesc->pData is allocated with conf_malloc
+/// and owned by the caller. Pass it to RendererDesc::pPipelineCacheDesc or addPipelineCache, which reject data from another device or driver
+bool loadPipelineCache(const char* pFileName, PipelineCacheDesc* pOutDesc);
+/// Writes the serialized cache to the shader binary directory. Usually called with pRenderer->pPipelineCache before removeRenderer
+void savePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache, const char* pFileName);
+
+/// Creates the pipelines on the workers of pThreadSystem and the calling thread so the driver compiles them concurrently.
+/// Falls back to creating them one after the other if pThreadSystem is NULL
+void addPipelines(Renderer* pRenderer, uint32_t count, const PipelineDesc* pDescs, Pipeline** ppPipelines, ThreadSystem* pThreadSystem);
@@ -173,5 +173,10 @@ void destroyShaderReflection(ShaderReflection* pReflection);
 void createPipelineReflection(ShaderReflection* pReflection, uint32_t stageCount, PipelineReflection* pOutReflection);
 void destroyPipelineReflection(PipelineReflection* pReflection);
 
-//void serializeReflection(File* pInFile, Reflection* pReflection);
-//void deserializeReflection(File* pOutFile, Reflection* pReflection);
+// Binary form of a single stage reflection so it can be cached next to the shader byte code.
+// Names are stored as offsets into the name pool. The layout matches the structs of the current platform
+// so the data is only valid for the renderer API that produced it
+/// Writes the serialized reflection to pData. Pass NULL pData to query the size
+void serializeShaderReflection(const ShaderReflection* pReflection, size_t* pSize, void* pData);
+/// Returns false if the data is malformed or was written for a different stage or struct layout
+bool deserializeShaderReflection(const void* pData, size_t size, ShaderStage shaderStage, ShaderReflection* pOutReflection);
@@ -47,6 +47,7 @@
 #include "../../ThirdParty/OpenSource/EASTL/string_hash_map.h"
 
 #import "../IRenderer.h"
+#include "../DescriptorIndexMap.h"
 #include "MetalMemoryAllocator.h"
 #include "../../OS/Interfaces/ILog.h"
 #include "../../OS/Core/GPUConfig.h"
@@ -72,17 +73,12 @@ extern void mtl_createShaderReflection(
 	Renderer* pRenderer, Shader* shader, const uint8_t* shaderCode, uint32_t shaderSize, ShaderStage shaderStage,
 	eastl::unordered_map<uint32_t, MTLVertexFormat>* vertexAttributeFormats, ShaderReflection* pOutReflection);
 
-typedef struct DescriptorIndexMap
-{
-	eastl::string_hash_map<uint32_t> mMap;
-} DescriptorIndexMap;
-
 // in Metal we must split all resources back by shaders
 typedef struct ShaderDescriptors
 {
 	Shader*         pShader;
 	
-	eastl::string_hash_map<uint32_t> mDescriptorNameToIndexMap;
+	DescriptorIndexMap* pDescriptorNameToIndexMap;
 	
 	DescriptorInfo* pDescriptors;
 	uint32_t        mDescriptorCount;
@@ -398,28 +394,13 @@ typedef struct MTLDescriptorSet
 
 typedef eastl::unordered_set<void*> ResourcesList[RESOURCE_TYPE_COUNT];
 
-const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const char* pResName, uint32_t* pIndex)
+const DescriptorInfo* get_descriptor_for_shader(const ShaderDescriptors* pShader, const DescriptorName& name, uint32_t* pIndex)
 {
-	decltype(pRootSignature->pDescriptorNameToIndexMap->mMap)::const_iterator it = pRootSignature->pDescriptorNameToIndexMap->mMap.find(pResName);
-	if (it != pRootSignature->pDescriptorNameToIndexMap->mMap.end())
-	{
-		*pIndex = it->second;
-		return &pRootSignature->pDescriptors[it->second];
-	}
-	else
-	{
-        LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", pResName);
-		return NULL;
-	}
-}
-
-const DescriptorInfo* get_descriptor_for_shader(const ShaderDescriptors* pShader, const char* pResName, uint32_t* pIndex)
-{
-    decltype(pShader->mDescriptorNameToIndexMap)::const_iterator it = pShader->mDescriptorNameToIndexMap.find(pResName);
-    if (it != pShader->mDescriptorNameToIndexMap.end())
+    const uint32_t index = find_descriptor_index(pShader->pDescriptorNameToIndexMap, name);
+    if (index != (uint32_t)-1)
     {
-        *pIndex = it->second;
-        return &pShader->pDescriptors[it->second];
+        *pIndex = index;
+        return &pShader->pDescriptors[index];
     }
     else
     {
@@ -613,11 +594,11 @@ void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorS
 //
 // Push Constants
 //
-void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char* pName, const void* pConstants)
+void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, DescriptorName name, const void* pConstants)
 {
     ASSERT(pCmd);
     ASSERT(pRootSignature);
-    ASSERT(pName);
+    ASSERT(name.pName);
     
     uint32_t descIndex = -1;
     
@@ -625,7 +606,7 @@ void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char*
     {
         const ShaderDescriptors& shaderPair(pRootSignature->pShaderDescriptors[i]);
         
-        const DescriptorInfo* pDesc = get_descriptor_for_shader(&shaderPair, pName, &descIndex);
+        const DescriptorInfo* pDesc = get_descriptor_for_shader(&shaderPair, name, &descIndex);
         
         if(pDesc)
         {
@@ -2445,10 +2426,8 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	ASSERT(pRenderer->pDevice != nil);
 	ASSERT(ppRootSignature);
 	
-	RootSignature* pRootSignature = (RootSignature*)conf_calloc(1, sizeof(RootSignature) + sizeof(DescriptorIndexMap));
-	pRootSignature->pDescriptorNameToIndexMap = (DescriptorIndexMap*)(pRootSignature + 1);
-	ASSERT(pRootSignature->pDescriptorNameToIndexMap);
-	conf_placement_new<DescriptorIndexMap>(pRootSignature->pDescriptorNameToIndexMap);
+	// Descriptors are looked up per shader (see ShaderDescriptors) so the root signature itself has no name table
+	RootSignature* pRootSignature = (RootSignature*)conf_calloc(1, sizeof(RootSignature));
 	
 	eastl::vector<ShaderResource>        shaderResources;
 
@@ -2476,10 +2455,17 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
                 pRootSignature->mPipelineType = PIPELINE_TYPE_GRAPHICS;
             }
             
+            DescriptorNameToIndexMap indexMap;
+            for (uint32_t i = 0; i < pReflection->mShaderResourceCount; ++i)
+                indexMap.insert(pReflection->pShaderResources[i].name, i);
+            
+            // Descriptors and their name table share one allocation
+            const size_t descriptorsSize = pReflection->mShaderResourceCount * sizeof(DescriptorInfo);
             pRootSignature->pShaderDescriptors[sh].pShader = pRootSignatureDesc->ppShaders[sh];
             pRootSignature->pShaderDescriptors[sh].mDescriptorCount = pReflection->mShaderResourceCount;
-            pRootSignature->pShaderDescriptors[sh].pDescriptors = (DescriptorInfo*)conf_calloc( pRootSignature->pShaderDescriptors[sh].mDescriptorCount, sizeof(DescriptorInfo) );
-            conf_placement_new<eastl::unordered_map<uint32_t, uint32_t>>(&pRootSignature->pShaderDescriptors[sh].mDescriptorNameToIndexMap);
+            pRootSignature->pShaderDescriptors[sh].pDescriptors = (DescriptorInfo*)conf_calloc(1, descriptorsSize + descriptor_index_map_size(indexMap));
+            pRootSignature->pShaderDescriptors[sh].pDescriptorNameToIndexMap = (DescriptorIndexMap*)((uint8_t*)pRootSignature->pShaderDescriptors[sh].pDescriptors + descriptorsSize);
+            init_descriptor_index_map(pRootSignature->pShaderDescriptors[sh].pDescriptorNameToIndexMap, indexMap);
             
             for (uint32_t i = 0; i < pReflection->mShaderResourceCount; ++i)
             {
@@ -2491,8 +2477,6 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
                 uint32_t                  setIndex = pRes->set;
                 const DescriptorUpdateFrequency updateFreq((DescriptorUpdateFrequency)setIndex);
 
-                pRootSignature->pShaderDescriptors[sh].mDescriptorNameToIndexMap[pRes->name] = i;
-                
                 pDesc->mReg = pRes->reg;
 //                pDesc->mDesc.set = pRes->set;
                 pDesc->mSize = pRes->size;
@@ -2535,14 +2519,11 @@ void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
 {
 	for (uint32_t i = 0; i < pRootSignature->mShaderDescriptorsCount; ++i)
 	{
-		pRootSignature->pShaderDescriptors[i].mDescriptorNameToIndexMap.clear(true);
 		SAFE_FREE(pRootSignature->pShaderDescriptors[i].pDescriptors);
 	}
 	
 	SAFE_FREE(pRootSignature->pShaderDescriptors);
 	SAFE_FREE(pRootSignature->pDescriptors);
-	
-	pRootSignature->pDescriptorNameToIndexMap->mMap.clear(true);
 	SAFE_FREE(pRootSignature);
 }
 
@@ -2769,6 +2750,33 @@ void removePipeline(Renderer* pRenderer, Pipeline* pPipeline)
 	SAFE_FREE(pPipeline);
 }
 
+// Metal caches compiled pipelines on its own, the cache object only exists for API parity
+void addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipelineCache);
+
+	PipelineCache* pPipelineCache = (PipelineCache*)conf_calloc(1, sizeof(PipelineCache));
+	ASSERT(pPipelineCache);
+
+	*ppPipelineCache = pPipelineCache;
+}
+
+void removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+
+	SAFE_FREE(pPipelineCache);
+}
+
+void getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData)
+{
+	ASSERT(pSize);
+	*pSize = 0;
+}
+
 void addIndirectCommandSignature(Renderer* pRenderer, const CommandSignatureDesc* pDesc, CommandSignature** ppCommandSignature)
 {
 	ASSERT(pRenderer != nil);
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "../IRenderer.h"
+
+/* Command packets recorded by the null backend.
+ * Each Cmd owns a linear stream of variable sized packets (NullCmdHeader followed by the payload and
+ * any inline arrays/strings), 8 byte aligned. queueSubmit walks the stream on the host.
+ */
+
+enum NullCmdType
+{
+	NULL_CMD_TYPE_cmdBindRenderTargets,
+	NULL_CMD_TYPE_cmdSetViewport,
+	NULL_CMD_TYPE_cmdSetScissor,
+	NULL_CMD_TYPE_cmdBindPipeline,
+	NULL_CMD_TYPE_cmdBindDescriptorSet,
+	NULL_CMD_TYPE_cmdBindPushConstants,
+	NULL_CMD_TYPE_cmdBindIndexBuffer,
+	NULL_CMD_TYPE_cmdBindVertexBuffer,
+	NULL_CMD_TYPE_cmdDraw,
+	NULL_CMD_TYPE_cmdDrawInstanced,
+	NULL_CMD_TYPE_cmdDrawIndexed,
+	NULL_CMD_TYPE_cmdDrawIndexedInstanced,
+	NULL_CMD_TYPE_cmdDispatch,
+	NULL_CMD_TYPE_cmdExecuteIndirect,
+	NULL_CMD_TYPE_cmdResourceBarrier,
+	NULL_CMD_TYPE_cmdResetQueryPool,
+	NULL_CMD_TYPE_cmdBeginQuery,
+	NULL_CMD_TYPE_cmdEndQuery,
+	NULL_CMD_TYPE_cmdResolveQuery,
+	NULL_CMD_TYPE_cmdBeginDebugMarker,
+	NULL_CMD_TYPE_cmdEndDebugMarker,
+	NULL_CMD_TYPE_cmdAddDebugMarker,
+	NULL_CMD_TYPE_cmdUpdateBuffer,
+	NULL_CMD_TYPE_cmdUpdateSubresource,
+	NULL_CMD_TYPE_COUNT
+};
+
+struct NullCmdHeader
+{
+	uint32_t mType;
+	/// Size of the packet in bytes including this header
+	uint32_t mSize;
+};
+
+struct NullBindRenderTargetsCmd
+{
+	RenderTarget*   ppRenderTargets[MAX_RENDER_TARGET_ATTACHMENTS];
+	RenderTarget*   pDepthStencil;
+	uint32_t        mRenderTargetCount;
+	uint32_t        mHasLoadActions;
+	LoadActionsDesc mLoadActions;
+};
+
+struct NullSetViewportCmd
+{
+	float x;
+	float y;
+	float width;
+	float height;
+	float minDepth;
+	float maxDepth;
+};
+
+struct NullSetScissorCmd
+{
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+struct NullBindPipelineCmd
+{
+	Pipeline* pPipeline;
+};
+
+struct NullBindDescriptorSetCmd
+{
+	DescriptorSet* pDescriptorSet;
+	uint32_t       mIndex;
+};
+
+/// Followed by mSize bytes of constant data
+struct NullBindPushConstantsCmd
+{
+	const DescriptorInfo* pDesc;
+	uint32_t              mSize;
+};
+
+struct NullBindIndexBufferCmd
+{
+	Buffer*  pBuffer;
+	uint64_t mOffset;
+	uint32_t mIndexType;
+};
+
+/// Followed by mBufferCount Buffer*, mBufferCount uint32_t strides and mBufferCount uint64_t offsets
+struct NullBindVertexBufferCmd
+{
+	uint32_t mBufferCount;
+	uint32_t mHasOffsets;
+};
+
+struct NullDrawCmd
+{
+	uint32_t vertexCount;
+	uint32_t firstVertex;
+};
+
+struct NullDrawInstancedCmd
+{
+	uint32_t vertexCount;
+	uint32_t firstVertex;
+	uint32_t instanceCount;
+	uint32_t firstInstance;
+};
+
+struct NullDrawIndexedCmd
+{
+	uint32_t indexCount;
+	uint32_t firstIndex;
+	uint32_t firstVertex;
+};
+
+struct NullDrawIndexedInstancedCmd
+{
+	uint32_t indexCount;
+	uint32_t firstIndex;
+	uint32_t instanceCount;
+	uint32_t firstVertex;
+	uint32_t firstInstance;
+};
+
+struct NullDispatchCmd
+{
+	uint32_t groupCountX;
+	uint32_t groupCountY;
+	uint32_t groupCountZ;
+};
+
+struct NullExecuteIndirectCmd
+{
+	CommandSignature* pCommandSignature;
+	Buffer*           pIndirectBuffer;
+	uint64_t          bufferOffset;
+	Buffer*           pCounterBuffer;
+	uint64_t          counterBufferOffset;
+	uint32_t          maxCommandCount;
+};
+
+/// Followed by the buffer, texture and render target barrier arrays
+struct NullResourceBarrierCmd
+{
+	uint32_t numBufferBarriers;
+	uint32_t numTextureBarriers;
+	uint32_t numRenderTargetBarriers;
+};
+
+struct NullQueryCmd
+{
+	QueryPool* pQueryPool;
+	uint32_t   mIndex;
+	uint32_t   mCount;
+};
+
+struct NullResolveQueryCmd
+{
+	QueryPool* pQueryPool;
+	Buffer*    pReadbackBuffer;
+	uint32_t   startQuery;
+	uint32_t   queryCount;
+};
+
+/// Followed by the null terminated marker name
+struct NullDebugMarkerCmd
+{
+	float r;
+	float g;
+	float b;
+};
+
+struct NullUpdateBufferCmd
+{
+	Buffer*  pSrcBuffer;
+	Buffer*  pBuffer;
+	uint64_t srcOffset;
+	uint64_t dstOffset;
+	uint64_t size;
+};
+
+struct NullUpdateSubresourceCmd
+{
+	Texture*            pTexture;
+	Buffer*             pSrcBuffer;
+	SubresourceDataDesc mSubresourceDesc;
+};
+
+/// One slot of a descriptor set table written by updateDescriptorSet
+typedef struct NullDescriptorHandle
+{
+	/// Sampler, Texture, Buffer or AccelerationStructure bound to the slot
+	const void* pResource;
+	/// Buffer offset for buffers, UAV mip slice for RW textures
+	uint64_t    mOffset;
+	uint64_t    mSize;
+} NullDescriptorHandle;
+
+static inline const NullCmdHeader* null_cmd_begin(const Cmd* pCmd) { return (const NullCmdHeader*)pCmd->pNullCmdData; }
+
+static inline const NullCmdHeader* null_cmd_end(const Cmd* pCmd) { return (const NullCmdHeader*)(pCmd->pNullCmdData + pCmd->mNullCmdSize); }
+
+static inline const NullCmdHeader* null_cmd_next(const NullCmdHeader* pHeader)
+{
+	return (const NullCmdHeader*)((const uint8_t*)pHeader + pHeader->mSize);
+}
+
+template <typename T> static inline const T* null_cmd_payload(const NullCmdHeader* pHeader) { return (const T*)(pHeader + 1); }
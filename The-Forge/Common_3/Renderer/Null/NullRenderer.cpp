@@ -0,0 +1,1657 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+/* Null renderer.
+ * Implements the low level interface without a GPU so the CPU side of an application (scene update, command
+ * recording, resource streaming) can be profiled on headless machines. Commands are recorded into a packet
+ * stream per Cmd (see NullCommands.h). queueSubmit executes the copy and query packets on the host and
+ * completes fences and semaphores after RendererDesc::mNullGpuLatency microseconds of simulated GPU time.
+ */
+
+#ifdef NULL_RENDERER
+#define RENDERER_IMPLEMENTATION
+
+#include "../../ThirdParty/OpenSource/EASTL/string.h"
+#include "../../ThirdParty/OpenSource/EASTL/unordered_map.h"
+#include "../../ThirdParty/OpenSource/EASTL/vector.h"
+#include "../../ThirdParty/OpenSource/EASTL/string_hash_map.h"
+#include "../../OS/Interfaces/ILog.h"
+#include "../../OS/Interfaces/IThread.h"
+#include "../../OS/Interfaces/ITime.h"
+#include "../../OS/Core/Atomics.h"
+#include "../IRenderer.h"
+#include "../DescriptorIndexMap.h"
+#include "../../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_base.h"
+#include "../../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_query.h"
+#include "NullCommands.h"
+
+#include "../../OS/Interfaces/IMemory.h"
+
+extern void null_createShaderReflection(const uint8_t* shaderCode, uint32_t shaderSize, ShaderStage shaderStage, ShaderReflection* pOutReflection);
+
+#define SAFE_FREE(p_var)  \
+	if (p_var)            \
+	{                     \
+		conf_free(p_var); \
+	}
+
+#if defined(__cplusplus)
+#define DECLARE_ZERO(type, var) type var = {};
+#else
+#define DECLARE_ZERO(type, var) type var = { 0 };
+#endif
+
+// clang-format off
+API_INTERFACE void FORGE_CALLCONV addBuffer(Renderer* pRenderer, const BufferDesc* desc, Buffer** pp_buffer);
+API_INTERFACE void FORGE_CALLCONV removeBuffer(Renderer* pRenderer, Buffer* p_buffer);
+API_INTERFACE void FORGE_CALLCONV addTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture);
+API_INTERFACE void FORGE_CALLCONV removeTexture(Renderer* pRenderer, Texture* pTexture);
+API_INTERFACE void FORGE_CALLCONV mapBuffer(Renderer* pRenderer, Buffer* pBuffer, ReadRange* pRange);
+API_INTERFACE void FORGE_CALLCONV unmapBuffer(Renderer* pRenderer, Buffer* pBuffer);
+API_INTERFACE void FORGE_CALLCONV cmdUpdateBuffer(Cmd* pCmd, Buffer* pBuffer, uint64_t dstOffset, Buffer* pSrcBuffer, uint64_t srcOffset, uint64_t size);
+API_INTERFACE void FORGE_CALLCONV cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, SubresourceDataDesc* pSubresourceDesc);
+// clang-format on
+
+/************************************************************************/
+// Internal utility functions
+/************************************************************************/
+static const uint32_t gNullCmdInitialCapacity = 4096;
+
+// Appends a packet of the given type to the command stream and returns its payload
+static void* null_cmd_alloc(Cmd* pCmd, NullCmdType type, uint32_t payloadSize)
+{
+	ASSERT(pCmd);
+	ASSERT(pCmd->pNullCmdData && "beginCmd was never called for that specific Cmd buffer!");
+
+	const uint32_t size = round_up((uint32_t)sizeof(NullCmdHeader) + payloadSize, 8);
+	if (pCmd->mNullCmdSize + size > pCmd->mNullCmdCapacity)
+	{
+		pCmd->mNullCmdCapacity = max(pCmd->mNullCmdCapacity * 2, pCmd->mNullCmdSize + size);
+		pCmd->pNullCmdData = (uint8_t*)conf_realloc(pCmd->pNullCmdData, pCmd->mNullCmdCapacity);
+	}
+
+	NullCmdHeader* pHeader = (NullCmdHeader*)(pCmd->pNullCmdData + pCmd->mNullCmdSize);
+	pHeader->mType = type;
+	pHeader->mSize = size;
+	pCmd->mNullCmdSize += size;
+	++pCmd->mNullCmdCount;
+	return pHeader + 1;
+}
+
+template <typename T> static T* null_cmd_alloc(Cmd* pCmd, NullCmdType type, uint32_t extraSize = 0)
+{
+	return (T*)null_cmd_alloc(pCmd, type, (uint32_t)sizeof(T) + extraSize);
+}
+
+// Size in bytes of one mip level of one array layer along with its block row pitch and block row count
+static uint64_t util_mip_size(TinyImageFormat format, uint32_t width, uint32_t height, uint32_t depth, uint32_t mip, uint32_t* pRowPitch, uint32_t* pRowCount)
+{
+	const uint32_t blockWidth = TinyImageFormat_WidthOfBlock(format);
+	const uint32_t blockHeight = TinyImageFormat_HeightOfBlock(format);
+	const uint32_t blockBytes = TinyImageFormat_BitSizeOfBlock(format) / 8;
+
+	const uint32_t mipWidth = max(1U, width >> mip);
+	const uint32_t mipHeight = max(1U, height >> mip);
+	const uint32_t mipDepth = max(1U, depth >> mip);
+
+	const uint32_t rowPitch = ((mipWidth + blockWidth - 1) / blockWidth) * blockBytes;
+	const uint32_t rowCount = (mipHeight + blockHeight - 1) / blockHeight;
+	if (pRowPitch)
+		*pRowPitch = rowPitch;
+	if (pRowCount)
+		*pRowCount = rowCount;
+	return (uint64_t)rowPitch * rowCount * mipDepth;
+}
+
+static uint64_t util_layer_size(const Texture* pTexture)
+{
+	uint64_t size = 0;
+	for (uint32_t i = 0; i < pTexture->mMipLevels; ++i)
+		size += util_mip_size(
+			(TinyImageFormat)pTexture->mFormat, (uint32_t)pTexture->mWidth, (uint32_t)pTexture->mHeight, (uint32_t)pTexture->mDepth, i, NULL, NULL);
+	return size;
+}
+
+static void util_update_buffer(const NullUpdateBufferCmd* pUpdate)
+{
+	ASSERT(pUpdate->srcOffset + pUpdate->size <= pUpdate->pSrcBuffer->mSize);
+	ASSERT(pUpdate->dstOffset + pUpdate->size <= pUpdate->pBuffer->mSize);
+	memcpy(pUpdate->pBuffer->pNullData + pUpdate->dstOffset, pUpdate->pSrcBuffer->pNullData + pUpdate->srcOffset, pUpdate->size);
+}
+
+// Copies the block rows of the uploaded region into the texture storage (layer major, full mip chain per layer)
+static void util_update_subresource(const NullUpdateSubresourceCmd* pUpdate)
+{
+	const Texture*             pTexture = pUpdate->pTexture;
+	const SubresourceDataDesc& desc = pUpdate->mSubresourceDesc;
+	if (!pTexture->pNullData)
+		return;
+
+	const TinyImageFormat format = (TinyImageFormat)pTexture->mFormat;
+	const uint32_t        blockWidth = TinyImageFormat_WidthOfBlock(format);
+	const uint32_t        blockHeight = TinyImageFormat_HeightOfBlock(format);
+	const uint32_t        blockBytes = TinyImageFormat_BitSizeOfBlock(format) / 8;
+
+	uint64_t dstOffset = desc.mArrayLayer * util_layer_size(pTexture);
+	for (uint32_t i = 0; i < desc.mMipLevel; ++i)
+		dstOffset += util_mip_size(format, (uint32_t)pTexture->mWidth, (uint32_t)pTexture->mHeight, (uint32_t)pTexture->mDepth, i, NULL, NULL);
+
+	uint32_t dstRowPitch = 0;
+	uint32_t dstRowCount = 0;
+	util_mip_size(format, (uint32_t)pTexture->mWidth, (uint32_t)pTexture->mHeight, (uint32_t)pTexture->mDepth, desc.mMipLevel, &dstRowPitch, &dstRowCount);
+
+	const uint32_t rowCount = (desc.mRegion.mHeight + blockHeight - 1) / blockHeight;
+	const uint32_t rowSize = min(dstRowPitch, ((desc.mRegion.mWidth + blockWidth - 1) / blockWidth) * blockBytes);
+	const uint32_t dstX = (desc.mRegion.mXOffset / blockWidth) * blockBytes;
+	const uint32_t dstY = desc.mRegion.mYOffset / blockHeight;
+
+	const uint8_t* pSrc = pUpdate->pSrcBuffer->pNullData + desc.mBufferOffset;
+	uint8_t*       pDst = pTexture->pNullData + dstOffset;
+	for (uint32_t z = 0; z < max(1U, desc.mRegion.mDepth); ++z)
+	{
+		const uint64_t dstSlice = (uint64_t)(desc.mRegion.mZOffset + z) * dstRowPitch * dstRowCount;
+		for (uint32_t y = 0; y < rowCount && dstY + y < dstRowCount; ++y)
+		{
+			memcpy(
+				pDst + dstSlice + (uint64_t)(dstY + y) * dstRowPitch + dstX, pSrc + (uint64_t)z * desc.mSlicePitch + (uint64_t)y * desc.mRowPitch,
+				min(rowSize, dstRowPitch - dstX));
+		}
+	}
+}
+
+static void util_wait_until(int64_t time)
+{
+	for (int64_t now = getUSec(); now < time; now = getUSec())
+	{
+		// Sleep for whole milliseconds and spin on the remainder to keep the simulated latency precise
+		const int64_t remaining = time - now;
+		Thread::Sleep(remaining > 1000 ? (unsigned)(remaining / 1000) : 0);
+	}
+}
+
+static void add_default_resources(Renderer* pRenderer)
+{
+	pRenderer->pCapBits = (GPUCapBits*)conf_calloc(1, sizeof(GPUCapBits));
+	for (uint32_t i = 0; i < TinyImageFormat_Count; ++i)
+	{
+		pRenderer->pCapBits->canShaderReadFrom[i] = true;
+		pRenderer->pCapBits->canShaderWriteTo[i] = true;
+		pRenderer->pCapBits->canRenderTargetWriteTo[i] = true;
+	}
+
+	pRenderer->pActiveGpuSettings = (GPUSettings*)conf_calloc(1, sizeof(GPUSettings));
+	GPUSettings* pSettings = pRenderer->pActiveGpuSettings;
+	pSettings->mUniformBufferAlignment = 256;
+	pSettings->mUploadBufferTextureAlignment = 16;
+	pSettings->mUploadBufferTextureRowAlignment = 1;
+	pSettings->mMaxVertexInputBindings = 32;
+	pSettings->mMaxRootSignatureDWORDS = 64;
+	pSettings->mWaveLaneCount = 32;
+	pSettings->mMultiDrawIndirect = true;
+	pSettings->mROVsSupported = true;
+	pSettings->mGpuVendorPreset.mPresetLevel = GPU_PRESET_ULTRA;
+	strncpy(pSettings->mGpuVendorPreset.mVendorId, "0x0000", MAX_GPU_VENDOR_STRING_LENGTH);
+	strncpy(pSettings->mGpuVendorPreset.mModelId, "0x0000", MAX_GPU_VENDOR_STRING_LENGTH);
+	strncpy(pSettings->mGpuVendorPreset.mRevisionId, "0x00", MAX_GPU_VENDOR_STRING_LENGTH);
+	strncpy(pSettings->mGpuVendorPreset.mGpuName, "Null Renderer", MAX_GPU_VENDOR_STRING_LENGTH);
+}
+
+static void remove_default_resources(Renderer* pRenderer)
+{
+	SAFE_FREE(pRenderer->pActiveGpuSettings);
+	SAFE_FREE(pRenderer->pCapBits);
+}
+/************************************************************************/
+// Renderer Init Remove
+/************************************************************************/
+void initRenderer(const char* appName, const RendererDesc* settings, Renderer** ppRenderer)
+{
+	ASSERT(ppRenderer);
+	ASSERT(settings);
+
+	Renderer* pRenderer = (Renderer*)conf_calloc(1, sizeof(Renderer));
+	ASSERT(pRenderer);
+
+	pRenderer->mGpuMode = settings->mGpuMode;
+	pRenderer->mShaderTarget = shader_target_6_3;
+	pRenderer->mEnableGpuBasedValidation = settings->mEnableGPUBasedValidation;
+	pRenderer->mApi = RENDERER_API_NULL;
+	pRenderer->mLinkedNodeCount = 1;
+	pRenderer->mNullGpuLatency = settings->mNullGpuLatency;
+
+	pRenderer->pName = (char*)conf_calloc(strlen(appName) + 1, sizeof(char));
+	memcpy(pRenderer->pName, appName, strlen(appName));
+
+	add_default_resources(pRenderer);
+
+	LOGF(LogLevel::eINFO, "Null renderer initialized. Simulated GPU latency: %u us", pRenderer->mNullGpuLatency);
+
+	// Renderer is good!
+	*ppRenderer = pRenderer;
+}
+
+void removeRenderer(Renderer* pRenderer)
+{
+	ASSERT(pRenderer);
+
+	if (pRenderer->mNullBufferMemory || pRenderer->mNullTextureMemory)
+	{
+		LOGF(
+			LogLevel::eWARNING, "Null renderer removed with %llu bytes of buffer and %llu bytes of texture memory still allocated",
+			(unsigned long long)pRenderer->mNullBufferMemory, (unsigned long long)pRenderer->mNullTextureMemory);
+	}
+
+	remove_default_resources(pRenderer);
+
+	SAFE_FREE(pRenderer->pName);
+	SAFE_FREE(pRenderer);
+}
+/************************************************************************/
+// Resource Creation Functions
+/************************************************************************/
+void addFence(Renderer* pRenderer, Fence** ppFence)
+{
+	ASSERT(pRenderer);
+	ASSERT(ppFence);
+
+	Fence* pFence = (Fence*)conf_calloc(1, sizeof(Fence));
+	ASSERT(pFence);
+
+	*ppFence = pFence;
+}
+
+void removeFence(Renderer* pRenderer, Fence* pFence)
+{
+	ASSERT(pRenderer);
+	ASSERT(pFence);
+
+	SAFE_FREE(pFence);
+}
+
+void addSemaphore(Renderer* pRenderer, Semaphore** ppSemaphore)
+{
+	ASSERT(pRenderer);
+	ASSERT(ppSemaphore);
+
+	Semaphore* pSemaphore = (Semaphore*)conf_calloc(1, sizeof(Semaphore));
+	ASSERT(pSemaphore);
+
+	*ppSemaphore = pSemaphore;
+}
+
+void removeSemaphore(Renderer* pRenderer, Semaphore* pSemaphore)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSemaphore);
+
+	SAFE_FREE(pSemaphore);
+}
+
+void addQueue(Renderer* pRenderer, QueueDesc* pDesc, Queue** ppQueue)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppQueue);
+
+	Queue* pQueue = (Queue*)conf_calloc(1, sizeof(Queue));
+	ASSERT(pQueue);
+
+	pQueue->mUploadGranularity = { 1, 1, 1 };
+	pQueue->mNodeIndex = pDesc->mNodeIndex;
+	pQueue->mType = pDesc->mType;
+	pQueue->mNullGpuLatency = pRenderer->mNullGpuLatency;
+	pQueue->mNullLastCompletion = 0;
+
+	*ppQueue = pQueue;
+}
+
+void removeQueue(Renderer* pRenderer, Queue* pQueue)
+{
+	ASSERT(pRenderer);
+	ASSERT(pQueue);
+
+	SAFE_FREE(pQueue);
+}
+
+void addSwapChain(Renderer* pRenderer, const SwapChainDesc* pDesc, SwapChain** ppSwapChain)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppSwapChain);
+	ASSERT(pDesc->mImageCount <= MAX_SWAPCHAIN_IMAGES);
+
+	SwapChain* pSwapChain = (SwapChain*)conf_calloc(1, sizeof(SwapChain) + pDesc->mImageCount * sizeof(RenderTarget*));
+	ASSERT(pSwapChain);
+
+	pSwapChain->ppRenderTargets = (RenderTarget**)(pSwapChain + 1);
+	ASSERT(pSwapChain->ppRenderTargets);
+
+	RenderTargetDesc descColor = {};
+	descColor.mWidth = pDesc->mWidth;
+	descColor.mHeight = pDesc->mHeight;
+	descColor.mDepth = 1;
+	descColor.mArraySize = 1;
+	descColor.mFormat = pDesc->mColorFormat;
+	descColor.mClearValue = pDesc->mColorClearValue;
+	descColor.mSampleCount = SAMPLE_COUNT_1;
+	descColor.mSampleQuality = 0;
+
+	for (uint32_t i = 0; i < pDesc->mImageCount; ++i)
+	{
+		::addRenderTarget(pRenderer, &descColor, &pSwapChain->ppRenderTargets[i]);
+	}
+
+	pSwapChain->mImageCount = pDesc->mImageCount;
+	pSwapChain->mEnableVsync = pDesc->mEnableVsync;
+	pSwapChain->mIndex = pDesc->mImageCount - 1;
+
+	*ppSwapChain = pSwapChain;
+}
+
+void removeSwapChain(Renderer* pRenderer, SwapChain* pSwapChain)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSwapChain);
+
+	for (uint32_t i = 0; i < pSwapChain->mImageCount; ++i)
+	{
+		removeRenderTarget(pRenderer, pSwapChain->ppRenderTargets[i]);
+	}
+
+	SAFE_FREE(pSwapChain);
+}
+/************************************************************************/
+// Command Pool Functions
+/************************************************************************/
+void addCmdPool(Renderer* pRenderer, const CmdPoolDesc* pDesc, CmdPool** ppCmdPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppCmdPool);
+
+	CmdPool* pCmdPool = (CmdPool*)conf_calloc(1, sizeof(CmdPool));
+	ASSERT(pCmdPool);
+
+	pCmdPool->pQueue = pDesc->pQueue;
+
+	*ppCmdPool = pCmdPool;
+}
+
+void removeCmdPool(Renderer* pRenderer, CmdPool* pCmdPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pCmdPool);
+
+	SAFE_FREE(pCmdPool);
+}
+
+void addCmd(Renderer* pRenderer, const CmdDesc* pDesc, Cmd** ppCmd)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppCmd);
+
+	Cmd* pCmd = (Cmd*)conf_calloc(1, sizeof(Cmd));
+	ASSERT(pCmd);
+
+	pCmd->pRenderer = pRenderer;
+	pCmd->pCmdPool = pDesc->pPool;
+	pCmd->pQueue = pDesc->pPool->pQueue;
+	pCmd->mType = pDesc->pPool->pQueue->mType;
+	pCmd->mNodeIndex = pDesc->pPool->pQueue->mNodeIndex;
+
+	pCmd->mNullCmdCapacity = gNullCmdInitialCapacity;
+	pCmd->pNullCmdData = (uint8_t*)conf_malloc(pCmd->mNullCmdCapacity);
+
+	*ppCmd = pCmd;
+}
+
+void removeCmd(Renderer* pRenderer, Cmd* pCmd)
+{
+	ASSERT(pRenderer);
+	ASSERT(pCmd);
+
+	SAFE_FREE(pCmd->pNullCmdData);
+	SAFE_FREE(pCmd);
+}
+
+void addCmd_n(Renderer* pRenderer, const CmdDesc* pDesc, uint32_t cmdCount, Cmd*** pppCmd)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(cmdCount);
+	ASSERT(pppCmd);
+
+	Cmd** ppCmds = (Cmd**)conf_calloc(cmdCount, sizeof(Cmd*));
+	ASSERT(ppCmds);
+
+	for (uint32_t i = 0; i < cmdCount; ++i)
+	{
+		::addCmd(pRenderer, pDesc, &ppCmds[i]);
+	}
+
+	*pppCmd = ppCmds;
+}
+
+void removeCmd_n(Renderer* pRenderer, uint32_t cmdCount, Cmd** ppCmds)
+{
+	ASSERT(ppCmds);
+
+	for (uint32_t i = 0; i < cmdCount; ++i)
+	{
+		removeCmd(pRenderer, ppCmds[i]);
+	}
+
+	SAFE_FREE(ppCmds);
+}
+/************************************************************************/
+// All buffer, texture loading handled by resource system -> IResourceLoader.
+/************************************************************************/
+void addBuffer(Renderer* pRenderer, const BufferDesc* pDesc, Buffer** ppBuffer)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(pDesc->mSize > 0);
+	ASSERT(ppBuffer);
+
+	Buffer* pBuffer = (Buffer*)conf_calloc(1, sizeof(Buffer));
+	ASSERT(pBuffer);
+
+	uint64_t allocationSize = pDesc->mSize;
+	// Align the buffer size to multiples of the dynamic uniform buffer minimum size
+	if (pDesc->mDescriptors & DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+	{
+		allocationSize = round_up_64(allocationSize, pRenderer->pActiveGpuSettings->mUniformBufferAlignment);
+	}
+
+	pBuffer->pNullData = (uint8_t*)conf_calloc(1, allocationSize);
+	ASSERT(pBuffer->pNullData);
+	tfrg_atomic64_add_relaxed(&pRenderer->mNullBufferMemory, allocationSize);
+
+	// Host visible buffers are persistently mapped like the other backends do with BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT
+	if (pDesc->mMemoryUsage != RESOURCE_MEMORY_USAGE_GPU_ONLY && (pDesc->mFlags & BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT))
+	{
+		pBuffer->pCpuMappedAddress = pBuffer->pNullData;
+	}
+
+	pBuffer->mSize = (uint32_t)pDesc->mSize;
+	pBuffer->mMemoryUsage = pDesc->mMemoryUsage;
+	pBuffer->mNodeIndex = pDesc->mNodeIndex;
+	pBuffer->mStartState = pDesc->mStartState;
+	pBuffer->mCurrentState = pDesc->mStartState;
+	pBuffer->mDescriptors = pDesc->mDescriptors;
+
+	*ppBuffer = pBuffer;
+}
+
+void removeBuffer(Renderer* pRenderer, Buffer* pBuffer)
+{
+	ASSERT(pRenderer);
+	ASSERT(pBuffer);
+
+	uint64_t allocationSize = pBuffer->mSize;
+	if (pBuffer->mDescriptors & DESCRIPTOR_TYPE_UNIFORM_BUFFER)
+	{
+		allocationSize = round_up_64(allocationSize, pRenderer->pActiveGpuSettings->mUniformBufferAlignment);
+	}
+	tfrg_atomic64_add_relaxed(&pRenderer->mNullBufferMemory, -(int64_t)allocationSize);
+
+	SAFE_FREE(pBuffer->pNullData);
+	SAFE_FREE(pBuffer);
+}
+
+void mapBuffer(Renderer* pRenderer, Buffer* pBuffer, ReadRange* pRange)
+{
+	UNREF_PARAM(pRenderer);
+	UNREF_PARAM(pRange);
+	ASSERT(pBuffer);
+	ASSERT(pBuffer->mMemoryUsage != RESOURCE_MEMORY_USAGE_GPU_ONLY && "Trying to map non-cpu accessible resource");
+
+	pBuffer->pCpuMappedAddress = pBuffer->pNullData;
+}
+
+void unmapBuffer(Renderer* pRenderer, Buffer* pBuffer)
+{
+	UNREF_PARAM(pRenderer);
+	ASSERT(pBuffer);
+	ASSERT(pBuffer->mMemoryUsage != RESOURCE_MEMORY_USAGE_GPU_ONLY && "Trying to unmap non-cpu accessible resource");
+
+	pBuffer->pCpuMappedAddress = NULL;
+}
+
+void addTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc && pDesc->mWidth && pDesc->mHeight && (pDesc->mDepth || pDesc->mArraySize));
+	ASSERT(ppTexture);
+
+	if (pDesc->mSampleCount > SAMPLE_COUNT_1 && pDesc->mMipLevels > 1)
+	{
+		LOGF(LogLevel::eERROR, "Multi-Sampled textures cannot have mip maps");
+		ASSERT(false);
+		return;
+	}
+
+	Texture* pTexture = (Texture*)conf_calloc(1, sizeof(Texture));
+	ASSERT(pTexture);
+
+	pTexture->mNodeIndex = pDesc->mNodeIndex;
+	pTexture->mStartState = pDesc->mStartState;
+	pTexture->mCurrentState = pDesc->mStartState;
+	pTexture->mUav = pDesc->mDescriptors & DESCRIPTOR_TYPE_RW_TEXTURE;
+	pTexture->mMipLevels = max(1U, pDesc->mMipLevels);
+	pTexture->mWidth = pDesc->mWidth;
+	pTexture->mHeight = pDesc->mHeight;
+	pTexture->mDepth = max(1U, pDesc->mDepth);
+	pTexture->mArraySize = max(1U, pDesc->mArraySize);
+	pTexture->mFormat = pDesc->mFormat;
+	pTexture->mOwnsImage = true;
+
+	// Render targets are only ever written by draws and dispatches which are not executed, so they need no storage
+	const bool isRenderTarget = (pDesc->mStartState & (RESOURCE_STATE_RENDER_TARGET | RESOURCE_STATE_DEPTH_WRITE)) != 0;
+	if (!isRenderTarget)
+	{
+		pTexture->mNullDataSize = util_layer_size(pTexture) * pTexture->mArraySize;
+		pTexture->pNullData = (uint8_t*)conf_calloc(1, pTexture->mNullDataSize);
+		ASSERT(pTexture->pNullData);
+		tfrg_atomic64_add_relaxed(&pRenderer->mNullTextureMemory, pTexture->mNullDataSize);
+	}
+
+	if (pDesc->mHostVisible)
+	{
+		LOGF(LogLevel::eWARNING, "Null renderer does not map host visible textures");
+	}
+
+	*ppTexture = pTexture;
+}
+
+void removeTexture(Renderer* pRenderer, Texture* pTexture)
+{
+	ASSERT(pRenderer);
+	ASSERT(pTexture);
+
+	if (pTexture->pNullData)
+	{
+		tfrg_atomic64_add_relaxed(&pRenderer->mNullTextureMemory, -(int64_t)pTexture->mNullDataSize);
+		SAFE_FREE(pTexture->pNullData);
+	}
+
+	SAFE_FREE(pTexture);
+}
+
+void addRenderTarget(Renderer* pRenderer, const RenderTargetDesc* pDesc, RenderTarget** ppRenderTarget)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppRenderTarget);
+
+	bool const isDepth = TinyImageFormat_IsDepthAndStencil(pDesc->mFormat) || TinyImageFormat_IsDepthOnly(pDesc->mFormat);
+
+	ASSERT(!((isDepth) && (pDesc->mDescriptors & DESCRIPTOR_TYPE_RW_TEXTURE)) && "Cannot use depth stencil as UAV");
+
+	RenderTarget* pRenderTarget = (RenderTarget*)conf_calloc(1, sizeof(RenderTarget));
+	ASSERT(pRenderTarget);
+
+	TextureDesc textureDesc = {};
+	textureDesc.mArraySize = pDesc->mArraySize;
+	textureDesc.mClearValue = pDesc->mClearValue;
+	textureDesc.mDepth = pDesc->mDepth;
+	textureDesc.mFlags = pDesc->mFlags;
+	textureDesc.mFormat = pDesc->mFormat;
+	textureDesc.mHeight = pDesc->mHeight;
+	textureDesc.mMipLevels = max(1U, pDesc->mMipLevels);
+	textureDesc.mSampleCount = pDesc->mSampleCount;
+	textureDesc.mSampleQuality = pDesc->mSampleQuality;
+	textureDesc.mWidth = pDesc->mWidth;
+	textureDesc.mNodeIndex = pDesc->mNodeIndex;
+	textureDesc.mDescriptors = pDesc->mDescriptors | DESCRIPTOR_TYPE_TEXTURE;
+	textureDesc.mStartState = isDepth ? RESOURCE_STATE_DEPTH_WRITE : RESOURCE_STATE_RENDER_TARGET;
+
+	addTexture(pRenderer, &textureDesc, &pRenderTarget->pTexture);
+
+	pRenderTarget->mWidth = pDesc->mWidth;
+	pRenderTarget->mHeight = pDesc->mHeight;
+	pRenderTarget->mArraySize = pDesc->mArraySize;
+	pRenderTarget->mDepth = pDesc->mDepth;
+	pRenderTarget->mMipLevels = textureDesc.mMipLevels;
+	pRenderTarget->mSampleCount = pDesc->mSampleCount;
+	pRenderTarget->mSampleQuality = pDesc->mSampleQuality;
+	pRenderTarget->mFormat = pDesc->mFormat;
+	pRenderTarget->mClearValue = pDesc->mClearValue;
+	pRenderTarget->mDescriptors = pDesc->mDescriptors;
+
+	*ppRenderTarget = pRenderTarget;
+}
+
+void removeRenderTarget(Renderer* pRenderer, RenderTarget* pRenderTarget)
+{
+	ASSERT(pRenderer);
+	ASSERT(pRenderTarget);
+
+	removeTexture(pRenderer, pRenderTarget->pTexture);
+
+	SAFE_FREE(pRenderTarget);
+}
+
+void addSampler(Renderer* pRenderer, const SamplerDesc* pDesc, Sampler** ppSampler)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(pDesc->mCompareFunc < MAX_COMPARE_MODES);
+	ASSERT(ppSampler);
+
+	Sampler* pSampler = (Sampler*)conf_calloc(1, sizeof(Sampler));
+	ASSERT(pSampler);
+
+	*ppSampler = pSampler;
+}
+
+void removeSampler(Renderer* pRenderer, Sampler* pSampler)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSampler);
+
+	SAFE_FREE(pSampler);
+}
+/************************************************************************/
+// Shader Functions
+/************************************************************************/
+void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader** ppShaderProgram)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc && pDesc->mStages);
+	ASSERT(ppShaderProgram);
+
+	Shader* pShaderProgram = (Shader*)conf_calloc(1, sizeof(Shader) + sizeof(PipelineReflection));
+	ASSERT(pShaderProgram);
+
+	pShaderProgram->mStages = pDesc->mStages;
+	pShaderProgram->pReflection = (PipelineReflection*)(pShaderProgram + 1);
+
+	uint32_t reflectionCount = 0;
+
+	for (uint32_t i = 0; i < SHADER_STAGE_COUNT; ++i)
+	{
+		ShaderStage                  stage_mask = (ShaderStage)(1 << i);
+		const BinaryShaderStageDesc* pStage = NULL;
+
+		if (stage_mask == (pShaderProgram->mStages & stage_mask))
+		{
+			switch (stage_mask)
+			{
+				case SHADER_STAGE_VERT: pStage = &pDesc->mVert; break;
+				case SHADER_STAGE_TESC: pStage = &pDesc->mHull; break;
+				case SHADER_STAGE_TESE: pStage = &pDesc->mDomain; break;
+				case SHADER_STAGE_GEOM: pStage = &pDesc->mGeom; break;
+				case SHADER_STAGE_FRAG: pStage = &pDesc->mFrag; break;
+				case SHADER_STAGE_COMP:
+				case SHADER_STAGE_RAYTRACING: pStage = &pDesc->mComp; break;
+				default: break;
+			}
+
+			if (!deserializeShaderReflection(
+					pStage->pReflection, pStage->mReflectionSize, stage_mask,
+					&pShaderProgram->pReflection->mStageReflections[reflectionCount]))
+			{
+				null_createShaderReflection(
+					(const uint8_t*)(pStage->pByteCode), (uint32_t)pStage->mByteCodeSize, stage_mask,
+					&pShaderProgram->pReflection->mStageReflections[reflectionCount]);
+			}
+
+			reflectionCount++;
+		}
+	}
+
+	createPipelineReflection(pShaderProgram->pReflection->mStageReflections, reflectionCount, pShaderProgram->pReflection);
+
+	*ppShaderProgram = pShaderProgram;
+}
+
+void removeShader(Renderer* pRenderer, Shader* pShaderProgram)
+{
+	UNREF_PARAM(pRenderer);
+	ASSERT(pShaderProgram);
+
+	destroyPipelineReflection(pShaderProgram->pReflection);
+
+	SAFE_FREE(pShaderProgram);
+}
+/************************************************************************/
+// Root Signature Functions
+/************************************************************************/
+void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatureDesc, RootSignature** ppRootSignature)
+{
+	ASSERT(pRenderer);
+	ASSERT(pRootSignatureDesc);
+	ASSERT(ppRootSignature);
+
+	eastl::vector<ShaderResource> shaderResources;
+	DescriptorNameToIndexMap      indexMap;
+	PipelineType                  pipelineType = PIPELINE_TYPE_UNDEFINED;
+
+	eastl::unordered_map<eastl::string, Sampler*> staticSamplerMap;
+	for (uint32_t i = 0; i < pRootSignatureDesc->mStaticSamplerCount; ++i)
+		staticSamplerMap.insert({ { pRootSignatureDesc->ppStaticSamplerNames[i], pRootSignatureDesc->ppStaticSamplers[i] } });
+
+	// Collect all unique shader resources in the given shaders
+	// Resources are parsed by name (two resources named "XYZ" in two shaders will be considered the same resource)
+	for (uint32_t sh = 0; sh < pRootSignatureDesc->mShaderCount; ++sh)
+	{
+		PipelineReflection const* pReflection = pRootSignatureDesc->ppShaders[sh]->pReflection;
+
+		if (pReflection->mShaderStages & SHADER_STAGE_COMP)
+			pipelineType = PIPELINE_TYPE_COMPUTE;
+		else if (pReflection->mShaderStages & SHADER_STAGE_RAYTRACING)
+			pipelineType = PIPELINE_TYPE_RAYTRACING;
+		else
+			pipelineType = PIPELINE_TYPE_GRAPHICS;
+
+		for (uint32_t i = 0; i < pReflection->mShaderResourceCount; ++i)
+		{
+			ShaderResource const*             pRes = &pReflection->pShaderResources[i];
+			decltype(indexMap)::iterator pNode = indexMap.find(pRes->name);
+			if (pNode == indexMap.end())
+			{
+				indexMap.insert(pRes->name, (uint32_t)shaderResources.size());
+				shaderResources.push_back(*pRes);
+			}
+			// If the resource was already collected, just update the shader stage mask in case it is used in a different
+			// shader stage in this case
+			else
+			{
+				// The source reflection does not evaluate #if blocks so only warn on layout mismatches
+				if (shaderResources[pNode->second].reg != pRes->reg || shaderResources[pNode->second].set != pRes->set)
+				{
+					LOGF(LogLevel::eWARNING, "Shared shader resource %s has mismatching register or space", pRes->name);
+				}
+				shaderResources[pNode->second].used_stages |= pRes->used_stages;
+			}
+		}
+	}
+
+	size_t totalSize = sizeof(RootSignature);
+	totalSize += shaderResources.size() * sizeof(DescriptorInfo);
+	totalSize += descriptor_index_map_size(indexMap);
+
+	RootSignature* pRootSignature = (RootSignature*)conf_calloc(1, totalSize);
+	ASSERT(pRootSignature);
+
+	pRootSignature->mDescriptorCount = (uint32_t)shaderResources.size();
+	pRootSignature->pDescriptors = (DescriptorInfo*)(pRootSignature + 1);
+	pRootSignature->pDescriptorNameToIndexMap = (DescriptorIndexMap*)(pRootSignature->pDescriptors + pRootSignature->mDescriptorCount);
+	ASSERT(pRootSignature->pDescriptorNameToIndexMap);
+	init_descriptor_index_map(pRootSignature->pDescriptorNameToIndexMap, indexMap);
+
+	pRootSignature->mPipelineType = pipelineType;
+
+	// Fill the descriptor array to be stored in the root signature
+	for (uint32_t i = 0; i < (uint32_t)shaderResources.size(); ++i)
+	{
+		DescriptorInfo*       pDesc = &pRootSignature->pDescriptors[i];
+		const ShaderResource* pRes = &shaderResources[i];
+		uint32_t              setIndex = min((uint32_t)pRes->set, (uint32_t)DESCRIPTOR_UPDATE_FREQ_COUNT - 1);
+
+		// If the size of the resource is zero, assume its a bindless resource
+		// All bindless resources will go in the static descriptor table
+		if (pRes->size == 0)
+			setIndex = 0;
+
+		pDesc->pName = pRes->name;
+		pDesc->mReg = pRes->reg;
+		pDesc->mSize = pRes->size;
+		pDesc->mType = pRes->type;
+		pDesc->mDim = pRes->dim;
+		pDesc->mUsedStages = pRes->used_stages;
+		pDesc->mUpdateFrequency = setIndex;
+		pDesc->mIndexInParent = i;
+		pDesc->mHandleIndex = 0;
+
+		if (pDesc->mType == DESCRIPTOR_TYPE_ROOT_CONSTANT)
+		{
+			// Root constants are recorded into the command stream, mSize is the size of the block in bytes
+			pDesc->mRootDescriptor = 1;
+			continue;
+		}
+
+		if (pDesc->mType == DESCRIPTOR_TYPE_SAMPLER)
+		{
+			decltype(staticSamplerMap)::iterator pNode = staticSamplerMap.find(pDesc->pName);
+			if (pNode != staticSamplerMap.end())
+			{
+				LOGF(LogLevel::eINFO, "Descriptor (%s) : User specified Static Sampler", pDesc->pName);
+				// Set the index to invalid value so we can use this later for error checking if user tries to update a static sampler
+				pDesc->mIndexInParent = -1;
+				continue;
+			}
+		}
+
+		const uint32_t slotCount = pDesc->mSize ? pDesc->mSize : max(1U, pRootSignatureDesc->mMaxBindlessTextures);
+		pDesc->mHandleIndex = pRootSignature->mNullDescriptorCounts[setIndex];
+		pRootSignature->mNullDescriptorCounts[setIndex] += slotCount;
+	}
+
+	*ppRootSignature = pRootSignature;
+}
+
+void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
+{
+	UNREF_PARAM(pRenderer);
+	ASSERT(pRootSignature);
+
+	SAFE_FREE(pRootSignature);
+}
+/************************************************************************/
+// Pipeline Functions
+/************************************************************************/
+void addPipeline(Renderer* pRenderer, const PipelineDesc* pDesc, Pipeline** ppPipeline)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipeline);
+
+	Pipeline* pPipeline = (Pipeline*)conf_calloc(1, sizeof(Pipeline));
+	ASSERT(pPipeline);
+
+	pPipeline->mType = pDesc->mType;
+	switch (pDesc->mType)
+	{
+		case PIPELINE_TYPE_COMPUTE:
+			ASSERT(pDesc->mComputeDesc.pShaderProgram);
+			pPipeline->pRootSignature = pDesc->mComputeDesc.pRootSignature;
+			break;
+		case PIPELINE_TYPE_GRAPHICS:
+			ASSERT(pDesc->mGraphicsDesc.pShaderProgram);
+			pPipeline->pRootSignature = pDesc->mGraphicsDesc.pRootSignature;
+			break;
+		case PIPELINE_TYPE_RAYTRACING: pPipeline->pRootSignature = pDesc->mRaytracingDesc.pGlobalRootSignature; break;
+		default: ASSERT(false); break;
+	}
+
+	*ppPipeline = pPipeline;
+}
+
+void removePipeline(Renderer* pRenderer, Pipeline* pPipeline)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipeline);
+
+	SAFE_FREE(pPipeline);
+}
+/************************************************************************/
+// Pipeline Cache Functions
+/************************************************************************/
+// There is nothing to compile, the cache object only exists for API parity
+void addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipelineCache);
+
+	PipelineCache* pPipelineCache = (PipelineCache*)conf_calloc(1, sizeof(PipelineCache));
+	ASSERT(pPipelineCache);
+
+	*ppPipelineCache = pPipelineCache;
+}
+
+void removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+
+	SAFE_FREE(pPipelineCache);
+}
+
+void getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData)
+{
+	ASSERT(pSize);
+	*pSize = 0;
+}
+/************************************************************************/
+// Descriptor Set Implementation
+/************************************************************************/
+const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const DescriptorName& name)
+{
+	const uint32_t index = find_descriptor_index(pRootSignature->pDescriptorNameToIndexMap, name);
+	if (index != (uint32_t)-1)
+	{
+		return &pRootSignature->pDescriptors[index];
+	}
+	else
+	{
+		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", name.pName);
+		return NULL;
+	}
+}
+
+void addDescriptorSet(Renderer* pRenderer, const DescriptorSetDesc* pDesc, DescriptorSet** ppDescriptorSet)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppDescriptorSet);
+
+	const RootSignature* pRootSignature = pDesc->pRootSignature;
+	const uint32_t       handleCount = pRootSignature->mNullDescriptorCounts[pDesc->mUpdateFrequency] * pDesc->mMaxSets;
+
+	DescriptorSet* pDescriptorSet = (DescriptorSet*)conf_calloc(1, sizeof(DescriptorSet) + handleCount * sizeof(NullDescriptorHandle));
+	ASSERT(pDescriptorSet);
+
+	pDescriptorSet->pHandles = (NullDescriptorHandle*)(pDescriptorSet + 1);
+	pDescriptorSet->pRootSignature = pRootSignature;
+	pDescriptorSet->mMaxSets = pDesc->mMaxSets;
+	pDescriptorSet->mUpdateFrequency = (uint8_t)pDesc->mUpdateFrequency;
+	pDescriptorSet->mNodeIndex = (uint8_t)pDesc->mNodeIndex;
+
+	*ppDescriptorSet = pDescriptorSet;
+}
+
+void removeDescriptorSet(Renderer* pRenderer, DescriptorSet* pDescriptorSet)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescriptorSet);
+
+	SAFE_FREE(pDescriptorSet);
+}
+
+void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDescriptorSet, uint32_t count, const DescriptorData* pParams)
+{
+#ifdef _DEBUG
+#define VALIDATE_DESCRIPTOR(descriptor,...)																\
+	if (!(descriptor))																					\
+	{																									\
+		eastl::string msg = __FUNCTION__ + eastl::string(" : ") + eastl::string().sprintf(__VA_ARGS__);	\
+		LOGF(LogLevel::eERROR, msg.c_str());															\
+		_FailedAssert(__FILE__, __LINE__, msg.c_str());													\
+		continue;																						\
+	}
+#else
+#define VALIDATE_DESCRIPTOR(descriptor,...)
+#endif
+
+	ASSERT(pRenderer);
+	ASSERT(pDescriptorSet);
+	ASSERT(index < pDescriptorSet->mMaxSets);
+
+	const RootSignature*  pRootSignature = pDescriptorSet->pRootSignature;
+	const uint32_t        setHandleCount = pRootSignature->mNullDescriptorCounts[pDescriptorSet->mUpdateFrequency];
+	NullDescriptorHandle* pHandles = pDescriptorSet->pHandles + (uint64_t)index * setHandleCount;
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		const DescriptorData* pParam = pParams + i;
+		uint32_t              paramIndex = pParam->mIndex;
+		const DescriptorInfo* pDesc =
+			(paramIndex != (uint32_t)-1) ? (pRootSignature->pDescriptors + paramIndex) : get_descriptor(pRootSignature, pParam->pName);
+
+		VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName.pName);
+		if (!pDesc)
+			continue;
+
+		VALIDATE_DESCRIPTOR(
+			pDesc->mUpdateFrequency == pDescriptorSet->mUpdateFrequency, "Descriptor (%s) - Mismatching update frequency and register space",
+			pDesc->pName);
+
+		const DescriptorType type = (DescriptorType)pDesc->mType;
+		const uint32_t       arrayCount = max(1U, pParam->mCount);
+
+		switch (type)
+		{
+			case DESCRIPTOR_TYPE_SAMPLER:
+			{
+				// Index is invalid when descriptor is a static sampler
+				VALIDATE_DESCRIPTOR(
+					pDesc->mIndexInParent != -1,
+					"Trying to update a static sampler (%s). All static samplers must be set in addRootSignature and cannot be updated later",
+					pDesc->pName);
+
+				VALIDATE_DESCRIPTOR(pParam->ppSamplers, "NULL Sampler (%s)", pDesc->pName);
+
+				for (uint32_t arr = 0; arr < arrayCount; ++arr)
+				{
+					VALIDATE_DESCRIPTOR(pParam->ppSamplers[arr], "NULL Sampler (%s [%u] )", pDesc->pName, arr);
+					pHandles[pDesc->mHandleIndex + arr] = { pParam->ppSamplers[arr], 0, 0 };
+				}
+				break;
+			}
+			case DESCRIPTOR_TYPE_TEXTURE:
+			case DESCRIPTOR_TYPE_RW_TEXTURE:
+			{
+				VALIDATE_DESCRIPTOR(pParam->ppTextures, "NULL Texture (%s)", pDesc->pName);
+				const uint32_t mipSlice = type == DESCRIPTOR_TYPE_RW_TEXTURE ? pParam->mUAVMipSlice : 0;
+
+				for (uint32_t arr = 0; arr < arrayCount; ++arr)
+				{
+					VALIDATE_DESCRIPTOR(pParam->ppTextures[arr], "NULL Texture (%s [%u] )", pDesc->pName, arr);
+					VALIDATE_DESCRIPTOR(
+						mipSlice < pParam->ppTextures[arr]->mMipLevels, "Descriptor : (%s [%u] ) Mip Slice (%u) exceeds mip levels (%u)",
+						pDesc->pName, arr, mipSlice, (uint32_t)pParam->ppTextures[arr]->mMipLevels);
+					pHandles[pDesc->mHandleIndex + arr] = { pParam->ppTextures[arr], mipSlice, 0 };
+				}
+				break;
+			}
+			case DESCRIPTOR_TYPE_BUFFER:
+			case DESCRIPTOR_TYPE_BUFFER_RAW:
+			case DESCRIPTOR_TYPE_RW_BUFFER:
+			case DESCRIPTOR_TYPE_RW_BUFFER_RAW:
+			case DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+			{
+				VALIDATE_DESCRIPTOR(pParam->ppBuffers, "NULL Buffer (%s)", pDesc->pName);
+
+				for (uint32_t arr = 0; arr < arrayCount; ++arr)
+				{
+					VALIDATE_DESCRIPTOR(pParam->ppBuffers[arr], "NULL Buffer (%s [%u] )", pDesc->pName, arr);
+					if (pParam->pOffsets || pParam->pSizes)
+					{
+						VALIDATE_DESCRIPTOR(pParam->pSizes, "Descriptor (%s) - pSizes must be provided with pOffsets", pDesc->pName);
+						VALIDATE_DESCRIPTOR(pParam->pSizes[arr] > 0, "Descriptor (%s) - pSizes[%u] is zero", pDesc->pName, arr);
+					}
+
+					pHandles[pDesc->mHandleIndex + arr] = { pParam->ppBuffers[arr], pParam->pOffsets ? pParam->pOffsets[arr] : 0,
+															pParam->pSizes ? pParam->pSizes[arr] : pParam->ppBuffers[arr]->mSize };
+				}
+				break;
+			}
+			case DESCRIPTOR_TYPE_RAY_TRACING:
+			{
+				VALIDATE_DESCRIPTOR(pParam->ppAccelerationStructures, "NULL Acceleration Structure (%s)", pDesc->pName);
+
+				for (uint32_t arr = 0; arr < arrayCount; ++arr)
+				{
+					pHandles[pDesc->mHandleIndex + arr] = { pParam->ppAccelerationStructures[arr], 0, 0 };
+				}
+				break;
+			}
+			default: break;
+		}
+	}
+}
+/************************************************************************/
+// Command buffer Functions
+/************************************************************************/
+void beginCmd(Cmd* pCmd)
+{
+	ASSERT(pCmd);
+
+	pCmd->mNullCmdSize = 0;
+	pCmd->mNullCmdCount = 0;
+}
+
+void endCmd(Cmd* pCmd) { ASSERT(pCmd); }
+
+void cmdBindRenderTargets(
+	Cmd* pCmd, uint32_t renderTargetCount, RenderTarget** ppRenderTargets, RenderTarget* pDepthStencil,
+	const LoadActionsDesc* pLoadActions /* = NULL*/, uint32_t* pColorArraySlices, uint32_t* pColorMipSlices, uint32_t depthArraySlice,
+	uint32_t depthMipSlice)
+{
+	ASSERT(pCmd);
+	ASSERT(renderTargetCount <= MAX_RENDER_TARGET_ATTACHMENTS);
+	UNREF_PARAM(pColorArraySlices);
+	UNREF_PARAM(pColorMipSlices);
+	UNREF_PARAM(depthArraySlice);
+	UNREF_PARAM(depthMipSlice);
+
+	NullBindRenderTargetsCmd* pPacket = null_cmd_alloc<NullBindRenderTargetsCmd>(pCmd, NULL_CMD_TYPE_cmdBindRenderTargets);
+	for (uint32_t i = 0; i < renderTargetCount; ++i)
+		pPacket->ppRenderTargets[i] = ppRenderTargets[i];
+	pPacket->pDepthStencil = pDepthStencil;
+	pPacket->mRenderTargetCount = renderTargetCount;
+	pPacket->mHasLoadActions = pLoadActions != NULL;
+	if (pLoadActions)
+		pPacket->mLoadActions = *pLoadActions;
+}
+
+void cmdSetViewport(Cmd* pCmd, float x, float y, float width, float height, float minDepth, float maxDepth)
+{
+	*null_cmd_alloc<NullSetViewportCmd>(pCmd, NULL_CMD_TYPE_cmdSetViewport) = { x, y, width, height, minDepth, maxDepth };
+}
+
+void cmdSetScissor(Cmd* pCmd, uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+{
+	*null_cmd_alloc<NullSetScissorCmd>(pCmd, NULL_CMD_TYPE_cmdSetScissor) = { x, y, width, height };
+}
+
+void cmdBindPipeline(Cmd* pCmd, Pipeline* pPipeline)
+{
+	ASSERT(pPipeline);
+	null_cmd_alloc<NullBindPipelineCmd>(pCmd, NULL_CMD_TYPE_cmdBindPipeline)->pPipeline = pPipeline;
+}
+
+void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorSet)
+{
+	ASSERT(pDescriptorSet);
+	ASSERT(index < pDescriptorSet->mMaxSets);
+	*null_cmd_alloc<NullBindDescriptorSetCmd>(pCmd, NULL_CMD_TYPE_cmdBindDescriptorSet) = { pDescriptorSet, index };
+}
+
+static void util_bind_push_constants(Cmd* pCmd, const DescriptorInfo* pDesc, const void* pConstants)
+{
+	ASSERT(pDesc->mType == DESCRIPTOR_TYPE_ROOT_CONSTANT);
+	NullBindPushConstantsCmd* pPacket = null_cmd_alloc<NullBindPushConstantsCmd>(pCmd, NULL_CMD_TYPE_cmdBindPushConstants, pDesc->mSize);
+	pPacket->pDesc = pDesc;
+	pPacket->mSize = pDesc->mSize;
+	memcpy(pPacket + 1, pConstants, pDesc->mSize);
+}
+
+void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, DescriptorName name, const void* pConstants)
+{
+	ASSERT(pRootSignature);
+	ASSERT(name.pName);
+	ASSERT(pConstants);
+
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, name);
+	ASSERT(pDesc);
+	if (pDesc)
+		util_bind_push_constants(pCmd, pDesc, pConstants);
+}
+
+void cmdBindPushConstantsByIndex(Cmd* pCmd, RootSignature* pRootSignature, uint32_t paramIndex, const void* pConstants)
+{
+	ASSERT(pRootSignature);
+	ASSERT(pConstants);
+	ASSERT(paramIndex < pRootSignature->mDescriptorCount);
+
+	util_bind_push_constants(pCmd, pRootSignature->pDescriptors + paramIndex, pConstants);
+}
+
+void cmdBindIndexBuffer(Cmd* pCmd, Buffer* pBuffer, uint32_t indexType, uint64_t offset)
+{
+	ASSERT(pBuffer);
+	NullBindIndexBufferCmd* pPacket = null_cmd_alloc<NullBindIndexBufferCmd>(pCmd, NULL_CMD_TYPE_cmdBindIndexBuffer);
+	pPacket->pBuffer = pBuffer;
+	pPacket->mOffset = offset;
+	pPacket->mIndexType = indexType;
+}
+
+void cmdBindVertexBuffer(Cmd* pCmd, uint32_t bufferCount, Buffer** ppBuffers, const uint32_t* pStrides, const uint64_t* pOffsets)
+{
+	ASSERT(bufferCount);
+	ASSERT(ppBuffers);
+	ASSERT(pStrides);
+
+	const uint32_t arraySize = bufferCount * (uint32_t)(sizeof(Buffer*) + sizeof(uint32_t) + sizeof(uint64_t));
+	NullBindVertexBufferCmd* pPacket = null_cmd_alloc<NullBindVertexBufferCmd>(pCmd, NULL_CMD_TYPE_cmdBindVertexBuffer, arraySize);
+	pPacket->mBufferCount = bufferCount;
+	pPacket->mHasOffsets = pOffsets != NULL;
+
+	// Pointers and offsets first to keep them 8 byte aligned
+	Buffer**  ppDstBuffers = (Buffer**)(pPacket + 1);
+	uint64_t* pDstOffsets = (uint64_t*)(ppDstBuffers + bufferCount);
+	uint32_t* pDstStrides = (uint32_t*)(pDstOffsets + bufferCount);
+	for (uint32_t i = 0; i < bufferCount; ++i)
+	{
+		ppDstBuffers[i] = ppBuffers[i];
+		pDstOffsets[i] = pOffsets ? pOffsets[i] : 0;
+		pDstStrides[i] = pStrides[i];
+	}
+}
+
+void cmdDraw(Cmd* pCmd, uint32_t vertexCount, uint32_t firstVertex)
+{
+	*null_cmd_alloc<NullDrawCmd>(pCmd, NULL_CMD_TYPE_cmdDraw) = { vertexCount, firstVertex };
+}
+
+void cmdDrawInstanced(Cmd* pCmd, uint32_t vertexCount, uint32_t firstVertex, uint32_t instanceCount, uint32_t firstInstance)
+{
+	*null_cmd_alloc<NullDrawInstancedCmd>(pCmd, NULL_CMD_TYPE_cmdDrawInstanced) = { vertexCount, firstVertex, instanceCount, firstInstance };
+}
+
+void cmdDrawIndexed(Cmd* pCmd, uint32_t indexCount, uint32_t firstIndex, uint32_t firstVertex)
+{
+	*null_cmd_alloc<NullDrawIndexedCmd>(pCmd, NULL_CMD_TYPE_cmdDrawIndexed) = { indexCount, firstIndex, firstVertex };
+}
+
+void cmdDrawIndexedInstanced(
+	Cmd* pCmd, uint32_t indexCount, uint32_t firstIndex, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+{
+	*null_cmd_alloc<NullDrawIndexedInstancedCmd>(pCmd, NULL_CMD_TYPE_cmdDrawIndexedInstanced) = { indexCount, firstIndex, instanceCount,
+																								  firstVertex, firstInstance };
+}
+
+void cmdDispatch(Cmd* pCmd, uint32_t groupCountX, uint32_t groupCountY, uint32_t groupCountZ)
+{
+	*null_cmd_alloc<NullDispatchCmd>(pCmd, NULL_CMD_TYPE_cmdDispatch) = { groupCountX, groupCountY, groupCountZ };
+}
+
+void cmdResourceBarrier(
+	Cmd* pCmd, uint32_t numBufferBarriers, BufferBarrier* pBufferBarriers, uint32_t numTextureBarriers, TextureBarrier* pTextureBarriers,
+	uint32_t numRtBarriers, RenderTargetBarrier* pRtBarriers)
+{
+	const uint32_t bufferSize = numBufferBarriers * (uint32_t)sizeof(BufferBarrier);
+	const uint32_t textureSize = numTextureBarriers * (uint32_t)sizeof(TextureBarrier);
+	const uint32_t rtSize = numRtBarriers * (uint32_t)sizeof(RenderTargetBarrier);
+
+	NullResourceBarrierCmd* pPacket =
+		null_cmd_alloc<NullResourceBarrierCmd>(pCmd, NULL_CMD_TYPE_cmdResourceBarrier, bufferSize + textureSize + rtSize + 8);
+	pPacket->numBufferBarriers = numBufferBarriers;
+	pPacket->numTextureBarriers = numTextureBarriers;
+	pPacket->numRenderTargetBarriers = numRtBarriers;
+
+	uint8_t* pDst = (uint8_t*)round_up_64((uint64_t)(pPacket + 1), 8);
+	if (bufferSize)
+		memcpy(pDst, pBufferBarriers, bufferSize);
+	if (textureSize)
+		memcpy(pDst + bufferSize, pTextureBarriers, textureSize);
+	if (rtSize)
+		memcpy(pDst + bufferSize + textureSize, pRtBarriers, rtSize);
+
+	// There is no GPU timeline to order against, track the state immediately
+	for (uint32_t i = 0; i < numBufferBarriers; ++i)
+	{
+		Buffer* pBuffer = pBufferBarriers[i].pBuffer;
+		if (pBufferBarriers[i].mNewState != pBuffer->mCurrentState)
+		{
+			pBuffer->mPreviousState = pBuffer->mCurrentState;
+			pBuffer->mCurrentState = pBufferBarriers[i].mNewState;
+		}
+	}
+	for (uint32_t i = 0; i < numTextureBarriers; ++i)
+	{
+		Texture* pTexture = pTextureBarriers[i].pTexture;
+		if (pTextureBarriers[i].mNewState != pTexture->mCurrentState)
+		{
+			pTexture->mPreviousState = pTexture->mCurrentState;
+			pTexture->mCurrentState = pTextureBarriers[i].mNewState;
+		}
+	}
+	for (uint32_t i = 0; i < numRtBarriers; ++i)
+	{
+		Texture* pTexture = pRtBarriers[i].pRenderTarget->pTexture;
+		if (pRtBarriers[i].mNewState != pTexture->mCurrentState)
+		{
+			pTexture->mPreviousState = pTexture->mCurrentState;
+			pTexture->mCurrentState = pRtBarriers[i].mNewState;
+		}
+	}
+}
+
+void cmdUpdateBuffer(Cmd* pCmd, Buffer* pBuffer, uint64_t dstOffset, Buffer* pSrcBuffer, uint64_t srcOffset, uint64_t size)
+{
+	ASSERT(pBuffer);
+	ASSERT(pSrcBuffer);
+	*null_cmd_alloc<NullUpdateBufferCmd>(pCmd, NULL_CMD_TYPE_cmdUpdateBuffer) = { pSrcBuffer, pBuffer, srcOffset, dstOffset, size };
+}
+
+void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, SubresourceDataDesc* pSubresourceDesc)
+{
+	ASSERT(pTexture);
+	ASSERT(pSrcBuffer);
+	ASSERT(pSubresourceDesc);
+	*null_cmd_alloc<NullUpdateSubresourceCmd>(pCmd, NULL_CMD_TYPE_cmdUpdateSubresource) = { pTexture, pSrcBuffer, *pSubresourceDesc };
+}
+
+void cmdUpdateVirtualTexture(Cmd* pCmd, Texture* pTexture)
+{
+	UNREF_PARAM(pCmd);
+	UNREF_PARAM(pTexture);
+}
+/************************************************************************/
+// Queue Fence Semaphore Functions
+/************************************************************************/
+void acquireNextImage(Renderer* pRenderer, SwapChain* pSwapChain, Semaphore* pSignalSemaphore, Fence* pFence, uint32_t* pImageIndex)
+{
+	ASSERT(pRenderer);
+	ASSERT(pSwapChain);
+	ASSERT(pImageIndex);
+
+	pSwapChain->mIndex = (pSwapChain->mIndex + 1) % pSwapChain->mImageCount;
+	*pImageIndex = pSwapChain->mIndex;
+
+	// The next image is always available right away
+	const int64_t now = getUSec();
+	if (pSignalSemaphore)
+	{
+		pSignalSemaphore->mNullSignalTime = now;
+		pSignalSemaphore->mSignaled = true;
+	}
+	if (pFence)
+	{
+		pFence->mNullCompletionTime = now;
+		pFence->mSubmitted = true;
+	}
+}
+
+void queueSubmit(Queue* pQueue, const QueueSubmitDesc* pDesc)
+{
+	ASSERT(pQueue);
+	ASSERT(pDesc);
+
+	// Work starts once the queue is free and every wait semaphore is signaled
+	int64_t start = max(getUSec(), pQueue->mNullLastCompletion);
+	for (uint32_t i = 0; i < pDesc->mWaitSemaphoreCount; ++i)
+	{
+		Semaphore* pSemaphore = pDesc->ppWaitSemaphores[i];
+		if (pSemaphore->mSignaled)
+		{
+			start = max(start, pSemaphore->mNullSignalTime);
+			pSemaphore->mSignaled = false;
+		}
+	}
+
+	const int64_t latency = pQueue->mNullGpuLatency;
+	const int64_t completion = start + latency;
+
+	uint32_t packetCount = 0;
+	for (uint32_t i = 0; i < pDesc->mCmdCount; ++i)
+		packetCount += pDesc->ppCmds[i]->mNullCmdCount;
+
+	// Execute what has a visible result on the host. Timestamps are spread over the simulated execution time
+	uint32_t packetIndex = 0;
+	for (uint32_t i = 0; i < pDesc->mCmdCount; ++i)
+	{
+		const Cmd* pCmd = pDesc->ppCmds[i];
+		for (const NullCmdHeader* pHeader = null_cmd_begin(pCmd); pHeader != null_cmd_end(pCmd); pHeader = null_cmd_next(pHeader), ++packetIndex)
+		{
+			switch (pHeader->mType)
+			{
+				case NULL_CMD_TYPE_cmdUpdateBuffer: util_update_buffer(null_cmd_payload<NullUpdateBufferCmd>(pHeader)); break;
+				case NULL_CMD_TYPE_cmdUpdateSubresource: util_update_subresource(null_cmd_payload<NullUpdateSubresourceCmd>(pHeader)); break;
+				case NULL_CMD_TYPE_cmdResetQueryPool:
+				{
+					const NullQueryCmd* pQuery = null_cmd_payload<NullQueryCmd>(pHeader);
+					memset(pQuery->pQueryPool->pNullQueryData + pQuery->mIndex, 0, pQuery->mCount * sizeof(uint64_t));
+					break;
+				}
+				case NULL_CMD_TYPE_cmdBeginQuery:
+				case NULL_CMD_TYPE_cmdEndQuery:
+				{
+					const NullQueryCmd* pQuery = null_cmd_payload<NullQueryCmd>(pHeader);
+					if (pQuery->pQueryPool->mType == QUERY_TYPE_TIMESTAMP)
+						pQuery->pQueryPool->pNullQueryData[pQuery->mIndex] = (uint64_t)(start + latency * packetIndex / max(1U, packetCount));
+					break;
+				}
+				case NULL_CMD_TYPE_cmdResolveQuery:
+				{
+					const NullResolveQueryCmd* pResolve = null_cmd_payload<NullResolveQueryCmd>(pHeader);
+					ASSERT(pResolve->queryCount * sizeof(uint64_t) <= pResolve->pReadbackBuffer->mSize);
+					memcpy(
+						pResolve->pReadbackBuffer->pNullData, pResolve->pQueryPool->pNullQueryData + pResolve->startQuery,
+						pResolve->queryCount * sizeof(uint64_t));
+					break;
+				}
+				default: break;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < pDesc->mSignalSemaphoreCount; ++i)
+	{
+		pDesc->ppSignalSemaphores[i]->mNullSignalTime = completion;
+		pDesc->ppSignalSemaphores[i]->mSignaled = true;
+	}
+
+	if (pDesc->pSignalFence)
+	{
+		pDesc->pSignalFence->mNullCompletionTime = completion;
+		pDesc->pSignalFence->mSubmitted = true;
+	}
+
+	pQueue->mNullLastCompletion = completion;
+}
+
+void queuePresent(Queue* pQueue, const QueuePresentDesc* pDesc)
+{
+	ASSERT(pQueue);
+	ASSERT(pDesc);
+
+	for (uint32_t i = 0; i < pDesc->mWaitSemaphoreCount; ++i)
+	{
+		Semaphore* pSemaphore = pDesc->ppWaitSemaphores[i];
+		if (pSemaphore->mSignaled)
+		{
+			pQueue->mNullLastCompletion = max(pQueue->mNullLastCompletion, pSemaphore->mNullSignalTime);
+			pSemaphore->mSignaled = false;
+		}
+	}
+}
+
+void waitForFences(Renderer* pRenderer, uint32_t fenceCount, Fence** ppFences)
+{
+	ASSERT(pRenderer);
+	ASSERT(fenceCount);
+	ASSERT(ppFences);
+
+	for (uint32_t i = 0; i < fenceCount; ++i)
+	{
+		if (ppFences[i]->mSubmitted)
+		{
+			util_wait_until(ppFences[i]->mNullCompletionTime);
+			ppFences[i]->mSubmitted = false;
+		}
+	}
+}
+
+void waitQueueIdle(Queue* pQueue)
+{
+	ASSERT(pQueue);
+	util_wait_until(pQueue->mNullLastCompletion);
+}
+
+void getFenceStatus(Renderer* pRenderer, Fence* pFence, FenceStatus* pFenceStatus)
+{
+	UNREF_PARAM(pRenderer);
+	ASSERT(pFence);
+	ASSERT(pFenceStatus);
+
+	*pFenceStatus = FENCE_STATUS_COMPLETE;
+
+	if (pFence->mSubmitted)
+	{
+		if (getUSec() >= pFence->mNullCompletionTime)
+		{
+			pFence->mSubmitted = false;
+		}
+		else
+		{
+			*pFenceStatus = FENCE_STATUS_INCOMPLETE;
+		}
+	}
+	else
+	{
+		*pFenceStatus = FENCE_STATUS_NOTSUBMITTED;
+	}
+}
+
+void toggleVSync(Renderer* pRenderer, SwapChain** ppSwapChain)
+{
+	UNREF_PARAM(pRenderer);
+	ASSERT(*ppSwapChain);
+	(*ppSwapChain)->mEnableVsync = !(*ppSwapChain)->mEnableVsync;
+}
+/************************************************************************/
+// Utility functions
+/************************************************************************/
+TinyImageFormat getRecommendedSwapchainFormat(bool hintHDR)
+{
+	UNREF_PARAM(hintHDR);
+	return TinyImageFormat_B8G8R8A8_UNORM;
+}
+/************************************************************************/
+// Indirect Draw functions
+/************************************************************************/
+void addIndirectCommandSignature(Renderer* pRenderer, const CommandSignatureDesc* pDesc, CommandSignature** ppCommandSignature)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(pDesc->mIndirectArgCount);
+	ASSERT(ppCommandSignature);
+
+	CommandSignature* pCommandSignature = (CommandSignature*)conf_calloc(1, sizeof(CommandSignature));
+	ASSERT(pCommandSignature);
+
+	uint32_t commandStride = 0;
+	for (uint32_t i = 0; i < pDesc->mIndirectArgCount; ++i)
+	{
+		switch (pDesc->pArgDescs[i].mType)
+		{
+			case INDIRECT_DRAW:
+				pCommandSignature->mDrawType = INDIRECT_DRAW;
+				commandStride += sizeof(IndirectDrawArguments);
+				break;
+			case INDIRECT_DRAW_INDEX:
+				pCommandSignature->mDrawType = INDIRECT_DRAW_INDEX;
+				commandStride += sizeof(IndirectDrawIndexArguments);
+				break;
+			case INDIRECT_DISPATCH:
+				pCommandSignature->mDrawType = INDIRECT_DISPATCH;
+				commandStride += sizeof(IndirectDispatchArguments);
+				break;
+			default:
+				commandStride += sizeof(uint32_t) * max(1U, pDesc->pArgDescs[i].mCount);
+				break;
+		}
+	}
+
+	pCommandSignature->mStride = round_up(commandStride, 16);
+
+	*ppCommandSignature = pCommandSignature;
+}
+
+void removeIndirectCommandSignature(Renderer* pRenderer, CommandSignature* pCommandSignature)
+{
+	ASSERT(pRenderer);
+	SAFE_FREE(pCommandSignature);
+}
+
+void cmdExecuteIndirect(
+	Cmd* pCmd, CommandSignature* pCommandSignature, uint maxCommandCount, Buffer* pIndirectBuffer, uint64_t bufferOffset,
+	Buffer* pCounterBuffer, uint64_t counterBufferOffset)
+{
+	ASSERT(pCommandSignature);
+	ASSERT(pIndirectBuffer);
+	*null_cmd_alloc<NullExecuteIndirectCmd>(pCmd, NULL_CMD_TYPE_cmdExecuteIndirect) = { pCommandSignature, pIndirectBuffer, bufferOffset,
+																						 pCounterBuffer,    counterBufferOffset, maxCommandCount };
+}
+/************************************************************************/
+// GPU Query Implementation
+/************************************************************************/
+void getTimestampFrequency(Queue* pQueue, double* pFrequency)
+{
+	UNREF_PARAM(pQueue);
+	ASSERT(pFrequency);
+
+	// Timestamps are written in getUSec units
+	*pFrequency = 1000000.0;
+}
+
+void addQueryPool(Renderer* pRenderer, const QueryPoolDesc* pDesc, QueryPool** ppQueryPool)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppQueryPool);
+
+	QueryPool* pQueryPool = (QueryPool*)conf_calloc(1, sizeof(QueryPool) + pDesc->mQueryCount * sizeof(uint64_t));
+	ASSERT(pQueryPool);
+
+	pQueryPool->pNullQueryData = (uint64_t*)(pQueryPool + 1);
+	pQueryPool->mType = pDesc->mType;
+	pQueryPool->mCount = pDesc->mQueryCount;
+
+	*ppQueryPool = pQueryPool;
+}
+
+void removeQueryPool(Renderer* pRenderer, QueryPool* pQueryPool)
+{
+	UNREF_PARAM(pRenderer);
+	SAFE_FREE(pQueryPool);
+}
+
+void cmdResetQueryPool(Cmd* pCmd, QueryPool* pQueryPool, uint32_t startQuery, uint32_t queryCount)
+{
+	ASSERT(pQueryPool);
+	ASSERT(startQuery + queryCount <= pQueryPool->mCount);
+	*null_cmd_alloc<NullQueryCmd>(pCmd, NULL_CMD_TYPE_cmdResetQueryPool) = { pQueryPool, startQuery, queryCount };
+}
+
+void cmdBeginQuery(Cmd* pCmd, QueryPool* pQueryPool, QueryDesc* pQuery)
+{
+	ASSERT(pQueryPool);
+	ASSERT(pQuery);
+	ASSERT(pQuery->mIndex < pQueryPool->mCount);
+	*null_cmd_alloc<NullQueryCmd>(pCmd, NULL_CMD_TYPE_cmdBeginQuery) = { pQueryPool, pQuery->mIndex, 1 };
+}
+
+void cmdEndQuery(Cmd* pCmd, QueryPool* pQueryPool, QueryDesc* pQuery)
+{
+	ASSERT(pQueryPool);
+	ASSERT(pQuery);
+	ASSERT(pQuery->mIndex < pQueryPool->mCount);
+	*null_cmd_alloc<NullQueryCmd>(pCmd, NULL_CMD_TYPE_cmdEndQuery) = { pQueryPool, pQuery->mIndex, 1 };
+}
+
+void cmdResolveQuery(Cmd* pCmd, QueryPool* pQueryPool, Buffer* pReadbackBuffer, uint32_t startQuery, uint32_t queryCount)
+{
+	ASSERT(pQueryPool);
+	ASSERT(pReadbackBuffer);
+	ASSERT(startQuery + queryCount <= pQueryPool->mCount);
+	*null_cmd_alloc<NullResolveQueryCmd>(pCmd, NULL_CMD_TYPE_cmdResolveQuery) = { pQueryPool, pReadbackBuffer, startQuery, queryCount };
+}
+/************************************************************************/
+// Memory Stats Implementation
+/************************************************************************/
+void calculateMemoryStats(Renderer* pRenderer, char** stats)
+{
+	ASSERT(pRenderer);
+	ASSERT(stats);
+
+	eastl::string str = eastl::string().sprintf(
+		"{\n  \"Total\": { \"BufferBytes\": %llu, \"TextureBytes\": %llu }\n}\n", (unsigned long long)pRenderer->mNullBufferMemory,
+		(unsigned long long)pRenderer->mNullTextureMemory);
+	*stats = (char*)conf_calloc(str.size() + 1, sizeof(char));
+	memcpy(*stats, str.c_str(), str.size());
+}
+
+void freeMemoryStats(Renderer* pRenderer, char* stats)
+{
+	UNREF_PARAM(pRenderer);
+	SAFE_FREE(stats);
+}
+/************************************************************************/
+// Debug Marker Implementation
+/************************************************************************/
+static void util_debug_marker(Cmd* pCmd, NullCmdType type, float r, float g, float b, const char* pName)
+{
+	const uint32_t nameSize = (uint32_t)strlen(pName) + 1;
+	NullDebugMarkerCmd* pPacket = null_cmd_alloc<NullDebugMarkerCmd>(pCmd, type, nameSize);
+	*pPacket = { r, g, b };
+	memcpy(pPacket + 1, pName, nameSize);
+}
+
+void cmdBeginDebugMarker(Cmd* pCmd, float r, float g, float b, const char* pName)
+{
+	ASSERT(pName);
+	util_debug_marker(pCmd, NULL_CMD_TYPE_cmdBeginDebugMarker, r, g, b, pName);
+}
+
+void cmdEndDebugMarker(Cmd* pCmd) { null_cmd_alloc(pCmd, NULL_CMD_TYPE_cmdEndDebugMarker, 0); }
+
+void cmdAddDebugMarker(Cmd* pCmd, float r, float g, float b, const char* pName)
+{
+	ASSERT(pName);
+	util_debug_marker(pCmd, NULL_CMD_TYPE_cmdAddDebugMarker, r, g, b, pName);
+}
+/************************************************************************/
+// Resource Debug Naming Interface
+/************************************************************************/
+void setBufferName(Renderer* pRenderer, Buffer* pBuffer, const char* pName) {}
+void setTextureName(Renderer* pRenderer, Texture* pTexture, const char* pName) {}
+#endif    // #ifdef NULL_RENDERER
@@ -0,0 +1,609 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#ifdef NULL_RENDERER
+
+#include "../IRenderer.h"
+
+#include "../../ThirdParty/OpenSource/EASTL/string.h"
+#include "../../ThirdParty/OpenSource/EASTL/vector.h"
+#include "../../ThirdParty/OpenSource/EASTL/string_hash_map.h"
+#include "../../OS/Interfaces/ILog.h"
+#include "../../OS/Interfaces/IMemory.h"
+
+/* The null backend has no shader compiler. The resource loader hands it the Vulkan GLSL source (with includes
+ * expanded and the user macros prepended as #defines) and the reflection below scans the global layout()
+ * declarations to recover the same names, sets and bindings the SPIR-V reflection would report.
+ * Preprocessor conditionals are not evaluated, so resources declared in inactive branches are reported as well.
+ */
+
+typedef struct GlslToken
+{
+	const char* pText;
+	uint32_t    mLength;
+} GlslToken;
+
+typedef struct GlslResource
+{
+	eastl::string    mName;
+	DescriptorType   mType;
+	TextureDimension mDim;
+	uint32_t         mSet;
+	uint32_t         mReg;
+	uint32_t         mSize;
+} GlslResource;
+
+typedef struct GlslLayout
+{
+	uint32_t mSet;
+	uint32_t mBinding;
+	uint32_t mLocation;
+	uint32_t mLocalSize[3];
+	uint32_t mVertices;
+	bool     mPushConstant;
+} GlslLayout;
+
+static bool tok_is(const GlslToken& tok, const char* pStr)
+{
+	size_t len = strlen(pStr);
+	return tok.mLength == len && strncmp(tok.pText, pStr, len) == 0;
+}
+
+static bool tok_starts_with(const GlslToken& tok, const char* pStr)
+{
+	size_t len = strlen(pStr);
+	return tok.mLength >= len && strncmp(tok.pText, pStr, len) == 0;
+}
+
+static bool is_ident_char(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_'; }
+
+static uint32_t tok_to_uint(const GlslToken& tok)
+{
+	char buffer[32] = {};
+	memcpy(buffer, tok.pText, min(tok.mLength, 31U));
+	return (uint32_t)strtoul(buffer, NULL, 0);
+}
+
+static void tokenize_line(const char* pBegin, const char* pEnd, eastl::vector<GlslToken>& tokens)
+{
+	const char* p = pBegin;
+	while (p < pEnd)
+	{
+		const char c = *p;
+		if (c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\\')
+		{
+			++p;
+		}
+		else if (c == '/' && p + 1 < pEnd && p[1] == '/')
+		{
+			return;
+		}
+		else if (is_ident_char(c))
+		{
+			const char* pStart = p;
+			while (p < pEnd && (is_ident_char(*p) || *p == '.'))
+				++p;
+			tokens.push_back({ pStart, (uint32_t)(p - pStart) });
+		}
+		else
+		{
+			tokens.push_back({ p, 1 });
+			++p;
+		}
+	}
+}
+
+// Splits the source into tokens, dropping comments and directives and expanding object-like #defines
+static void tokenize(const char* pSource, uint32_t size, eastl::vector<GlslToken>& outTokens)
+{
+	eastl::string_hash_map<eastl::vector<GlslToken> > macros;
+	eastl::vector<GlslToken>                          lineTokens;
+
+	const char* p = pSource;
+	const char* pEnd = pSource + size;
+	bool        lineStart = true;
+
+	while (p < pEnd)
+	{
+		const char c = *p;
+		if (c == '\n')
+		{
+			lineStart = true;
+			++p;
+		}
+		else if (c == ' ' || c == '\t' || c == '\r')
+		{
+			++p;
+		}
+		else if (c == '/' && p + 1 < pEnd && p[1] == '/')
+		{
+			while (p < pEnd && *p != '\n')
+				++p;
+		}
+		else if (c == '/' && p + 1 < pEnd && p[1] == '*')
+		{
+			p += 2;
+			while (p + 1 < pEnd && !(p[0] == '*' && p[1] == '/'))
+				++p;
+			p = min(p + 2, pEnd);
+		}
+		else if (c == '#' && lineStart)
+		{
+			// Directive spans until the first newline not preceded by a line continuation
+			const char* pLine = p + 1;
+			while (p < pEnd && !(*p == '\n' && p[-1] != '\\'))
+				++p;
+
+			lineTokens.clear();
+			tokenize_line(pLine, p, lineTokens);
+			if (lineTokens.size() >= 2 && tok_is(lineTokens[0], "define") &&
+				!(lineTokens[1].pText + lineTokens[1].mLength < p && lineTokens[1].pText[lineTokens[1].mLength] == '('))
+			{
+				eastl::string name(lineTokens[1].pText, lineTokens[1].mLength);
+				macros[name.c_str()].assign(lineTokens.begin() + 2, lineTokens.end());
+			}
+		}
+		else if (is_ident_char(c))
+		{
+			lineStart = false;
+			const char* pStart = p;
+			while (p < pEnd && (is_ident_char(*p) || *p == '.'))
+				++p;
+			GlslToken tok = { pStart, (uint32_t)(p - pStart) };
+
+			eastl::string name(tok.pText, tok.mLength);
+			decltype(macros)::iterator it = macros.find(name.c_str());
+			if (it != macros.end())
+				outTokens.insert(outTokens.end(), it->second.begin(), it->second.end());
+			else
+				outTokens.push_back(tok);
+		}
+		else
+		{
+			lineStart = false;
+			outTokens.push_back({ p, 1 });
+			++p;
+		}
+	}
+}
+
+// Byte size and std430 alignment of a GLSL member or vertex input type
+static void type_size_align(const GlslToken& type, uint32_t* pSize, uint32_t* pAlign)
+{
+	uint32_t scalar = 4;
+	uint32_t components = 1;
+	uint32_t columns = 1;
+
+	const char* p = type.pText;
+	uint32_t    len = type.mLength;
+	if (tok_starts_with(type, "double") || tok_starts_with(type, "dvec") || tok_starts_with(type, "dmat"))
+		scalar = 8;
+	else if (tok_starts_with(type, "float16_t") || tok_starts_with(type, "f16vec") || tok_starts_with(type, "half"))
+		scalar = 2;
+
+	const eastl::string name(p, len);
+	const size_t        vecPos = name.find("vec");
+	const size_t        matPos = name.find("mat");
+	const char*         pVec = vecPos != eastl::string::npos ? p + vecPos : NULL;
+	const char*         pMat = matPos != eastl::string::npos ? p + matPos : NULL;
+	if (pVec && pVec + 3 < p + len)
+	{
+		components = (uint32_t)(pVec[3] - '0');
+	}
+	else if (pMat && pMat + 3 < p + len)
+	{
+		columns = (uint32_t)(pMat[3] - '0');
+		components = (pMat + 5 < p + len && pMat[4] == 'x') ? (uint32_t)(pMat[5] - '0') : columns;
+	}
+	else if (!(tok_is(type, "float") || tok_is(type, "int") || tok_is(type, "uint") || tok_is(type, "bool") || tok_is(type, "double") ||
+			   tok_is(type, "float16_t") || tok_is(type, "half")))
+	{
+		// Nested structs are not parsed, assume a vec4
+		components = 4;
+	}
+
+	const uint32_t vecAlign = scalar * (components == 3 ? 4 : components);
+	*pAlign = vecAlign;
+	*pSize = columns > 1 ? columns * vecAlign : scalar * components;
+}
+
+static TextureDimension type_to_dim(const GlslToken& type)
+{
+	eastl::string name(type.pText, type.mLength);
+	size_t        pos = name.find_first_of("123C");
+	if (pos == eastl::string::npos)
+		return TEXTURE_DIM_UNDEFINED;
+	name = name.substr(pos);
+	if (name.find("Shadow") != eastl::string::npos)
+		name.erase(name.find("Shadow"), 6);
+
+	if (name == "1D")
+		return TEXTURE_DIM_1D;
+	if (name == "1DArray")
+		return TEXTURE_DIM_1D_ARRAY;
+	if (name == "2D" || name == "2DRect")
+		return TEXTURE_DIM_2D;
+	if (name == "2DArray")
+		return TEXTURE_DIM_2D_ARRAY;
+	if (name == "2DMS")
+		return TEXTURE_DIM_2DMS;
+	if (name == "2DMSArray")
+		return TEXTURE_DIM_2DMS_ARRAY;
+	if (name == "3D")
+		return TEXTURE_DIM_3D;
+	if (name == "Cube")
+		return TEXTURE_DIM_CUBE;
+	if (name == "CubeArray")
+		return TEXTURE_DIM_CUBE_ARRAY;
+	return TEXTURE_DIM_UNDEFINED;
+}
+
+static DescriptorType opaque_type_to_descriptor(const GlslToken& type)
+{
+	GlslToken base = type;
+	// Strip the component type prefix of integer images/textures/samplers
+	if (base.mLength > 1 && (base.pText[0] == 'i' || base.pText[0] == 'u') &&
+		(strncmp(base.pText + 1, "texture", 7) == 0 || strncmp(base.pText + 1, "image", 5) == 0 || strncmp(base.pText + 1, "sampler", 7) == 0))
+	{
+		++base.pText;
+		--base.mLength;
+	}
+
+	if (tok_is(base, "sampler") || tok_is(base, "samplerShadow"))
+		return DESCRIPTOR_TYPE_SAMPLER;
+	if (tok_is(base, "textureBuffer") || tok_is(base, "samplerBuffer"))
+		return DESCRIPTOR_TYPE_BUFFER;
+	if (tok_is(base, "imageBuffer"))
+		return DESCRIPTOR_TYPE_RW_BUFFER;
+	if (tok_starts_with(base, "texture") || tok_starts_with(base, "sampler") || tok_starts_with(base, "subpassInput"))
+		return DESCRIPTOR_TYPE_TEXTURE;
+	if (tok_starts_with(base, "image"))
+		return DESCRIPTOR_TYPE_RW_TEXTURE;
+	if (tok_starts_with(base, "accelerationStructure"))
+		return DESCRIPTOR_TYPE_RAY_TRACING;
+	return DESCRIPTOR_TYPE_UNDEFINED;
+}
+
+// Returns the index of the token following the next ';' at the current brace depth
+static size_t skip_declaration(const eastl::vector<GlslToken>& tokens, size_t i)
+{
+	int depth = 0;
+	for (; i < tokens.size(); ++i)
+	{
+		if (tok_is(tokens[i], "{"))
+			++depth;
+		else if (tok_is(tokens[i], "}"))
+			--depth;
+		else if (depth <= 0 && tok_is(tokens[i], ";"))
+			return i + 1;
+	}
+	return i;
+}
+
+// Parses an optional "[N]" / "[]" suffix. Unsized arrays report 0 (bindless)
+static size_t parse_array_size(const eastl::vector<GlslToken>& tokens, size_t i, uint32_t* pSize)
+{
+	*pSize = 1;
+	if (i < tokens.size() && tok_is(tokens[i], "["))
+	{
+		*pSize = (i + 1 < tokens.size() && !tok_is(tokens[i + 1], "]")) ? tok_to_uint(tokens[i + 1]) : 0;
+		while (i < tokens.size() && !tok_is(tokens[i], "]"))
+			++i;
+		++i;
+	}
+	return i;
+}
+
+static void add_resource(eastl::vector<GlslResource>& resources, const GlslResource& resource)
+{
+	for (const GlslResource& res : resources)
+	{
+		if (res.mName == resource.mName)
+			return;
+	}
+	resources.push_back(resource);
+}
+
+static size_t parse_layout_declaration(
+	const eastl::vector<GlslToken>& tokens, size_t i, ShaderStage shaderStage, eastl::vector<GlslResource>& resources,
+	eastl::vector<GlslResource>& vertexInputs, ShaderReflection* pOutReflection)
+{
+	GlslLayout layout = {};
+	layout.mLocation = ~0u;
+
+	// layout( qualifier [= value], ... )
+	++i;
+	if (i >= tokens.size() || !tok_is(tokens[i], "("))
+		return skip_declaration(tokens, i);
+	for (++i; i < tokens.size() && !tok_is(tokens[i], ")"); ++i)
+	{
+		const GlslToken& key = tokens[i];
+		uint32_t         value = 0;
+		if (i + 2 < tokens.size() && tok_is(tokens[i + 1], "="))
+		{
+			value = tok_to_uint(tokens[i + 2]);
+			i += 2;
+		}
+
+		if (tok_is(key, "set"))
+			layout.mSet = value;
+		else if (tok_is(key, "binding"))
+			layout.mBinding = value;
+		else if (tok_is(key, "location"))
+			layout.mLocation = value;
+		else if (tok_is(key, "push_constant"))
+			layout.mPushConstant = true;
+		else if (tok_is(key, "local_size_x"))
+			layout.mLocalSize[0] = value;
+		else if (tok_is(key, "local_size_y"))
+			layout.mLocalSize[1] = value;
+		else if (tok_is(key, "local_size_z"))
+			layout.mLocalSize[2] = value;
+		else if (tok_is(key, "vertices"))
+			layout.mVertices = value;
+	}
+	++i;
+
+	// Storage and memory qualifiers
+	bool readOnly = false;
+	for (; i < tokens.size(); ++i)
+	{
+		const GlslToken& tok = tokens[i];
+		if (tok_is(tok, "readonly"))
+			readOnly = true;
+		else if (!(tok_is(tok, "writeonly") || tok_is(tok, "restrict") || tok_is(tok, "coherent") || tok_is(tok, "volatile") ||
+				   tok_is(tok, "flat") || tok_is(tok, "noperspective") || tok_is(tok, "smooth") || tok_is(tok, "highp") ||
+				   tok_is(tok, "mediump") || tok_is(tok, "lowp") || tok_is(tok, "precise") || tok_is(tok, "invariant")))
+			break;
+	}
+	if (i >= tokens.size())
+		return i;
+
+	const GlslToken& storage = tokens[i++];
+	if (tok_is(storage, "in"))
+	{
+		if (i < tokens.size() && tok_is(tokens[i], ";"))
+		{
+			if (shaderStage == SHADER_STAGE_COMP)
+			{
+				for (uint32_t c = 0; c < 3; ++c)
+					pOutReflection->mNumThreadsPerGroup[c] = max(1U, layout.mLocalSize[c]);
+			}
+			return i + 1;
+		}
+
+		if (shaderStage == SHADER_STAGE_VERT && layout.mLocation != ~0u && i + 1 < tokens.size())
+		{
+			uint32_t size = 0, align = 0;
+			type_size_align(tokens[i], &size, &align);
+			GlslResource input = { eastl::string(tokens[i + 1].pText, tokens[i + 1].mLength), DESCRIPTOR_TYPE_UNDEFINED,
+								   TEXTURE_DIM_UNDEFINED, 0, layout.mLocation, size };
+			add_resource(vertexInputs, input);
+		}
+		return skip_declaration(tokens, i);
+	}
+
+	if (tok_is(storage, "out"))
+	{
+		if (shaderStage == SHADER_STAGE_TESC && layout.mVertices)
+			pOutReflection->mNumControlPoint = layout.mVertices;
+		return skip_declaration(tokens, i);
+	}
+
+	const bool isUniform = tok_is(storage, "uniform");
+	const bool isBuffer = tok_is(storage, "buffer");
+	if ((!isUniform && !isBuffer) || i + 1 >= tokens.size())
+		return skip_declaration(tokens, i);
+
+	// Block declaration: uniform Name { members } [instance][array];
+	if (tok_is(tokens[i + 1], "{"))
+	{
+		const GlslToken& blockName = tokens[i];
+		uint32_t         blockSize = 0;
+		uint32_t         blockAlign = 4;
+
+		for (i += 2; i < tokens.size() && !tok_is(tokens[i], "}");)
+		{
+			// member: [qualifiers] type name [N];
+			size_t end = i;
+			while (end < tokens.size() && !tok_is(tokens[end], ";") && !tok_is(tokens[end], "}"))
+				++end;
+			if (end >= tokens.size() || tok_is(tokens[end], "}"))
+			{
+				i = end;
+				break;
+			}
+
+			size_t nameIndex = end - 1;
+			uint32_t count = 1;
+			if (tok_is(tokens[nameIndex], "]"))
+			{
+				while (nameIndex > i && !tok_is(tokens[nameIndex], "["))
+					--nameIndex;
+				parse_array_size(tokens, nameIndex, &count);
+				--nameIndex;
+			}
+			if (nameIndex > i)
+			{
+				uint32_t size = 0, align = 0;
+				type_size_align(tokens[nameIndex - 1], &size, &align);
+				const uint32_t stride = (uint32_t)round_up(size, align);
+				blockSize = (uint32_t)round_up(blockSize, align) + (count > 1 ? stride * count : size);
+				blockAlign = max(blockAlign, align);
+			}
+			i = end + 1;
+		}
+		++i;
+
+		GlslResource resource = {};
+		resource.mName = eastl::string(blockName.pText, blockName.mLength);
+		resource.mDim = TEXTURE_DIM_UNDEFINED;
+		resource.mSet = layout.mSet;
+		resource.mReg = layout.mBinding;
+		resource.mSize = 1;
+		if (i < tokens.size() && !tok_is(tokens[i], ";") && !tok_is(tokens[i], "["))
+		{
+			// Use the instance name if there is one
+			resource.mName = eastl::string(tokens[i].pText, tokens[i].mLength);
+			++i;
+		}
+		i = parse_array_size(tokens, i, &resource.mSize);
+
+		if (layout.mPushConstant)
+		{
+			resource.mType = DESCRIPTOR_TYPE_ROOT_CONSTANT;
+			resource.mSet = 0;
+			resource.mReg = 0;
+			resource.mSize = (uint32_t)round_up(blockSize, blockAlign);
+		}
+		else if (isUniform)
+		{
+			resource.mType = DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		}
+		else
+		{
+			resource.mType = readOnly ? DESCRIPTOR_TYPE_BUFFER : DESCRIPTOR_TYPE_RW_BUFFER;
+		}
+
+		add_resource(resources, resource);
+		return skip_declaration(tokens, i);
+	}
+
+	// Opaque declaration: uniform type name[N];
+	if (isUniform)
+	{
+		const DescriptorType type = opaque_type_to_descriptor(tokens[i]);
+		if (type != DESCRIPTOR_TYPE_UNDEFINED)
+		{
+			GlslResource resource = {};
+			resource.mName = eastl::string(tokens[i + 1].pText, tokens[i + 1].mLength);
+			resource.mType = type;
+			resource.mDim = (type == DESCRIPTOR_TYPE_TEXTURE || type == DESCRIPTOR_TYPE_RW_TEXTURE) ? type_to_dim(tokens[i]) : TEXTURE_DIM_UNDEFINED;
+			resource.mSet = layout.mSet;
+			resource.mReg = layout.mBinding;
+			parse_array_size(tokens, i + 2, &resource.mSize);
+			add_resource(resources, resource);
+		}
+	}
+
+	return skip_declaration(tokens, i);
+}
+
+void null_createShaderReflection(const uint8_t* shaderCode, uint32_t shaderSize, ShaderStage shaderStage, ShaderReflection* pOutReflection)
+{
+	if (pOutReflection == NULL)
+	{
+		LOGF(LogLevel::eERROR, "Create Shader Refection failed. Invalid reflection output!");
+		return;    // TODO: error msg
+	}
+
+	eastl::vector<GlslToken> tokens;
+	tokens.reserve(shaderSize / 4);
+	tokenize((const char*)shaderCode, shaderSize, tokens);
+
+	eastl::vector<GlslResource> resources;
+	eastl::vector<GlslResource> vertexInputs;
+
+	pOutReflection->mNumThreadsPerGroup[0] = 1;
+	pOutReflection->mNumThreadsPerGroup[1] = 1;
+	pOutReflection->mNumThreadsPerGroup[2] = 1;
+	pOutReflection->mNumControlPoint = 0;
+
+	int    depth = 0;
+	size_t i = 0;
+	while (i < tokens.size())
+	{
+		const GlslToken& tok = tokens[i];
+		if (tok_is(tok, "{"))
+			++depth;
+		else if (tok_is(tok, "}"))
+			--depth;
+		else if (depth == 0 && tok_is(tok, "layout"))
+		{
+			i = parse_layout_declaration(tokens, i, shaderStage, resources, vertexInputs, pOutReflection);
+			continue;
+		}
+		++i;
+	}
+
+	// lets find out the size of the name pool we need
+	uint32_t namePoolSize = 0;
+	for (const GlslResource& res : resources)
+		namePoolSize += (uint32_t)res.mName.size() + 1;
+	for (const GlslResource& input : vertexInputs)
+		namePoolSize += (uint32_t)input.mName.size() + 1;
+
+	char* namePool = NULL;
+	if (namePoolSize)
+		namePool = (char*)conf_calloc(namePoolSize, 1);
+	char* pCurrentName = namePool;
+
+	VertexInput* pVertexInputs = NULL;
+	if (vertexInputs.size())
+	{
+		pVertexInputs = (VertexInput*)conf_malloc(sizeof(VertexInput) * vertexInputs.size());
+		for (uint32_t j = 0; j < (uint32_t)vertexInputs.size(); ++j)
+		{
+			pVertexInputs[j].size = vertexInputs[j].mSize;
+			pVertexInputs[j].name = pCurrentName;
+			pVertexInputs[j].name_size = (uint32_t)vertexInputs[j].mName.size();
+			memcpy(pCurrentName, vertexInputs[j].mName.c_str(), vertexInputs[j].mName.size());
+			pCurrentName += vertexInputs[j].mName.size() + 1;
+		}
+	}
+
+	ShaderResource* pResources = NULL;
+	if (resources.size())
+	{
+		pResources = (ShaderResource*)conf_calloc(resources.size(), sizeof(ShaderResource));
+		for (uint32_t j = 0; j < (uint32_t)resources.size(); ++j)
+		{
+			pResources[j].type = resources[j].mType;
+			pResources[j].set = resources[j].mSet;
+			pResources[j].reg = resources[j].mReg;
+			pResources[j].size = resources[j].mSize;
+			pResources[j].used_stages = shaderStage;
+			pResources[j].name = pCurrentName;
+			pResources[j].name_size = (uint32_t)resources[j].mName.size();
+			pResources[j].dim = resources[j].mDim;
+			memcpy(pCurrentName, resources[j].mName.c_str(), resources[j].mName.size());
+			pCurrentName += resources[j].mName.size() + 1;
+		}
+	}
+
+	pOutReflection->mShaderStage = shaderStage;
+
+	pOutReflection->pNamePool = namePool;
+	pOutReflection->mNamePoolSize = namePoolSize;
+
+	pOutReflection->pVertexInputs = pVertexInputs;
+	pOutReflection->mVertexInputsCount = (uint32_t)vertexInputs.size();
+
+	pOutReflection->pShaderResources = pResources;
+	pOutReflection->mShaderResourceCount = (uint32_t)resources.size();
+
+	pOutReflection->pVariables = NULL;
+	pOutReflection->mVariableCount = 0;
+}
+#endif    // #ifdef NULL_RENDERER
@@ -27,6 +27,8 @@
 
 #include "../ThirdParty/OpenSource/tinyimageformat/tinyimageformat_bits.h"
 #include "../ThirdParty/OpenSource/EASTL/deque.h"
+#include "../ThirdParty/OpenSource/EASTL/unordered_map.h"
+#include "../ThirdParty/OpenSource/EASTL/string.h"
 
 #define CGLTF_IMPLEMENTATION
 #include "../ThirdParty/OpenSource/cgltf/cgltf.h"
@@ -35,6 +37,10 @@
 #include "IResourceLoader.h"
 #include "../OS/Interfaces/ILog.h"
 #include "../OS/Interfaces/IThread.h"
+#include "../OS/Interfaces/ITime.h"
+#include "../OS/FileSystem/FileMapping.h"
+#include "../OS/Interfaces/IProfiler.h"
+#include "../OS/Core/ThreadSystem.h"
 #include "../OS/Image/Image.h"
 
 //this is needed for unix as PATH_MAX is defined instead of MAX_PATH
@@ -50,16 +56,14 @@
 #endif
 #include "../OS/Interfaces/IMemory.h"
 
-#ifdef NX64
 #include "../ThirdParty/OpenSource/murmurhash3/MurmurHash3_32.h"
-#endif
 
 extern void addBuffer(Renderer* pRenderer, const BufferDesc* desc, Buffer** pp_buffer);
 extern void removeBuffer(Renderer* pRenderer, Buffer* p_buffer);
 extern void mapBuffer(Renderer* pRenderer, Buffer* pBuffer, ReadRange* pRange);
 extern void unmapBuffer(Renderer* pRenderer, Buffer* pBuffer);
 extern void addTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** pp_texture);
-extern void addVirtualTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture, void* pImageData);
+extern void addVirtualTexture(Renderer* pRenderer, const TextureDesc* pDesc, Texture** ppTexture, void* pPageCache);
 extern void removeTexture(Renderer* pRenderer, Texture* p_texture);
 extern void cmdUpdateBuffer(Cmd* pCmd, Buffer* pBuffer, uint64_t dstOffset, Buffer* pSrcBuffer, uint64_t srcOffset, uint64_t size);
 extern void cmdUpdateSubresource(Cmd* pCmd, Texture* pTexture, Buffer* pSrcBuffer, SubresourceDataDesc* pSubresourceDesc);
@@ -94,6 +98,7 @@ typedef struct TextureLoadDescInternal
 
 	// Following is ignored if pDesc != NULL.  pDesc->mFlags will be considered instead.
 	TextureCreationFlags mCreationFlag;
+	bool                 mProgressive;
 } TextureLoadDescInternal;
 
 typedef struct TextureUpdateDescInternal
@@ -131,6 +136,64 @@ typedef struct CopyEngine
 } CopyEngine;
 
 
+//////////////////////////////////////////////////////////////////////////
+// Progressive texture streaming
+//////////////////////////////////////////////////////////////////////////
+
+// Residency of one progressive texture. The texture only holds the file mips from mResidentMip on. Changing that
+// builds a replacement texture with the new mip range, which updateTextureStreaming swaps into pTexture once its
+// copies completed. Everything but pFilePath is guarded by ResourceLoader::mTextureStreamMutex.
+typedef struct TextureStream
+{
+	Texture*                pTexture;
+	/// The mips of each replacement are read from the file again
+	Path*                   pFilePath;
+	uint32_t                mNodeIndex;
+	TextureCreationFlags    mCreationFlag;
+	/// GPU bytes of each file mip over all layers
+	eastl::vector<uint64_t> mMipSizes;
+	uint32_t                mLayerCount;
+	/// Mips from mBaseMip on are uploaded with the texture and never dropped
+	uint32_t                mBaseMip;
+	/// File mip that is mip 0 of pTexture
+	uint32_t                mResidentMip;
+	uint32_t                mRequestedMip;
+	/// Replacement holding the file mips from mPendingMip on, recorded into copy set mPendingSet
+	Texture*                pPendingTexture;
+	uint32_t                mPendingMip;
+	size_t                  mPendingSet;
+	/// The copies of pPendingTexture completed
+	bool                    mPendingReady;
+} TextureStream;
+
+// Native resources a progressive texture had before updateTextureStreaming replaced them. Destroyed once the frames
+// that may still sample them are done
+typedef struct RetiredTexture
+{
+	Texture* pTexture;
+	uint64_t mSize;
+	uint64_t mFrame;
+} RetiredTexture;
+
+//////////////////////////////////////////////////////////////////////////
+// Asset cache
+//////////////////////////////////////////////////////////////////////////
+
+// One texture or geometry loaded from a file, shared by every addResource call with the same path and parameters.
+// Guarded by ResourceLoader::mAssetCacheMutex.
+typedef struct AssetCacheEntry
+{
+	eastl::string         mKey;
+	/// Texture* or Geometry*, written by the streamer when the load completes
+	void*                 pResource;
+	uint32_t              mRefCount;
+	bool                  mLoaded;
+	/// Token of the load, handed to the calls that join it
+	SyncToken             mToken;
+	/// Outputs of the addResource calls waiting for the load
+	eastl::vector<void**> mWaiters;
+} AssetCacheEntry;
+
 typedef enum UpdateRequestType
 {
 	UPDATE_REQUEST_UPDATE_BUFFER,
@@ -159,6 +222,8 @@ typedef struct UpdateRequest
 	UpdateRequest(Texture* tex) : mType(UPDATE_REQUEST_UPDATE_RESOURCE_STATE) { texture = tex; buffer = NULL; }
 	UpdateRequestType mType;
 	uint64_t mWaitIndex = 0;
+	int64_t mQueueTime = 0;
+	AssetCacheEntry* pCacheEntry = NULL;
 	union
 	{
 		BufferUpdateDesc bufUpdateDesc;
@@ -169,12 +234,30 @@ typedef struct UpdateRequest
 	};
 } UpdateRequest;
 
+struct VirtualTexturePageCache;
+
+// Page of a virtual texture held by the page cache, linked in least recently used order
+typedef struct VirtualTexturePageEntry
+{
+	VirtualTexturePageCache*        pCache;
+	uint32_t                        mPageIndex;
+	uint8_t*                        pData;
+	struct VirtualTexturePageEntry* pPrev;
+	struct VirtualTexturePageEntry* pNext;
+} VirtualTexturePageEntry;
+
+typedef struct VirtualTexturePageRequest
+{
+	VirtualTexturePageCache* pCache;
+	uint32_t                 mPageIndex;
+} VirtualTexturePageRequest;
+
 typedef struct UpdateState
 {
 	UpdateState() : UpdateState(UpdateRequest())
 	{
 	}
-	UpdateState(const UpdateRequest& request) : mRequest(request), mMipLevel(0), mArrayLayer(0), mOffset({ 0, 0, 0 }), mSize(0)
+	UpdateState(const UpdateRequest& request) : mRequest(request), mMipLevel(0), mArrayLayer(0), mOffset({ 0, 0, 0 }), mSize(0), mDecodeTime(0)
 	{
 	}
 
@@ -183,8 +266,29 @@ typedef struct UpdateState
 	uint32_t      mArrayLayer;
 	uint3         mOffset;
 	uint64_t      mSize;
+	/// Microseconds the request spent reading and decoding its file
+	uint64_t      mDecodeTime;
 } UpdateState;
 
+// Profiler counters published by the streamer, see publishResourceLoaderCounters
+typedef struct ResourceLoaderCounter
+{
+	const char* pName;
+	bool        mBytes;
+} ResourceLoaderCounter;
+
+static const ResourceLoaderCounter gResourceLoaderCounters[] = {
+	{ "ResourceLoader/QueueDepth", false },
+	{ "ResourceLoader/UploadedBytes", true },
+	{ "ResourceLoader/UploadBytesPerSecond", true },
+	{ "ResourceLoader/StagingOverflows", false },
+	{ "ResourceLoader/StagingOverflowBytes", true },
+	{ "ResourceLoader/AvgQueueWaitUs", false },
+	{ "ResourceLoader/AvgDecodeUs", false },
+	{ "ResourceLoader/AvgUploadUs", false },
+};
+#define RESOURCE_LOADER_COUNTER_COUNT (sizeof(gResourceLoaderCounters) / sizeof(gResourceLoaderCounters[0]))
+
 class ResourceLoader
 {
 public:
@@ -201,6 +305,7 @@ public:
 	Mutex mTokenMutex;
 	ConditionVariable mTokenCond;
 	Mutex mStagingBufferMutex;
+	Mutex mTextureStreamMutex;
 	eastl::deque <UpdateRequest> mActiveQueue;
 	eastl::deque <UpdateRequest> mRequestQueue[MAX_GPUS][LOAD_PRIORITY_COUNT];
 
@@ -212,14 +317,40 @@ public:
 	CopyEngine pCopyEngines[MAX_GPUS];
 	size_t mActiveSetIndex;
 
+	Mutex mStatsMutex;
+	ResourceLoaderStats mStats;
+	/// Microseconds the streamer spent on iterations that submitted copies
+	uint64_t mBusyTime;
+	/// Profiler counter tokens, registered again whenever the profiler was initialized since the last publish
+	ProfileToken mCounterTokens[RESOURCE_LOADER_COUNTER_COUNT];
+	uint32_t mCounterGeneration;
+
+	Mutex mAssetCacheMutex;
+	eastl::unordered_map<eastl::string, AssetCacheEntry*> mAssetCache;
+	eastl::unordered_map<void*, AssetCacheEntry*> mAssetCacheResources;
+
+	eastl::unordered_map<Texture*, TextureStream*> mTextureStreams;
+	eastl::vector<RetiredTexture> mRetiredTextures;
+	/// Number of updateTextureStreaming calls
+	uint64_t mTextureStreamingFrame;
+	/// GPU bytes of the streamed mips of every progressive texture, replacement and retired texture
+	uint64_t mTextureStreamingSize;
+
+	/// Pages of all virtual textures share mDesc.mVirtualTexturePageCacheSize
+	Mutex mVirtualTexturePageMutex;
+	VirtualTexturePageEntry* pMostRecentPage;
+	VirtualTexturePageEntry* pLeastRecentPage;
+	uint64_t mVirtualTexturePageCacheUsed;
+	eastl::deque<VirtualTexturePageRequest> mVirtualTexturePageRequests;
+
 #if defined(NX64)
 	ThreadTypeNX mThreadType;
 	void* mThreadStackPtr;
 #endif
 
-	static void InitImageClass()
+	static void InitImageClass(ThreadSystem* pThreadSystem)
 	{
-		Image::Init();
+		Image::Init(pThreadSystem);
 	}
 
 	static void ExitImageClass()
@@ -279,6 +410,20 @@ public:
 		return result;
 	}
 
+	static ImageLoadingResult CreateImageMips(const Path* filePath, uint32_t firstMip, uint32_t mipCount, uint rowAlignment, uint subtextureAlignment, Image** pOutImage)
+	{
+		Image* pImage = AllocImage();
+
+		ImageLoadingResult result = pImage->LoadMipsFromFile(filePath, firstMip, mipCount, rowAlignment, subtextureAlignment);
+
+		if (result != IMAGE_LOADING_RESULT_SUCCESS)
+			DestroyImage(pImage);
+		else
+			*pOutImage = pImage;
+
+		return result;
+	}
+
 	static ImageLoadingResult CreateImage(void const* mem, uint32_t size, char const* extension, memoryAllocationFunc pAllocator, void* pUserData, uint rowAlignment, uint subtextureAlignment, Image** pOutImage)
 	{
 		FileStream* stream = fsOpenReadOnlyMemory(mem, size);
@@ -458,6 +603,104 @@ static void streamerFlush(CopyEngine* pCopyEngine, size_t activeSet)
 	}
 }
 
+/************************************************************************/
+// Telemetry
+/************************************************************************/
+static void addHistogramSample(ResourceLoaderHistogram* pHistogram, uint64_t us)
+{
+	uint32_t bucket = 0;
+	for (uint64_t v = us; v && bucket < RESOURCE_LOADER_HISTOGRAM_BUCKET_COUNT - 1; v >>= 1)
+		++bucket;
+	++pHistogram->mBuckets[bucket];
+	++pHistogram->mCount;
+	pHistogram->mTotalUs += us;
+	pHistogram->mMaxUs = max(pHistogram->mMaxUs, us);
+}
+
+static void recordStagingOverflow(uint64_t size)
+{
+	pResourceLoader->mStatsMutex.Acquire();
+	++pResourceLoader->mStats.mStagingOverflowCount;
+	pResourceLoader->mStats.mStagingOverflowBytes += size;
+	pResourceLoader->mStatsMutex.Release();
+}
+
+static void recordRequestStats(ResourceLoader* pLoader, const UpdateState& updateState, uint32_t priority, int64_t startTime, int64_t endTime)
+{
+	const UpdateRequestType type = updateState.mRequest.mType;
+	const uint64_t queueWait = startTime > updateState.mRequest.mQueueTime ? (uint64_t)(startTime - updateState.mRequest.mQueueTime) : 0;
+	const uint64_t processTime = endTime > startTime ? (uint64_t)(endTime - startTime) : 0;
+
+	pLoader->mStatsMutex.Acquire();
+	addHistogramSample(&pLoader->mStats.mQueueWait[priority], queueWait);
+	if (type == UPDATE_REQUEST_LOAD_TEXTURE || type == UPDATE_REQUEST_LOAD_GEOMETRY)
+		addHistogramSample(&pLoader->mStats.mDecode, updateState.mDecodeTime);
+	addHistogramSample(&pLoader->mStats.mUpload, processTime - min(processTime, updateState.mDecodeTime));
+	pLoader->mStatsMutex.Release();
+}
+
+static uint64_t getHistogramAverage(const ResourceLoaderHistogram& histogram)
+{
+	return histogram.mCount ? histogram.mTotalUs / histogram.mCount : 0;
+}
+
+static void getResourceLoaderStats(ResourceLoader* pLoader, ResourceLoaderStats* pStats)
+{
+	ASSERT(pStats);
+	pLoader->mStatsMutex.Acquire();
+	*pStats = pLoader->mStats;
+	pStats->mUploadBytesPerSecond = pLoader->mBusyTime ? pStats->mUploadedBytes * 1e6 / pLoader->mBusyTime : 0.0;
+	pLoader->mStatsMutex.Release();
+
+	pLoader->mQueueMutex.Acquire();
+	for (uint32_t priority = 0; priority < LOAD_PRIORITY_COUNT; ++priority)
+	{
+		pStats->mQueueDepth[priority] = 0;
+		for (uint32_t i = 0; i < MAX_GPUS; ++i)
+			pStats->mQueueDepth[priority] += (uint32_t)pLoader->mRequestQueue[i][priority].size();
+	}
+	pLoader->mQueueMutex.Release();
+}
+
+static void publishResourceLoaderCounters(ResourceLoader* pLoader)
+{
+	// Tokens of a previous profiler session point at counters that no longer exist
+	const uint32_t generation = getProfileCounterGeneration();
+	if (!generation)
+		return;
+	if (generation != pLoader->mCounterGeneration)
+	{
+		for (uint32_t i = 0; i < RESOURCE_LOADER_COUNTER_COUNT; ++i)
+			pLoader->mCounterTokens[i] = getProfileCounterToken(gResourceLoaderCounters[i].pName, gResourceLoaderCounters[i].mBytes);
+		pLoader->mCounterGeneration = generation;
+	}
+
+	ResourceLoaderStats stats;
+	getResourceLoaderStats(pLoader, &stats);
+
+	uint32_t queueDepth = 0;
+	ResourceLoaderHistogram queueWait = {};
+	for (uint32_t i = 0; i < LOAD_PRIORITY_COUNT; ++i)
+	{
+		queueDepth += stats.mQueueDepth[i];
+		queueWait.mCount += stats.mQueueWait[i].mCount;
+		queueWait.mTotalUs += stats.mQueueWait[i].mTotalUs;
+	}
+
+	const int64_t values[RESOURCE_LOADER_COUNTER_COUNT] = {
+		queueDepth,
+		(int64_t)stats.mUploadedBytes,
+		(int64_t)stats.mUploadBytesPerSecond,
+		(int64_t)stats.mStagingOverflowCount,
+		(int64_t)stats.mStagingOverflowBytes,
+		(int64_t)getHistogramAverage(queueWait),
+		(int64_t)getHistogramAverage(stats.mDecode),
+		(int64_t)getHistogramAverage(stats.mUpload),
+	};
+	for (uint32_t i = 0; i < RESOURCE_LOADER_COUNTER_COUNT; ++i)
+		setProfileCounter(pLoader->mCounterTokens[i], values[i]);
+}
+
 /// Return memory from pre-allocated staging buffer or create a temporary buffer if the streamer ran out of memory
 static MappedMemoryRange allocateStagingMemory(uint64_t memoryRequirement, uint32_t alignment, bool waitForSpace)
 {
@@ -499,6 +742,7 @@ static MappedMemoryRange allocateStagingMemory(uint64_t memoryRequirement, uint3
 			mapBuffer(pResourceLoader->pRenderer, buffer, NULL);
 #endif
 			pResourceSet->mTempBuffers.emplace_back(buffer);
+			recordStagingOverflow(memoryRequirement);
 			return { (uint8_t*)buffer->pCpuMappedAddress, pResourceSet->mTempBuffers.back(), 0, memoryRequirement };
 		}
 		if (waitForSpace)
@@ -525,6 +769,7 @@ static MappedMemoryRange allocateStagingMemory(uint64_t memoryRequirement, uint3
 	mapBuffer(pResourceLoader->pRenderer, buffer, NULL);
 #endif
 	pResourceSet->mTempBuffers.emplace_back(buffer);
+	recordStagingOverflow(memoryRequirement);
 	return { (uint8_t*)buffer->pCpuMappedAddress, pResourceSet->mTempBuffers.back(), 0, memoryRequirement };
 }
 
@@ -864,6 +1109,640 @@ static UploadFunctionResult updateTexture(Renderer* pRenderer, CopyEngine* pCopy
 	return UPLOAD_FUNCTION_RESULT_COMPLETED;
 }
 
+/************************************************************************/
+// Virtual texture page streaming
+/************************************************************************/
+#define VIRTUAL_TEXTURE_DEFAULT_PAGE_CACHE_SIZE (64ull << 20)
+// Pages the streamer reads per iteration so a burst of requests doesn't hold back the other loads
+#define VIRTUAL_TEXTURE_PAGE_READS_PER_ITERATION 64u
+
+// File and page table of one sparse virtual texture. Pages are read from the .svt file only when the visibility
+// feedback asks for them and are kept in the page cache shared by all virtual textures. pFile is only read with
+// mMutex held. Everything else is guarded by ResourceLoader::mVirtualTexturePageMutex.
+typedef struct VirtualTexturePageCache
+{
+	Mutex                                  mMutex;
+	FileStream*                            pFile;
+	eastl::vector<uint64_t>                mPageOffsets;
+	uint64_t                               mPageByteSize;
+	/// Cached copy of every page, NULL when the page is not cached
+	eastl::vector<VirtualTexturePageEntry*> mPageEntries;
+	/// The page is queued for the streamer
+	eastl::vector<bool>                    mPageRequested;
+	bool                                   mRemoved;
+	uint64_t                               mHitCount;
+	uint64_t                               mMissCount;
+} VirtualTexturePageCache;
+
+static void svtUnlinkEntry(ResourceLoader* pLoader, VirtualTexturePageEntry* pEntry)
+{
+	if (pEntry->pPrev)
+		pEntry->pPrev->pNext = pEntry->pNext;
+	else
+		pLoader->pMostRecentPage = pEntry->pNext;
+	if (pEntry->pNext)
+		pEntry->pNext->pPrev = pEntry->pPrev;
+	else
+		pLoader->pLeastRecentPage = pEntry->pPrev;
+}
+
+static void svtPushMostRecentEntry(ResourceLoader* pLoader, VirtualTexturePageEntry* pEntry)
+{
+	pEntry->pPrev = NULL;
+	pEntry->pNext = pLoader->pMostRecentPage;
+	if (pLoader->pMostRecentPage)
+		pLoader->pMostRecentPage->pPrev = pEntry;
+	else
+		pLoader->pLeastRecentPage = pEntry;
+	pLoader->pMostRecentPage = pEntry;
+}
+
+static void svtRemoveEntry(ResourceLoader* pLoader, VirtualTexturePageEntry* pEntry)
+{
+	svtUnlinkEntry(pLoader, pEntry);
+	pEntry->pCache->mPageEntries[pEntry->mPageIndex] = NULL;
+	pLoader->mVirtualTexturePageCacheUsed -= pEntry->pCache->mPageByteSize;
+	conf_free(pEntry->pData);
+	conf_delete(pEntry);
+}
+
+// Called with mVirtualTexturePageMutex held. Evicts the least recently used pages of any virtual texture until
+// pData fits in the budget
+static void svtInsertEntry(ResourceLoader* pLoader, VirtualTexturePageCache* pCache, uint32_t pageIndex, uint8_t* pData)
+{
+	while (pLoader->pLeastRecentPage && pLoader->mVirtualTexturePageCacheUsed + pCache->mPageByteSize > pLoader->mDesc.mVirtualTexturePageCacheSize)
+		svtRemoveEntry(pLoader, pLoader->pLeastRecentPage);
+
+	VirtualTexturePageEntry* pEntry = conf_new(VirtualTexturePageEntry);
+	pEntry->pCache = pCache;
+	pEntry->mPageIndex = pageIndex;
+	pEntry->pData = pData;
+	pCache->mPageEntries[pageIndex] = pEntry;
+	pLoader->mVirtualTexturePageCacheUsed += pCache->mPageByteSize;
+	svtPushMostRecentEntry(pLoader, pEntry);
+}
+
+// Called with pCache->mMutex held
+static uint8_t* svtReadPage(VirtualTexturePageCache* pCache, uint32_t pageIndex)
+{
+	uint8_t* pData = (uint8_t*)conf_malloc(pCache->mPageByteSize);
+	bool     read = fsSeekStream(pCache->pFile, SBO_START_OF_FILE, (ssize_t)pCache->mPageOffsets[pageIndex]) &&
+		fsReadFromStream(pCache->pFile, pData, pCache->mPageByteSize) == pCache->mPageByteSize;
+	if (!read)
+	{
+		LOGF(LogLevel::eERROR, "Failed to read virtual texture page %u", pageIndex);
+		memset(pData, 0, pCache->mPageByteSize);
+	}
+	return pData;
+}
+
+static bool addVirtualTexturePageCache(const Path* filePath, SVTHeader* pHeader, VirtualTexturePageCache** ppCache)
+{
+	FileStream* pFile = fsOpenFile(filePath, FM_READ_BINARY);
+	if (!pFile)
+	{
+		LOGF(LogLevel::eERROR, "Failed to open virtual texture %s", fsGetPathAsNativeString(filePath));
+		return false;
+	}
+
+	VirtualTexturePageCache* pCache = conf_new(VirtualTexturePageCache);
+	if (!readSVTHeader(pFile, pHeader, &pCache->mPageOffsets) || pHeader->mComponentCount != 4 || pHeader->mPageCount == 0)
+	{
+		LOGF(LogLevel::eERROR, "Invalid virtual texture %s", fsGetPathAsNativeString(filePath));
+		fsCloseStream(pFile);
+		conf_delete(pCache);
+		return false;
+	}
+
+	pCache->mMutex.Init();
+	pCache->pFile = pFile;
+	pCache->mPageByteSize = (uint64_t)pHeader->mPageSize * pHeader->mPageSize * pHeader->mComponentCount;
+	pCache->mPageEntries.resize(pHeader->mPageCount, NULL);
+	pCache->mPageRequested.resize(pHeader->mPageCount, false);
+	pCache->mRemoved = false;
+	pCache->mHitCount = 0;
+	pCache->mMissCount = 0;
+
+	*ppCache = pCache;
+	return true;
+}
+
+// Returns whether page pageIndex is cached. Pages that are not are queued for the streamer to read, the renderer
+// skips them and asks again on a later frame. Called by the renderer when it fills the pages requested by the
+// visibility feedback
+bool requestVirtualTexturePage(void* pPageCache, uint32_t pageIndex)
+{
+	VirtualTexturePageCache* pCache = (VirtualTexturePageCache*)pPageCache;
+	if (!pCache || pageIndex >= pCache->mPageEntries.size())
+		return false;
+
+	pResourceLoader->mVirtualTexturePageMutex.Acquire();
+	VirtualTexturePageEntry* pEntry = pCache->mPageEntries[pageIndex];
+	bool wakeStreamer = false;
+	if (pEntry)
+	{
+		svtUnlinkEntry(pResourceLoader, pEntry);
+		svtPushMostRecentEntry(pResourceLoader, pEntry);
+	}
+	else if (!pCache->mPageRequested[pageIndex])
+	{
+		pCache->mPageRequested[pageIndex] = true;
+		wakeStreamer = pResourceLoader->mVirtualTexturePageRequests.empty();
+		VirtualTexturePageRequest request = { pCache, pageIndex };
+		pResourceLoader->mVirtualTexturePageRequests.push_back(request);
+	}
+	pResourceLoader->mVirtualTexturePageMutex.Release();
+
+	// The streamer keeps reading until the queue is empty, so it only needs a nudge for the first request
+	if (wakeStreamer)
+	{
+		pResourceLoader->mQueueMutex.Acquire();
+		pResourceLoader->mQueueMutex.Release();
+		pResourceLoader->mQueueCond.WakeOne();
+	}
+	return pEntry != NULL;
+}
+
+// Copies page pageIndex to pDst. A page that is not cached is read on the calling thread when waitForRead is set,
+// otherwise it is queued like requestVirtualTexturePage does and false is returned
+bool readVirtualTexturePage(void* pPageCache, uint32_t pageIndex, void* pDst, uint64_t size, bool waitForRead)
+{
+	VirtualTexturePageCache* pCache = (VirtualTexturePageCache*)pPageCache;
+	if (!pCache || pageIndex >= pCache->mPageEntries.size() || size != pCache->mPageByteSize)
+	{
+		memset(pDst, 0, size);
+		return false;
+	}
+
+	pResourceLoader->mVirtualTexturePageMutex.Acquire();
+	VirtualTexturePageEntry* pEntry = pCache->mPageEntries[pageIndex];
+	if (pEntry)
+	{
+		++pCache->mHitCount;
+		svtUnlinkEntry(pResourceLoader, pEntry);
+		svtPushMostRecentEntry(pResourceLoader, pEntry);
+		memcpy(pDst, pEntry->pData, size);
+	}
+	pResourceLoader->mVirtualTexturePageMutex.Release();
+
+	if (pEntry)
+		return true;
+	if (!waitForRead)
+	{
+		requestVirtualTexturePage(pPageCache, pageIndex);
+		return false;
+	}
+
+	pCache->mMutex.Acquire();
+	uint8_t* pData = svtReadPage(pCache, pageIndex);
+	memcpy(pDst, pData, size);
+	pResourceLoader->mVirtualTexturePageMutex.Acquire();
+	++pCache->mMissCount;
+	if (pCache->mPageEntries[pageIndex])
+		conf_free(pData);
+	else
+		svtInsertEntry(pResourceLoader, pCache, pageIndex, pData);
+	pResourceLoader->mVirtualTexturePageMutex.Release();
+	pCache->mMutex.Release();
+	return true;
+}
+
+static bool hasVirtualTexturePageRequests(ResourceLoader* pLoader)
+{
+	pLoader->mVirtualTexturePageMutex.Acquire();
+	bool hasRequests = !pLoader->mVirtualTexturePageRequests.empty();
+	pLoader->mVirtualTexturePageMutex.Release();
+	return hasRequests;
+}
+
+// Reads the queued pages on the streamer thread. They are uploaded by the renderer on a later frame, when the
+// visibility feedback asks for them again
+static void readVirtualTexturePages(ResourceLoader* pLoader)
+{
+	for (uint32_t i = 0; i < VIRTUAL_TEXTURE_PAGE_READS_PER_ITERATION; ++i)
+	{
+		pLoader->mVirtualTexturePageMutex.Acquire();
+		if (pLoader->mVirtualTexturePageRequests.empty())
+		{
+			pLoader->mVirtualTexturePageMutex.Release();
+			break;
+		}
+		VirtualTexturePageRequest request = pLoader->mVirtualTexturePageRequests.front();
+		pLoader->mVirtualTexturePageRequests.pop_front();
+		// Taken before letting go of the page mutex so removeVirtualTexturePageCache waits for the read
+		request.pCache->mMutex.Acquire();
+		pLoader->mVirtualTexturePageMutex.Release();
+
+		uint8_t* pData = svtReadPage(request.pCache, request.mPageIndex);
+
+		pLoader->mVirtualTexturePageMutex.Acquire();
+		++request.pCache->mMissCount;
+		request.pCache->mPageRequested[request.mPageIndex] = false;
+		if (request.pCache->mRemoved || request.pCache->mPageEntries[request.mPageIndex])
+			conf_free(pData);
+		else
+			svtInsertEntry(pLoader, request.pCache, request.mPageIndex, pData);
+		pLoader->mVirtualTexturePageMutex.Release();
+		request.pCache->mMutex.Release();
+	}
+}
+
+void removeVirtualTexturePageCache(void* pPageCache)
+{
+	VirtualTexturePageCache* pCache = (VirtualTexturePageCache*)pPageCache;
+	if (!pCache)
+		return;
+
+	pResourceLoader->mVirtualTexturePageMutex.Acquire();
+	pCache->mRemoved = true;
+	eastl::deque<VirtualTexturePageRequest>& requests = pResourceLoader->mVirtualTexturePageRequests;
+	for (eastl::deque<VirtualTexturePageRequest>::iterator it = requests.begin(); it != requests.end();)
+	{
+		if (it->pCache == pCache)
+			it = requests.erase(it);
+		else
+			++it;
+	}
+	pResourceLoader->mVirtualTexturePageMutex.Release();
+
+	// Waits for a page the streamer may be reading
+	pCache->mMutex.Acquire();
+	pCache->mMutex.Release();
+
+	pResourceLoader->mVirtualTexturePageMutex.Acquire();
+	for (VirtualTexturePageEntry* pEntry : pCache->mPageEntries)
+	{
+		if (pEntry)
+			svtRemoveEntry(pResourceLoader, pEntry);
+	}
+	pResourceLoader->mVirtualTexturePageMutex.Release();
+
+	LOGF(LogLevel::eINFO, "Virtual texture page cache: %llu hits, %llu pages read", (unsigned long long)pCache->mHitCount, (unsigned long long)pCache->mMissCount);
+	fsCloseStream(pCache->pFile);
+	pCache->mMutex.Destroy();
+	conf_delete(pCache);
+}
+
+static void addTextureFromImage(TextureLoadDescInternal* pTextureDesc, Image* pImage, void* pNativeHandle)
+{
+	TextureDesc desc = {};
+	desc.mFlags = pTextureDesc->mCreationFlag;
+	desc.mWidth = pImage->GetWidth();
+	desc.mHeight = pImage->GetHeight();
+	desc.mDepth = max(1U, pImage->GetDepth());
+	desc.mArraySize = pImage->GetArrayCount();
+
+	desc.mMipLevels = pImage->GetMipMapCount();
+	desc.mSampleCount = SAMPLE_COUNT_1;
+	desc.mSampleQuality = 0;
+	desc.mFormat = pImage->GetFormat();
+
+	if (pTextureDesc->mCreationFlag & TEXTURE_CREATION_FLAG_SRGB)
+	{
+		// Set the format to be an sRGB format.
+		uint64_t formatBits = desc.mFormat;
+		formatBits &= ~((uint64_t)(TinyImageFormat_PACK_TYPE_REQUIRED_BITS - 1) << TinyImageFormat_PACK_TYPE_SHIFT);
+		formatBits |= (uint64_t)TinyImageFormat_PACK_TYPE_SRGB << TinyImageFormat_PACK_TYPE_SHIFT;
+		desc.mFormat = (TinyImageFormat)formatBits;
+	}
+
+	desc.mClearValue = ClearValue();
+	desc.mDescriptors = DESCRIPTOR_TYPE_TEXTURE;
+	desc.mStartState = RESOURCE_STATE_COMMON;
+	desc.pNativeHandle = pNativeHandle;
+	desc.mHostVisible = false;
+	desc.mNodeIndex = pTextureDesc->mNodeIndex;
+
+	if (pImage->IsCube())
+	{
+		desc.mDescriptors |= DESCRIPTOR_TYPE_TEXTURE_CUBE;
+		desc.mArraySize *= 6;
+	}
+
+	wchar_t debugName[MAX_PATH] = {};
+	desc.pDebugName = debugName;
+
+	if (const Path *path = pImage->GetPath()) {
+		PathComponent fileName = fsGetPathFileName(path);
+		mbstowcs(debugName, fileName.buffer, min((size_t)MAX_PATH, fileName.length));
+	}
+
+	addTexture(pResourceLoader->pRenderer, &desc, pTextureDesc->ppTexture);
+}
+
+/************************************************************************/
+// Progressive texture streaming
+/************************************************************************/
+#define TEXTURE_STREAMING_DEFAULT_BUDGET (256ull << 20)
+// Mips up to this size are uploaded together with the texture, the more detailed ones are streamed
+#define TEXTURE_STREAMING_BASE_MIP_SIZE 128u
+#define TEXTURE_STREAMING_NO_PENDING_MIP UINT32_MAX
+
+// Records the copies of every mip and layer of pImage into pTexture. Each layer of a mip is contiguous in a linear image
+// so it is copied into the staging buffer in one go. pTexture is always a texture the app cannot reference yet, either
+// a new progressive texture or the replacement of one, so the copy queue owns every subresource of it here
+static void uploadTextureMips(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, Texture* pTexture, Image* pImage)
+{
+	ASSERT(pImage->IsLinearLayout());
+	bool applyBarriers = pRenderer->mApi == RENDERER_API_VULKAN || pRenderer->mApi == RENDERER_API_XBOX_D3D12 || pRenderer->mApi == RENDERER_API_METAL;
+	uint32_t textureAlignment = ResourceLoader::GetSubtextureAlignment(pRenderer);
+	uint32_t layerCount = pImage->GetArrayCount() * (pImage->IsCube() ? 6 : 1);
+
+	Cmd* pCmd = acquireCmd(pCopyEngine, activeSet);
+
+	if (applyBarriers)
+	{
+		TextureBarrier preCopyBarrier = { pTexture, RESOURCE_STATE_COPY_DEST };
+		cmdResourceBarrier(pCmd, 0, NULL, 1, &preCopyBarrier, 0, NULL);
+	}
+
+	for (uint32_t i = 0; i < pImage->GetMipMapCount(); ++i)
+	{
+		uint32_t layerSize = pImage->GetArraySliceSize(i);
+		for (uint32_t j = 0; j < layerCount; ++j)
+		{
+			MappedMemoryRange range = allocateStagingMemory(layerSize, textureAlignment, /* waitForSpace = */ false);
+			ASSERT(range.pData);
+			memcpy(range.pData, pImage->GetPixels(i, j), layerSize);
+
+			SubresourceDataDesc texData = {};
+			texData.mBufferOffset = range.mOffset;
+			texData.mRowPitch = pImage->GetBytesPerRow(i);
+			texData.mSlicePitch = texData.mRowPitch * pImage->GetRowCount(i);
+			texData.mArrayLayer = j;
+			texData.mMipLevel = i;
+			texData.mRegion = { 0, 0, 0, pImage->GetWidth(i), pImage->GetHeight(i), max(1U, pImage->GetDepth(i)) };
+			cmdUpdateSubresource(pCmd, pTexture, range.pBuffer, &texData);
+		}
+	}
+
+	if (applyBarriers)
+	{
+		TextureBarrier postCopyBarrier = { pTexture, util_determine_resource_start_state(pTexture->mUav) };
+		cmdResourceBarrier(pCmd, 0, NULL, 1, &postCopyBarrier, 0, NULL);
+	}
+	else
+	{
+		pTexture->mCurrentState = util_determine_resource_start_state(pTexture->mUav);
+	}
+}
+
+// GPU memory of the streamed mips [firstMip, mBaseMip) of a texture holding file mips from firstMip on
+static uint64_t getStreamedSize(const TextureStream* pStream, uint32_t firstMip)
+{
+	uint64_t size = 0;
+	for (uint32_t i = firstMip; i < pStream->mBaseMip; ++i)
+		size += pStream->mMipSizes[i];
+	return size;
+}
+
+// Mip the next replacement of the texture should start at, TEXTURE_STREAMING_NO_PENDING_MIP if it is where the app
+// wants it. Promotes one mip at a time, drops straight to the requested mip
+static uint32_t getTextureStreamTarget(const TextureStream* pStream)
+{
+	if (pStream->mRequestedMip < pStream->mResidentMip)
+		return pStream->mResidentMip - 1;
+	if (pStream->mRequestedMip > pStream->mResidentMip)
+		return pStream->mRequestedMip;
+	return TEXTURE_STREAMING_NO_PENDING_MIP;
+}
+
+// Called with mTextureStreamMutex held
+static bool textureStreamHasWork(ResourceLoader* pLoader, const TextureStream* pStream)
+{
+	// One replacement at a time, the next one is decided once updateTextureStreaming published it
+	if (pStream->mPendingMip != TEXTURE_STREAMING_NO_PENDING_MIP)
+		return false;
+	uint32_t target = getTextureStreamTarget(pStream);
+	if (target == TEXTURE_STREAMING_NO_PENDING_MIP)
+		return false;
+	// Dropping mips always goes ahead since it ends up giving memory back
+	if (target > pStream->mResidentMip)
+		return true;
+	return pLoader->mTextureStreamingSize + getStreamedSize(pStream, target) <= pLoader->mDesc.mTextureStreamingBudget;
+}
+
+static bool hasTextureStreamWork(ResourceLoader* pLoader)
+{
+	bool hasWork = false;
+	pLoader->mTextureStreamMutex.Acquire();
+	for (eastl::pair<Texture* const, TextureStream*>& it : pLoader->mTextureStreams)
+	{
+		if (textureStreamHasWork(pLoader, it.second))
+		{
+			hasWork = true;
+			break;
+		}
+	}
+	pLoader->mTextureStreamMutex.Release();
+	return hasWork;
+}
+
+// Taken so the wake up cannot slip in between the streamer checking for work and going to sleep
+static void wakeStreamer(ResourceLoader* pLoader)
+{
+	pLoader->mQueueMutex.Acquire();
+	pLoader->mQueueMutex.Release();
+	pLoader->mQueueCond.WakeOne();
+}
+
+// Marks the replacements recorded into a copy set that has completed as ready to be published.
+// completedSet == SIZE_MAX completes every set
+static void completeTextureStreams(ResourceLoader* pLoader, size_t completedSet)
+{
+	pLoader->mTextureStreamMutex.Acquire();
+	for (eastl::pair<Texture* const, TextureStream*>& it : pLoader->mTextureStreams)
+	{
+		TextureStream* pStream = it.second;
+		if (!pStream->pPendingTexture || pStream->mPendingReady || (completedSet != SIZE_MAX && pStream->mPendingSet != completedSet))
+			continue;
+		pStream->mPendingReady = true;
+	}
+	pLoader->mTextureStreamMutex.Release();
+}
+
+static void addStreamTexture(TextureStream* pStream, Image* pImage, Texture** ppTexture)
+{
+	TextureLoadDescInternal desc = {};
+	desc.ppTexture = ppTexture;
+	desc.mNodeIndex = pStream->mNodeIndex;
+	desc.mCreationFlag = pStream->mCreationFlag;
+	addTextureFromImage(&desc, pImage, NULL);
+}
+
+// Builds the replacement of every stream that wants one, fits in the budget and fits in the staging buffer of the
+// active set. Only the file mips the replacement holds are read. Called on the streamer thread with
+// mStagingBufferMutex held, which keeps removeResource from freeing the streams in the meantime
+static void streamTextureMips(ResourceLoader* pLoader, uint32_t nodeIndex)
+{
+	Renderer*   pRenderer = pLoader->pRenderer;
+	CopyEngine* pCopyEngine = &pLoader->pCopyEngines[nodeIndex];
+	size_t      activeSet = pLoader->mActiveSetIndex;
+	uint32_t    textureAlignment = ResourceLoader::GetSubtextureAlignment(pRenderer);
+	uint32_t    textureRowAlignment = ResourceLoader::GetTextureRowAlignment(pRenderer);
+
+	// Staging memory is allocated from the copy engine of GPU 0
+	CopyResourceSet* pResourceSet = &pLoader->pCopyEngines[0].resourceSets[activeSet];
+	uint64_t stagingSize = pResourceSet->mBuffer->mSize;
+	uint64_t stagingLeft = stagingSize - min(stagingSize, pResourceSet->allocatedSpace);
+
+	eastl::vector<TextureStream*> uploads;
+
+	pLoader->mTextureStreamMutex.Acquire();
+	for (eastl::pair<Texture* const, TextureStream*>& it : pLoader->mTextureStreams)
+	{
+		TextureStream* pStream = it.second;
+		if (pStream->mNodeIndex != nodeIndex || !textureStreamHasWork(pLoader, pStream))
+			continue;
+
+		// Wait for the next set rather than spilling into a temporary buffer, unless the mips would never fit
+		uint32_t target = getTextureStreamTarget(pStream);
+		uint64_t stagingRequired = 0;
+		for (uint32_t i = target; i < (uint32_t)pStream->mMipSizes.size(); ++i)
+			stagingRequired += pStream->mMipSizes[i] + (uint64_t)pStream->mLayerCount * textureAlignment;
+		if (stagingRequired > stagingLeft && stagingLeft != stagingSize)
+			continue;
+		stagingLeft -= min(stagingLeft, stagingRequired);
+
+		pLoader->mTextureStreamingSize += getStreamedSize(pStream, target);
+		pStream->mPendingMip = target;
+		pStream->mPendingSet = activeSet;
+		uploads.push_back(pStream);
+	}
+	pLoader->mTextureStreamMutex.Release();
+
+	for (TextureStream* pStream : uploads)
+	{
+		uint32_t mipCount = (uint32_t)pStream->mMipSizes.size() - pStream->mPendingMip;
+		Image*   pImage = NULL;
+		ImageLoadingResult result =
+			ResourceLoader::CreateImageMips(pStream->pFilePath, pStream->mPendingMip, mipCount, textureRowAlignment, textureAlignment, &pImage);
+
+		Texture* pPendingTexture = NULL;
+		if (result == IMAGE_LOADING_RESULT_SUCCESS)
+		{
+			addStreamTexture(pStream, pImage, &pPendingTexture);
+			uploadTextureMips(pRenderer, pCopyEngine, activeSet, pPendingTexture, pImage);
+			ResourceLoader::DestroyImage(pImage);
+		}
+
+		pLoader->mTextureStreamMutex.Acquire();
+		if (pPendingTexture)
+		{
+			pStream->pPendingTexture = pPendingTexture;
+		}
+		else
+		{
+			// Keep the mips that are resident and stop asking for others
+			pLoader->mTextureStreamingSize -= getStreamedSize(pStream, pStream->mPendingMip);
+			pStream->mPendingMip = TEXTURE_STREAMING_NO_PENDING_MIP;
+			pStream->mRequestedMip = pStream->mResidentMip;
+		}
+		pLoader->mTextureStreamMutex.Release();
+	}
+}
+
+// Frees a stream and the replacement it was building. Its copy set must have completed
+static void removeTextureStream(ResourceLoader* pLoader, TextureStream* pStream)
+{
+	if (pStream->pPendingTexture)
+		removeTexture(pLoader->pRenderer, pStream->pPendingTexture);
+	fsFreePath(pStream->pFilePath);
+	conf_delete(pStream);
+}
+
+static void removeRetiredTextures(ResourceLoader* pLoader, uint64_t minAge)
+{
+	eastl::vector<Texture*> textures;
+	pLoader->mTextureStreamMutex.Acquire();
+	for (uint32_t i = 0; i < (uint32_t)pLoader->mRetiredTextures.size();)
+	{
+		RetiredTexture& retired = pLoader->mRetiredTextures[i];
+		if (pLoader->mTextureStreamingFrame - retired.mFrame < minAge)
+		{
+			++i;
+			continue;
+		}
+		textures.push_back(retired.pTexture);
+		pLoader->mTextureStreamingSize -= retired.mSize;
+		pLoader->mRetiredTextures.erase_unsorted(pLoader->mRetiredTextures.begin() + i);
+	}
+	pLoader->mTextureStreamMutex.Release();
+
+	for (Texture* pTexture : textures)
+		removeTexture(pLoader->pRenderer, pTexture);
+}
+
+// Uploads the small mips of a texture loaded with mProgressive and registers the rest for streaming. Returns false for
+// files that cannot be read mip by mip, they are loaded whole
+static bool loadTextureProgressive(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, UpdateState& pTextureUpdate, UploadFunctionResult* pResult)
+{
+	TextureLoadDescInternal* pTextureDesc = &pTextureUpdate.mRequest.texLoadDesc;
+	uint32_t textureAlignment = ResourceLoader::GetSubtextureAlignment(pRenderer);
+	uint32_t textureRowAlignment = ResourceLoader::GetTextureRowAlignment(pRenderer);
+
+	int64_t decodeStartTime = getUSec();
+	Image* pHeader = NULL;
+	if (ResourceLoader::CreateImageMips(pTextureDesc->pFilePath, 0, 0, 1, 1, &pHeader) != IMAGE_LOADING_RESULT_SUCCESS)
+		return false;
+
+	uint32_t mipCount = pHeader->GetMipMapCount();
+	uint32_t baseMip = 0;
+	while (baseMip + 1 < mipCount && max(pHeader->GetWidth(baseMip), pHeader->GetHeight(baseMip)) > TEXTURE_STREAMING_BASE_MIP_SIZE)
+		++baseMip;
+
+	// Only the base mips are read and allocated, the detailed ones come with the replacements built by streamTextureMips
+	Image* pImage = NULL;
+	ImageLoadingResult result = ResourceLoader::CreateImageMips(pTextureDesc->pFilePath, baseMip, mipCount - baseMip, textureRowAlignment, textureAlignment, &pImage);
+	pTextureUpdate.mDecodeTime = (uint64_t)(getUSec() - decodeStartTime);
+	if (result != IMAGE_LOADING_RESULT_SUCCESS)
+	{
+		ResourceLoader::DestroyImage(pHeader);
+		fsFreePath(pTextureDesc->pFilePath);
+		*pResult = UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
+		return true;
+	}
+
+	addTextureFromImage(pTextureDesc, pImage, NULL);
+	Texture* pTexture = *pTextureDesc->ppTexture;
+	uploadTextureMips(pRenderer, pCopyEngine, activeSet, pTexture, pImage);
+	ResourceLoader::DestroyImage(pImage);
+	*pResult = UPLOAD_FUNCTION_RESULT_COMPLETED;
+
+	// Small enough to be uploaded whole
+	if (baseMip == 0)
+	{
+		ResourceLoader::DestroyImage(pHeader);
+		fsFreePath(pTextureDesc->pFilePath);
+		return true;
+	}
+
+	TextureStream* pStream = conf_new(TextureStream);
+	pStream->pTexture = pTexture;
+	pStream->pFilePath = pTextureDesc->pFilePath;
+	pStream->mNodeIndex = pTextureDesc->mNodeIndex;
+	pStream->mCreationFlag = pTextureDesc->mCreationFlag;
+	pStream->mLayerCount = pHeader->GetArrayCount() * (pHeader->IsCube() ? 6 : 1);
+	// Tightly packed size of each mip, which is what the GPU allocation of the mip comes down to
+	pStream->mMipSizes.resize(mipCount);
+	for (uint32_t i = 0; i < mipCount; ++i)
+		pStream->mMipSizes[i] = (uint64_t)pHeader->GetArraySliceSize(i) * pStream->mLayerCount;
+	pStream->mBaseMip = baseMip;
+	pStream->mResidentMip = baseMip;
+	pStream->mRequestedMip = 0;
+	pStream->pPendingTexture = NULL;
+	pStream->mPendingMip = TEXTURE_STREAMING_NO_PENDING_MIP;
+	pStream->mPendingSet = 0;
+	pStream->mPendingReady = false;
+	ResourceLoader::DestroyImage(pHeader);
+
+	pResourceLoader->mTextureStreamMutex.Acquire();
+	pResourceLoader->mTextureStreams[pTexture] = pStream;
+	pResourceLoader->mTextureStreamMutex.Release();
+
+	return true;
+}
+
 static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, UpdateState& pTextureUpdate)
 {
 	TextureLoadDescInternal* pTextureDesc = &pTextureUpdate.mRequest.texLoadDesc;
@@ -880,39 +1759,35 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 	Image* pImage = NULL;
 	if (pTextureDesc->pFilePath)
 	{
-#if !defined(METAL) && !defined(DIRECT3D11)
+#if !defined(METAL) && !defined(DIRECT3D11) && !defined(NULL_RENDERER)
 		PathComponent component = fsGetPathExtension(pTextureDesc->pFilePath);
 
 		bool isSparseVirtualTexture = (component.length > 0 && strcmp(component.buffer, "svt") == 0) ? true : false;
 
 		if (isSparseVirtualTexture)
 		{
-			ImageLoadingResult result = ResourceLoader::CreateImage(pTextureDesc->pFilePath, NULL, NULL, 1, 1, &pImage);
-
-			if (result != IMAGE_LOADING_RESULT_ALLOCATION_FAILED)
-				fsFreePath(pTextureDesc->pFilePath);
-
-			if (result == IMAGE_LOADING_RESULT_ALLOCATION_FAILED)
-				return UPLOAD_FUNCTION_RESULT_STAGING_BUFFER_FULL;
-			else if (result != IMAGE_LOADING_RESULT_SUCCESS)
+			// Only the header and page table are read here, pages are streamed in when they become visible
+			SVTHeader                svtHeader = {};
+			VirtualTexturePageCache* pPageCache = NULL;
+			bool opened = addVirtualTexturePageCache(pTextureDesc->pFilePath, &svtHeader, &pPageCache);
+			fsFreePath(pTextureDesc->pFilePath);
+			if (!opened)
 				return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 
 			TextureDesc SVTDesc = {};
-			SVTDesc.mWidth = pImage->GetWidth();
-			SVTDesc.mHeight = pImage->GetHeight();
-			SVTDesc.mDepth = pImage->GetDepth();
+			SVTDesc.mWidth = svtHeader.mWidth;
+			SVTDesc.mHeight = svtHeader.mHeight;
+			SVTDesc.mDepth = 1;
 			SVTDesc.mFlags = TEXTURE_CREATION_FLAG_NONE;
-			SVTDesc.mFormat = pImage->GetFormat();
+			SVTDesc.mFormat = TinyImageFormat_R8G8B8A8_UNORM;
 			SVTDesc.mHostVisible = false;
-			SVTDesc.mMipLevels = pImage->GetMipMapCount();
+			SVTDesc.mMipLevels = svtHeader.mMipMapCount;
 			SVTDesc.mSampleCount = SAMPLE_COUNT_1;
 			//SVTDesc.mStartState = RESOURCE_STATE_COMMON;
 			SVTDesc.mStartState = RESOURCE_STATE_COPY_DEST;
 			SVTDesc.mDescriptors = DESCRIPTOR_TYPE_TEXTURE;
 
-			addVirtualTexture(pResourceLoader->pRenderer, &SVTDesc, pTextureDesc->ppTexture, pImage->GetPixels());
-
-			ResourceLoader::DestroyImage(pImage);
+			addVirtualTexture(pResourceLoader->pRenderer, &SVTDesc, pTextureDesc->ppTexture, pPageCache);
 
 			/************************************************************************/
 			// Create visibility buffer
@@ -998,7 +1873,15 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 		}
 #endif
 
+#if !defined(ORBIS)
+		UploadFunctionResult progressiveResult = UPLOAD_FUNCTION_RESULT_COMPLETED;
+		if (pTextureDesc->mProgressive && loadTextureProgressive(pRenderer, pCopyEngine, activeSet, pTextureUpdate, &progressiveResult))
+			return progressiveResult;
+#endif
+
+		int64_t decodeStartTime = getUSec();
 		ImageLoadingResult result = ResourceLoader::CreateImage(pTextureDesc->pFilePath, allocateTextureStagingMemory, &allocation, textureRowAlignment, textureAlignment, &pImage);
+		pTextureUpdate.mDecodeTime = (uint64_t)(getUSec() - decodeStartTime);
 
 		if (result != IMAGE_LOADING_RESULT_ALLOCATION_FAILED)
 			fsFreePath(pTextureDesc->pFilePath);
@@ -1015,7 +1898,9 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 	}
 	else if (pTextureDesc->mBinaryImageData.pBinaryData)
 	{
+		int64_t decodeStartTime = getUSec();
 		ImageLoadingResult result = ResourceLoader::CreateImage(pTextureDesc->mBinaryImageData.pBinaryData, (uint32_t)pTextureDesc->mBinaryImageData.mSize, pTextureDesc->mBinaryImageData.pExtension, allocateTextureStagingMemory, &allocation, textureRowAlignment, textureAlignment, &pImage);
+		pTextureUpdate.mDecodeTime = (uint64_t)(getUSec() - decodeStartTime);
 		if (result == IMAGE_LOADING_RESULT_ALLOCATION_FAILED)
 			return UPLOAD_FUNCTION_RESULT_STAGING_BUFFER_FULL;
 		else if (result != IMAGE_LOADING_RESULT_SUCCESS)
@@ -1024,53 +1909,11 @@ static UploadFunctionResult loadTexture(Renderer* pRenderer, CopyEngine* pCopyEn
 	else
 		ASSERT(0 && "Invalid params");
 
-	TextureDesc desc = {};
-	desc.mFlags = pTextureDesc->mCreationFlag;
-	desc.mWidth = pImage->GetWidth();
-	desc.mHeight = pImage->GetHeight();
-	desc.mDepth = max(1U, pImage->GetDepth());
-	desc.mArraySize = pImage->GetArrayCount();
-
-	desc.mMipLevels = pImage->GetMipMapCount();
-	desc.mSampleCount = SAMPLE_COUNT_1;
-	desc.mSampleQuality = 0;
-	desc.mFormat = pImage->GetFormat();
-
-	if (pTextureDesc->mCreationFlag & TEXTURE_CREATION_FLAG_SRGB)
-	{
-		// Set the format to be an sRGB format.
-		uint64_t formatBits = desc.mFormat;
-		formatBits &= ~((uint64_t)(TinyImageFormat_PACK_TYPE_REQUIRED_BITS - 1) << TinyImageFormat_PACK_TYPE_SHIFT);
-		formatBits |= (uint64_t)TinyImageFormat_PACK_TYPE_SRGB << TinyImageFormat_PACK_TYPE_SHIFT;
-		desc.mFormat = (TinyImageFormat)formatBits;
-	}
-
-	desc.mClearValue = ClearValue();
-	desc.mDescriptors = DESCRIPTOR_TYPE_TEXTURE;
-	desc.mStartState = RESOURCE_STATE_COMMON;
 #if defined(ORBIS)
-	desc.pNativeHandle = allocation.pAllocationInfo;
+	addTextureFromImage(pTextureDesc, pImage, allocation.pAllocationInfo);
 #else
-	desc.pNativeHandle = NULL;
+	addTextureFromImage(pTextureDesc, pImage, NULL);
 #endif
-	desc.mHostVisible = false;
-	desc.mNodeIndex = pTextureDesc->mNodeIndex;
-
-	if (pImage->IsCube())
-	{
-		desc.mDescriptors |= DESCRIPTOR_TYPE_TEXTURE_CUBE;
-		desc.mArraySize *= 6;
-	}
-
-	wchar_t debugName[MAX_PATH] = {};
-	desc.pDebugName = debugName;
-
-	if (const Path *path = pImage->GetPath()) {
-		PathComponent fileName = fsGetPathFileName(path);
-		mbstowcs(debugName, fileName.buffer, min((size_t)MAX_PATH, fileName.length));
-	}
-
-	addTexture(pResourceLoader->pRenderer, &desc, pTextureDesc->ppTexture);
 
 #if defined(ORBIS)
 	UploadFunctionResult result = UPLOAD_FUNCTION_RESULT_COMPLETED;
@@ -1285,7 +2128,12 @@ static UploadFunctionResult updateBuffer(Renderer* pRenderer, CopyEngine* pCopyE
 
 static UploadFunctionResult updateResourceState(Renderer* pRenderer, CopyEngine* pCopyEngine, size_t activeSet, UpdateState& pUpdate)
 {
+#ifdef _DURANGO
+	// Xbox One needs explicit resource transitions
+	bool applyBarriers = true;
+#else
 	bool applyBarriers = pRenderer->mApi == RENDERER_API_VULKAN;
+#endif
 	if (applyBarriers)
 	{
 		Cmd* pCmd = acquireCmd(pCopyEngine, activeSet);
@@ -1305,6 +2153,11 @@ static UploadFunctionResult updateResourceState(Renderer* pRenderer, CopyEngine*
 			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 		}
 	}
+	else if (pUpdate.mRequest.buffer)
+	{
+		// Resource will automatically transition so just set the next state without a barrier
+		pUpdate.mRequest.buffer->mCurrentState = pUpdate.mRequest.buffer->mStartState;
+	}
 
 	return UPLOAD_FUNCTION_RESULT_COMPLETED;
 }
@@ -1318,6 +2171,7 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 	// Geometry in gltf container
 	if (iext && (stricmp(iext, "gltf") == 0 || stricmp(iext, "glb") == 0))
 	{
+		int64_t decodeStartTime = getUSec();
 		FileStream* file = fsOpenFile(pDesc->pFilePath, FM_READ_BINARY);
 		if (!file)
 		{
@@ -1391,6 +2245,7 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 			conf_free(fileData);
 			return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 		}
+		pGeometryLoad.mDecodeTime = (uint64_t)(getUSec() - decodeStartTime);
 
 		typedef void (*PackingFunction)(uint32_t count, uint32_t stride, uint32_t offset, const uint8_t* src, uint8_t* dst);
 
@@ -1765,6 +2620,89 @@ static UploadFunctionResult loadGeometry(Renderer* pRenderer, CopyEngine* pCopyE
 
 	return UPLOAD_FUNCTION_RESULT_INVALID_REQUEST;
 }
+//////////////////////////////////////////////////////////////////////////
+// Asset cache
+//////////////////////////////////////////////////////////////////////////
+static void buildAssetCacheKey(const char* pType, const Path* pFilePath, uint32_t flags, uint32_t nodeIndex, eastl::string& key)
+{
+	key.sprintf("%s|%p|%s|%u|%u", pType, fsGetPathFileSystem(pFilePath), fsGetPathAsNativeString(pFilePath), flags, nodeIndex);
+}
+
+// Returns true if ppResource was served by an entry that is loaded or in flight. Otherwise a new entry is created and
+// returned with mAssetCacheMutex still held, so the caller can queue the load and set its token before anyone joins
+static bool acquireAssetCacheEntry(const eastl::string& key, void** ppResource, SyncToken* token, AssetCacheEntry** ppEntry)
+{
+	pResourceLoader->mAssetCacheMutex.Acquire();
+	eastl::unordered_map<eastl::string, AssetCacheEntry*>::iterator it = pResourceLoader->mAssetCache.find(key);
+	if (it != pResourceLoader->mAssetCache.end())
+	{
+		AssetCacheEntry* pEntry = it->second;
+		++pEntry->mRefCount;
+		if (pEntry->mLoaded)
+			*ppResource = pEntry->pResource;
+		else
+			pEntry->mWaiters.push_back(ppResource);
+		if (token)
+			*token = max(pEntry->mToken, *token);
+		pResourceLoader->mAssetCacheMutex.Release();
+		return true;
+	}
+
+	AssetCacheEntry* pEntry = conf_new(AssetCacheEntry);
+	pEntry->mKey = key;
+	pEntry->pResource = NULL;
+	pEntry->mRefCount = 1;
+	pEntry->mLoaded = false;
+	pEntry->mToken = {};
+	pEntry->mWaiters.push_back(ppResource);
+	pResourceLoader->mAssetCache[key] = pEntry;
+	*ppEntry = pEntry;
+	return false;
+}
+
+// Called on the streamer thread once the load of the entry has finished, successfully or not
+static void resolveAssetCacheEntry(ResourceLoader* pLoader, AssetCacheEntry* pEntry)
+{
+	pLoader->mAssetCacheMutex.Acquire();
+	for (void** ppResource : pEntry->mWaiters)
+		*ppResource = pEntry->pResource;
+	pEntry->mWaiters.clear();
+
+	if (pEntry->pResource)
+	{
+		pEntry->mLoaded = true;
+		pLoader->mAssetCacheResources[pEntry->pResource] = pEntry;
+	}
+	else
+	{
+		// Failed loads are not cached so the next request tries again
+		pLoader->mAssetCache.erase(pEntry->mKey);
+		conf_delete(pEntry);
+	}
+	pLoader->mAssetCacheMutex.Release();
+}
+
+// Returns true while other addResource calls still hold the resource
+static bool releaseAssetCacheEntry(void* pResource)
+{
+	bool referenced = false;
+	pResourceLoader->mAssetCacheMutex.Acquire();
+	eastl::unordered_map<void*, AssetCacheEntry*>::iterator it = pResourceLoader->mAssetCacheResources.find(pResource);
+	if (it != pResourceLoader->mAssetCacheResources.end())
+	{
+		AssetCacheEntry* pEntry = it->second;
+		referenced = --pEntry->mRefCount > 0;
+		if (!referenced)
+		{
+			pResourceLoader->mAssetCacheResources.erase(it);
+			pResourceLoader->mAssetCache.erase(pEntry->mKey);
+			conf_delete(pEntry);
+		}
+	}
+	pResourceLoader->mAssetCacheMutex.Release();
+	return referenced;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // Resource Loader Implementation
 //////////////////////////////////////////////////////////////////////////
@@ -1806,7 +2744,7 @@ static void streamerThreadFunc(void* pThreadData)
 	while (pLoader->mRun)
 	{
 		pLoader->mQueueMutex.Acquire();
-		while (allQueuesEmpty(pLoader) && pLoader->mRun)
+		while (allQueuesEmpty(pLoader) && !hasTextureStreamWork(pLoader) && !hasVirtualTexturePageRequests(pLoader) && pLoader->mRun)
 		{
 			// Empty queue
 			// Signal all tokens before going into condition variable sleep
@@ -1814,6 +2752,9 @@ static void streamerThreadFunc(void* pThreadData)
 				for (uint32_t b = 0; b < pLoader->mDesc.mBufferCount; ++b)
 					waitCopyEngineSet(pLoader->pRenderer, &pLoader->pCopyEngines[i], b);
 
+			// Replacements waiting on a copy set can be published by updateTextureStreaming
+			completeTextureStreams(pLoader, SIZE_MAX);
+
 			// As the only writer atomicity is preserved
 			pLoader->mTokenMutex.Acquire();
 			for (size_t i = 0; i < LOAD_PRIORITY_COUNT; ++i)
@@ -1823,12 +2764,18 @@ static void streamerThreadFunc(void* pThreadData)
 			pLoader->mTokenMutex.Release();
 			pLoader->mTokenCond.WakeAll();
 
+			if (hasTextureStreamWork(pLoader))
+				break;
+
 			// Sleep until someone adds an update request to the queue
 			pLoader->mQueueCond.Wait(pLoader->mQueueMutex);
 		}
 		pLoader->mQueueMutex.Release();
 
+		readVirtualTexturePages(pLoader);
+
 		pLoader->mStagingBufferMutex.Acquire();
+		int64_t iterationStartTime = getUSec();
 
 		for (uint32_t i = 1; i < linkedGPUCount; ++i)
 		{
@@ -1875,6 +2822,7 @@ static void streamerThreadFunc(void* pThreadData)
 				for (size_t j = 0; j < requestCount; j += 1)
 				{
 					UpdateState updateState = pLoader->mActiveQueue[j];
+					int64_t startTime = getUSec();
 
 					UploadFunctionResult result = UPLOAD_FUNCTION_RESULT_COMPLETED;
 					switch (updateState.mRequest.mType)
@@ -1901,6 +2849,13 @@ static void streamerThreadFunc(void* pThreadData)
 
 					completionMask |= completed << i;
 
+					if (result != UPLOAD_FUNCTION_RESULT_STAGING_BUFFER_FULL)
+					{
+						recordRequestStats(pLoader, updateState, priority, startTime, getUSec());
+						if (updateState.mRequest.pCacheEntry)
+							resolveAssetCacheEntry(pLoader, updateState.mRequest.pCacheEntry);
+					}
+
 					if (updateState.mRequest.mWaitIndex && completed)
 					{
 						// It's a queue, so items need to be processed in order for the SyncToken to work, but we're also inserting retries.
@@ -1925,10 +2880,28 @@ static void streamerThreadFunc(void* pThreadData)
 					}
 				}
 			}
+
+			// Progressive textures fill whatever the requests left of the staging buffer
+			streamTextureMips(pLoader, i);
 		}
 
 		if (completionMask != 0)
 		{
+			// Everything in the staging memory of GPU 0 is submitted by this flush
+			CopyResourceSet& resourceSet = pLoader->pCopyEngines[0].resourceSets[pLoader->mActiveSetIndex];
+			if (pLoader->pCopyEngines[0].isRecording)
+			{
+				uint64_t submittedBytes = resourceSet.allocatedSpace;
+				for (Buffer* pTempBuffer : resourceSet.mTempBuffers)
+					submittedBytes += pTempBuffer->mSize;
+
+				pLoader->mStatsMutex.Acquire();
+				pLoader->mStats.mUploadedBytes += submittedBytes;
+				pLoader->mBusyTime += (uint64_t)(getUSec() - iterationStartTime);
+				pLoader->mStatsMutex.Release();
+				publishResourceLoaderCounters(pLoader);
+			}
+
 			for (uint32_t i = 0; i < linkedGPUCount; ++i)
 			{
 				streamerFlush(&pLoader->pCopyEngines[i], pLoader->mActiveSetIndex);
@@ -1946,6 +2919,7 @@ static void streamerThreadFunc(void* pThreadData)
 				waitCopyEngineSet(pLoader->pRenderer, &pLoader->pCopyEngines[i], pLoader->mActiveSetIndex);
 				resetCopyEngineSet(pLoader->pRenderer, &pLoader->pCopyEngines[i], pLoader->mActiveSetIndex);
 			}
+			completeTextureStreams(pLoader, pLoader->mActiveSetIndex);
 
 			// As the only writer atomicity is preserved
 			pLoader->mTokenMutex.Acquire();
@@ -1969,7 +2943,7 @@ static void streamerThreadFunc(void* pThreadData)
 	}
 }
 
-ResourceLoaderDesc gDefaultResourceLoaderDesc = { 32ull << 20, 2 };
+ResourceLoaderDesc gDefaultResourceLoaderDesc = { 32ull << 20, 2, VIRTUAL_TEXTURE_DEFAULT_PAGE_CACHE_SIZE, NULL, TEXTURE_STREAMING_DEFAULT_BUDGET };
 
 static void addResourceLoader(Renderer* pRenderer, ResourceLoaderDesc* pDesc, ResourceLoader** ppLoader)
 {
@@ -1978,12 +2952,28 @@ static void addResourceLoader(Renderer* pRenderer, ResourceLoaderDesc* pDesc, Re
 
 	pLoader->mRun = true;
 	pLoader->mDesc = pDesc ? *pDesc : gDefaultResourceLoaderDesc;
+	if (!pLoader->mDesc.mTextureStreamingBudget)
+		pLoader->mDesc.mTextureStreamingBudget = TEXTURE_STREAMING_DEFAULT_BUDGET;
+	if (!pLoader->mDesc.mVirtualTexturePageCacheSize)
+		pLoader->mDesc.mVirtualTexturePageCacheSize = VIRTUAL_TEXTURE_DEFAULT_PAGE_CACHE_SIZE;
+	pLoader->mTextureStreamingSize = 0;
+	pLoader->mTextureStreamingFrame = 0;
+	pLoader->pMostRecentPage = NULL;
+	pLoader->pLeastRecentPage = NULL;
+	pLoader->mVirtualTexturePageCacheUsed = 0;
 
 	pLoader->mQueueMutex.Init();
 	pLoader->mTokenMutex.Init();
 	pLoader->mQueueCond.Init();
 	pLoader->mTokenCond.Init();
 	pLoader->mStagingBufferMutex.Init();
+	pLoader->mTextureStreamMutex.Init();
+	pLoader->mVirtualTexturePageMutex.Init();
+	pLoader->mStatsMutex.Init();
+	pLoader->mAssetCacheMutex.Init();
+	pLoader->mStats = {};
+	pLoader->mBusyTime = 0;
+	pLoader->mCounterGeneration = 0;
 
 	for (size_t i = 0; i < LOAD_PRIORITY_COUNT; i += 1)
 	{
@@ -2015,11 +3005,27 @@ static void removeResourceLoader(ResourceLoader* pLoader)
 	pLoader->mRun = false;
 	pLoader->mQueueCond.WakeOne();
 	destroy_thread(pLoader->mThread);
+
+	// Textures that were never removed
+	for (eastl::pair<Texture* const, TextureStream*>& it : pLoader->mTextureStreams)
+		removeTextureStream(pLoader, it.second);
+	pLoader->mTextureStreams.clear();
+	removeRetiredTextures(pLoader, 0);
+
+	for (eastl::pair<const eastl::string, AssetCacheEntry*>& it : pLoader->mAssetCache)
+		conf_delete(it.second);
+	pLoader->mAssetCache.clear();
+	pLoader->mAssetCacheResources.clear();
+
 	pLoader->mQueueCond.Destroy();
 	pLoader->mTokenCond.Destroy();
 	pLoader->mQueueMutex.Destroy();
 	pLoader->mTokenMutex.Destroy();
 	pLoader->mStagingBufferMutex.Destroy();
+	pLoader->mTextureStreamMutex.Destroy();
+	pLoader->mVirtualTexturePageMutex.Destroy();
+	pLoader->mStatsMutex.Destroy();
+	pLoader->mAssetCacheMutex.Destroy();
 
 	conf_delete(pLoader);
 }
@@ -2034,12 +3040,13 @@ static void queueResourceUpdate(ResourceLoader* pLoader, BufferUpdateDesc* pBuff
 
 	pLoader->mRequestQueue[nodeIndex][priority].emplace_back(UpdateRequest(*pBufferUpdate));
 	pLoader->mRequestQueue[nodeIndex][priority].back().mWaitIndex = t.mWaitIndex[priority];
+	pLoader->mRequestQueue[nodeIndex][priority].back().mQueueTime = getUSec();
 	pLoader->mQueueMutex.Release();
 	pLoader->mQueueCond.WakeOne();
 	if (token) *token = max(t, *token);
 }
 
-static void queueResourceUpdate(ResourceLoader* pLoader, TextureLoadDescInternal* pTextureUpdate, SyncToken* token, LoadPriority priority)
+static void queueResourceUpdate(ResourceLoader* pLoader, TextureLoadDescInternal* pTextureUpdate, SyncToken* token, LoadPriority priority, AssetCacheEntry* pCacheEntry = NULL)
 {
 	uint32_t nodeIndex = pTextureUpdate->mNodeIndex;
 	pLoader->mQueueMutex.Acquire();
@@ -2049,12 +3056,14 @@ static void queueResourceUpdate(ResourceLoader* pLoader, TextureLoadDescInternal
 
 	pLoader->mRequestQueue[nodeIndex][priority].emplace_back(UpdateRequest(*pTextureUpdate));
 	pLoader->mRequestQueue[nodeIndex][priority].back().mWaitIndex = t.mWaitIndex[priority];
+	pLoader->mRequestQueue[nodeIndex][priority].back().mQueueTime = getUSec();
+	pLoader->mRequestQueue[nodeIndex][priority].back().pCacheEntry = pCacheEntry;
 	pLoader->mQueueMutex.Release();
 	pLoader->mQueueCond.WakeOne();
 	if (token) *token = max(t, *token);
 }
 
-static void queueResourceUpdate(ResourceLoader* pLoader, GeometryLoadDesc* pGeometryLoad, SyncToken* token, LoadPriority priority)
+static void queueResourceUpdate(ResourceLoader* pLoader, GeometryLoadDesc* pGeometryLoad, SyncToken* token, LoadPriority priority, AssetCacheEntry* pCacheEntry = NULL)
 {
 	uint32_t nodeIndex = pGeometryLoad->mNodeIndex;
 	pLoader->mQueueMutex.Acquire();
@@ -2064,6 +3073,8 @@ static void queueResourceUpdate(ResourceLoader* pLoader, GeometryLoadDesc* pGeom
 
 	pLoader->mRequestQueue[nodeIndex][priority].emplace_back(UpdateRequest(*pGeometryLoad));
 	pLoader->mRequestQueue[nodeIndex][priority].back().mWaitIndex = t.mWaitIndex[priority];
+	pLoader->mRequestQueue[nodeIndex][priority].back().mQueueTime = getUSec();
+	pLoader->mRequestQueue[nodeIndex][priority].back().pCacheEntry = pCacheEntry;
 	pLoader->mQueueMutex.Release();
 	pLoader->mQueueCond.WakeOne();
 	if (token) *token = max(t, *token);
@@ -2081,6 +3092,7 @@ static void queueResourceUpdate(ResourceLoader* pLoader, TextureUpdateDescIntern
 
 	pLoader->mRequestQueue[nodeIndex][priority].emplace_back(UpdateRequest(*pTextureUpdate));
 	pLoader->mRequestQueue[nodeIndex][priority].back().mWaitIndex = t.mWaitIndex[priority];
+	pLoader->mRequestQueue[nodeIndex][priority].back().mQueueTime = getUSec();
 	pLoader->mQueueMutex.Release();
 	pLoader->mQueueCond.WakeOne();
 	if (token) *token = max(t, *token);
@@ -2096,6 +3108,7 @@ static void queueResourceUpdate(ResourceLoader* pLoader, Buffer* pBuffer, SyncTo
 
 	pLoader->mRequestQueue[nodeIndex][priority].emplace_back(UpdateRequest(pBuffer));
 	pLoader->mRequestQueue[nodeIndex][priority].back().mWaitIndex = t.mWaitIndex[priority];
+	pLoader->mRequestQueue[nodeIndex][priority].back().mQueueTime = getUSec();
 	pLoader->mQueueMutex.Release();
 	pLoader->mQueueCond.WakeOne();
 	if (token) *token = max(t, *token);
@@ -2111,6 +3124,7 @@ static void queueResourceUpdate(ResourceLoader* pLoader, Texture* pTexture, Sync
 
 	pLoader->mRequestQueue[nodeIndex][priority].emplace_back(UpdateRequest(pTexture));
 	pLoader->mRequestQueue[nodeIndex][priority].back().mWaitIndex = t.mWaitIndex[priority];
+	pLoader->mRequestQueue[nodeIndex][priority].back().mQueueTime = getUSec();
 	pLoader->mQueueMutex.Release();
 	pLoader->mQueueCond.WakeOne();
 	if (token) *token = max(t, *token);
@@ -2150,7 +3164,7 @@ void initResourceLoaderInterface(Renderer* pRenderer, ResourceLoaderDesc* pDesc)
 {
 	addResourceLoader(pRenderer, pDesc, &pResourceLoader);
 
-	ResourceLoader::InitImageClass();
+	ResourceLoader::InitImageClass(pResourceLoader->mDesc.pThreadSystem);
 }
 
 void exitResourceLoaderInterface(Renderer* pRenderer)
@@ -2160,9 +3174,69 @@ void exitResourceLoaderInterface(Renderer* pRenderer)
 	removeResourceLoader(pResourceLoader);
 }
 
-static uint64_t getMaximumStagingAllocationSize()
-{
-	return pResourceLoader->pCopyEngines[0].bufferSize;
+static uint64_t getMaximumStagingAllocationSize()
+{
+	return pResourceLoader->pCopyEngines[0].bufferSize;
+}
+
+// Memory the CPU can write and the GPU read without a copy. Besides the CPU heaps this catches buffers that ended up
+// persistently mapped at runtime, like GPU_ONLY allocations the driver placed in host-visible device memory.
+// Readback memory is left to the GPU and always goes through staging
+static bool isBufferHostVisible(const Buffer* pBuffer)
+{
+	ResourceMemoryUsage memoryUsage = (ResourceMemoryUsage)pBuffer->mMemoryUsage;
+	if (memoryUsage == RESOURCE_MEMORY_USAGE_GPU_TO_CPU)
+		return false;
+	return UMA || pBuffer->pCpuMappedAddress || memoryUsage == RESOURCE_MEMORY_USAGE_CPU_ONLY ||
+		   memoryUsage == RESOURCE_MEMORY_USAGE_CPU_TO_GPU || memoryUsage == RESOURCE_MEMORY_USAGE_UNKNOWN;
+}
+
+// A direct write is visible to the GPU right away. Buffers the caller declared for CPU writes leave frame-in-flight safety
+// to the caller as before. Any other buffer is only written in place while idle, i.e. right after it was created,
+// because the GPU may still be reading the previous contents
+static bool canWriteBufferDirectly(const Buffer* pBuffer, bool idle)
+{
+	if (!isBufferHostVisible(pBuffer))
+		return false;
+	ResourceMemoryUsage memoryUsage = (ResourceMemoryUsage)pBuffer->mMemoryUsage;
+	return idle || memoryUsage == RESOURCE_MEMORY_USAGE_CPU_ONLY || memoryUsage == RESOURCE_MEMORY_USAGE_CPU_TO_GPU ||
+		   memoryUsage == RESOURCE_MEMORY_USAGE_UNKNOWN;
+}
+
+static void beginUpdateBuffer(BufferUpdateDesc* pBufferUpdate, bool idle)
+{
+	Buffer* pBuffer = pBufferUpdate->pBuffer;
+	ASSERT(pBuffer);
+
+	uint64_t size = pBufferUpdate->mSize > 0 ? pBufferUpdate->mSize : (pBufferUpdate->pBuffer->mSize - pBufferUpdate->mDstOffset);
+	ASSERT(pBufferUpdate->mDstOffset + size <= pBuffer->mSize);
+
+	if (canWriteBufferDirectly(pBuffer, idle))
+	{
+		// We can directly provide the buffer's CPU-accessible address.
+		bool map = !pBuffer->pCpuMappedAddress;
+
+		if (map)
+		{
+			mapBuffer(pResourceLoader->pRenderer, pBuffer, NULL);
+		}
+
+		pBufferUpdate->mInternalData.mMappedRange = { (uint8_t*)pBuffer->pCpuMappedAddress + pBufferUpdate->mDstOffset, pBuffer };
+		pBufferUpdate->pMappedData = pBufferUpdate->mInternalData.mMappedRange.pData;
+		pBufferUpdate->mInternalData.mBufferNeedsUnmap = map;
+		pBufferUpdate->mInternalData.mDirectWrite = true;
+	}
+	else
+	{
+		// We need to use a staging buffer.
+		pResourceLoader->mStagingBufferMutex.Acquire();
+		MappedMemoryRange range = allocateStagingMemory(size, RESOURCE_BUFFER_ALIGNMENT, /* waitForSpace = */ true);
+		pBufferUpdate->pMappedData = range.pData;
+
+		pBufferUpdate->mInternalData.mMappedRange = range;
+		pBufferUpdate->mInternalData.mBufferNeedsUnmap = false;
+		pBufferUpdate->mInternalData.mDirectWrite = false;
+	}
 }
 
 static void beginAddBuffer(BufferLoadDesc* pBufferDesc)
@@ -2176,9 +3250,10 @@ static void beginAddBuffer(BufferLoadDesc* pBufferDesc)
 
 	if (update)
 	{
+		// Nothing can be reading the buffer yet
 		BufferUpdateDesc bufferUpdate = { *pBufferDesc->ppBuffer };
 		bufferUpdate.mSize = pBufferDesc->mDesc.mSize;
-		beginUpdateResource(&bufferUpdate);
+		beginUpdateBuffer(&bufferUpdate, true);
 		memcpy(bufferUpdate.pMappedData, pBufferDesc->pData, bufferUpdate.mSize);
 		pBufferDesc->mInternalData = bufferUpdate.mInternalData;
 
@@ -2203,6 +3278,16 @@ static void endAddBuffer(BufferLoadDesc* pBufferDesc, SyncToken* token, LoadPrio
 		bufferUpdate.mInternalData = pBufferDesc->mInternalData;
 		endUpdateResource(&bufferUpdate, token);
 
+		// A staged upload leaves GPU buffers in their start state. A direct write queues nothing, so queue the transition
+		// from the common state it was created in
+		Buffer* pBuffer = *pBufferDesc->ppBuffer;
+		if (pBufferDesc->mInternalData.mDirectWrite &&
+			(pBuffer->mMemoryUsage == RESOURCE_MEMORY_USAGE_GPU_ONLY || pBuffer->mMemoryUsage == RESOURCE_MEMORY_USAGE_GPU_TO_CPU))
+		{
+			pBuffer->mStartState = util_determine_resource_start_state(pBuffer);
+			queueResourceUpdate(pResourceLoader, pBuffer, token, priority);
+		}
+
 		pBufferDesc->mInternalData = {};
 	}
 	else
@@ -2284,12 +3369,35 @@ static void endAddTexture(TextureLoadDesc* pTextureDesc, SyncToken* token, LoadP
 	{
 		TextureLoadDescInternal updateDesc = {};
 		updateDesc.ppTexture = pTextureDesc->ppTexture;
-		updateDesc.pFilePath = fsCopyPath(pTextureDesc->pFilePath);
 		updateDesc.mNodeIndex = pTextureDesc->mNodeIndex;
 		if (pTextureDesc->pBinaryImageData)
 			updateDesc.mBinaryImageData = *pTextureDesc->pBinaryImageData;
 		updateDesc.mCreationFlag = pTextureDesc->mCreationFlag;
-		queueResourceUpdate(pResourceLoader, &updateDesc, token, priority);
+		updateDesc.mProgressive = pTextureDesc->mProgressive && pTextureDesc->pFilePath;
+
+		AssetCacheEntry* pCacheEntry = NULL;
+		if (pTextureDesc->pFilePath && pTextureDesc->mShared)
+		{
+			eastl::string key;
+			buildAssetCacheKey(updateDesc.mProgressive ? "progressive texture" : "texture", pTextureDesc->pFilePath,
+				(uint32_t)updateDesc.mCreationFlag, updateDesc.mNodeIndex, key);
+			if (acquireAssetCacheEntry(key, (void**)pTextureDesc->ppTexture, token, &pCacheEntry))
+				return;
+			updateDesc.ppTexture = (Texture**)&pCacheEntry->pResource;
+		}
+
+		updateDesc.pFilePath = fsCopyPath(pTextureDesc->pFilePath);
+		if (pCacheEntry)
+		{
+			queueResourceUpdate(pResourceLoader, &updateDesc, &pCacheEntry->mToken, priority, pCacheEntry);
+			if (token)
+				*token = max(pCacheEntry->mToken, *token);
+			pResourceLoader->mAssetCacheMutex.Release();
+		}
+		else
+		{
+			queueResourceUpdate(pResourceLoader, &updateDesc, token, priority);
+		}
 	}
 }
 
@@ -2298,9 +3406,9 @@ void addResource(BufferLoadDesc* pBufferDesc, SyncToken* token, LoadPriority pri
 	uint64_t stagingBufferSize = getMaximumStagingAllocationSize();
 	ASSERT(stagingBufferSize > 0);
 
-	if (pBufferDesc->pData && pBufferDesc->mDesc.mSize > stagingBufferSize && pBufferDesc->mDesc.mMemoryUsage != RESOURCE_MEMORY_USAGE_CPU_ONLY)
+	if (pBufferDesc->pData && pBufferDesc->mDesc.mSize > stagingBufferSize)
 	{
-		// The data is too large for a single staging buffer copy, so perform it in stages.
+		// The data may be too large for a single staging buffer copy, so perform it in stages.
 
 		// Save the data parameter so we can restore it later.
 		const void* data = pBufferDesc->pData;
@@ -2312,12 +3420,20 @@ void addResource(BufferLoadDesc* pBufferDesc, SyncToken* token, LoadPriority pri
 
 		BufferUpdateDesc updateDesc = {};
 		updateDesc.pBuffer = *pBufferDesc->ppBuffer;
+		// Buffers that turned out host visible are written in place, so the staging buffer size does not limit them
+		if (canWriteBufferDirectly(updateDesc.pBuffer, true))
+		{
+			beginUpdateBuffer(&updateDesc, true);
+			memcpy(updateDesc.pMappedData, data, pBufferDesc->mDesc.mSize);
+			endUpdateResource(&updateDesc, token);
+			return;
+		}
 		for (uint64_t offset = 0; offset < pBufferDesc->mDesc.mSize; offset += stagingBufferSize)
 		{
 			size_t chunkSize = min(stagingBufferSize, pBufferDesc->mDesc.mSize - offset);
 			updateDesc.mSize = chunkSize;
 			updateDesc.mDstOffset = offset;
-			beginUpdateResource(&updateDesc);
+			beginUpdateBuffer(&updateDesc, true);
 			memcpy(updateDesc.pMappedData, (char*)data + offset, chunkSize);
 			endUpdateResource(&updateDesc, token);
 		}
@@ -2342,17 +3458,136 @@ void addResource(GeometryLoadDesc* pDesc, SyncToken* token, LoadPriority priorit
 	ASSERT(pDesc->ppGeometry);
 
 	GeometryLoadDesc updateDesc = *pDesc;
+
+	AssetCacheEntry* pCacheEntry = NULL;
+	if (pDesc->mFlags & GEOMETRY_LOAD_FLAG_SHARED)
+	{
+		// The vertex layout decides how the file is packed into the buffers. Semantic names do not matter
+		eastl::string key;
+		buildAssetCacheKey("geometry", pDesc->pFilePath, (uint32_t)pDesc->mFlags, pDesc->mNodeIndex, key);
+		for (uint32_t i = 0; i < pDesc->pVertexLayout->mAttribCount; ++i)
+		{
+			const VertexAttrib& attrib = pDesc->pVertexLayout->mAttribs[i];
+			key.append_sprintf("|%u,%u,%u,%u,%u,%u", (uint32_t)attrib.mSemantic, (uint32_t)attrib.mFormat, attrib.mBinding, attrib.mLocation,
+				attrib.mOffset, (uint32_t)attrib.mRate);
+		}
+		if (acquireAssetCacheEntry(key, (void**)pDesc->ppGeometry, token, &pCacheEntry))
+			return;
+		updateDesc.ppGeometry = (Geometry**)&pCacheEntry->pResource;
+	}
+
 	updateDesc.pFilePath = fsCopyPath(pDesc->pFilePath);
 	updateDesc.pVertexLayout = (VertexLayout*)conf_calloc(1, sizeof(VertexLayout));
 	memcpy(updateDesc.pVertexLayout, pDesc->pVertexLayout, sizeof(VertexLayout));
-	queueResourceUpdate(pResourceLoader, &updateDesc, token, priority);
+	if (pCacheEntry)
+	{
+		queueResourceUpdate(pResourceLoader, &updateDesc, &pCacheEntry->mToken, priority, pCacheEntry);
+		if (token)
+			*token = max(pCacheEntry->mToken, *token);
+		pResourceLoader->mAssetCacheMutex.Release();
+	}
+	else
+	{
+		queueResourceUpdate(pResourceLoader, &updateDesc, token, priority);
+	}
 }
 
 void removeResource(Texture* pTexture)
 {
+	if (releaseAssetCacheEntry(pTexture))
+		return;
+
+	// Only progressive textures are shared with the streamer, the others are removed without waiting on it
+	pResourceLoader->mTextureStreamMutex.Acquire();
+	bool streamed = pResourceLoader->mTextureStreams.find(pTexture) != pResourceLoader->mTextureStreams.end();
+	pResourceLoader->mTextureStreamMutex.Release();
+
+	if (streamed)
+	{
+		// Holding the staging mutex keeps the streamer from building a replacement of the texture
+		pResourceLoader->mStagingBufferMutex.Acquire();
+		pResourceLoader->mTextureStreamMutex.Acquire();
+		eastl::unordered_map<Texture*, TextureStream*>::iterator it = pResourceLoader->mTextureStreams.find(pTexture);
+		TextureStream* pStream = it->second;
+		pResourceLoader->mTextureStreams.erase(it);
+		pResourceLoader->mTextureStreamingSize -= getStreamedSize(pStream, pStream->mResidentMip);
+		if (pStream->mPendingMip != TEXTURE_STREAMING_NO_PENDING_MIP)
+			pResourceLoader->mTextureStreamingSize -= getStreamedSize(pStream, pStream->mPendingMip);
+		pResourceLoader->mTextureStreamMutex.Release();
+
+		// The copies of the replacement may still be in flight
+		if (pStream->pPendingTexture && !pStream->mPendingReady)
+			waitCopyEngineSet(pResourceLoader->pRenderer, &pResourceLoader->pCopyEngines[pStream->mNodeIndex], pStream->mPendingSet);
+		removeTextureStream(pResourceLoader, pStream);
+		pResourceLoader->mStagingBufferMutex.Release();
+
+		// Other textures may fit in the budget now
+		wakeStreamer(pResourceLoader);
+	}
+
 	removeTexture(pResourceLoader->pRenderer, pTexture);
 }
 
+uint32_t getTextureResidentMip(Texture* pTexture)
+{
+	uint32_t residentMip = 0;
+	pResourceLoader->mTextureStreamMutex.Acquire();
+	eastl::unordered_map<Texture*, TextureStream*>::iterator it = pResourceLoader->mTextureStreams.find(pTexture);
+	if (it != pResourceLoader->mTextureStreams.end())
+		residentMip = it->second->mResidentMip;
+	pResourceLoader->mTextureStreamMutex.Release();
+	return residentMip;
+}
+
+void requestTextureMip(Texture* pTexture, uint32_t mostDetailedMip)
+{
+	pResourceLoader->mTextureStreamMutex.Acquire();
+	eastl::unordered_map<Texture*, TextureStream*>::iterator it = pResourceLoader->mTextureStreams.find(pTexture);
+	if (it != pResourceLoader->mTextureStreams.end())
+		it->second->mRequestedMip = min(mostDetailedMip, it->second->mBaseMip);
+	pResourceLoader->mTextureStreamMutex.Release();
+
+	wakeStreamer(pResourceLoader);
+}
+
+void updateTextureStreaming(uint32_t framesInFlight)
+{
+	bool releasedBudget = false;
+
+	pResourceLoader->mTextureStreamMutex.Acquire();
+	++pResourceLoader->mTextureStreamingFrame;
+	for (eastl::pair<Texture* const, TextureStream*>& it : pResourceLoader->mTextureStreams)
+	{
+		TextureStream* pStream = it.second;
+		if (!pStream->mPendingReady)
+			continue;
+
+		// Progressive textures only have SRV descriptors so the native resources are entirely held by the struct and
+		// can be swapped. The app keeps its pointer while the old resources are retired
+		Texture* pRetired = pStream->pPendingTexture;
+		Texture temp = *pStream->pTexture;
+		*pStream->pTexture = *pRetired;
+		*pRetired = temp;
+
+		RetiredTexture retired = { pRetired, getStreamedSize(pStream, pStream->mResidentMip), pResourceLoader->mTextureStreamingFrame };
+		pResourceLoader->mRetiredTextures.push_back(retired);
+
+		pStream->mResidentMip = pStream->mPendingMip;
+		pStream->pPendingTexture = NULL;
+		pStream->mPendingMip = TEXTURE_STREAMING_NO_PENDING_MIP;
+		pStream->mPendingReady = false;
+	}
+	releasedBudget = !pResourceLoader->mRetiredTextures.empty();
+	pResourceLoader->mTextureStreamMutex.Release();
+
+	// The frames that may still sample the retired resources are the ones recorded before this call
+	removeRetiredTextures(pResourceLoader, framesInFlight);
+
+	// Published textures may want their next mip, retired ones may have freed the budget
+	if (releasedBudget)
+		wakeStreamer(pResourceLoader);
+}
+
 void removeResource(Buffer* pBuffer)
 {
 	removeBuffer(pResourceLoader->pRenderer, pBuffer);
@@ -2360,6 +3595,9 @@ void removeResource(Buffer* pBuffer)
 
 void removeResource(Geometry* pGeom)
 {
+	if (releaseAssetCacheEntry(pGeom))
+		return;
+
 	removeResource(pGeom->pIndexBuffer);
 
 	for (uint32_t i = 0; i < pGeom->mVertexBufferCount; ++i)
@@ -2370,37 +3608,7 @@ void removeResource(Geometry* pGeom)
 
 void beginUpdateResource(BufferUpdateDesc* pBufferUpdate)
 {
-	Buffer* pBuffer = pBufferUpdate->pBuffer;
-	ASSERT(pBuffer);
-
-	uint64_t size = pBufferUpdate->mSize > 0 ? pBufferUpdate->mSize : (pBufferUpdate->pBuffer->mSize - pBufferUpdate->mDstOffset);
-	ASSERT(pBufferUpdate->mDstOffset + size <= pBuffer->mSize);
-
-	ResourceMemoryUsage memoryUsage = (ResourceMemoryUsage)pBufferUpdate->pBuffer->mMemoryUsage;
-	if (UMA || memoryUsage == RESOURCE_MEMORY_USAGE_CPU_ONLY || memoryUsage == RESOURCE_MEMORY_USAGE_CPU_TO_GPU || memoryUsage == RESOURCE_MEMORY_USAGE_UNKNOWN)
-	{
-		// We can directly provide the buffer's CPU-accessible address.
-		bool map = !pBuffer->pCpuMappedAddress;
-
-		if (map)
-		{
-			mapBuffer(pResourceLoader->pRenderer, pBuffer, NULL);
-		}
-
-		pBufferUpdate->mInternalData.mMappedRange = { (uint8_t*)pBuffer->pCpuMappedAddress + pBufferUpdate->mDstOffset, pBuffer };
-		pBufferUpdate->pMappedData = pBufferUpdate->mInternalData.mMappedRange.pData;
-		pBufferUpdate->mInternalData.mBufferNeedsUnmap = map;
-	}
-	else
-	{
-		// We need to use a staging buffer.
-		pResourceLoader->mStagingBufferMutex.Acquire();
-		MappedMemoryRange range = allocateStagingMemory(size, RESOURCE_BUFFER_ALIGNMENT, /* waitForSpace = */ true);
-		pBufferUpdate->pMappedData = range.pData;
-
-		pBufferUpdate->mInternalData.mMappedRange = range;
-		pBufferUpdate->mInternalData.mBufferNeedsUnmap = false;
-	}
+	beginUpdateBuffer(pBufferUpdate, false);
 }
 
 void beginUpdateResource(TextureUpdateDesc* pTextureUpdate)
@@ -2458,8 +3666,8 @@ void endUpdateResource(BufferUpdateDesc* pBufferUpdate, SyncToken* token)
 		unmapBuffer(pResourceLoader->pRenderer, pBufferUpdate->pBuffer);
 	}
 
-	ResourceMemoryUsage memoryUsage = (ResourceMemoryUsage)pBufferUpdate->pBuffer->mMemoryUsage;
-	if (!UMA && (memoryUsage == RESOURCE_MEMORY_USAGE_GPU_TO_CPU || memoryUsage == RESOURCE_MEMORY_USAGE_GPU_ONLY))
+	// Decided in beginUpdateResource, the buffer may have been mapped for the write and unmapped above
+	if (!pBufferUpdate->mInternalData.mDirectWrite)
 	{
 		queueResourceUpdate(pResourceLoader, pBufferUpdate, token, LOAD_PRIORITY_UPDATE);
 		// We need to hold the staging buffer mutex until after enqueuing the update to ensure the active set doesn't change in between allocating the staging memory and submitting to the queue.
@@ -2508,6 +3716,19 @@ bool isTokenCompleted(const SyncToken* token)
 	return isTokenCompleted(pResourceLoader, token);
 }
 
+void getResourceLoaderStats(ResourceLoaderStats* pStats)
+{
+	getResourceLoaderStats(pResourceLoader, pStats);
+}
+
+void resetResourceLoaderStats()
+{
+	pResourceLoader->mStatsMutex.Acquire();
+	pResourceLoader->mStats = {};
+	pResourceLoader->mBusyTime = 0;
+	pResourceLoader->mStatsMutex.Release();
+}
+
 void waitForToken(const SyncToken* token)
 {
 	waitForToken(pResourceLoader, token);
@@ -2947,10 +4168,78 @@ bool save_byte_code(const Path* binaryShaderPath, const eastl::vector<char>& byt
 	return true;
 }
 
+// Reflection is cached in a file next to the shader binary so addShaderBinary can skip reflecting the byte code.
+// The header ties the cached reflection to the exact byte code it was generated from
+typedef struct ShaderReflectionFileHeader
+{
+	uint32_t mByteCodeHash;
+	uint32_t mByteCodeSize;
+} ShaderReflectionFileHeader;
+
+static uint32_t util_shader_byte_code_hash(const eastl::vector<char>& byteCode)
+{
+	uint32_t hash = 0;
+	MurmurHash3_x86_32(byteCode.data(), (int)byteCode.size(), 0, &hash);
+	return hash;
+}
+
+// Maps the serialized reflection if it was generated from byteCode. The caller unmaps it once the shader is created
+bool check_for_shader_reflection(const Path* reflectionPath, const eastl::vector<char>& byteCode, FileMapping* pReflection)
+{
+	if (fsGetFileSystemKind(fsGetPathFileSystem(reflectionPath)) != FSK_SYSTEM || !fsFileExists(reflectionPath))
+		return false;
+
+	if (!fsMapFileReadOnly(reflectionPath, pReflection))
+		return false;
+
+	const ShaderReflectionFileHeader* pHeader = (const ShaderReflectionFileHeader*)pReflection->pData;
+	const bool valid = pReflection->mSize > sizeof(ShaderReflectionFileHeader) && pHeader->mByteCodeSize == (uint32_t)byteCode.size() &&
+		pHeader->mByteCodeHash == util_shader_byte_code_hash(byteCode);
+	if (!valid)
+		fsUnmapFile(pReflection);
+	return valid;
+}
+
+// Saves the reflection the renderer generated for byteCode. Other loads may have the file mapped, so it is written
+// next to the target and moved over it instead of being rewritten in place
+bool save_shader_reflection(const Path* reflectionPath, const eastl::vector<char>& byteCode, const ShaderReflection* pReflection)
+{
+	if (fsGetFileSystemKind(fsGetPathFileSystem(reflectionPath)) != FSK_SYSTEM)
+		return false;
+
+	// Another load of the same stage may have saved it since this one checked
+	FileMapping existing = {};
+	if (check_for_shader_reflection(reflectionPath, byteCode, &existing))
+	{
+		fsUnmapFile(&existing);
+		return true;
+	}
+
+	size_t size = 0;
+	serializeShaderReflection(pReflection, &size, NULL);
+	if (!size)
+		return false;
+
+	eastl::vector<char> data(sizeof(ShaderReflectionFileHeader) + size);
+	ShaderReflectionFileHeader header = { util_shader_byte_code_hash(byteCode), (uint32_t)byteCode.size() };
+	memcpy(data.data(), &header, sizeof(header));
+	serializeShaderReflection(pReflection, &size, data.data() + sizeof(header));
+
+	PathHandle tempPath = fsAppendPathExtension(reflectionPath, "tmp");
+	if (!save_byte_code(tempPath, data))
+		return false;
+	if (!fsReplaceFile(tempPath, reflectionPath))
+	{
+		fsDeleteFile(tempPath);
+		return false;
+	}
+	return true;
+}
+
 bool load_shader_stage_byte_code(
 	Renderer* pRenderer, ShaderTarget target, ShaderStage stage, ShaderStage allStages, const Path* filePath, uint32_t macroCount,
 	ShaderMacro* pMacros, eastl::vector<char>& byteCode,
-	const char* pEntryPoint)
+	const char* pEntryPoint, PathHandle* pReflectionPath, FileMapping* pReflection)
 {
 	eastl::string code;
 	time_t          timeStamp = 0;
@@ -3007,7 +4296,22 @@ bool load_shader_stage_byte_code(
 	}
 #endif
 
-#ifndef NX64
+#if defined(NULL_RENDERER)
+	// There is no shader compiler behind the null renderer. Hand it the preprocessed source with the user macros
+	// prepended so its reflection sees the same declarations the real compiler would
+	eastl::string source;
+	for (uint32_t i = 0; i < macroCount; ++i)
+		source += eastl::string().sprintf("#define %s %s\n", pMacros[i].definition, pMacros[i].value);
+	source += code;
+	byteCode.assign(source.begin(), source.end());
+
+	if (!code.size())
+	{
+		LOGF(eERROR, "Empty shader source %s", fsGetPathAsNativeString(filePath));
+		fsCloseStream(sourceFileStream);
+		return false;
+	}
+#elif !defined(NX64)
 	PathComponent directoryPath, fileName, extension;
 	fsGetPathComponents(filePath, &directoryPath, &fileName, &extension);
 	eastl::string shaderDefines;
@@ -3103,6 +4407,12 @@ bool load_shader_stage_byte_code(
 			return false;
 		}
 	}
+
+#if !defined(METAL) && !defined(ORBIS)
+	// Metal reflection also records vertex formats on the shader so it always runs
+	*pReflectionPath = fsAppendPathExtension(binaryShaderPath, "refl");
+	check_for_shader_reflection(*pReflectionPath, byteCode, pReflection);
+#endif
 #else
 #endif
 
@@ -3204,7 +4514,25 @@ bool find_shader_stage(
 	return true;
 }
 #endif
-void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShader)
+// Variants often share a stage (e.g. one vertex shader for many pixel shader permutations). When shaders are added
+// concurrently, stages are locked by file and macros so a shared binary is compiled and written by one thread while
+// the others wait and then load it
+#define SHADER_COMPILE_LOCK_COUNT 64
+
+static uint32_t util_shader_stage_lock_index(const Path* filePath, ShaderTarget target, uint32_t macroCount, const ShaderMacro* pMacros)
+{
+	const char* pPath = fsGetPathAsNativeString(filePath);
+	uint32_t    hash = (uint32_t)target;
+	MurmurHash3_x86_32(pPath, (int)strlen(pPath), hash, &hash);
+	for (uint32_t i = 0; i < macroCount; ++i)
+	{
+		MurmurHash3_x86_32(pMacros[i].definition, (int)strlen(pMacros[i].definition), hash, &hash);
+		MurmurHash3_x86_32(pMacros[i].value, (int)strlen(pMacros[i].value), hash, &hash);
+	}
+	return hash % SHADER_COMPILE_LOCK_COUNT;
+}
+
+static void addShaderImpl(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShader, Mutex* pCompileLocks)
 {
 	if ((uint32_t)pDesc->mTarget > pRenderer->mShaderTarget)
 	{
@@ -3218,6 +4546,10 @@ void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShad
 
 	BinaryShaderDesc      binaryDesc = {};
 	eastl::vector<char> byteCodes[SHADER_STAGE_COUNT] = {};
+	FileMapping         reflections[SHADER_STAGE_COUNT] = {};
+	PathHandle          reflectionPaths[SHADER_STAGE_COUNT] = {};
+	ShaderStage         stageMasks[SHADER_STAGE_COUNT] = {};
+	Mutex*              pStageLocks[SHADER_STAGE_COUNT] = {};
 #if defined(METAL)
 	char* pSources[SHADER_STAGE_COUNT] = {};
 #endif
@@ -3270,14 +4602,35 @@ void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShad
 				for (uint32_t macro = 0; macro < pDesc->mStages[i].mMacroCount; ++macro)
 					macros[pRenderer->mBuiltinShaderDefinesCount + macro] = pDesc->mStages[i].pMacros[macro];
 
-				if (!load_shader_stage_byte_code(
+				if (pCompileLocks)
+				{
+					pStageLocks[i] = &pCompileLocks[util_shader_stage_lock_index(filePath, pDesc->mTarget, macroCount, macros.data())];
+					pStageLocks[i]->Acquire();
+				}
+
+				const bool loaded = load_shader_stage_byte_code(
 					pRenderer, pDesc->mTarget, stage, stages, filePath, macroCount, macros.data(),
-					byteCodes[i], pDesc->mStages[i].pEntryPointName))
+					byteCodes[i], pDesc->mStages[i].pEntryPointName, &reflectionPaths[i], &reflections[i]);
+
+				if (pStageLocks[i])
+					pStageLocks[i]->Release();
+
+				if (!loaded)
+				{
+					for (uint32_t j = 0; j < i; ++j)
+						fsUnmapFile(&reflections[j]);
 					return;
+				}
 
 				binaryDesc.mStages |= stage;
+				stageMasks[i] = stage;
 				pStage->pByteCode = byteCodes[i].data();
 				pStage->mByteCodeSize = (uint32_t)byteCodes[i].size();
+				if (reflections[i].pData)
+				{
+					pStage->pReflection = (const char*)reflections[i].pData + sizeof(ShaderReflectionFileHeader);
+					pStage->mReflectionSize = (uint32_t)(reflections[i].mSize - sizeof(ShaderReflectionFileHeader));
+				}
 #if defined(METAL)
 				if (pDesc->mStages[i].pEntryPointName)
 					pStage->pEntryPoint = pDesc->mStages[i].pEntryPointName;
@@ -3306,6 +4659,34 @@ void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShad
 
 	addShaderBinary(pRenderer, &binaryDesc, ppShader);
 
+	// The renderer deserialized the cached reflection into the shader
+	for (uint32_t i = 0; i < SHADER_STAGE_COUNT; ++i)
+	{
+		if (reflections[i].pData)
+		{
+			fsUnmapFile(&reflections[i]);
+			continue;
+		}
+		// Cache the reflection of stages which had to be reflected from byte code
+		if (!reflectionPaths[i] || !*ppShader)
+			continue;
+
+		const PipelineReflection* pReflection = (*ppShader)->pReflection;
+		for (uint32_t s = 0; s < pReflection->mStageReflectionCount; ++s)
+		{
+			if (pReflection->mStageReflections[s].mShaderStage == stageMasks[i])
+			{
+				if (pStageLocks[i])
+					pStageLocks[i]->Acquire();
+				if (!save_shader_reflection(reflectionPaths[i], byteCodes[i], &pReflection->mStageReflections[s]))
+					LOGF(LogLevel::eWARNING, "Failed to save shader reflection %s", fsGetPathAsNativeString(reflectionPaths[i]));
+				if (pStageLocks[i])
+					pStageLocks[i]->Release();
+				break;
+			}
+		}
+	}
+
 #if defined(METAL)
 	for (uint32_t i = 0; i < SHADER_STAGE_COUNT; ++i)
 	{
@@ -3368,3 +4749,189 @@ void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShad
 	addShader(pRenderer, &desc, ppShader);
 #endif
 }
+
+void addShader(Renderer* pRenderer, const ShaderLoadDesc* pDesc, Shader** ppShader)
+{
+	addShaderImpl(pRenderer, pDesc, ppShader, NULL);
+}
+
+typedef struct ShaderBatch
+{
+	Renderer*             pRenderer;
+	const ShaderLoadDesc* pDescs;
+	Shader**              ppShaders;
+	Mutex*                pCompileLocks;
+	uint32_t              mCount;
+	tfrg_atomic32_t       mNextIndex;
+	tfrg_atomic32_t       mRemainingTasks;
+} ShaderBatch;
+
+// Each task keeps taking the next shader until the batch is exhausted so the number of tasks bounds the parallelism
+static void addShaderBatch(ShaderBatch* pBatch)
+{
+	for (;;)
+	{
+		const uint32_t index = (uint32_t)tfrg_atomic32_add_relaxed(&pBatch->mNextIndex, 1);
+		if (index >= pBatch->mCount)
+			break;
+
+		addShaderImpl(pBatch->pRenderer, &pBatch->pDescs[index], &pBatch->ppShaders[index], pBatch->pCompileLocks);
+	}
+}
+
+static void addShaderTask(void* pUser, uintptr_t)
+{
+	ShaderBatch* pBatch = (ShaderBatch*)pUser;
+	addShaderBatch(pBatch);
+	// Publishes the shaders of this task to addShaders waiting on the count
+	tfrg_atomic32_add_release(&pBatch->mRemainingTasks, -1);
+}
+
+void addShaders(Renderer* pRenderer, uint32_t count, const ShaderLoadDesc* pDescs, Shader** ppShaders, ThreadSystem* pThreadSystem, uint32_t maxConcurrency)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescs);
+	ASSERT(ppShaders);
+
+	if (!maxConcurrency)
+		maxConcurrency = Thread::GetNumCPUCores();
+	const uint32_t concurrency = min(count, maxConcurrency);
+
+	if (!pThreadSystem || concurrency <= 1)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+			addShader(pRenderer, &pDescs[i], &ppShaders[i]);
+		return;
+	}
+
+	Mutex compileLocks[SHADER_COMPILE_LOCK_COUNT];
+	for (uint32_t i = 0; i < SHADER_COMPILE_LOCK_COUNT; ++i)
+		compileLocks[i].Init();
+
+	// The calling thread is one of the workers
+	ShaderBatch batch = { pRenderer, pDescs, ppShaders, compileLocks, count, 0, concurrency - 1 };
+	addThreadSystemRangeTask(pThreadSystem, addShaderTask, &batch, concurrency - 1);
+
+	addShaderBatch(&batch);
+	while (tfrg_atomic32_load_acquire(&batch.mRemainingTasks))
+	{
+		if (!assistThreadSystem(pThreadSystem))
+			Thread::Sleep(0);
+	}
+
+	for (uint32_t i = 0; i < SHADER_COMPILE_LOCK_COUNT; ++i)
+		compileLocks[i].Destroy();
+}
+/************************************************************************/
+// Pipeline Cache
+/************************************************************************/
+bool loadPipelineCache(const char* pFileName, PipelineCacheDesc* pOutDesc)
+{
+	ASSERT(pFileName);
+	ASSERT(pOutDesc);
+
+	*pOutDesc = {};
+
+	FileStream* fh = fsOpenFileInResourceDirectory(RD_SHADER_BINARIES, pFileName, FM_READ_BINARY);
+	if (!fh)
+		return false;
+
+	const ssize_t size = fsGetStreamFileSize(fh);
+	if (size <= 0)
+	{
+		fsCloseStream(fh);
+		return false;
+	}
+
+	pOutDesc->pData = conf_malloc((size_t)size);
+	pOutDesc->mSize = fsReadFromStream(fh, pOutDesc->pData, (size_t)size);
+	fsCloseStream(fh);
+
+	// Header and device validation happens in addPipelineCache
+	if (pOutDesc->mSize != (size_t)size)
+	{
+		LOGF(LogLevel::eWARNING, "Failed to read pipeline cache %s", pFileName);
+		conf_free(pOutDesc->pData);
+		*pOutDesc = {};
+		return false;
+	}
+
+	return true;
+}
+
+void savePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache, const char* pFileName)
+{
+	ASSERT(pRenderer);
+	ASSERT(pFileName);
+
+	if (!pPipelineCache)
+		return;
+
+	size_t size = 0;
+	getPipelineCacheData(pRenderer, pPipelineCache, &size, NULL);
+	if (!size)
+		return;
+
+	void* pData = conf_malloc(size);
+	getPipelineCacheData(pRenderer, pPipelineCache, &size, pData);
+
+	PathHandle cachePath = fsCopyPathInResourceDirectory(RD_SHADER_BINARIES, pFileName);
+	PathHandle parentDirectory = fsCopyParentPath(cachePath);
+	if (!fsFileExists(parentDirectory))
+	{
+		fsCreateDirectory(parentDirectory);
+	}
+
+	FileStream* fh = fsOpenFile(cachePath, FM_WRITE_BINARY);
+	if (fh)
+	{
+		fsWriteToStream(fh, pData, size);
+		fsCloseStream(fh);
+	}
+	else
+	{
+		LOGF(LogLevel::eWARNING, "Failed to save pipeline cache %s", pFileName);
+	}
+
+	conf_free(pData);
+}
+
+typedef struct PipelineBatch
+{
+	Renderer*           pRenderer;
+	const PipelineDesc* pDescs;
+	Pipeline**          ppPipelines;
+	tfrg_atomic32_t     mRemaining;
+} PipelineBatch;
+
+static void addPipelineTask(void* pUser, uintptr_t index)
+{
+	PipelineBatch* pBatch = (PipelineBatch*)pUser;
+	addPipeline(pBatch->pRenderer, &pBatch->pDescs[index], &pBatch->ppPipelines[index]);
+	// Publishes the pipeline to addPipelines waiting on the count
+	tfrg_atomic32_add_release(&pBatch->mRemaining, -1);
+}
+
+void addPipelines(Renderer* pRenderer, uint32_t count, const PipelineDesc* pDescs, Pipeline** ppPipelines, ThreadSystem* pThreadSystem)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDescs);
+	ASSERT(ppPipelines);
+
+	if (!pThreadSystem || count <= 1)
+	{
+		for (uint32_t i = 0; i < count; ++i)
+			addPipeline(pRenderer, &pDescs[i], &ppPipelines[i]);
+		return;
+	}
+
+	PipelineBatch batch = { pRenderer, pDescs, ppPipelines, count };
+	addThreadSystemRangeTask(pThreadSystem, addPipelineTask, &batch, count);
+
+	// Compile on this thread as well instead of waiting for the whole thread system to go idle, it may be busy with unrelated work
+	while (tfrg_atomic32_load_acquire(&batch.mRemaining))
+	{
+		if (!assistThreadSystem(pThreadSystem))
+			Thread::Sleep(0);
+	}
+}
@@ -25,6 +25,7 @@ typedef struct UMAAllocation {
 typedef struct BufferUpdateInternalData {
 	MappedMemoryRange mMappedRange;
 	bool mBufferNeedsUnmap;
+	bool mDirectWrite;
 } BufferUpdateInternalData;
 
 #ifdef __cplusplus
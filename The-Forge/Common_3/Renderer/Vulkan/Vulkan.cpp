@@ -61,6 +61,7 @@
 #endif
 
 #include "../IRenderer.h"
+#include "../DescriptorIndexMap.h"
 
 #include "../../ThirdParty/OpenSource/EASTL/functional.h"
 #include "../../ThirdParty/OpenSource/EASTL/sort.h"
@@ -81,6 +82,10 @@
 #include "../../OS/Interfaces/IMemory.h"
 
 extern void vk_createShaderReflection(const uint8_t* shaderCode, uint32_t shaderSize, ShaderStage shaderStage, ShaderReflection* pOutReflection);
+// Virtual texture pages are streamed from disk by the resource loader
+extern bool requestVirtualTexturePage(void* pPageCache, uint32_t pageIndex);
+extern bool readVirtualTexturePage(void* pPageCache, uint32_t pageIndex, void* pDst, uint64_t size, bool waitForRead);
+extern void removeVirtualTexturePageCache(void* pPageCache);
 
 #ifdef ENABLE_RAYTRACING
 extern void addRaytracingPipelineImpl(const RaytracingPipelineDesc*, Pipeline**);
@@ -597,8 +602,6 @@ VkPipelineBindPoint gPipelineBindPoint[PIPELINE_TYPE_COUNT] =
 #endif
 };
 
-using DescriptorNameToIndexMap = eastl::string_hash_map<uint32_t>;
-
 union DescriptorUpdateData
 {
 	VkDescriptorImageInfo  mImageInfo;
@@ -614,21 +617,16 @@ struct SizeOffset
 /************************************************************************/
 // Descriptor Set Structure
 /************************************************************************/
-typedef struct DescriptorIndexMap
-{
-	eastl::string_hash_map<uint32_t> mMap;
-} DescriptorIndexMap;
-
-static const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const char* pResName)
+static const DescriptorInfo* get_descriptor(const RootSignature* pRootSignature, const DescriptorName& name)
 {
-	DescriptorNameToIndexMap::const_iterator it = pRootSignature->pDescriptorNameToIndexMap->mMap.find(pResName);
-	if (it != pRootSignature->pDescriptorNameToIndexMap->mMap.end())
+	const uint32_t index = find_descriptor_index(pRootSignature->pDescriptorNameToIndexMap, name);
+	if (index != (uint32_t)-1)
 	{
-		return &pRootSignature->pDescriptors[it->second];
+		return &pRootSignature->pDescriptors[index];
 	}
 	else
 	{
-		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", pResName);
+		LOGF(LogLevel::eERROR, "Invalid descriptor param (%s)", name.pName);
 		return NULL;
 	}
 }
@@ -2712,6 +2710,9 @@ void initRenderer(const char* appName, const RendererDesc* pDesc, Renderer** ppR
 
 	add_default_resources(pRenderer);
 
+	PipelineCacheDesc pipelineCacheDesc = {};
+	addPipelineCache(pRenderer, pDesc->pPipelineCacheDesc ? pDesc->pPipelineCacheDesc : &pipelineCacheDesc, &pRenderer->pPipelineCache);
+
 	// Renderer is good!
 	*ppRenderer = pRenderer;
 }
@@ -2720,6 +2721,8 @@ void removeRenderer(Renderer* pRenderer)
 {
 	ASSERT(pRenderer);
 
+	removePipelineCache(pRenderer, pRenderer->pPipelineCache);
+
 	remove_default_resources(pRenderer);
 
 	remove_descriptor_pool(pRenderer, pRenderer->pDescriptorPool);
@@ -4245,7 +4248,7 @@ void updateDescriptorSet(Renderer* pRenderer, uint32_t index, DescriptorSet* pDe
 		}
 		else
 		{
-			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName);
+			VALIDATE_DESCRIPTOR(pDesc, "Invalid descriptor with param name (%s)", pParam->pName.pName);
 		}
 
 		const DescriptorType type = (DescriptorType)pDesc->mType;
@@ -4502,14 +4505,14 @@ void cmdBindDescriptorSet(Cmd* pCmd, uint32_t index, DescriptorSet* pDescriptorS
 		pDescriptorSet->mDynamicOffsetCount, pDescriptorSet->mDynamicOffsetCount ? &pDescriptorSet->pDynamicSizeOffsets[index].mOffset : NULL);
 }
 
-void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, const char* pName, const void* pConstants)
+void cmdBindPushConstants(Cmd* pCmd, RootSignature* pRootSignature, DescriptorName name, const void* pConstants)
 {
 	ASSERT(pCmd);
 	ASSERT(pConstants);
 	ASSERT(pRootSignature);
-	ASSERT(pName);
+	ASSERT(name.pName);
 	
-	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, pName);
+	const DescriptorInfo* pDesc = get_descriptor(pRootSignature, name);
 	ASSERT(pDesc);
 	ASSERT(DESCRIPTOR_TYPE_ROOT_CONSTANT == pDesc->mType);
 
@@ -4594,9 +4597,10 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 			{
 				case SHADER_STAGE_VERT:
 				{
-					vk_createShaderReflection(
-						(const uint8_t*)pDesc->mVert.pByteCode, (uint32_t)pDesc->mVert.mByteCodeSize, stage_mask,
-						&stageReflections[counter]);
+					if (!deserializeShaderReflection(pDesc->mVert.pReflection, pDesc->mVert.mReflectionSize, stage_mask, &stageReflections[counter]))
+						vk_createShaderReflection(
+							(const uint8_t*)pDesc->mVert.pByteCode, (uint32_t)pDesc->mVert.mByteCodeSize, stage_mask,
+							&stageReflections[counter]);
 
 					create_info.codeSize = pDesc->mVert.mByteCodeSize;
 					create_info.pCode = (const uint32_t*)pDesc->mVert.pByteCode;
@@ -4607,9 +4611,10 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 				break;
 				case SHADER_STAGE_TESC:
 				{
-					vk_createShaderReflection(
-						(const uint8_t*)pDesc->mHull.pByteCode, (uint32_t)pDesc->mHull.mByteCodeSize, stage_mask,
-						&stageReflections[counter]);
+					if (!deserializeShaderReflection(pDesc->mHull.pReflection, pDesc->mHull.mReflectionSize, stage_mask, &stageReflections[counter]))
+						vk_createShaderReflection(
+							(const uint8_t*)pDesc->mHull.pByteCode, (uint32_t)pDesc->mHull.mByteCodeSize, stage_mask,
+							&stageReflections[counter]);
 
 					create_info.codeSize = pDesc->mHull.mByteCodeSize;
 					create_info.pCode = (const uint32_t*)pDesc->mHull.pByteCode;
@@ -4620,9 +4625,10 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 				break;
 				case SHADER_STAGE_TESE:
 				{
-					vk_createShaderReflection(
-						(const uint8_t*)pDesc->mDomain.pByteCode, (uint32_t)pDesc->mDomain.mByteCodeSize, stage_mask,
-						&stageReflections[counter]);
+					if (!deserializeShaderReflection(pDesc->mDomain.pReflection, pDesc->mDomain.mReflectionSize, stage_mask, &stageReflections[counter]))
+						vk_createShaderReflection(
+							(const uint8_t*)pDesc->mDomain.pByteCode, (uint32_t)pDesc->mDomain.mByteCodeSize, stage_mask,
+							&stageReflections[counter]);
 
 					create_info.codeSize = pDesc->mDomain.mByteCodeSize;
 					create_info.pCode = (const uint32_t*)pDesc->mDomain.pByteCode;
@@ -4633,9 +4639,10 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 				break;
 				case SHADER_STAGE_GEOM:
 				{
-					vk_createShaderReflection(
-						(const uint8_t*)pDesc->mGeom.pByteCode, (uint32_t)pDesc->mGeom.mByteCodeSize, stage_mask,
-						&stageReflections[counter]);
+					if (!deserializeShaderReflection(pDesc->mGeom.pReflection, pDesc->mGeom.mReflectionSize, stage_mask, &stageReflections[counter]))
+						vk_createShaderReflection(
+							(const uint8_t*)pDesc->mGeom.pByteCode, (uint32_t)pDesc->mGeom.mByteCodeSize, stage_mask,
+							&stageReflections[counter]);
 
 					create_info.codeSize = pDesc->mGeom.mByteCodeSize;
 					create_info.pCode = (const uint32_t*)pDesc->mGeom.pByteCode;
@@ -4646,9 +4653,10 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 				break;
 				case SHADER_STAGE_FRAG:
 				{
-					vk_createShaderReflection(
-						(const uint8_t*)pDesc->mFrag.pByteCode, (uint32_t)pDesc->mFrag.mByteCodeSize, stage_mask,
-						&stageReflections[counter]);
+					if (!deserializeShaderReflection(pDesc->mFrag.pReflection, pDesc->mFrag.mReflectionSize, stage_mask, &stageReflections[counter]))
+						vk_createShaderReflection(
+							(const uint8_t*)pDesc->mFrag.pByteCode, (uint32_t)pDesc->mFrag.mByteCodeSize, stage_mask,
+							&stageReflections[counter]);
 
 					create_info.codeSize = pDesc->mFrag.mByteCodeSize;
 					create_info.pCode = (const uint32_t*)pDesc->mFrag.pByteCode;
@@ -4662,9 +4670,10 @@ void addShaderBinary(Renderer* pRenderer, const BinaryShaderDesc* pDesc, Shader*
 				case SHADER_STAGE_RAYTRACING:
 #endif
 				{
-					vk_createShaderReflection(
-						(const uint8_t*)pDesc->mComp.pByteCode, (uint32_t)pDesc->mComp.mByteCodeSize, stage_mask,
-						&stageReflections[counter]);
+					if (!deserializeShaderReflection(pDesc->mComp.pReflection, pDesc->mComp.mReflectionSize, stage_mask, &stageReflections[counter]))
+						vk_createShaderReflection(
+							(const uint8_t*)pDesc->mComp.pByteCode, (uint32_t)pDesc->mComp.mByteCodeSize, stage_mask,
+							&stageReflections[counter]);
 
 					create_info.codeSize = pDesc->mComp.mByteCodeSize;
 					create_info.pCode = (const uint32_t*)pDesc->mComp.pByteCode;
@@ -4766,7 +4775,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	}
 
 	PipelineType pipelineType = PIPELINE_TYPE_UNDEFINED;
-	DescriptorIndexMap indexMap;
+	DescriptorNameToIndexMap indexMap;
 
 	// Collect all unique shader resources in the given shaders
 	// Resources are parsed by name (two resources named "XYZ" in two shaders will be considered the same resource)
@@ -4791,9 +4800,9 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 			if (pRes->type == DESCRIPTOR_TYPE_ROOT_CONSTANT)
 				setIndex = 0;
 
-			eastl::string_hash_map<uint32_t>::iterator it =
-				indexMap.mMap.find(pRes->name);
-			if (it == indexMap.mMap.end())
+			decltype(indexMap)::iterator it =
+				indexMap.find(pRes->name);
+			if (it == indexMap.end())
 			{
 				decltype(shaderResources)::iterator it = eastl::find(shaderResources.begin(), shaderResources.end(), *pRes,
 					[](const ShaderResource& a, const ShaderResource& b)
@@ -4802,7 +4811,7 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 				});
 				if (it == shaderResources.end())
 				{
-					indexMap.mMap.insert(pRes->name, (uint32_t)shaderResources.size());
+					indexMap.insert(pRes->name, (uint32_t)shaderResources.size());
 					shaderResources.push_back(*pRes);
 				}
 				else
@@ -4819,8 +4828,8 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 						return;
 					}
 
-					indexMap.mMap.insert(pRes->name,
-						indexMap.mMap[it->name]);
+					indexMap.insert(pRes->name,
+						indexMap[it->name]);
 					it->used_stages |= pRes->used_stages;
 				}
 			}
@@ -4861,14 +4870,14 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 
 	size_t totalSize = sizeof(RootSignature);
 	totalSize += shaderResources.size() * sizeof(DescriptorInfo);
-	totalSize += sizeof(DescriptorIndexMap);
+	totalSize += descriptor_index_map_size(indexMap);
 	RootSignature* pRootSignature = (RootSignature*)conf_calloc(1, totalSize);
 	ASSERT(pRootSignature);
 
 	pRootSignature->pDescriptors = (DescriptorInfo*)(pRootSignature + 1);
 	pRootSignature->pDescriptorNameToIndexMap = (DescriptorIndexMap*)(pRootSignature->pDescriptors + shaderResources.size());
 	ASSERT(pRootSignature->pDescriptorNameToIndexMap);
-	conf_placement_new<DescriptorIndexMap>(pRootSignature->pDescriptorNameToIndexMap);
+	init_descriptor_index_map(pRootSignature->pDescriptorNameToIndexMap, indexMap);
 
 	if ((uint32_t)shaderResources.size())
 	{
@@ -4876,7 +4885,6 @@ void addRootSignature(Renderer* pRenderer, const RootSignatureDesc* pRootSignatu
 	}
 
 	pRootSignature->mPipelineType = pipelineType;
-	pRootSignature->pDescriptorNameToIndexMap->mMap = indexMap.mMap;
 
 	// Fill the descriptor array to be stored in the root signature
 	for (uint32_t i = 0; i < (uint32_t)shaderResources.size(); ++i)
@@ -5206,9 +5214,6 @@ void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
 		SAFE_FREE(pRootSignature->pUpdateTemplateData[i]);
 	}
 
-	// Need delete since the destructor frees allocated memory
-	pRootSignature->pDescriptorNameToIndexMap->mMap.clear(true);
-
 	vkDestroyPipelineLayout(pRenderer->pVkDevice, pRootSignature->pPipelineLayout, NULL);
 
 	SAFE_FREE(pRootSignature);
@@ -5216,7 +5221,7 @@ void removeRootSignature(Renderer* pRenderer, RootSignature* pRootSignature)
 /************************************************************************/
 // Pipeline State Functions
 /************************************************************************/
-static void addGraphicsPipelineImpl(Renderer* pRenderer, const GraphicsPipelineDesc* pDesc, Pipeline** ppPipeline)
+static void addGraphicsPipelineImpl(Renderer* pRenderer, const GraphicsPipelineDesc* pDesc, PipelineCache* pCache, Pipeline** ppPipeline)
 {
 	ASSERT(pRenderer);
 	ASSERT(ppPipeline);
@@ -5459,7 +5464,8 @@ static void addGraphicsPipelineImpl(Renderer* pRenderer, const GraphicsPipelineD
 		add_info.subpass = 0;
 		add_info.basePipelineHandle = VK_NULL_HANDLE;
 		add_info.basePipelineIndex = -1;
-		VkResult vk_res = vkCreateGraphicsPipelines(pRenderer->pVkDevice, VK_NULL_HANDLE, 1, &add_info, NULL, &(pPipeline->pVkPipeline));
+		VkPipelineCache psoCache = pCache ? pCache->pCache : VK_NULL_HANDLE;
+		VkResult vk_res = vkCreateGraphicsPipelines(pRenderer->pVkDevice, psoCache, 1, &add_info, NULL, &(pPipeline->pVkPipeline));
 		ASSERT(VK_SUCCESS == vk_res);
 
 		remove_render_pass(pRenderer, pRenderPass);
@@ -5468,7 +5474,7 @@ static void addGraphicsPipelineImpl(Renderer* pRenderer, const GraphicsPipelineD
 	*ppPipeline = pPipeline;
 }
 
-static void addComputePipelineImpl(Renderer* pRenderer, const ComputePipelineDesc* pDesc, Pipeline** ppPipeline)
+static void addComputePipelineImpl(Renderer* pRenderer, const ComputePipelineDesc* pDesc, PipelineCache* pCache, Pipeline** ppPipeline)
 {
 	ASSERT(pRenderer);
 	ASSERT(ppPipeline);
@@ -5501,7 +5507,8 @@ static void addComputePipelineImpl(Renderer* pRenderer, const ComputePipelineDes
 		create_info.layout = pDesc->pRootSignature->pPipelineLayout;
 		create_info.basePipelineHandle = 0;
 		create_info.basePipelineIndex = 0;
-		VkResult vk_res = vkCreateComputePipelines(pRenderer->pVkDevice, VK_NULL_HANDLE, 1, &create_info, NULL, &(pPipeline->pVkPipeline));
+		VkPipelineCache psoCache = pCache ? pCache->pCache : VK_NULL_HANDLE;
+		VkResult vk_res = vkCreateComputePipelines(pRenderer->pVkDevice, psoCache, 1, &create_info, NULL, &(pPipeline->pVkPipeline));
 		ASSERT(VK_SUCCESS == vk_res);
 	}
 
@@ -5510,16 +5517,18 @@ static void addComputePipelineImpl(Renderer* pRenderer, const ComputePipelineDes
 
 void addPipeline(Renderer* pRenderer, const PipelineDesc* pDesc, Pipeline** ppPipeline)
 {
+	PipelineCache* pCache = pDesc->pCache ? pDesc->pCache : pRenderer->pPipelineCache;
+
 	switch (pDesc->mType)
 	{
 		case(PIPELINE_TYPE_COMPUTE):
 		{
-			addComputePipelineImpl(pRenderer, &pDesc->mComputeDesc, ppPipeline);
+			addComputePipelineImpl(pRenderer, &pDesc->mComputeDesc, pCache, ppPipeline);
 			break;
 		}
 		case(PIPELINE_TYPE_GRAPHICS):
 		{
-			addGraphicsPipelineImpl(pRenderer, &pDesc->mGraphicsDesc, ppPipeline);
+			addGraphicsPipelineImpl(pRenderer, &pDesc->mGraphicsDesc, pCache, ppPipeline);
 			break;
 		}
 #ifdef ENABLE_RAYTRACING
@@ -5554,6 +5563,131 @@ void removePipeline(Renderer* pRenderer, Pipeline* pPipeline)
 	SAFE_FREE(pPipeline);
 }
 /************************************************************************/
+// Pipeline Cache Functions
+/************************************************************************/
+// Written in front of the driver data so a cache from a different device or driver is rejected before it reaches the driver
+typedef struct PipelineCacheHeader
+{
+	uint32_t mMagic;
+	uint32_t mVersion;
+	uint32_t mVendorId;
+	uint32_t mDeviceId;
+	uint32_t mDriverVersion;
+	uint8_t  mCacheUUID[VK_UUID_SIZE];
+	uint32_t mPadA;
+	uint64_t mDataSize;
+} PipelineCacheHeader;
+
+static const uint32_t gPipelineCacheMagic = 0x43504654;    // "TFPC"
+static const uint32_t gPipelineCacheVersion = 1;
+
+static void util_fill_pipeline_cache_header(Renderer* pRenderer, PipelineCacheHeader* pHeader)
+{
+	const VkPhysicalDeviceProperties* pProperties = &pRenderer->pVkActiveGPUProperties->properties;
+	pHeader->mMagic = gPipelineCacheMagic;
+	pHeader->mVersion = gPipelineCacheVersion;
+	pHeader->mVendorId = pProperties->vendorID;
+	pHeader->mDeviceId = pProperties->deviceID;
+	pHeader->mDriverVersion = pProperties->driverVersion;
+	memcpy(pHeader->mCacheUUID, pProperties->pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+void addPipelineCache(Renderer* pRenderer, const PipelineCacheDesc* pDesc, PipelineCache** ppPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pDesc);
+	ASSERT(ppPipelineCache);
+
+	PipelineCache* pPipelineCache = (PipelineCache*)conf_calloc(1, sizeof(PipelineCache));
+	ASSERT(pPipelineCache);
+
+	DECLARE_ZERO(VkPipelineCacheCreateInfo, add_info);
+	add_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	add_info.pNext = NULL;
+	add_info.flags = 0;
+	add_info.initialDataSize = 0;
+	add_info.pInitialData = NULL;
+
+	if (pDesc->pData && pDesc->mSize)
+	{
+		DECLARE_ZERO(PipelineCacheHeader, expected);
+		util_fill_pipeline_cache_header(pRenderer, &expected);
+
+		const PipelineCacheHeader* pHeader = (const PipelineCacheHeader*)pDesc->pData;
+		if (pDesc->mSize < sizeof(PipelineCacheHeader) || pHeader->mDataSize > pDesc->mSize - sizeof(PipelineCacheHeader) ||
+			pHeader->mMagic != expected.mMagic || pHeader->mVersion != expected.mVersion)
+		{
+			LOGF(LogLevel::eWARNING, "Pipeline cache data is invalid and will be ignored");
+		}
+		else if (
+			pHeader->mVendorId != expected.mVendorId || pHeader->mDeviceId != expected.mDeviceId ||
+			pHeader->mDriverVersion != expected.mDriverVersion || memcmp(pHeader->mCacheUUID, expected.mCacheUUID, VK_UUID_SIZE) != 0)
+		{
+			LOGF(LogLevel::eINFO, "Pipeline cache was written by a different device or driver and will be rebuilt");
+		}
+		else
+		{
+			add_info.initialDataSize = (size_t)pHeader->mDataSize;
+			add_info.pInitialData = pHeader + 1;
+		}
+	}
+
+	VkResult vk_res = vkCreatePipelineCache(pRenderer->pVkDevice, &add_info, NULL, &pPipelineCache->pCache);
+	if (VK_SUCCESS != vk_res && add_info.initialDataSize)
+	{
+		LOGF(LogLevel::eWARNING, "Driver rejected the pipeline cache data. Creating an empty cache");
+		add_info.initialDataSize = 0;
+		add_info.pInitialData = NULL;
+		vk_res = vkCreatePipelineCache(pRenderer->pVkDevice, &add_info, NULL, &pPipelineCache->pCache);
+	}
+	ASSERT(VK_SUCCESS == vk_res);
+
+	*ppPipelineCache = pPipelineCache;
+}
+
+void removePipelineCache(Renderer* pRenderer, PipelineCache* pPipelineCache)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+
+	if (pPipelineCache->pCache)
+	{
+		vkDestroyPipelineCache(pRenderer->pVkDevice, pPipelineCache->pCache, NULL);
+	}
+
+	SAFE_FREE(pPipelineCache);
+}
+
+void getPipelineCacheData(Renderer* pRenderer, PipelineCache* pPipelineCache, size_t* pSize, void* pData)
+{
+	ASSERT(pRenderer);
+	ASSERT(pPipelineCache);
+	ASSERT(pSize);
+
+	size_t dataSize = 0;
+	VkResult vk_res = vkGetPipelineCacheData(pRenderer->pVkDevice, pPipelineCache->pCache, &dataSize, NULL);
+	ASSERT(VK_SUCCESS == vk_res);
+
+	if (!pData)
+	{
+		*pSize = sizeof(PipelineCacheHeader) + dataSize;
+		return;
+	}
+
+	ASSERT(*pSize >= sizeof(PipelineCacheHeader));
+	PipelineCacheHeader* pHeader = (PipelineCacheHeader*)pData;
+	memset(pHeader, 0, sizeof(PipelineCacheHeader));
+	util_fill_pipeline_cache_header(pRenderer, pHeader);
+
+	// The cache can only grow between the two calls, in which case the driver writes as much as fits and returns VK_INCOMPLETE
+	dataSize = *pSize - sizeof(PipelineCacheHeader);
+	vk_res = vkGetPipelineCacheData(pRenderer->pVkDevice, pPipelineCache->pCache, &dataSize, pHeader + 1);
+	ASSERT(VK_SUCCESS == vk_res || VK_INCOMPLETE == vk_res);
+
+	pHeader->mDataSize = dataSize;
+	*pSize = sizeof(PipelineCacheHeader) + dataSize;
+}
+/************************************************************************/
 // Command buffer functions
 /************************************************************************/
 void beginCmd(Cmd* pCmd)
@@ -6889,11 +7023,18 @@ void fillVirtualTexture(Cmd* pCmd, Texture* pTexture, Fence* pFence)
 		uint pageIndex = VisibilityData[i];
 		VirtualTexturePage* pPage = &(*pPageTable)[pageIndex];
 
+		// Pages that are not cached yet are read by the resource loader and filled on a later frame
+		if (pPage->imageMemoryBind.memory == VK_NULL_HANDLE && !requestVirtualTexturePage(pTexture->pSvt->pPageCache, pageIndex))
+			continue;
+
 		if (allocateVirtualPage(pRenderer, pTexture, *pPage, pTexture->pSvt->mSparseMemoryTypeIndex))
 		{
-			void* pData = (void*)((unsigned char*)pTexture->pSvt->mVirtualImageData + (pageIndex * pPage->size));
-
-			memcpy(pPage->pIntermediateBuffer->pCpuMappedAddress, pData, pPage->size);
+			// The page may have been evicted since it was requested
+			if (!readVirtualTexturePage(pTexture->pSvt->pPageCache, pageIndex, pPage->pIntermediateBuffer->pCpuMappedAddress, pPage->size, false))
+			{
+				releaseVirtualPage(pRenderer, *pPage, true);
+				continue;
+			}
 
 			//Copy image to VkImage	
 			VkBufferImageCopy region = {};
@@ -6968,10 +7109,8 @@ void fillVirtualTextureLevel(Cmd* pCmd, Texture* pTexture, uint32_t mipLevel)
 		{
 			if (allocateVirtualPage(pRenderer, pTexture, *pPage, pTexture->pSvt->mSparseMemoryTypeIndex))
 			{
-				void* pData = (void*)((unsigned char*)pTexture->pSvt->mVirtualImageData + (pageIndex * (uint32_t)pPage->size));
-
-				//CPU to GPU
-				memcpy(pPage->pIntermediateBuffer->pCpuMappedAddress, pData, pPage->size);
+				//CPU to GPU. Only filled when the texture is created by the resource loader, so the page is read right away
+				readVirtualTexturePage(pTexture->pSvt->pPageCache, pageIndex, pPage->pIntermediateBuffer->pCpuMappedAddress, pPage->size, true);
 
 				//Copy image to VkImage	
 				VkBufferImageCopy region = {};
@@ -7025,7 +7164,7 @@ void fillVirtualTextureLevel(Cmd* pCmd, Texture* pTexture, uint32_t mipLevel)
 	}
 }
 
-void addVirtualTexture(Renderer * pRenderer, const TextureDesc * pDesc, Texture** ppTexture, void* pImageData)
+void addVirtualTexture(Renderer * pRenderer, const TextureDesc * pDesc, Texture** ppTexture, void* pPageCache)
 {
 	ASSERT(pRenderer);
 	Texture* pTexture = (Texture*)conf_calloc(1, sizeof(*pTexture) + sizeof(VirtualTexture));
@@ -7041,8 +7180,7 @@ void addVirtualTexture(Renderer * pRenderer, const TextureDesc * pDesc, Texture*
 		mipSize /= 4;
 	}
 
-	pTexture->pSvt->mVirtualImageData = (char*)conf_malloc(imageSize * sizeof(uint32_t));
-	memcpy(pTexture->pSvt->mVirtualImageData, pImageData, imageSize * sizeof(uint32_t));
+	pTexture->pSvt->pPageCache = pPageCache;
 
 	// Create command buffer to transition resources to the correct state
 	Queue*   graphicsQueue = NULL;
@@ -7384,8 +7522,8 @@ void removeVirtualTexture(Renderer* pRenderer, VirtualTexture* pSvt)
 	if (pSvt->mPageCounts)
 		removeBuffer(pRenderer, pSvt->mPageCounts);
 
-	if (pSvt->mVirtualImageData)
-		conf_free(pSvt->mVirtualImageData);
+	if (pSvt->pPageCache)
+		removeVirtualTexturePageCache(pSvt->pPageCache);
 }
 
 void cmdUpdateVirtualTexture(Cmd* cmd, Texture* pTexture)
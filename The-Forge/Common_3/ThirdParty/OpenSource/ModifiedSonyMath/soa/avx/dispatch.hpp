@@ -0,0 +1,188 @@
+//========================================= #ConfettiMathExtensionsBegin ================================================
+//========================================= #ConfettiAnimationMathExtensionsBegin =======================================
+
+/*
+* Copyright (c) 2018-2020 The Forge Interactive Inc.
+*
+* This file is part of The-Forge
+* (see https://github.com/ConfettiFX/The-Forge).
+*
+* Licensed to the Apache Software Foundation (ASF) under one
+* or more contributor license agreements.  See the NOTICE file
+* distributed with this work for additional information
+* regarding copyright ownership.  The ASF licenses this file
+* to you under the Apache License, Version 2.0 (the
+* "License"); you may not use this file except in compliance
+* with the License.  You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, either express or implied.  See the License for the
+* specific language governing permissions and limitations
+* under the License.
+*/
+
+
+#ifndef VECTORMATH_SOA_AVX_DISPATCH_HPP
+#define VECTORMATH_SOA_AVX_DISPATCH_HPP
+
+#include <stddef.h>
+
+// Batch functions over arrays of 4-wide Soa types. When the running cpu
+// supports AVX two consecutive elements are processed at once with the Soa8
+// types, otherwise (or for the odd element left) the 4-wide path is used.
+// The choice is made once, at the first call.
+
+namespace Vectormath
+{
+namespace Soa
+{
+
+inline bool IsAvxSupported() {
+#if VECTORMATH_SOA_HAS_AVX
+  static const bool supported = []() {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    // The OS must also save the ymm registers on context switches.
+    return osxsave && avx && (_xgetbv(0) & 0x6) == 0x6;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx") != 0;
+#endif
+  }();
+  return supported;
+#else
+  return false;
+#endif
+}
+
+namespace Internal
+{
+
+//----------------------------------------------------------------------------
+// 4-wide kernels
+//----------------------------------------------------------------------------
+
+inline void SoaTransformToMatrices4(const SoaTransform* _transforms, size_t _count, SoaFloat4x4* _matrices) {
+  for (size_t i = 0; i < _count; ++i) {
+    _matrices[i] =
+        SoaFloat4x4::FromAffine(_transforms[i].translation, _transforms[i].rotation, _transforms[i].scale);
+  }
+}
+
+inline void SoaTransformBlend4(const SoaTransform* _a, const SoaTransform* _b, float _f, size_t _count,
+                               SoaTransform* _out) {
+  const Vector4 f(_f);
+  for (size_t i = 0; i < _count; ++i) {
+    _out[i].translation = Lerp(_a[i].translation, _b[i].translation, f);
+    _out[i].rotation = NLerpEst(_a[i].rotation, _b[i].rotation, f);
+    _out[i].scale = Lerp(_a[i].scale, _b[i].scale, f);
+  }
+}
+
+inline void SoaFloat4x4Multiply4(const SoaFloat4x4* _a, const SoaFloat4x4* _b, size_t _count, SoaFloat4x4* _out) {
+  for (size_t i = 0; i < _count; ++i) {
+    _out[i] = _a[i] * _b[i];
+  }
+}
+
+#if VECTORMATH_SOA_HAS_AVX
+
+//----------------------------------------------------------------------------
+// 8-wide kernels
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline void SoaTransformToMatrices8(const SoaTransform* _transforms, size_t _count,
+                                                          SoaFloat4x4* _matrices) {
+  size_t i = 0;
+  for (; i + 2 <= _count; i += 2) {
+    const Soa8Transform t = Soa8Transform::Load(_transforms[i], _transforms[i + 1]);
+    Soa8Float4x4::FromAffine(t.translation, t.rotation, t.scale).Store(&_matrices[i], &_matrices[i + 1]);
+  }
+  SoaTransformToMatrices4(_transforms + i, _count - i, _matrices + i);
+}
+
+VECTORMATH_AVX_TARGET inline void SoaTransformBlend8(const SoaTransform* _a, const SoaTransform* _b, float _f,
+                                                     size_t _count, SoaTransform* _out) {
+  const Float8 f = Float8::Splat(_f);
+  size_t i = 0;
+  for (; i + 2 <= _count; i += 2) {
+    const Soa8Transform a = Soa8Transform::Load(_a[i], _a[i + 1]);
+    const Soa8Transform b = Soa8Transform::Load(_b[i], _b[i + 1]);
+    const Soa8Transform r = {Lerp(a.translation, b.translation, f), NLerpEst(a.rotation, b.rotation, f),
+                             Lerp(a.scale, b.scale, f)};
+    r.Store(&_out[i], &_out[i + 1]);
+  }
+  SoaTransformBlend4(_a + i, _b + i, _f, _count - i, _out + i);
+}
+
+VECTORMATH_AVX_TARGET inline void SoaFloat4x4Multiply8(const SoaFloat4x4* _a, const SoaFloat4x4* _b, size_t _count,
+                                                       SoaFloat4x4* _out) {
+  size_t i = 0;
+  for (; i + 2 <= _count; i += 2) {
+    const Soa8Float4x4 a = Soa8Float4x4::Load(_a[i], _a[i + 1]);
+    const Soa8Float4x4 b = Soa8Float4x4::Load(_b[i], _b[i + 1]);
+    (a * b).Store(&_out[i], &_out[i + 1]);
+  }
+  SoaFloat4x4Multiply4(_a + i, _b + i, _count - i, _out + i);
+}
+
+#endif // VECTORMATH_SOA_HAS_AVX
+
+} // namespace Internal
+
+//----------------------------------------------------------------------------
+// Batch functions
+//----------------------------------------------------------------------------
+
+// Converts _count SoaTransform to their affine matrices, see SoaFloat4x4::FromAffine.
+// _matrices can't alias _transforms.
+inline void SoaTransformToMatrices(const SoaTransform* _transforms, size_t _count, SoaFloat4x4* _matrices) {
+#if VECTORMATH_SOA_HAS_AVX
+  typedef void (*Fn)(const SoaTransform*, size_t, SoaFloat4x4*);
+  static const Fn fn = IsAvxSupported() ? &Internal::SoaTransformToMatrices8 : &Internal::SoaTransformToMatrices4;
+  fn(_transforms, _count, _matrices);
+#else
+  Internal::SoaTransformToMatrices4(_transforms, _count, _matrices);
+#endif
+}
+
+// Blends _count pairs of SoaTransform with coefficient _f: translation and
+// scale are linearly interpolated, rotation uses NLerpEst.
+// _out may alias _a or _b.
+inline void SoaTransformBlend(const SoaTransform* _a, const SoaTransform* _b, float _f, size_t _count,
+                              SoaTransform* _out) {
+#if VECTORMATH_SOA_HAS_AVX
+  typedef void (*Fn)(const SoaTransform*, const SoaTransform*, float, size_t, SoaTransform*);
+  static const Fn fn = IsAvxSupported() ? &Internal::SoaTransformBlend8 : &Internal::SoaTransformBlend4;
+  fn(_a, _b, _f, _count, _out);
+#else
+  Internal::SoaTransformBlend4(_a, _b, _f, _count, _out);
+#endif
+}
+
+// Computes _out[i] = _a[i] * _b[i] for _count matrices.
+// _out can't alias _a or _b.
+inline void SoaFloat4x4Multiply(const SoaFloat4x4* _a, const SoaFloat4x4* _b, size_t _count, SoaFloat4x4* _out) {
+#if VECTORMATH_SOA_HAS_AVX
+  typedef void (*Fn)(const SoaFloat4x4*, const SoaFloat4x4*, size_t, SoaFloat4x4*);
+  static const Fn fn = IsAvxSupported() ? &Internal::SoaFloat4x4Multiply8 : &Internal::SoaFloat4x4Multiply4;
+  fn(_a, _b, _count, _out);
+#else
+  Internal::SoaFloat4x4Multiply4(_a, _b, _count, _out);
+#endif
+}
+
+} // namespace Soa
+} // namespace Vectormath
+
+#endif // VECTORMATH_SOA_AVX_DISPATCH_HPP
+
+//========================================= #ConfettiAnimationMathExtensionsEnd =======================================
+//========================================= #ConfettiMathExtensionsEnd ================================================
@@ -0,0 +1,243 @@
+//========================================= #ConfettiMathExtensionsBegin ================================================
+//========================================= #ConfettiAnimationMathExtensionsBegin =======================================
+
+/*
+* Copyright (c) 2018-2020 The Forge Interactive Inc.
+*
+* This file is part of The-Forge
+* (see https://github.com/ConfettiFX/The-Forge).
+*
+* Licensed to the Apache Software Foundation (ASF) under one
+* or more contributor license agreements.  See the NOTICE file
+* distributed with this work for additional information
+* regarding copyright ownership.  The ASF licenses this file
+* to you under the Apache License, Version 2.0 (the
+* "License"); you may not use this file except in compliance
+* with the License.  You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, either express or implied.  See the License for the
+* specific language governing permissions and limitations
+* under the License.
+*/
+
+
+#ifndef VECTORMATH_SOA_AVX_FLOAT_HPP
+#define VECTORMATH_SOA_AVX_FLOAT_HPP
+
+namespace Vectormath
+{
+namespace Soa
+{
+
+//----------------------------------------------------------------------------
+// Soa8Float3
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Float3 Soa8Float3::Load(const Float8& _x, const Float8& _y, const Float8& _z) {
+  const Soa8Float3 r = {_x, _y, _z};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float3 Soa8Float3::Load(const SoaFloat3& _lo, const SoaFloat3& _hi) {
+  const Soa8Float3 r = {Float8::Load(_lo.x, _hi.x), Float8::Load(_lo.y, _hi.y), Float8::Load(_lo.z, _hi.z)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float3 Soa8Float3::zero() {
+  const Float8 zero = Float8::zero();
+  const Soa8Float3 r = {zero, zero, zero};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float3 Soa8Float3::one() {
+  const Float8 one = Float8::one();
+  const Soa8Float3 r = {one, one, one};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline void Soa8Float3::Store(SoaFloat3* _lo, SoaFloat3* _hi) const {
+  x.Store(&_lo->x, &_hi->x);
+  y.Store(&_lo->y, &_hi->y);
+  z.Store(&_lo->z, &_hi->z);
+}
+
+//----------------------------------------------------------------------------
+// Soa8Float4
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Soa8Float4::Load(const Float8& _x, const Float8& _y, const Float8& _z,
+                                                         const Float8& _w) {
+  const Soa8Float4 r = {_x, _y, _z, _w};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Soa8Float4::Load(const Soa8Float3& _v, const Float8& _w) {
+  const Soa8Float4 r = {_v.x, _v.y, _v.z, _w};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Soa8Float4::Load(const SoaFloat4& _lo, const SoaFloat4& _hi) {
+  const Soa8Float4 r = {Float8::Load(_lo.x, _hi.x), Float8::Load(_lo.y, _hi.y), Float8::Load(_lo.z, _hi.z),
+                        Float8::Load(_lo.w, _hi.w)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Soa8Float4::zero() {
+  const Float8 zero = Float8::zero();
+  const Soa8Float4 r = {zero, zero, zero, zero};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Soa8Float4::one() {
+  const Float8 one = Float8::one();
+  const Soa8Float4 r = {one, one, one, one};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline void Soa8Float4::Store(SoaFloat4* _lo, SoaFloat4* _hi) const {
+  x.Store(&_lo->x, &_hi->x);
+  y.Store(&_lo->y, &_hi->y);
+  z.Store(&_lo->z, &_hi->z);
+  w.Store(&_lo->w, &_hi->w);
+}
+
+//----------------------------------------------------------------------------
+// Soa8Float 3, 4 Methods
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator+(const Soa8Float4& _a, const Soa8Float4& _b) {
+  const Soa8Float4 r = {_a.x + _b.x, _a.y + _b.y, _a.z + _b.z, _a.w + _b.w};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator+(const Soa8Float3& _a, const Soa8Float3& _b) {
+  const Soa8Float3 r = {_a.x + _b.x, _a.y + _b.y, _a.z + _b.z};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator-(const Soa8Float4& _a, const Soa8Float4& _b) {
+  const Soa8Float4 r = {_a.x - _b.x, _a.y - _b.y, _a.z - _b.z, _a.w - _b.w};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator-(const Soa8Float3& _a, const Soa8Float3& _b) {
+  const Soa8Float3 r = {_a.x - _b.x, _a.y - _b.y, _a.z - _b.z};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator-(const Soa8Float4& _v) {
+  const Soa8Float4 r = {-_v.x, -_v.y, -_v.z, -_v.w};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator-(const Soa8Float3& _v) {
+  const Soa8Float3 r = {-_v.x, -_v.y, -_v.z};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator*(const Soa8Float4& _a, const Soa8Float4& _b) {
+  const Soa8Float4 r = {_a.x * _b.x, _a.y * _b.y, _a.z * _b.z, _a.w * _b.w};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator*(const Soa8Float3& _a, const Soa8Float3& _b) {
+  const Soa8Float3 r = {_a.x * _b.x, _a.y * _b.y, _a.z * _b.z};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator*(const Soa8Float4& _a, const Float8& _f) {
+  const Soa8Float4 r = {_a.x * _f, _a.y * _f, _a.z * _f, _a.w * _f};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator*(const Soa8Float3& _a, const Float8& _f) {
+  const Soa8Float3 r = {_a.x * _f, _a.y * _f, _a.z * _f};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator/(const Soa8Float4& _a, const Float8& _f) {
+  const Soa8Float4 r = {_a.x / _f, _a.y / _f, _a.z / _f, _a.w / _f};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator/(const Soa8Float3& _a, const Float8& _f) {
+  const Soa8Float3 r = {_a.x / _f, _a.y / _f, _a.z / _f};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Dot(const Soa8Float4& _a, const Soa8Float4& _b) {
+  return _a.x * _b.x + _a.y * _b.y + _a.z * _b.z + _a.w * _b.w;
+}
+VECTORMATH_AVX_TARGET inline Float8 Dot(const Soa8Float3& _a, const Soa8Float3& _b) {
+  return _a.x * _b.x + _a.y * _b.y + _a.z * _b.z;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float3 CrossProduct(const Soa8Float3& _a, const Soa8Float3& _b) {
+  const Soa8Float3 r = {_a.y * _b.z - _b.y * _a.z, _a.z * _b.x - _b.z * _a.x, _a.x * _b.y - _b.x * _a.y};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Length(const Soa8Float4& _v) {
+  return Sqrt(Dot(_v, _v));
+}
+VECTORMATH_AVX_TARGET inline Float8 Length(const Soa8Float3& _v) {
+  return Sqrt(Dot(_v, _v));
+}
+
+VECTORMATH_AVX_TARGET inline Float8 LengthSqr(const Soa8Float4& _v) {
+  return Dot(_v, _v);
+}
+VECTORMATH_AVX_TARGET inline Float8 LengthSqr(const Soa8Float3& _v) {
+  return Dot(_v, _v);
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Normalize(const Soa8Float4& _v) {
+  const Float8 inv_len = Float8::one() / Sqrt(Dot(_v, _v));
+  return _v * inv_len;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 Normalize(const Soa8Float3& _v) {
+  const Float8 inv_len = Float8::one() / Sqrt(Dot(_v, _v));
+  return _v * inv_len;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 IsNormalized(const Soa8Float4& _v) {
+  return CmpLt(Abs(Dot(_v, _v) - Float8::one()), Float8::Splat(kNormalizationToleranceSq));
+}
+VECTORMATH_AVX_TARGET inline Float8 IsNormalized(const Soa8Float3& _v) {
+  return CmpLt(Abs(Dot(_v, _v) - Float8::one()), Float8::Splat(kNormalizationToleranceSq));
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Lerp(const Soa8Float4& _a, const Soa8Float4& _b, const Float8& _f) {
+  const Soa8Float4 r = {MAdd(_b.x - _a.x, _f, _a.x), MAdd(_b.y - _a.y, _f, _a.y), MAdd(_b.z - _a.z, _f, _a.z),
+                        MAdd(_b.w - _a.w, _f, _a.w)};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 Lerp(const Soa8Float3& _a, const Soa8Float3& _b, const Float8& _f) {
+  const Soa8Float3 r = {MAdd(_b.x - _a.x, _f, _a.x), MAdd(_b.y - _a.y, _f, _a.y), MAdd(_b.z - _a.z, _f, _a.z)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Min(const Soa8Float4& _a, const Soa8Float4& _b) {
+  const Soa8Float4 r = {Min(_a.x, _b.x), Min(_a.y, _b.y), Min(_a.z, _b.z), Min(_a.w, _b.w)};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 Min(const Soa8Float3& _a, const Soa8Float3& _b) {
+  const Soa8Float3 r = {Min(_a.x, _b.x), Min(_a.y, _b.y), Min(_a.z, _b.z)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 Max(const Soa8Float4& _a, const Soa8Float4& _b) {
+  const Soa8Float4 r = {Max(_a.x, _b.x), Max(_a.y, _b.y), Max(_a.z, _b.z), Max(_a.w, _b.w)};
+  return r;
+}
+VECTORMATH_AVX_TARGET inline Soa8Float3 Max(const Soa8Float3& _a, const Soa8Float3& _b) {
+  const Soa8Float3 r = {Max(_a.x, _b.x), Max(_a.y, _b.y), Max(_a.z, _b.z)};
+  return r;
+}
+
+} // namespace Soa
+} // namespace Vectormath
+
+#endif // VECTORMATH_SOA_AVX_FLOAT_HPP
+
+//========================================= #ConfettiAnimationMathExtensionsEnd =======================================
+//========================================= #ConfettiMathExtensionsEnd ================================================
@@ -0,0 +1,220 @@
+//========================================= #ConfettiMathExtensionsBegin ================================================
+//========================================= #ConfettiAnimationMathExtensionsBegin =======================================
+
+/*
+* Copyright (c) 2018-2020 The Forge Interactive Inc.
+*
+* This file is part of The-Forge
+* (see https://github.com/ConfettiFX/The-Forge).
+*
+* Licensed to the Apache Software Foundation (ASF) under one
+* or more contributor license agreements.  See the NOTICE file
+* distributed with this work for additional information
+* regarding copyright ownership.  The ASF licenses this file
+* to you under the Apache License, Version 2.0 (the
+* "License"); you may not use this file except in compliance
+* with the License.  You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, either express or implied.  See the License for the
+* specific language governing permissions and limitations
+* under the License.
+*/
+
+
+#ifndef VECTORMATH_SOA_AVX_FLOAT4X4_HPP
+#define VECTORMATH_SOA_AVX_FLOAT4X4_HPP
+
+namespace Vectormath
+{
+namespace Soa
+{
+
+//----------------------------------------------------------------------------
+// Soa8Float4x4
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Soa8Float4x4::Load(const SoaFloat4x4& _lo, const SoaFloat4x4& _hi) {
+  const Soa8Float4x4 ret = {{Soa8Float4::Load(_lo.cols[0], _hi.cols[0]), Soa8Float4::Load(_lo.cols[1], _hi.cols[1]),
+                             Soa8Float4::Load(_lo.cols[2], _hi.cols[2]), Soa8Float4::Load(_lo.cols[3], _hi.cols[3])}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Soa8Float4x4::identity() {
+  const Float8 zero = Float8::zero();
+  const Float8 one = Float8::one();
+  const Soa8Float4x4 ret = {{{one, zero, zero, zero},
+                             {zero, one, zero, zero},
+                             {zero, zero, one, zero},
+                             {zero, zero, zero, one}}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Soa8Float4x4::Scaling(const Soa8Float4& _v) {
+  const Float8 zero = Float8::zero();
+  const Float8 one = Float8::one();
+  const Soa8Float4x4 ret = {{{_v.x, zero, zero, zero},
+                             {zero, _v.y, zero, zero},
+                             {zero, zero, _v.z, zero},
+                             {zero, zero, zero, one}}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Soa8Float4x4::FromQuaternion(const Soa8Quaternion& _q) {
+  const Float8 zero = Float8::zero();
+  const Float8 one = Float8::one();
+  const Float8 two = one + one;
+
+  const Float8 xx = _q.x * _q.x;
+  const Float8 xy = _q.x * _q.y;
+  const Float8 xz = _q.x * _q.z;
+  const Float8 xw = _q.x * _q.w;
+  const Float8 yy = _q.y * _q.y;
+  const Float8 yz = _q.y * _q.z;
+  const Float8 yw = _q.y * _q.w;
+  const Float8 zz = _q.z * _q.z;
+  const Float8 zw = _q.z * _q.w;
+
+  const Soa8Float4x4 ret = {
+      {{one - two * (yy + zz), two * (xy + zw), two * (xz - yw), zero},
+       {two * (xy - zw), one - two * (xx + zz), two * (yz + xw), zero},
+       {two * (xz + yw), two * (yz - xw), one - two * (xx + yy), zero},
+       {zero, zero, zero, one}}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Soa8Float4x4::FromAffine(const Soa8Float3& _translation,
+                                                                   const Soa8Quaternion& _quaternion,
+                                                                   const Soa8Float3& _scale) {
+  const Float8 zero = Float8::zero();
+  const Float8 one = Float8::one();
+  const Float8 two = one + one;
+
+  const Float8 xx = _quaternion.x * _quaternion.x;
+  const Float8 xy = _quaternion.x * _quaternion.y;
+  const Float8 xz = _quaternion.x * _quaternion.z;
+  const Float8 xw = _quaternion.x * _quaternion.w;
+  const Float8 yy = _quaternion.y * _quaternion.y;
+  const Float8 yz = _quaternion.y * _quaternion.z;
+  const Float8 yw = _quaternion.y * _quaternion.w;
+  const Float8 zz = _quaternion.z * _quaternion.z;
+  const Float8 zw = _quaternion.z * _quaternion.w;
+
+  const Soa8Float4x4 ret = {
+      {{_scale.x * (one - two * (yy + zz)), (_scale.x * two) * (xy + zw), (_scale.x * two) * (xz - yw), zero},
+       {(_scale.y * two) * (xy - zw), _scale.y * (one - two * (xx + zz)), (_scale.y * two) * (yz + xw), zero},
+       {(_scale.z * two) * (xz + yw), (_scale.z * two) * (yz - xw), _scale.z * (one - two * (xx + yy)), zero},
+       {_translation.x, _translation.y, _translation.z, one}}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline void Soa8Float4x4::Store(SoaFloat4x4* _lo, SoaFloat4x4* _hi) const {
+  cols[0].Store(&_lo->cols[0], &_hi->cols[0]);
+  cols[1].Store(&_lo->cols[1], &_hi->cols[1]);
+  cols[2].Store(&_lo->cols[2], &_hi->cols[2]);
+  cols[3].Store(&_lo->cols[3], &_hi->cols[3]);
+}
+
+//----------------------------------------------------------------------------
+// Soa8Float4x4 Methods
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Transpose(const Soa8Float4x4& _m) {
+  const Soa8Float4x4 ret = {
+      {{_m.cols[0].x, _m.cols[1].x, _m.cols[2].x, _m.cols[3].x},
+       {_m.cols[0].y, _m.cols[1].y, _m.cols[2].y, _m.cols[3].y},
+       {_m.cols[0].z, _m.cols[1].z, _m.cols[2].z, _m.cols[3].z},
+       {_m.cols[0].w, _m.cols[1].w, _m.cols[2].w, _m.cols[3].w}}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Invert(const Soa8Float4x4& _m) {
+  const Soa8Float4* cols = _m.cols;
+  const Float8 a00 = cols[2].z * cols[3].w - cols[3].z * cols[2].w;
+  const Float8 a01 = cols[2].y * cols[3].w - cols[3].y * cols[2].w;
+  const Float8 a02 = cols[2].y * cols[3].z - cols[3].y * cols[2].z;
+  const Float8 a03 = cols[2].x * cols[3].w - cols[3].x * cols[2].w;
+  const Float8 a04 = cols[2].x * cols[3].z - cols[3].x * cols[2].z;
+  const Float8 a05 = cols[2].x * cols[3].y - cols[3].x * cols[2].y;
+  const Float8 a06 = cols[1].z * cols[3].w - cols[3].z * cols[1].w;
+  const Float8 a07 = cols[1].y * cols[3].w - cols[3].y * cols[1].w;
+  const Float8 a08 = cols[1].y * cols[3].z - cols[3].y * cols[1].z;
+  const Float8 a09 = cols[1].x * cols[3].w - cols[3].x * cols[1].w;
+  const Float8 a10 = cols[1].x * cols[3].z - cols[3].x * cols[1].z;
+  const Float8 a11 = cols[1].y * cols[3].w - cols[3].y * cols[1].w;
+  const Float8 a12 = cols[1].x * cols[3].y - cols[3].x * cols[1].y;
+  const Float8 a13 = cols[1].z * cols[2].w - cols[2].z * cols[1].w;
+  const Float8 a14 = cols[1].y * cols[2].w - cols[2].y * cols[1].w;
+  const Float8 a15 = cols[1].y * cols[2].z - cols[2].y * cols[1].z;
+  const Float8 a16 = cols[1].x * cols[2].w - cols[2].x * cols[1].w;
+  const Float8 a17 = cols[1].x * cols[2].z - cols[2].x * cols[1].z;
+  const Float8 a18 = cols[1].x * cols[2].y - cols[2].x * cols[1].y;
+
+  const Float8 b0x = cols[1].y * a00 - cols[1].z * a01 + cols[1].w * a02;
+  const Float8 b1x = -cols[1].x * a00 + cols[1].z * a03 - cols[1].w * a04;
+  const Float8 b2x = cols[1].x * a01 - cols[1].y * a03 + cols[1].w * a05;
+  const Float8 b3x = -cols[1].x * a02 + cols[1].y * a04 - cols[1].z * a05;
+
+  const Float8 b0y = -cols[0].y * a00 + cols[0].z * a01 - cols[0].w * a02;
+  const Float8 b1y = cols[0].x * a00 - cols[0].z * a03 + cols[0].w * a04;
+  const Float8 b2y = -cols[0].x * a01 + cols[0].y * a03 - cols[0].w * a05;
+  const Float8 b3y = cols[0].x * a02 - cols[0].y * a04 + cols[0].z * a05;
+
+  const Float8 b0z = cols[0].y * a06 - cols[0].z * a07 + cols[0].w * a08;
+  const Float8 b1z = -cols[0].x * a06 + cols[0].z * a09 - cols[0].w * a10;
+  const Float8 b2z = cols[0].x * a11 - cols[0].y * a09 + cols[0].w * a12;
+  const Float8 b3z = -cols[0].x * a08 + cols[0].y * a10 - cols[0].z * a12;
+
+  const Float8 b0w = -cols[0].y * a13 + cols[0].z * a14 - cols[0].w * a15;
+  const Float8 b1w = cols[0].x * a13 - cols[0].z * a16 + cols[0].w * a17;
+  const Float8 b2w = -cols[0].x * a14 + cols[0].y * a16 - cols[0].w * a18;
+  const Float8 b3w = cols[0].x * a15 - cols[0].y * a17 + cols[0].z * a18;
+
+  const Float8 det = cols[0].x * b0x + cols[0].y * b1x + cols[0].z * b2x + cols[0].w * b3x;
+  const Float8 inv_det = Float8::one() / det;
+
+  const Soa8Float4x4 ret = {
+      {{b0x * inv_det, b0y * inv_det, b0z * inv_det, b0w * inv_det},
+       {b1x * inv_det, b1y * inv_det, b1z * inv_det, b1w * inv_det},
+       {b2x * inv_det, b2y * inv_det, b2z * inv_det, b2w * inv_det},
+       {b3x * inv_det, b3y * inv_det, b3z * inv_det, b3w * inv_det}}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator*(const Soa8Float4x4& _m, const Soa8Float4& _v) {
+  const Soa8Float4 ret = {
+      _m.cols[0].x * _v.x + _m.cols[1].x * _v.y + _m.cols[2].x * _v.z + _m.cols[3].x * _v.w,
+      _m.cols[0].y * _v.x + _m.cols[1].y * _v.y + _m.cols[2].y * _v.z + _m.cols[3].y * _v.w,
+      _m.cols[0].z * _v.x + _m.cols[1].z * _v.y + _m.cols[2].z * _v.z + _m.cols[3].z * _v.w,
+      _m.cols[0].w * _v.x + _m.cols[1].w * _v.y + _m.cols[2].w * _v.z + _m.cols[3].w * _v.w};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 operator*(const Soa8Float4x4& _a, const Soa8Float4x4& _b) {
+  const Soa8Float4x4 ret = {{_a * _b.cols[0], _a * _b.cols[1], _a * _b.cols[2], _a * _b.cols[3]}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 operator+(const Soa8Float4x4& _a, const Soa8Float4x4& _b) {
+  const Soa8Float4x4 ret = {
+      {_a.cols[0] + _b.cols[0], _a.cols[1] + _b.cols[1], _a.cols[2] + _b.cols[2], _a.cols[3] + _b.cols[3]}};
+  return ret;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 operator-(const Soa8Float4x4& _a, const Soa8Float4x4& _b) {
+  const Soa8Float4x4 ret = {
+      {_a.cols[0] - _b.cols[0], _a.cols[1] - _b.cols[1], _a.cols[2] - _b.cols[2], _a.cols[3] - _b.cols[3]}};
+  return ret;
+}
+
+} // namespace Soa
+} // namespace Vectormath
+
+#endif // VECTORMATH_SOA_AVX_FLOAT4X4_HPP
+
+//========================================= #ConfettiAnimationMathExtensionsEnd =======================================
+//========================================= #ConfettiMathExtensionsEnd ================================================
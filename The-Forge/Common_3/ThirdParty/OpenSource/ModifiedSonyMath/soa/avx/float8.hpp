@@ -0,0 +1,237 @@
+//========================================= #ConfettiMathExtensionsBegin ================================================
+//========================================= #ConfettiAnimationMathExtensionsBegin =======================================
+
+/*
+* Copyright (c) 2018-2020 The Forge Interactive Inc.
+*
+* This file is part of The-Forge
+* (see https://github.com/ConfettiFX/The-Forge).
+*
+* Licensed to the Apache Software Foundation (ASF) under one
+* or more contributor license agreements.  See the NOTICE file
+* distributed with this work for additional information
+* regarding copyright ownership.  The ASF licenses this file
+* to you under the Apache License, Version 2.0 (the
+* "License"); you may not use this file except in compliance
+* with the License.  You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, either express or implied.  See the License for the
+* specific language governing permissions and limitations
+* under the License.
+*/
+
+
+#ifndef VECTORMATH_SOA_AVX_FLOAT8_HPP
+#define VECTORMATH_SOA_AVX_FLOAT8_HPP
+
+namespace Vectormath
+{
+namespace Soa
+{
+
+//----------------------------------------------------------------------------
+// Float8
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::Load(const Vector4& _lo, const Vector4& _hi) {
+  const Float8 r = {_mm256_insertf128_ps(_mm256_castps128_ps256(_lo.get128()), _hi.get128(), 1)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::LoadPtr(const float* _f) {
+  const Float8 r = {_mm256_load_ps(_f)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::LoadPtrU(const float* _f) {
+  const Float8 r = {_mm256_loadu_ps(_f)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::Splat(float _f) {
+  const Float8 r = {_mm256_set1_ps(_f)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::Splat(const Vector4& _v) {
+  return Load(_v, _v);
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::zero() {
+  const Float8 r = {_mm256_setzero_ps()};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Float8::one() {
+  const Float8 r = {_mm256_set1_ps(1.0f)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline void Float8::Store(Vector4* _lo, Vector4* _hi) const {
+  *_lo = Vector4(_mm256_castps256_ps128(v));
+  *_hi = Vector4(_mm256_extractf128_ps(v, 1));
+}
+
+VECTORMATH_AVX_TARGET inline void Float8::StorePtr(float* _f) const {
+  _mm256_store_ps(_f, v);
+}
+
+VECTORMATH_AVX_TARGET inline void Float8::StorePtrU(float* _f) const {
+  _mm256_storeu_ps(_f, v);
+}
+
+VECTORMATH_AVX_TARGET inline Vector4 Float8::lo() const {
+  return Vector4(_mm256_castps256_ps128(v));
+}
+
+VECTORMATH_AVX_TARGET inline Vector4 Float8::hi() const {
+  return Vector4(_mm256_extractf128_ps(v, 1));
+}
+
+//----------------------------------------------------------------------------
+// Float8 Methods
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Float8 operator+(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_add_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 operator-(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_sub_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 operator*(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_mul_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 operator/(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_div_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 operator-(const Float8& _v) {
+  const Float8 r = {_mm256_xor_ps(_v.v, _mm256_set1_ps(-0.0f))};
+  return r;
+}
+
+// Kept as a separate multiply and add (no FMA) so results match the 4-wide
+// SSE path bit for bit.
+VECTORMATH_AVX_TARGET inline Float8 MAdd(const Float8& _a, const Float8& _b, const Float8& _c) {
+  const Float8 r = {_mm256_add_ps(_mm256_mul_ps(_a.v, _b.v), _c.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Min(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_min_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Max(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_max_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Abs(const Float8& _v) {
+  const Float8 r = {_mm256_andnot_ps(_mm256_set1_ps(-0.0f), _v.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Clamp(const Float8& _a, const Float8& _v, const Float8& _b) {
+  const Float8 r = {_mm256_max_ps(_a.v, _mm256_min_ps(_v.v, _b.v))};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Sqrt(const Float8& _v) {
+  const Float8 r = {_mm256_sqrt_ps(_v.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 RcpEst(const Float8& _v) {
+  const Float8 r = {_mm256_rcp_ps(_v.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 RSqrtEst(const Float8& _v) {
+  const Float8 r = {_mm256_rsqrt_ps(_v.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 RSqrtEstNR(const Float8& _v) {
+  const __m256 half = _mm256_set1_ps(0.5f);
+  const __m256 three = _mm256_set1_ps(3.0f);
+  const __m256 est = _mm256_rsqrt_ps(_v.v);
+  // est * 0.5 * (3 - v * est * est)
+  const __m256 muls = _mm256_mul_ps(_mm256_mul_ps(_v.v, est), est);
+  const Float8 r = {_mm256_mul_ps(_mm256_mul_ps(half, est), _mm256_sub_ps(three, muls))};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 CmpLt(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_cmp_ps(_a.v, _b.v, _CMP_LT_OQ)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 CmpLe(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_cmp_ps(_a.v, _b.v, _CMP_LE_OQ)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 CmpGt(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_cmp_ps(_a.v, _b.v, _CMP_GT_OQ)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 CmpGe(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_cmp_ps(_a.v, _b.v, _CMP_GE_OQ)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 CmpEq(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_cmp_ps(_a.v, _b.v, _CMP_EQ_OQ)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 CmpNe(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_cmp_ps(_a.v, _b.v, _CMP_NEQ_UQ)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 And(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_and_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Or(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_or_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Xor(const Float8& _a, const Float8& _b) {
+  const Float8 r = {_mm256_xor_ps(_a.v, _b.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Float8 Select(const Float8& _mask, const Float8& _true, const Float8& _false) {
+  const Float8 r = {_mm256_blendv_ps(_false.v, _true.v, _mask.v)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline int MoveMask(const Float8& _mask) {
+  return _mm256_movemask_ps(_mask.v);
+}
+
+} // namespace Soa
+} // namespace Vectormath
+
+#endif // VECTORMATH_SOA_AVX_FLOAT8_HPP
+
+//========================================= #ConfettiAnimationMathExtensionsEnd =======================================
+//========================================= #ConfettiMathExtensionsEnd ================================================
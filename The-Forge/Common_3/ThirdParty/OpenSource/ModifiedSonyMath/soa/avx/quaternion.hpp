@@ -0,0 +1,138 @@
+//========================================= #ConfettiMathExtensionsBegin ================================================
+//========================================= #ConfettiAnimationMathExtensionsBegin =======================================
+
+/*
+* Copyright (c) 2018-2020 The Forge Interactive Inc.
+*
+* This file is part of The-Forge
+* (see https://github.com/ConfettiFX/The-Forge).
+*
+* Licensed to the Apache Software Foundation (ASF) under one
+* or more contributor license agreements.  See the NOTICE file
+* distributed with this work for additional information
+* regarding copyright ownership.  The ASF licenses this file
+* to you under the Apache License, Version 2.0 (the
+* "License"); you may not use this file except in compliance
+* with the License.  You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, either express or implied.  See the License for the
+* specific language governing permissions and limitations
+* under the License.
+*/
+
+
+#ifndef VECTORMATH_SOA_AVX_QUATERNION_HPP
+#define VECTORMATH_SOA_AVX_QUATERNION_HPP
+
+namespace Vectormath
+{
+namespace Soa
+{
+
+//----------------------------------------------------------------------------
+// Soa8Quaternion
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Soa8Quaternion::Load(const Float8& _x, const Float8& _y, const Float8& _z,
+                                                                 const Float8& _w) {
+  const Soa8Quaternion r = {_x, _y, _z, _w};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Soa8Quaternion::Load(const SoaQuaternion& _lo, const SoaQuaternion& _hi) {
+  const Soa8Quaternion r = {Float8::Load(_lo.x, _hi.x), Float8::Load(_lo.y, _hi.y), Float8::Load(_lo.z, _hi.z),
+                            Float8::Load(_lo.w, _hi.w)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Soa8Quaternion::identity() {
+  const Float8 zero = Float8::zero();
+  const Soa8Quaternion r = {zero, zero, zero, Float8::one()};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline void Soa8Quaternion::Store(SoaQuaternion* _lo, SoaQuaternion* _hi) const {
+  x.Store(&_lo->x, &_hi->x);
+  y.Store(&_lo->y, &_hi->y);
+  z.Store(&_lo->z, &_hi->z);
+  w.Store(&_lo->w, &_hi->w);
+}
+
+//----------------------------------------------------------------------------
+// Soa8Quaternion Methods
+//----------------------------------------------------------------------------
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Conjugate(const Soa8Quaternion& _q) {
+  const Soa8Quaternion r = {-_q.x, -_q.y, -_q.z, _q.w};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator-(const Soa8Quaternion& _q) {
+  const Soa8Quaternion r = {-_q.x, -_q.y, -_q.z, -_q.w};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Normalize(const Soa8Quaternion& _q) {
+  const Float8 len2 = _q.x * _q.x + _q.y * _q.y + _q.z * _q.z + _q.w * _q.w;
+  const Float8 inv_len = Float8::one() / Sqrt(len2);
+  return _q * inv_len;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion NormalizeEst(const Soa8Quaternion& _q) {
+  const Float8 len2 = _q.x * _q.x + _q.y * _q.y + _q.z * _q.z + _q.w * _q.w;
+  // Uses RSqrtEstNR (with one more Newton-Raphson step) as quaternions loose
+  // much precision due to normalization.
+  return _q * RSqrtEstNR(len2);
+}
+
+VECTORMATH_AVX_TARGET inline Float8 IsNormalized(const Soa8Quaternion& _q) {
+  const Float8 len2 = _q.x * _q.x + _q.y * _q.y + _q.z * _q.z + _q.w * _q.w;
+  return CmpLt(Abs(len2 - Float8::one()), Float8::Splat(kNormalizationToleranceSq));
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Lerp(const Soa8Quaternion& _a, const Soa8Quaternion& _b, const Float8& _f) {
+  const Soa8Quaternion r = {MAdd(_b.x - _a.x, _f, _a.x), MAdd(_b.y - _a.y, _f, _a.y), MAdd(_b.z - _a.z, _f, _a.z),
+                            MAdd(_b.w - _a.w, _f, _a.w)};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion NLerp(const Soa8Quaternion& _a, const Soa8Quaternion& _b, const Float8& _f) {
+  return Normalize(Lerp(_a, _b, _f));
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion NLerpEst(const Soa8Quaternion& _a, const Soa8Quaternion& _b,
+                                                     const Float8& _f) {
+  return NormalizeEst(Lerp(_a, _b, _f));
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator+(const Soa8Quaternion& _a, const Soa8Quaternion& _b) {
+  const Soa8Quaternion r = {_a.x + _b.x, _a.y + _b.y, _a.z + _b.z, _a.w + _b.w};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator*(const Soa8Quaternion& _q, const Float8& _f) {
+  const Soa8Quaternion r = {_q.x * _f, _q.y * _f, _q.z * _f, _q.w * _f};
+  return r;
+}
+
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator*(const Soa8Quaternion& _a, const Soa8Quaternion& _b) {
+  const Soa8Quaternion r = {
+      _a.w * _b.x + _a.x * _b.w + _a.y * _b.z - _a.z * _b.y,
+      _a.w * _b.y + _a.y * _b.w + _a.z * _b.x - _a.x * _b.z,
+      _a.w * _b.z + _a.z * _b.w + _a.x * _b.y - _a.y * _b.x,
+      _a.w * _b.w - _a.x * _b.x - _a.y * _b.y - _a.z * _b.z};
+  return r;
+}
+
+} // namespace Soa
+} // namespace Vectormath
+
+#endif // VECTORMATH_SOA_AVX_QUATERNION_HPP
+
+//========================================= #ConfettiAnimationMathExtensionsEnd =======================================
+//========================================= #ConfettiMathExtensionsEnd ================================================
@@ -0,0 +1,364 @@
+//========================================= #ConfettiMathExtensionsBegin ================================================
+//========================================= #ConfettiAnimationMathExtensionsBegin =======================================
+
+/*
+* Copyright (c) 2018-2020 The Forge Interactive Inc.
+*
+* This file is part of The-Forge
+* (see https://github.com/ConfettiFX/The-Forge).
+*
+* Licensed to the Apache Software Foundation (ASF) under one
+* or more contributor license agreements.  See the NOTICE file
+* distributed with this work for additional information
+* regarding copyright ownership.  The ASF licenses this file
+* to you under the Apache License, Version 2.0 (the
+* "License"); you may not use this file except in compliance
+* with the License.  You may obtain a copy of the License at
+*
+*   http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing,
+* software distributed under the License is distributed on an
+* "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+* KIND, either express or implied.  See the License for the
+* specific language governing permissions and limitations
+* under the License.
+*/
+
+
+#ifndef VECTORMATH_SOA_AVX_HPP
+#define VECTORMATH_SOA_AVX_HPP
+
+// 8-wide SoA types built on 256 bit AVX registers. Each Soa8 type holds two
+// 4-wide Soa types worth of lanes, so a pair of SoaTransform (8 joints) is
+// processed per instruction instead of one.
+//
+// The types are only available on x86/x64 with the SSE backend. Translation
+// units do not need to be built with -mavx / /arch:AVX: every function is
+// tagged with VECTORMATH_AVX_TARGET so the code is compiled for AVX and must
+// only be reached after IsAvxSupported() returned true. The batch functions in
+// dispatch.hpp do this check once and fall back to the 4-wide Soa path.
+
+#if VECTORMATH_MODE_SSE && !VECTORMATH_MODE_SCE && \
+    (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define VECTORMATH_SOA_HAS_AVX 1
+#else
+#define VECTORMATH_SOA_HAS_AVX 0
+#endif
+
+#if VECTORMATH_SOA_HAS_AVX
+
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__AVX__) || defined(_MSC_VER)
+// Already compiling for AVX, or the compiler allows AVX intrinsics in any function.
+#define VECTORMATH_AVX_TARGET
+#else
+#define VECTORMATH_AVX_TARGET __attribute__((target("avx")))
+#endif
+
+#endif // VECTORMATH_SOA_HAS_AVX
+
+namespace Vectormath
+{
+namespace Soa
+{
+
+// Returns true if both the cpu and the OS (saved ymm state) support AVX.
+// The result is computed once and cached.
+inline bool IsAvxSupported();
+
+#if VECTORMATH_SOA_HAS_AVX
+
+// ========================================================
+// Forward Declarations
+// ========================================================
+
+class Float8;
+class Soa8Float3;
+class Soa8Float4;
+class Soa8Float4x4;
+class Soa8Quaternion;
+class Soa8Transform;
+
+//----------------------------------------------------------------------------
+// Float8
+//----------------------------------------------------------------------------
+
+// 8 floats, one per lane. Plays the role Vector4 plays for the 4-wide Soa
+// types. Comparisons return lane masks (all bits set or cleared) stored in a
+// Float8 that can be used with Select, And, Or and MoveMask.
+class Float8 {
+
+public:
+
+  __m256 v;
+
+  // Loads lanes 0-3 from _lo and lanes 4-7 from _hi.
+  VECTORMATH_AVX_TARGET static inline Float8 Load(const Vector4& _lo, const Vector4& _hi);
+
+  // Loads 8 floats from a 32 bytes aligned address.
+  VECTORMATH_AVX_TARGET static inline Float8 LoadPtr(const float* _f);
+
+  // Loads 8 floats from any address.
+  VECTORMATH_AVX_TARGET static inline Float8 LoadPtrU(const float* _f);
+
+  // Replicates _f in all lanes.
+  VECTORMATH_AVX_TARGET static inline Float8 Splat(float _f);
+
+  // Replicates each lane of _v in the matching lane of both halves.
+  VECTORMATH_AVX_TARGET static inline Float8 Splat(const Vector4& _v);
+
+  VECTORMATH_AVX_TARGET static inline Float8 zero();
+
+  VECTORMATH_AVX_TARGET static inline Float8 one();
+
+  // Stores lanes 0-3 in _lo and lanes 4-7 in _hi.
+  VECTORMATH_AVX_TARGET inline void Store(Vector4* _lo, Vector4* _hi) const;
+
+  // Stores 8 floats to a 32 bytes aligned address.
+  VECTORMATH_AVX_TARGET inline void StorePtr(float* _f) const;
+
+  // Stores 8 floats to any address.
+  VECTORMATH_AVX_TARGET inline void StorePtrU(float* _f) const;
+
+  // Returns lanes 0-3.
+  VECTORMATH_AVX_TARGET inline Vector4 lo() const;
+
+  // Returns lanes 4-7.
+  VECTORMATH_AVX_TARGET inline Vector4 hi() const;
+};
+
+// Per lane arithmetic.
+VECTORMATH_AVX_TARGET inline Float8 operator+(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 operator-(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 operator*(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 operator/(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 operator-(const Float8& _v);
+
+// Returns _a * _b + _c.
+VECTORMATH_AVX_TARGET inline Float8 MAdd(const Float8& _a, const Float8& _b, const Float8& _c);
+
+// Per lane min, max, absolute value and clamp.
+VECTORMATH_AVX_TARGET inline Float8 Min(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 Max(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 Abs(const Float8& _v);
+VECTORMATH_AVX_TARGET inline Float8 Clamp(const Float8& _a, const Float8& _v, const Float8& _b);
+
+// Per lane square root, reciprocal estimate and reciprocal square root.
+VECTORMATH_AVX_TARGET inline Float8 Sqrt(const Float8& _v);
+VECTORMATH_AVX_TARGET inline Float8 RcpEst(const Float8& _v);
+VECTORMATH_AVX_TARGET inline Float8 RSqrtEst(const Float8& _v);
+// Reciprocal square root estimate refined with one Newton-Raphson step.
+VECTORMATH_AVX_TARGET inline Float8 RSqrtEstNR(const Float8& _v);
+
+// Per lane comparisons, returning lane masks.
+VECTORMATH_AVX_TARGET inline Float8 CmpLt(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 CmpLe(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 CmpGt(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 CmpGe(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 CmpEq(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 CmpNe(const Float8& _a, const Float8& _b);
+
+// Lane mask operations.
+VECTORMATH_AVX_TARGET inline Float8 And(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 Or(const Float8& _a, const Float8& _b);
+VECTORMATH_AVX_TARGET inline Float8 Xor(const Float8& _a, const Float8& _b);
+
+// Returns _true lanes where _mask is set, _false lanes otherwise.
+VECTORMATH_AVX_TARGET inline Float8 Select(const Float8& _mask, const Float8& _true, const Float8& _false);
+
+// Returns the sign bit of each lane packed in the 8 low bits.
+VECTORMATH_AVX_TARGET inline int MoveMask(const Float8& _mask);
+
+//----------------------------------------------------------------------------
+// Soa8Float3 / Soa8Float4
+//----------------------------------------------------------------------------
+
+class Soa8Float3 {
+
+public:
+
+  Float8 x, y, z;
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float3 Load(const Float8& _x, const Float8& _y, const Float8& _z);
+
+  // Packs two 4-wide SoaFloat3 into one 8-wide.
+  VECTORMATH_AVX_TARGET static inline Soa8Float3 Load(const SoaFloat3& _lo, const SoaFloat3& _hi);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float3 zero();
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float3 one();
+
+  // Unpacks to two 4-wide SoaFloat3.
+  VECTORMATH_AVX_TARGET inline void Store(SoaFloat3* _lo, SoaFloat3* _hi) const;
+};
+
+class Soa8Float4 {
+
+public:
+
+  Float8 x, y, z, w;
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4 Load(const Float8& _x, const Float8& _y, const Float8& _z,
+                                                      const Float8& _w);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4 Load(const Soa8Float3& _v, const Float8& _w);
+
+  // Packs two 4-wide SoaFloat4 into one 8-wide.
+  VECTORMATH_AVX_TARGET static inline Soa8Float4 Load(const SoaFloat4& _lo, const SoaFloat4& _hi);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4 zero();
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4 one();
+
+  // Unpacks to two 4-wide SoaFloat4.
+  VECTORMATH_AVX_TARGET inline void Store(SoaFloat4* _lo, SoaFloat4* _hi) const;
+};
+
+// Same semantic as the SoaFloat3 / SoaFloat4 functions in soa.hpp.
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator+(const Soa8Float4& _a, const Soa8Float4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator+(const Soa8Float3& _a, const Soa8Float3& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator-(const Soa8Float4& _a, const Soa8Float4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator-(const Soa8Float3& _a, const Soa8Float3& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator-(const Soa8Float4& _v);
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator-(const Soa8Float3& _v);
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator*(const Soa8Float4& _a, const Soa8Float4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator*(const Soa8Float3& _a, const Soa8Float3& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator*(const Soa8Float4& _a, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator*(const Soa8Float3& _a, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator/(const Soa8Float4& _a, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Float3 operator/(const Soa8Float3& _a, const Float8& _f);
+
+VECTORMATH_AVX_TARGET inline Float8 Dot(const Soa8Float4& _a, const Soa8Float4& _b);
+VECTORMATH_AVX_TARGET inline Float8 Dot(const Soa8Float3& _a, const Soa8Float3& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float3 CrossProduct(const Soa8Float3& _a, const Soa8Float3& _b);
+VECTORMATH_AVX_TARGET inline Float8 Length(const Soa8Float4& _v);
+VECTORMATH_AVX_TARGET inline Float8 Length(const Soa8Float3& _v);
+VECTORMATH_AVX_TARGET inline Float8 LengthSqr(const Soa8Float4& _v);
+VECTORMATH_AVX_TARGET inline Float8 LengthSqr(const Soa8Float3& _v);
+VECTORMATH_AVX_TARGET inline Soa8Float4 Normalize(const Soa8Float4& _v);
+VECTORMATH_AVX_TARGET inline Soa8Float3 Normalize(const Soa8Float3& _v);
+VECTORMATH_AVX_TARGET inline Float8 IsNormalized(const Soa8Float4& _v);
+VECTORMATH_AVX_TARGET inline Float8 IsNormalized(const Soa8Float3& _v);
+VECTORMATH_AVX_TARGET inline Soa8Float4 Lerp(const Soa8Float4& _a, const Soa8Float4& _b, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Float3 Lerp(const Soa8Float3& _a, const Soa8Float3& _b, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Float4 Min(const Soa8Float4& _a, const Soa8Float4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float3 Min(const Soa8Float3& _a, const Soa8Float3& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float4 Max(const Soa8Float4& _a, const Soa8Float4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float3 Max(const Soa8Float3& _a, const Soa8Float3& _b);
+
+//----------------------------------------------------------------------------
+// Soa8Quaternion
+//----------------------------------------------------------------------------
+
+class Soa8Quaternion {
+
+public:
+
+  Float8 x, y, z, w;
+
+  VECTORMATH_AVX_TARGET static inline Soa8Quaternion Load(const Float8& _x, const Float8& _y, const Float8& _z,
+                                                          const Float8& _w);
+
+  // Packs two 4-wide SoaQuaternion into one 8-wide.
+  VECTORMATH_AVX_TARGET static inline Soa8Quaternion Load(const SoaQuaternion& _lo, const SoaQuaternion& _hi);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Quaternion identity();
+
+  // Unpacks to two 4-wide SoaQuaternion.
+  VECTORMATH_AVX_TARGET inline void Store(SoaQuaternion* _lo, SoaQuaternion* _hi) const;
+};
+
+// Same semantic as the SoaQuaternion functions in soa.hpp.
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Conjugate(const Soa8Quaternion& _q);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator-(const Soa8Quaternion& _q);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Normalize(const Soa8Quaternion& _q);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion NormalizeEst(const Soa8Quaternion& _q);
+VECTORMATH_AVX_TARGET inline Float8 IsNormalized(const Soa8Quaternion& _q);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion Lerp(const Soa8Quaternion& _a, const Soa8Quaternion& _b, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion NLerp(const Soa8Quaternion& _a, const Soa8Quaternion& _b, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion NLerpEst(const Soa8Quaternion& _a, const Soa8Quaternion& _b,
+                                                     const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator+(const Soa8Quaternion& _a, const Soa8Quaternion& _b);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator*(const Soa8Quaternion& _q, const Float8& _f);
+VECTORMATH_AVX_TARGET inline Soa8Quaternion operator*(const Soa8Quaternion& _a, const Soa8Quaternion& _b);
+
+//----------------------------------------------------------------------------
+// Soa8Float4x4
+//----------------------------------------------------------------------------
+
+// Column major, see SoaFloat4x4.
+class Soa8Float4x4 {
+
+public:
+
+  Soa8Float4 cols[4];
+
+  // Packs two 4-wide SoaFloat4x4 into one 8-wide.
+  VECTORMATH_AVX_TARGET static inline Soa8Float4x4 Load(const SoaFloat4x4& _lo, const SoaFloat4x4& _hi);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4x4 identity();
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4x4 Scaling(const Soa8Float4& _v);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4x4 FromQuaternion(const Soa8Quaternion& _q);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Float4x4 FromAffine(const Soa8Float3& _translation,
+                                                              const Soa8Quaternion& _quaternion,
+                                                              const Soa8Float3& _scale);
+
+  // Unpacks to two 4-wide SoaFloat4x4.
+  VECTORMATH_AVX_TARGET inline void Store(SoaFloat4x4* _lo, SoaFloat4x4* _hi) const;
+};
+
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Transpose(const Soa8Float4x4& _m);
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 Invert(const Soa8Float4x4& _m);
+VECTORMATH_AVX_TARGET inline Soa8Float4 operator*(const Soa8Float4x4& _m, const Soa8Float4& _v);
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 operator*(const Soa8Float4x4& _a, const Soa8Float4x4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 operator+(const Soa8Float4x4& _a, const Soa8Float4x4& _b);
+VECTORMATH_AVX_TARGET inline Soa8Float4x4 operator-(const Soa8Float4x4& _a, const Soa8Float4x4& _b);
+
+//----------------------------------------------------------------------------
+// Soa8Transform
+//----------------------------------------------------------------------------
+
+class Soa8Transform {
+
+public:
+
+  Soa8Float3 translation;
+  Soa8Quaternion rotation;
+  Soa8Float3 scale;
+
+  // Packs two 4-wide SoaTransform into one 8-wide.
+  VECTORMATH_AVX_TARGET static inline Soa8Transform Load(const SoaTransform& _lo, const SoaTransform& _hi);
+
+  VECTORMATH_AVX_TARGET static inline Soa8Transform identity();
+
+  // Unpacks to two 4-wide SoaTransform.
+  VECTORMATH_AVX_TARGET inline void Store(SoaTransform* _lo, SoaTransform* _hi) const;
+};
+
+#endif // VECTORMATH_SOA_HAS_AVX
+
+} // namespace Soa
+} // namespace Vectormath
+
+// Inline implementations:
+#if VECTORMATH_SOA_HAS_AVX
+#include "float8.hpp"
+#include "float.hpp"
+#include "float4x4.hpp"
+#include "quaternion.hpp"
+#include "transform.hpp"
+#endif
+#include "dispatch.hpp"
+
+#endif // VECTORMATH_SOA_AVX_HPP
+
+//========================================= #ConfettiAnimationMathExtensionsEnd =======================================
+//========================================= #ConfettiMathExtensionsEnd ================================================
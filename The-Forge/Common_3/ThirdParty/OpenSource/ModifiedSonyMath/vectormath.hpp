@@ -68,6 +68,7 @@
 //========================================= #ConfettiMathExtensionsBegin ================================================
 //========================================= #ConfettiAnimationMathExtensionsBegin =======================================
 #include "soa/soa.hpp"
+#include "soa/avx/soa_avx.hpp"
 using namespace Vectormath::Soa;
 //========================================= #ConfettiAnimationMathExtensionsEnd =======================================
 //========================================= #ConfettiMathExtensionsEnd ================================================
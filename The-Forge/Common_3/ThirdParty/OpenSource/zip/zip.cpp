@@ -818,6 +818,63 @@ int zip_total_entries(struct zip_t *zip) {
   return (int)zip->archive.m_total_files;
 }
 
+// CONFFX_BEGIN - Random access reads
+int zip_entry_data_location(struct zip_t *zip, int index,
+                            unsigned long long *offset,
+                            unsigned long long *compsize, int *method) {
+  mz_zip_archive *pzip = NULL;
+  mz_zip_archive_file_stat stats;
+  mz_uint32 local_header_u32[(MZ_ZIP_LOCAL_DIR_HEADER_SIZE + sizeof(mz_uint32) -
+                              1) /
+                             sizeof(mz_uint32)];
+  mz_uint8 *pLocal_header = (mz_uint8 *)local_header_u32;
+  mz_uint64 data_ofs;
+
+  if (!zip) {
+    // zip_t handler is not initialized
+    return -1;
+  }
+
+  pzip = &(zip->archive);
+  if (pzip->m_zip_mode != MZ_ZIP_MODE_READING) {
+    // the archive is not open for reading
+    return -1;
+  }
+
+  if (!mz_zip_reader_file_stat(pzip, (mz_uint)index, &stats)) {
+    return -1;
+  }
+
+  // Encryption and patch files are not supported.
+  if (stats.m_bit_flag & (1 | 32)) {
+    return -1;
+  }
+
+  // The central directory does not store the local extra field length, so the
+  // local header has to be parsed to find where the data starts.
+  if (pzip->m_pRead(pzip->m_pIO_opaque, stats.m_local_header_ofs,
+                    pLocal_header, MZ_ZIP_LOCAL_DIR_HEADER_SIZE) !=
+      MZ_ZIP_LOCAL_DIR_HEADER_SIZE) {
+    return -1;
+  }
+  if (MZ_READ_LE32(pLocal_header) != MZ_ZIP_LOCAL_DIR_HEADER_SIG) {
+    return -1;
+  }
+
+  data_ofs = stats.m_local_header_ofs + MZ_ZIP_LOCAL_DIR_HEADER_SIZE +
+             MZ_READ_LE16(pLocal_header + MZ_ZIP_LDH_FILENAME_LEN_OFS) +
+             MZ_READ_LE16(pLocal_header + MZ_ZIP_LDH_EXTRA_LEN_OFS);
+  if (data_ofs + stats.m_comp_size > pzip->m_archive_size) {
+    return -1;
+  }
+
+  *offset = data_ofs;
+  *compsize = stats.m_comp_size;
+  *method = stats.m_method;
+  return 0;
+}
+// CONFFX_END
+
 int zip_create(const char *zipname, const char *filenames[], size_t len) {
   int status = 0;
   size_t i;
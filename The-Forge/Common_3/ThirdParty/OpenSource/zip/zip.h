@@ -287,6 +287,25 @@ zip_entry_extract(struct zip_t *zip,
  */
 extern int zip_total_entries(struct zip_t *zip);
 
+// CONFFX_BEGIN - Random access reads
+/**
+ * Locates the raw data of an entry inside the archive file, so that it can be
+ * read (and inflated) without going through the zip handle.
+ *
+ * @param zip zip archive handler opened in read mode.
+ * @param index index of the entry.
+ * @param offset offset of the entry data from the start of the archive file.
+ * @param compsize size of the (possibly compressed) entry data.
+ * @param method compression method, 0 for stored or 8 for deflated.
+ *
+ * @return the return code - 0 on success, negative number (< 0) on error or
+ *         if the entry is encrypted.
+ */
+extern int zip_entry_data_location(struct zip_t *zip, int index,
+                                   unsigned long long *offset,
+                                   unsigned long long *compsize, int *method);
+// CONFFX_END
+
 /**
  * Creates a new archive and puts files into a single zip archive.
  *
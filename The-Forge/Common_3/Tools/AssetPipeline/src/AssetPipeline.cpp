@@ -28,6 +28,7 @@
 #include "../../../ThirdParty/OpenSource/EASTL/string.h"
 #include "../../../ThirdParty/OpenSource/EASTL/vector.h"
 #include "../../../ThirdParty/OpenSource/EASTL/unordered_map.h"
+#include "../../../ThirdParty/OpenSource/EASTL/sort.h"
 
 // OZZ
 #include "../../../ThirdParty/OpenSource/ozz-animation/include/ozz/base/io/stream.h"
@@ -48,6 +49,11 @@
 #include "../../../OS/Image/Image.h"
 #include "../../../OS/Interfaces/IOperatingSystem.h"
 #include "../../../OS/Interfaces/IFileSystem.h"
+#include "../../../OS/FileSystem/PackFileFormat.h"
+#include "../../../OS/Core/Atomics.h"
+#include "../../../OS/Core/ThreadSystem.h"
+#include "../../../OS/Interfaces/IThread.h"
+#include "../../../OS/Interfaces/ITime.h"
 #include "../../../OS/Interfaces/ILog.h"
 #include "../../../OS/Interfaces/IMemory.h"    //NOTE: this should be the last include in a .cpp
 
@@ -69,6 +75,340 @@ struct BoneInfo
 	ozz::animation::offline::RawSkeleton::Joint* pParentJoint;
 };
 
+// -- ASSET JOBS --
+
+typedef enum AssetTaskResult
+{
+	ASSET_TASK_FAILED,
+	ASSET_TASK_PROCESSED,
+	ASSET_TASK_SKIPPED,
+} AssetTaskResult;
+
+typedef AssetTaskResult (*AssetTaskFunc)(void* pUserData, uint32_t index);
+
+struct AssetJob
+{
+	AssetTaskFunc          pFunc;
+	void*                  pUserData;
+	const eastl::string*   pNames;
+	int64_t*               pDurations;
+	ProcessAssetsSettings* pSettings;
+	tfrg_atomic32_t        mFailedCount;
+	tfrg_atomic32_t        mSkippedCount;
+	tfrg_atomic32_t        mRemainingCount;
+};
+
+static void runAssetTask(void* pUserData, uintptr_t index)
+{
+	AssetJob*             pJob = (AssetJob*)pUserData;
+	const int64_t         start = getUSec();
+	const AssetTaskResult result = pJob->pFunc(pJob->pUserData, (uint32_t)index);
+	pJob->pDurations[index] = getUSec() - start;
+
+	if (result == ASSET_TASK_FAILED)
+		tfrg_atomic32_add_relaxed(&pJob->mFailedCount, 1);
+	else if (result == ASSET_TASK_SKIPPED)
+		tfrg_atomic32_add_relaxed(&pJob->mSkippedCount, 1);
+	else if (!pJob->pSettings->quiet)
+		LOGF(LogLevel::eINFO, "%s processed in %.2f ms.", pJob->pNames[index].c_str(), (double)pJob->pDurations[index] / 1000.0);
+
+	tfrg_atomic32_add_relaxed(&pJob->mRemainingCount, -1);
+}
+
+// Runs func once per asset on settings->pThreadSystem (or inline without one), then reports the totals and the slowest assets.
+// Returns false if any asset failed.
+static bool runAssetTasks(ProcessAssetsSettings* settings, const eastl::vector<eastl::string>& names, AssetTaskFunc func, void* pUserData)
+{
+	const uint32_t count = (uint32_t)names.size();
+	if (!count)
+		return true;
+
+	eastl::vector<int64_t> durations(count, 0);
+
+	AssetJob job = {};
+	job.pFunc = func;
+	job.pUserData = pUserData;
+	job.pNames = names.data();
+	job.pDurations = durations.data();
+	job.pSettings = settings;
+	job.mFailedCount = 0;
+	job.mSkippedCount = 0;
+	job.mRemainingCount = count;
+
+	const int64_t start = getUSec();
+	if (settings->pThreadSystem)
+	{
+		addThreadSystemRangeTask(settings->pThreadSystem, runAssetTask, &job, count);
+		while (tfrg_atomic32_load_acquire(&job.mRemainingCount))
+		{
+			if (!assistThreadSystem(settings->pThreadSystem))
+				Thread::Sleep(0);
+		}
+	}
+	else
+	{
+		for (uint32_t i = 0; i < count; ++i)
+			runAssetTask(&job, i);
+	}
+	const int64_t duration = getUSec() - start;
+
+	const uint32_t failedCount = tfrg_atomic32_load_relaxed(&job.mFailedCount);
+	const uint32_t skippedCount = tfrg_atomic32_load_relaxed(&job.mSkippedCount);
+	if (!settings->quiet)
+	{
+		LOGF(LogLevel::eINFO, "%u assets: %u processed, %u up-to-date, %u failed in %.2f ms.", count, count - skippedCount - failedCount,
+			 skippedCount, failedCount, (double)duration / 1000.0);
+
+		if (skippedCount < count)
+		{
+			eastl::vector<uint32_t> order(count);
+			for (uint32_t i = 0; i < count; ++i)
+				order[i] = i;
+			eastl::sort(order.begin(), order.end(), [&durations](uint32_t a, uint32_t b) { return durations[a] > durations[b]; });
+
+			for (uint32_t i = 0; i < min(count - skippedCount, 5u); ++i)
+				LOGF(LogLevel::eINFO, "  %10.2f ms  %s", (double)durations[order[i]] / 1000.0, names[order[i]].c_str());
+		}
+	}
+
+	return failedCount == 0;
+}
+
+// -- ASSET MANIFEST --
+
+#define ASSET_HASH_SEED 0xcbf29ce484222325ull
+// Bump whenever a command writes different output for the same inputs and settings, so every asset gets rebuilt
+#define ASSET_PIPELINE_VERSION 1
+
+// Output formats of ProcessTexture, normal maps keep two full precision channels
+#define ASSET_TEXTURE_COLOR_FORMAT TinyImageFormat_DXBC7_UNORM
+#define ASSET_TEXTURE_NORMAL_FORMAT TinyImageFormat_DXBC5_UNORM
+#define ASSET_VIRTUAL_TEXTURE_PAGE_SIZE 128
+
+// Content hash and settings hash of the last successful build of an asset, keyed by "<command>:<input path>"
+struct AssetManifestEntry
+{
+	uint64_t mInputHash;
+	uint64_t mSettingsHash;
+};
+
+struct AssetManifest
+{
+	PathHandle                                              mPath;
+	Mutex                                                   mMutex;
+	eastl::unordered_map<eastl::string, AssetManifestEntry> mEntries;
+};
+
+// FNV-1a, chained through hash so several inputs fold into one value
+static uint64_t hashAssetBytes(const void* pData, size_t size, uint64_t hash)
+{
+	const uint8_t* pBytes = (const uint8_t*)pData;
+	for (size_t i = 0; i < size; ++i)
+	{
+		hash ^= pBytes[i];
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+static uint64_t hashAssetFile(const Path* path, uint64_t hash)
+{
+	FileStream* pFile = fsOpenFile(path, FM_READ_BINARY);
+	if (!pFile)
+		return ~hash;
+
+	uint8_t buffer[16 * 1024];
+	size_t  bytesRead = 0;
+	while ((bytesRead = fsReadFromStream(pFile, buffer, sizeof(buffer))) > 0)
+		hash = hashAssetBytes(buffer, bytesRead, hash);
+	fsCloseStream(pFile);
+	return hash;
+}
+
+// pSettings holds everything besides the inputs that the output of the command depends on
+static uint64_t hashAssetSettings(const char* command, const void* pSettings, size_t size)
+{
+	const uint32_t version = ASSET_PIPELINE_VERSION;
+	uint64_t       hash = hashAssetBytes(&version, sizeof(version), ASSET_HASH_SEED);
+	hash = hashAssetBytes(command, strlen(command), hash);
+	return hashAssetBytes(pSettings, size, hash);
+}
+
+// An asset is skipped when its inputs and settings hash to what the manifest recorded and all of its outputs are still there
+static bool isAssetUpToDate(
+	ProcessAssetsSettings* settings, const eastl::string& key, uint64_t inputHash, uint64_t settingsHash, const PathHandle* pOutputs,
+	uint32_t outputCount)
+{
+	if (settings->force || !settings->pManifest)
+		return false;
+
+	for (uint32_t i = 0; i < outputCount; ++i)
+	{
+		if (!fsFileExists(pOutputs[i]) || fsGetLastModifiedTime(pOutputs[i]) < (time_t)settings->minLastModifiedTime)
+			return false;
+	}
+
+	MutexLock lock(settings->pManifest->mMutex);
+	eastl::unordered_map<eastl::string, AssetManifestEntry>::const_iterator it = settings->pManifest->mEntries.find(key);
+	return it != settings->pManifest->mEntries.end() && it->second.mInputHash == inputHash && it->second.mSettingsHash == settingsHash;
+}
+
+// Failed assets are dropped so their partially written outputs get rebuilt next time
+static void recordAsset(ProcessAssetsSettings* settings, const eastl::string& key, uint64_t inputHash, uint64_t settingsHash, bool success)
+{
+	if (!settings->pManifest)
+		return;
+
+	MutexLock lock(settings->pManifest->mMutex);
+	if (success)
+		settings->pManifest->mEntries[key] = { inputHash, settingsHash };
+	else
+		settings->pManifest->mEntries.erase(key);
+}
+
+AssetManifest* AssetPipeline::OpenManifest(const Path* manifestPath)
+{
+	AssetManifest* pManifest = conf_new(AssetManifest);
+	pManifest->mPath = fsCopyPath(manifestPath);
+	pManifest->mMutex.Init();
+
+	FileStream* pFile = fsFileExists(manifestPath) ? fsOpenFile(manifestPath, FM_READ) : NULL;
+	if (pFile)
+	{
+		while (!fsStreamAtEnd(pFile))
+		{
+			eastl::string      line = fsReadFromStreamSTLLine(pFile);
+			unsigned long long inputHash = 0;
+			unsigned long long settingsHash = 0;
+			int                keyOffset = 0;
+			if (sscanf(line.c_str(), "%llx %llx %n", &inputHash, &settingsHash, &keyOffset) == 2 && keyOffset)
+				pManifest->mEntries[line.c_str() + keyOffset] = { (uint64_t)inputHash, (uint64_t)settingsHash };
+		}
+		fsCloseStream(pFile);
+	}
+
+	return pManifest;
+}
+
+bool AssetPipeline::CloseManifest(AssetManifest* pManifest)
+{
+	// Nothing was built and nothing was recorded before, so there is no reason to create the file
+	bool        success = true;
+	FileStream* pFile = NULL;
+	if (!pManifest->mEntries.empty() || fsFileExists(pManifest->mPath))
+		pFile = fsOpenFile(pManifest->mPath, FM_WRITE);
+
+	if (pFile)
+	{
+		for (const eastl::pair<const eastl::string, AssetManifestEntry>& entry : pManifest->mEntries)
+		{
+			fsPrintToStream(
+				pFile, "%016llx %016llx %s\n", (unsigned long long)entry.second.mInputHash, (unsigned long long)entry.second.mSettingsHash,
+				entry.first.c_str());
+		}
+		fsCloseStream(pFile);
+	}
+	else if (!pManifest->mEntries.empty())
+	{
+		LOGF(LogLevel::eERROR, "Failed to write asset manifest %s.", fsGetPathAsNativeString(pManifest->mPath));
+		success = false;
+	}
+
+	pManifest->mMutex.Destroy();
+	conf_delete(pManifest);
+	return success;
+}
+
+struct AnimationTask
+{
+	eastl::vector<eastl::string>             mNames;
+	eastl::vector<eastl::vector<PathHandle>> mFiles;    // Rigged mesh first, then its animations
+	const Path*                              pOutputDirectory;
+	ProcessAssetsSettings*                   pSettings;
+};
+
+// The skeleton is keyed by the rigged mesh, every animation by its own file combined with the skeleton's inputs
+static AssetTaskResult processAnimationAsset(void* pUserData, uint32_t index)
+{
+	AnimationTask*                   pTask = (AnimationTask*)pUserData;
+	ProcessAssetsSettings*           settings = pTask->pSettings;
+	const eastl::string&             assetName = pTask->mNames[index];
+	const eastl::vector<PathHandle>& files = pTask->mFiles[index];
+	const Path*                      skinnedMesh = files[0];
+
+	PathHandle skeletonOutputDir = fsAppendPathComponent(pTask->pOutputDirectory, assetName.c_str());
+	PathHandle skeletonOutput = fsAppendPathComponent(skeletonOutputDir, "skeleton.ozz");
+	PathHandle animationOutputDir = fsAppendPathComponent(skeletonOutputDir, "animations");
+
+	// The runtime skeleton and animations are written in the archive format of the ozz version the tool is built with
+	const struct
+	{
+		uint32_t mSkeletonVersion;
+		uint32_t mAnimationVersion;
+	} animationSettings = { ozz::io::internal::Version<const ozz::animation::Skeleton>::kValue,
+							ozz::io::internal::Version<const ozz::animation::Animation>::kValue };
+	const uint64_t      settingsHash = hashAssetSettings("pa", &animationSettings, sizeof(animationSettings));
+	const uint64_t      skeletonHash = hashAssetFile(skinnedMesh, ASSET_HASH_SEED);
+	const eastl::string skeletonKey = eastl::string("pa:") + fsGetPathAsNativeString(skinnedMesh);
+
+	if (!fsFileExists(animationOutputDir))
+	{
+		if ((!fsFileExists(skeletonOutputDir) && !fsCreateDirectory(skeletonOutputDir)) || !fsCreateDirectory(animationOutputDir))
+		{
+			LOGF(LogLevel::eERROR, "Failed to create output directory %s.", fsGetPathAsNativeString(animationOutputDir));
+			return ASSET_TASK_FAILED;
+		}
+	}
+
+	bool                     processed = false;
+	ozz::animation::Skeleton skeleton;
+	if (!isAssetUpToDate(settings, skeletonKey, skeletonHash, settingsHash, &skeletonOutput, 1))
+	{
+		const bool success = AssetPipeline::CreateRuntimeSkeleton(skinnedMesh, assetName.c_str(), skeletonOutput, &skeleton, settings);
+		recordAsset(settings, skeletonKey, skeletonHash, settingsHash, success);
+		if (!success)
+			return ASSET_TASK_FAILED;
+		processed = true;
+	}
+	else
+	{
+		// Load skeleton from disk
+		ozz::io::File file(skeletonOutput, FM_READ_BINARY);
+
+		if (!file.opened())
+			return ASSET_TASK_FAILED;
+		ozz::io::IArchive archive(&file);
+		archive >> skeleton;
+		if (!file.CloseOzzFile())
+			return ASSET_TASK_FAILED;
+	}
+
+	bool success = true;
+	for (size_t i = 1; i < files.size(); ++i)
+	{
+		const PathHandle& animationFile = files[i];
+		eastl::string     animationName = fsPathComponentToString(fsGetPathFileName(animationFile));
+		const PathHandle  animationOutput = fsAppendPathComponent(animationOutputDir, (animationName + ".ozz").c_str());
+
+		const uint64_t      animationHash = hashAssetFile(animationFile, skeletonHash);
+		const eastl::string animationKey = eastl::string("pa:") + fsGetPathAsNativeString(animationFile);
+		if (isAssetUpToDate(settings, animationKey, animationHash, settingsHash, &animationOutput, 1))
+			continue;
+
+		const bool created = AssetPipeline::CreateRuntimeAnimation(
+			animationFile, &skeleton, assetName.c_str(), animationName.c_str(), animationOutput, settings);
+		recordAsset(settings, animationKey, animationHash, settingsHash, created);
+		success = success && created;
+		processed = true;
+	}
+
+	skeleton.Deallocate();
+
+	if (!success)
+		return ASSET_TASK_FAILED;
+	return processed ? ASSET_TASK_PROCESSED : ASSET_TASK_SKIPPED;
+}
+
 bool AssetPipeline::ProcessAnimations(const Path* animationDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings)
 {
 	// Check if animationDirectory exists
@@ -78,9 +418,6 @@ bool AssetPipeline::ProcessAnimations(const Path* animationDirectory, const Path
 		return false;
 	}
 
-	// Check if output directory exists
-	bool outputDirExists = fsFileExists(outputDirectory);
-
 	// Check for assets containing animations in animationDirectory
     AnimationAssetMap                animationAssets;
     
@@ -139,127 +476,101 @@ bool AssetPipeline::ProcessAnimations(const Path* animationDirectory, const Path
     if (animationAssets.empty())
         return true;
 
+    // If output directory doesn't exist, create it.
+    if (!fsFileExists(outputDirectory) && !fsCreateDirectory(outputDirectory))
+    {
+        LOGF(LogLevel::eERROR, "Failed to create output directory %s.", fsGetPathAsNativeString(outputDirectory));
+        return false;
+    }
+
     // Process the found assets
-    int  assetsProcessed = 0;
-    bool success = true;
+    AnimationTask task = {};
+    task.pOutputDirectory = outputDirectory;
+    task.pSettings = settings;
     for (AnimationAssetMap::iterator it = animationAssets.begin(); it != animationAssets.end(); ++it)
     {
-        const Path* skinnedMesh = it->second[0];
-
-        // Create skeleton output file name
-        PathHandle skeletonOutputDir = fsAppendPathComponent(outputDirectory, it->first.c_str());
-        PathHandle skeletonOutput = fsAppendPathComponent(skeletonOutputDir, "skeleton.ozz");
-
-        // Check if the skeleton is already up-to-date
-        bool processSkeleton = true;
-        if (!settings->force && outputDirExists)
-        {
-            time_t lastModified = fsGetLastModifiedTime(skinnedMesh);
-            time_t lastProcessed = fsGetLastModifiedTime(skeletonOutput);
-
-            if (lastModified < lastProcessed && lastProcessed != ~0u && lastProcessed > settings->minLastModifiedTime)
-                processSkeleton = false;
-        }
-
-        ozz::animation::Skeleton skeleton;
-        if (processSkeleton)
-        {
-            // If output directory doesn't exist, create it.
-            if (!outputDirExists)
-            {
-                if (!fsCreateDirectory(outputDirectory))
-                {
-                    LOGF(LogLevel::eERROR, "Failed to create output directory %s.", fsGetPathAsNativeString(outputDirectory));
-                    return false;
-                }
-                outputDirExists = true;
-            }
-
-            if (!fsFileExists(skeletonOutputDir))
-            {
-                if (!fsCreateDirectory(skeletonOutputDir))
-                {
-                    LOGF(LogLevel::eERROR, "Failed to create output directory %s.", fsGetPathAsNativeString(skeletonOutputDir));
-                    success = false;
-                    continue;
-                }
-            }
-
-            // Process the skeleton
-            if (!CreateRuntimeSkeleton(skinnedMesh, it->first.c_str(), skeletonOutput, &skeleton, settings))
-            {
-                success = false;
-                continue;
-            }
-
-            ++assetsProcessed;
-        }
-        else
-        {
-			// Load skeleton from disk
-			ozz::io::File file(skeletonOutput, FM_READ_BINARY);
+        task.mNames.push_back(it->first);
+        task.mFiles.push_back(it->second);
+    }
 
-			if (!file.opened())
-				return false;
-			ozz::io::IArchive archive(&file);
-			archive >> skeleton;
-			if (!file.CloseOzzFile())
-				return false;
-        }
+    return runAssetTasks(settings, task.mNames, processAnimationAsset, &task);
+}
 
-        // If output directory doesn't exist, create it.
-        PathHandle animationOutputDir = fsAppendPathComponent(skeletonOutputDir, "animations");
-        if (!fsFileExists(animationOutputDir))
-        {
-            if (!fsCreateDirectory(animationOutputDir))
-            {
-                LOGF(LogLevel::eERROR, "Failed to create output directory %s.", fsGetPathAsNativeString(animationOutputDir));
-                success = false;
-                skeleton.Deallocate();
-                continue;
-            }
-        }
+// Collects the textures under directory together with the output directory each one is written to, which mirrors
+// the subdirectory the texture is in
+static void collectTextureFiles(
+	const Path* directory, const Path* outputDirectory, eastl::vector<PathHandle>& files, eastl::vector<PathHandle>& outputDirectories)
+{
+	const char* extensions[] = { "png", "jpg" };
+	for (const char* extension : extensions)
+	{
+		eastl::vector<PathHandle> filesWithExtension = fsGetFilesWithExtension(directory, extension);
+		files.insert(files.end(), filesWithExtension.begin(), filesWithExtension.end());
+		outputDirectories.resize(files.size(), PathHandle(fsCopyPath(outputDirectory)));
+	}
 
-        // Process animations
-        for (size_t i = 1; i < it->second.size(); ++i)
-        {
-            const PathHandle& animationFile = it->second[i];
-            
-            eastl::string animationName = fsPathComponentToString(fsGetPathFileName(animationFile));
+	eastl::vector<PathHandle> subDirectories = fsGetSubDirectories(directory);
+	for (const PathHandle& subDir : subDirectories)
+	{
+		eastl::string subDirName = fsPathComponentToString(fsGetPathFileName(subDir));
+		PathHandle    subOutputDirectory = fsAppendPathComponent(outputDirectory, subDirName.c_str());
+		collectTextureFiles(subDir, subOutputDirectory, files, outputDirectories);
+	}
+}
 
-            // Create animation output file name
-            const eastl::string outputFileString = it->first + "/animations/" + animationName + ".ozz";
-            const PathHandle animationOutput = fsAppendPathComponent(outputDirectory, outputFileString.c_str());
+struct TextureTask
+{
+	eastl::vector<eastl::string> mNames;
+	eastl::vector<PathHandle>    mInputs;
+	eastl::vector<PathHandle>    mOutputs;
+	ProcessAssetsSettings*       pSettings;
+};
 
-            // Check if the animation is already up-to-date
-            bool processAnimation = true;
-            if (!settings->force && outputDirExists && !processSkeleton)
-            {
-                time_t lastModified = fsGetLastModifiedTime(animationFile);
-                time_t lastProcessed = fsGetLastModifiedTime(animationOutput);
+static AssetTaskResult processTextureTask(void* pUserData, uint32_t index)
+{
+	TextureTask*           pTask = (TextureTask*)pUserData;
+	ProcessAssetsSettings* settings = pTask->pSettings;
 
-                if (lastModified < lastProcessed && lastProcessed != ~0u && lastModified > settings->minLastModifiedTime)
-                    processAnimation = false;
-            }
+	const uint64_t inputHash = hashAssetFile(pTask->mInputs[index], ASSET_HASH_SEED);
+	const struct
+	{
+		TinyImageFormat mColorFormat;
+		TinyImageFormat mNormalFormat;
+	} textureSettings = { ASSET_TEXTURE_COLOR_FORMAT, ASSET_TEXTURE_NORMAL_FORMAT };
+	const uint64_t settingsHash = hashAssetSettings("pt", &textureSettings, sizeof(textureSettings));
+	if (isAssetUpToDate(settings, pTask->mNames[index], inputHash, settingsHash, &pTask->mOutputs[index], 1))
+		return ASSET_TASK_SKIPPED;
+
+	const bool success = AssetPipeline::ProcessTexture(pTask->mInputs[index], pTask->mOutputs[index], settings);
+	recordAsset(settings, pTask->mNames[index], inputHash, settingsHash, success);
+	return success ? ASSET_TASK_PROCESSED : ASSET_TASK_FAILED;
+}
 
-            if (processAnimation)
-            {
-                // Process the animation
-                if (!CreateRuntimeAnimation(
-                    animationFile, &skeleton, it->first.c_str(), animationName.c_str(), animationOutput, settings))
-                    continue;
+bool AssetPipeline::ProcessTexture(const Path* texturePath, const Path* outputPath, ProcessAssetsSettings* settings)
+{
+	Image* pImage = conf_new(Image);
+	if (pImage->LoadFromFile(texturePath, NULL, NULL) != IMAGE_LOADING_RESULT_SUCCESS)
+	{
+		LOGF(LogLevel::eERROR, "Failed to load image %s.", fsGetPathAsNativeString(texturePath));
+		pImage->Destroy();
+		conf_delete(pImage);
+		return false;
+	}
 
-                ++assetsProcessed;
-            }
-        }
+	if (!pImage->GenerateMipMaps(ALL_MIPLEVELS, settings->pThreadSystem) && !settings->quiet)
+		LOGF(LogLevel::eWARNING, "Could not generate mipmaps for %s, only the top level is compressed.", fsGetPathAsNativeString(texturePath));
 
-        skeleton.Deallocate();
-    }
+	eastl::string fileName = fsPathComponentToString(fsGetPathFileName(texturePath));
+	fileName.make_lower();
+	const TinyImageFormat format = fileName.find("normal") != eastl::string::npos ? ASSET_TEXTURE_NORMAL_FORMAT : ASSET_TEXTURE_COLOR_FORMAT;
 
-    if (!settings->quiet && assetsProcessed == 0 && success)
-        LOGF(LogLevel::eINFO, "All assets already up-to-date.");
+	bool success = pImage->Convert(format, settings->pThreadSystem) && pImage->iSaveDDS(outputPath);
+	if (!success)
+		LOGF(LogLevel::eERROR, "Failed to convert %s to %s.", fsGetPathAsNativeString(texturePath), fsGetPathAsNativeString(outputPath));
 
-    return success;
+	pImage->Destroy();
+	conf_delete(pImage);
+	return success;
 }
 
 bool AssetPipeline::ProcessTextures(const Path* textureDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings)
@@ -281,34 +592,95 @@ bool AssetPipeline::ProcessTextures(const Path* textureDirectory, const Path* ou
 		}
 	}
 
-    PathHandle currentDir = fsCopyWorkingDirectoryPath();
-	currentDir = fsAppendPathComponent(currentDir, "ImageConvertTools/ImageConvertTool.py");
-	eastl::string cmd("python ");
-	cmd.append("\"");
-	cmd.append(fsGetPathAsNativeString(currentDir));
-	cmd.append("\"");
-	cmd.append(" fixall ");
-	eastl::string inputStr(fsGetPathAsNativeString(textureDirectory));
-	cmd.append(inputStr);
-	cmd.append(" ");
+	eastl::vector<PathHandle> textureFiles;
+	eastl::vector<PathHandle> textureOutputDirectories;
+	collectTextureFiles(textureDirectory, outputDirectory, textureFiles, textureOutputDirectories);
 
-	eastl::string outputStr(fsGetPathAsNativeString(outputDirectory));
-	cmd.append(outputStr);
+	// Every texture is written as <name>.dds into the subdirectory of the output directory matching the one it is in.
+	// Textures that would still end up in the same file (name.png and name.jpg) are rejected before any task runs
+	TextureTask task = {};
+	task.pSettings = settings;
+	eastl::unordered_map<eastl::string, uint32_t> outputIndices;
+	for (uint32_t i = 0; i < (uint32_t)textureFiles.size(); ++i)
+	{
+		const PathHandle& textureFile = textureFiles[i];
+		eastl::string outputName = fsPathComponentToString(fsGetPathFileName(textureFile)) + ".dds";
+		PathHandle    outputPath = fsAppendPathComponent(textureOutputDirectories[i], outputName.c_str());
 
-#if !defined(TARGET_IOS) && !defined(__ANDROID__) && !defined(_DURANGO) && !defined(ORBIS)
-	int result = system(cmd.c_str());
-	if (result)
-		return true;
-	else
-		return false;
-#else
-    return true;
-#endif
+		eastl::string outputString = fsGetPathAsNativeString(outputPath);
+		eastl::unordered_map<eastl::string, uint32_t>::iterator it = outputIndices.find(outputString);
+		if (it != outputIndices.end())
+		{
+			LOGF(
+				LogLevel::eERROR, "%s and %s are both written to %s.", fsGetPathAsNativeString(task.mInputs[it->second]),
+				fsGetPathAsNativeString(textureFile), outputString.c_str());
+			return false;
+		}
+		outputIndices[outputString] = (uint32_t)task.mInputs.size();
+
+		if (!fsFileExists(textureOutputDirectories[i]) && !fsCreateDirectory(textureOutputDirectories[i]))
+		{
+			LOGF(LogLevel::eERROR, "Failed to create output directory %s.", fsGetPathAsNativeString(textureOutputDirectories[i]));
+			return false;
+		}
+
+		task.mNames.push_back(eastl::string("pt:") + fsGetPathAsNativeString(textureFile));
+		task.mInputs.push_back(textureFile);
+		task.mOutputs.push_back(outputPath);
+	}
+
+	// Mip generation and block compression of each texture share the pool with the other textures
+	Image::Init(settings->pThreadSystem);
+	bool success = runAssetTasks(settings, task.mNames, processTextureTask, &task);
+	Image::Exit();
+
+	return success;
+}
+
+struct VirtualTextureTask
+{
+	eastl::vector<eastl::string> mNames;
+	eastl::vector<PathHandle>    mInputs;
+	eastl::vector<PathHandle>    mOutputs;
+	ProcessAssetsSettings*       pSettings;
+};
+
+static AssetTaskResult processVirtualTextureTask(void* pUserData, uint32_t index)
+{
+	VirtualTextureTask*    pTask = (VirtualTextureTask*)pUserData;
+	ProcessAssetsSettings* settings = pTask->pSettings;
+
+	const uint64_t inputHash = hashAssetFile(pTask->mInputs[index], ASSET_HASH_SEED);
+	const struct
+	{
+		uint32_t mFileVersion;
+		uint32_t mPageSize;
+	} virtualTextureSettings = { SVT_FILE_VERSION, ASSET_VIRTUAL_TEXTURE_PAGE_SIZE };
+	const uint64_t settingsHash = hashAssetSettings("pvt", &virtualTextureSettings, sizeof(virtualTextureSettings));
+	if (isAssetUpToDate(settings, pTask->mNames[index], inputHash, settingsHash, &pTask->mOutputs[index], 1))
+		return ASSET_TASK_SKIPPED;
+
+	const bool success = AssetPipeline::ProcessVirtualTexture(pTask->mInputs[index], pTask->mOutputs[index], settings);
+	recordAsset(settings, pTask->mNames[index], inputHash, settingsHash, success);
+	return success ? ASSET_TASK_PROCESSED : ASSET_TASK_FAILED;
+}
+
+bool AssetPipeline::ProcessVirtualTexture(const Path* texturePath, const Path* outputPath, ProcessAssetsSettings* settings)
+{
+	Image* pImage = conf_new(Image);
+	bool   success = pImage->LoadFromFile(texturePath, NULL, NULL) == IMAGE_LOADING_RESULT_SUCCESS;
+	if (!success)
+		LOGF(LogLevel::eERROR, "Failed to load image %s.", fsGetPathAsNativeString(texturePath));
+	else if (!(success = pImage->iSaveSVT(outputPath, ASSET_VIRTUAL_TEXTURE_PAGE_SIZE)))
+		LOGF(LogLevel::eERROR, "Failed to save sparse virtual texture %s.", fsGetPathAsNativeString(outputPath));
+
+	pImage->Destroy();
+	conf_delete(pImage);
+	return success;
 }
 
 bool AssetPipeline::ProcessVirtualTextures(const Path* textureDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings)
 {
-#if !defined(__linux__) && !defined(METAL)
 	// Check if directory exists
 	if (!fsFileExists(textureDirectory))
 	{
@@ -326,90 +698,450 @@ bool AssetPipeline::ProcessVirtualTextures(const Path* textureDirectory, const P
 		}
 	}
 
-	// Get all image files
-	eastl::vector<PathHandle> ddsFilesInDirectory;
-	ddsFilesInDirectory = fsGetFilesWithExtension(textureDirectory, ".dds");
-
-	for (size_t i = 0; i < ddsFilesInDirectory.size(); ++i)
+	// The .svt is written next to its source image
+	VirtualTextureTask task = {};
+	task.pSettings = settings;
+	const char* extensions[] = { ".dds", ".ktx" };
+	for (const char* extension : extensions)
 	{
-		eastl::string outputFile = fsGetPathAsNativeString(ddsFilesInDirectory[i]);
-		
-		if (outputFile.size() > 0)
+		eastl::vector<PathHandle> files = fsGetFilesWithExtension(textureDirectory, extension);
+		for (const PathHandle& file : files)
 		{
-			Image* pImage = conf_new(Image);
-			pImage->Init();
+			task.mNames.push_back(eastl::string("pvt:") + fsGetPathAsNativeString(file));
+			task.mInputs.push_back(file);
+			task.mOutputs.push_back(fsReplacePathExtension(file, "svt"));
+		}
+	}
 
-			if (!pImage->LoadFromFile(ddsFilesInDirectory[i], NULL, NULL))
-			{
-				pImage->Destroy();
-				conf_delete(pImage);
-				LOGF(LogLevel::eERROR, "Failed to load image %s.", outputFile.c_str());
-				continue;
-			}
+	Image::Init(settings->pThreadSystem);
+	bool success = runAssetTasks(settings, task.mNames, processVirtualTextureTask, &task);
+	Image::Exit();
 
-			outputFile.resize(outputFile.size() - 4);
-			outputFile.append(".svt");
+	return success;
+}
 
-			PathHandle pathForSVT = fsCreatePath(fsGetSystemFileSystem(), outputFile.c_str());
+struct PackSourceEntry
+{
+	PathHandle    mPath;
+	eastl::string mName;
+	uint64_t      mPathHash;
+	bool          mDirectory;
+};
 
-			bool result = pImage->iSaveSVT(pathForSVT);
+static void CollectPackEntries(
+	const Path* directory, const eastl::string& relativeDirectory, const Path* packagePath, eastl::vector<PackSourceEntry>& entries)
+{
+	eastl::vector<PathHandle> files = fsGetFilesInDirectory(directory);
+	for (size_t i = 0; i < files.size(); ++i)
+	{
+		// Directory listings may contain subdirectories and "." / ".."; those are handled below.
+		if (fsDirectoryExists(files[i]) || fsPathsEqual(files[i], packagePath))
+			continue;
 
-			pImage->Destroy();
-			conf_delete(pImage);
+		eastl::string name = relativeDirectory.empty() ? "" : relativeDirectory + "/";
+		name.append(fsGetPathFileNameAndExtension(files[i]));
+		entries.push_back({ files[i], name, packHashPath(name.c_str(), name.size()), false });
+	}
 
-			if (result == false)
-			{
-				LOGF(LogLevel::eERROR, "Failed to save sparse virtual texture %s.", outputFile.c_str());
-				return false;
-			}			
+	eastl::vector<PathHandle> subDirectories = fsGetSubDirectories(directory);
+	for (size_t i = 0; i < subDirectories.size(); ++i)
+	{
+		eastl::string name = relativeDirectory.empty() ? "" : relativeDirectory + "/";
+		name.append(fsGetPathFileNameAndExtension(subDirectories[i]));
+		entries.push_back({ subDirectories[i], name, packHashPath(name.c_str(), name.size()), true });
+		CollectPackEntries(subDirectories[i], name, packagePath, entries);
+	}
+}
+
+static inline uint64_t AlignPackOffset(uint64_t offset, uint64_t alignment) { return (offset + alignment - 1) & ~(alignment - 1); }
+
+// Writes zeros until *offset reaches newOffset.
+static bool WritePackPadding(FileStream* stream, uint64_t* offset, uint64_t newOffset)
+{
+	static const uint8_t zeros[256] = {};
+	uint64_t             padding = newOffset - *offset;
+	while (padding > 0)
+	{
+		size_t bytesToWrite = (size_t)min(padding, (uint64_t)sizeof(zeros));
+		if (fsWriteToStream(stream, zeros, bytesToWrite) != bytesToWrite)
+			return false;
+		padding -= bytesToWrite;
+		*offset += bytesToWrite;
+	}
+	return true;
+}
+
+bool AssetPipeline::CreatePackage(const Path* inputDirectory, const Path* packagePath, ProcessAssetsSettings* settings)
+{
+	if (!fsDirectoryExists(inputDirectory))
+	{
+		LOGF(LogLevel::eERROR, "inputDirectory: \"%s\" does not exist.", fsGetPathAsNativeString(inputDirectory));
+		return false;
+	}
+
+	uint32_t dataAlignment = settings->packDataAlignment ? settings->packDataAlignment : PACK_DEFAULT_DATA_ALIGNMENT;
+	if (dataAlignment & (dataAlignment - 1))
+	{
+		LOGF(LogLevel::eERROR, "Package data alignment %u is not a power of two.", dataAlignment);
+		return false;
+	}
+
+	eastl::vector<PackSourceEntry> sources;
+	CollectPackEntries(inputDirectory, "", packagePath, sources);
+
+	// Skip the package if it is newer than everything that goes in it.
+	if (!settings->force && fsFileExists(packagePath))
+	{
+		time_t packageTime = fsGetLastModifiedTime(packagePath);
+		bool   upToDate = packageTime >= (time_t)settings->minLastModifiedTime;
+		for (size_t i = 0; upToDate && i < sources.size(); ++i)
+			upToDate = sources[i].mDirectory || fsGetLastModifiedTime(sources[i].mPath) <= packageTime;
+
+		if (upToDate)
+		{
+			if (!settings->quiet)
+				LOGF(LogLevel::eINFO, "Package %s is up to date.", fsGetPathAsNativeString(packagePath));
+			return true;
+		}
+	}
+
+	// The runtime binary searches entries by hash.
+	eastl::sort(sources.begin(), sources.end(), [](const PackSourceEntry& a, const PackSourceEntry& b) {
+		return a.mPathHash != b.mPathHash ? a.mPathHash < b.mPathHash : a.mName < b.mName;
+	});
+
+	const uint32_t blockSize = PACK_DEFAULT_BLOCK_SIZE;
+
+	PackHeader header = {};
+	header.mMagic = PACK_MAGIC;
+	header.mVersion = PACK_VERSION;
+	header.mBlockSize = blockSize;
+	header.mDataAlignment = dataAlignment;
+	header.mEntryCount = (uint32_t)sources.size();
+
+	eastl::vector<PackEntry> entries(sources.size());
+	eastl::string            names;
+	for (size_t i = 0; i < sources.size(); ++i)
+	{
+		PackEntry& entry = entries[i];
+		entry.mPathHash = sources[i].mPathHash;
+		entry.mSize = 0;
+		entry.mModifiedTime = (int64_t)fsGetLastModifiedTime(sources[i].mPath);
+		entry.mNameOffset = (uint32_t)names.size();
+		entry.mNameLength = (uint32_t)sources[i].mName.size();
+		entry.mFirstBlock = header.mBlockCount;
+		entry.mFlags = sources[i].mDirectory ? PACK_ENTRY_DIRECTORY : 0;
+		names.append(sources[i].mName.c_str(), sources[i].mName.size() + 1);
+
+		if (!sources[i].mDirectory)
+		{
+			FileStream* file = fsOpenFile(sources[i].mPath, FM_READ_BINARY);
+			entry.mSize = (uint64_t)fsGetStreamFileSize(file);
+			fsCloseStream(file);
+			header.mBlockCount += packBlockCount(entry.mSize, blockSize);
 		}
 	}
 
-	ddsFilesInDirectory.set_capacity(0);
+	header.mEntryTableOffset = sizeof(PackHeader);
+	header.mBlockTableOffset = header.mEntryTableOffset + entries.size() * sizeof(PackEntry);
+	header.mNameTableOffset = header.mBlockTableOffset + header.mBlockCount * sizeof(PackBlock);
+	header.mNameTableSize = names.size();
+
+	FileStream* pack = fsOpenFile(packagePath, FM_WRITE_BINARY);
+	if (!pack)
+	{
+		LOGF(LogLevel::eERROR, "Failed to open package %s for writing.", fsGetPathAsNativeString(packagePath));
+		return false;
+	}
+
+	// Tables are written last, once every block's offset is known.
+	uint64_t offset = 0;
+	bool     success = WritePackPadding(pack, &offset, AlignPackOffset(header.mNameTableOffset + header.mNameTableSize, dataAlignment));
 
-	eastl::vector<PathHandle> ktxFilesInDirectory;
-	ktxFilesInDirectory = fsGetFilesWithExtension(textureDirectory, ".ktx");
+	eastl::vector<PackBlock> blocks(header.mBlockCount);
+	eastl::vector<uint8_t>   fileData;
+	eastl::vector<uint8_t>   compressedData;
+	eastl::vector<uint32_t>  compressedSizes;
+	uint64_t                 totalSize = 0;
 
-	for (size_t i = 0; i < ktxFilesInDirectory.size(); ++i)
+	const size_t compressedBlockStride = packCompressBound(blockSize);
+	for (size_t i = 0; success && i < entries.size(); ++i)
 	{
-		eastl::string outputFile = fsGetPathAsNativeString(ktxFilesInDirectory[i]);
+		PackEntry& entry = entries[i];
+		if (entry.mFlags & PACK_ENTRY_DIRECTORY)
+			continue;
+
+		fileData.resize((size_t)entry.mSize);
+		FileStream* file = fsOpenFile(sources[i].mPath, FM_READ_BINARY);
+		if (fsReadFromStream(file, fileData.data(), fileData.size()) != fileData.size())
+		{
+			LOGF(LogLevel::eERROR, "Failed to read %s.", fsGetPathAsNativeString(sources[i].mPath));
+			fsCloseStream(file);
+			success = false;
+			break;
+		}
+		fsCloseStream(file);
 
-		if (outputFile.size() > 0)
+		uint32_t blockCount = packBlockCount(entry.mSize, blockSize);
+		uint64_t fileCompressedSize = 0;
+		compressedData.resize(blockCount * compressedBlockStride);
+		compressedSizes.resize(blockCount);
+		for (uint32_t b = 0; b < blockCount; ++b)
 		{
-			Image* pImage = conf_new(Image);
-			pImage->Init();
+			size_t srcSize = (size_t)min((uint64_t)blockSize, entry.mSize - (uint64_t)b * blockSize);
+			// Compressed blocks must come out strictly smaller; anything else is stored.
+			size_t compressedSize = packCompressBlock(
+				fileData.data() + (size_t)b * blockSize, srcSize, compressedData.data() + b * compressedBlockStride, srcSize - 1);
+			compressedSizes[b] = (uint32_t)(compressedSize ? compressedSize : srcSize);
+			fileCompressedSize += compressedSizes[b];
+		}
 
-			if (!pImage->LoadFromFile(ktxFilesInDirectory[i], NULL, NULL))
+		// Files that barely compress are stored whole so they can be read in place.
+		bool stored = fileCompressedSize + entry.mSize / 16 >= entry.mSize;
+		if (stored)
+		{
+			entry.mFlags |= PACK_ENTRY_STORED;
+			success = WritePackPadding(pack, &offset, AlignPackOffset(offset, dataAlignment)) &&
+					  fsWriteToStream(pack, fileData.data(), fileData.size()) == fileData.size();
+		}
+
+		for (uint32_t b = 0; success && b < blockCount; ++b)
+		{
+			PackBlock& block = blocks[entry.mFirstBlock + b];
+			block.mSize = (uint32_t)min((uint64_t)blockSize, entry.mSize - (uint64_t)b * blockSize);
+			if (stored)
 			{
-				pImage->Destroy();
-				conf_delete(pImage);
-				LOGF(LogLevel::eERROR, "Failed to load image %s.", outputFile.c_str());
+				block.mOffset = offset + (uint64_t)b * blockSize;
+				block.mCompressedSize = block.mSize;
 				continue;
 			}
 
-			outputFile.resize(outputFile.size() - 4);
-			outputFile.append(".svt");
+			success = WritePackPadding(pack, &offset, AlignPackOffset(offset, dataAlignment));
+			block.mOffset = offset;
+			block.mCompressedSize = compressedSizes[b];
+			const uint8_t* blockData = block.mCompressedSize == block.mSize ? fileData.data() + (size_t)b * blockSize
+																			 : compressedData.data() + b * compressedBlockStride;
+			success = success && fsWriteToStream(pack, blockData, block.mCompressedSize) == block.mCompressedSize;
+			offset += block.mCompressedSize;
+		}
 
-			PathHandle pathForSVT = fsCreatePath(fsGetSystemFileSystem(), outputFile.c_str());
+		if (stored)
+			offset += entry.mSize;
+		totalSize += entry.mSize;
+	}
 
-			bool result = pImage->iSaveSVT(pathForSVT);
+	success = success && fsSeekStream(pack, SBO_START_OF_FILE, 0) &&
+			  fsWriteToStream(pack, &header, sizeof(header)) == sizeof(header) &&
+			  fsWriteToStream(pack, entries.data(), entries.size() * sizeof(PackEntry)) == entries.size() * sizeof(PackEntry) &&
+			  fsWriteToStream(pack, blocks.data(), blocks.size() * sizeof(PackBlock)) == blocks.size() * sizeof(PackBlock) &&
+			  fsWriteToStream(pack, names.data(), names.size()) == names.size();
+	fsCloseStream(pack);
 
-			pImage->Destroy();
-			conf_delete(pImage);
+	if (!success)
+	{
+		LOGF(LogLevel::eERROR, "Failed to write package %s.", fsGetPathAsNativeString(packagePath));
+		fsDeleteFile(packagePath);
+		return false;
+	}
 
-			if (result == false)
-			{
-				LOGF(LogLevel::eERROR, "Failed to save sparse virtual texture %s.", outputFile.c_str());
-				return false;
-			}
-		}
+	if (!settings->quiet)
+	{
+		LOGF(LogLevel::eINFO, "Packed %u entries into %s: %llu bytes -> %llu bytes.", header.mEntryCount,
+			fsGetPathAsNativeString(packagePath), (unsigned long long)totalSize, (unsigned long long)offset);
 	}
 
-	ktxFilesInDirectory.set_capacity(0);
-#endif
 	return true;
 }
 
+#define RETURN_IF_TFX_ERROR(expression) if (!(expression)) { LOGF(eERROR, "Failed to load tfx"); return false; }
+
+static bool processTFXFile(const Path* input, const Path* output, ProcessAssetsSettings* settings)
+{
+	PathHandle binFilePath = fsReplacePathExtension(output, "bin");
+
+	FileStream* tfxFile = fsOpenFile(input, FM_READ_BINARY);
+	AMD::TressFXAsset tressFXAsset = {};
+	RETURN_IF_TFX_ERROR(tressFXAsset.LoadHairData(tfxFile))
+	fsCloseStream(tfxFile);
+
+	if (settings->mFollowHairCount)
+	{
+		RETURN_IF_TFX_ERROR(tressFXAsset.GenerateFollowHairs(settings->mFollowHairCount, settings->mTipSeperationFactor, settings->mMaxRadiusAroundGuideHair))
+	}
+
+	RETURN_IF_TFX_ERROR(tressFXAsset.ProcessAsset())
+
+	struct TypePair { cgltf_type type; cgltf_component_type comp; };
+	const TypePair vertexTypes[] =
+	{
+		{ cgltf_type_scalar, cgltf_component_type_r_32u },   // Indices
+		{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Position
+		{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Tangents
+		{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Global rotations
+		{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Local rotations
+		{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Ref vectors
+		{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Follow root offsets
+		{ cgltf_type_vec2,   cgltf_component_type_r_32f },   // Strand UVs
+		{ cgltf_type_scalar, cgltf_component_type_r_32u },   // Strand types
+		{ cgltf_type_scalar, cgltf_component_type_r_32f },   // Thickness coeffs
+		{ cgltf_type_scalar, cgltf_component_type_r_32f },   // Rest lengths
+	};
+	const uint32_t vertexStrides[] =
+	{
+		sizeof(uint32_t), // Indices
+		sizeof(float4),   // Position
+		sizeof(float4),   // Tangents
+		sizeof(float4),   // Global rotations
+		sizeof(float4),   // Local rotations
+		sizeof(float4),   // Ref vectors
+		sizeof(float4),   // Follow root offsets
+		sizeof(float2),   // Strand UVs
+		sizeof(uint32_t), // Strand types
+		sizeof(float),    // Thickness coeffs
+		sizeof(float),    // Rest lengths
+	};
+	const uint32_t vertexCounts[] =
+	{
+		(uint32_t)tressFXAsset.GetNumHairTriangleIndices(),   // Indices
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Position
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Tangents
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Global rotations
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Local rotations
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Ref vectors
+		(uint32_t)tressFXAsset.m_numTotalStrands,    // Follow root offsets
+		(uint32_t)tressFXAsset.m_numTotalStrands,    // Strand UVs
+		(uint32_t)tressFXAsset.m_numTotalStrands,    // Strand types
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Thickness coeffs
+		(uint32_t)tressFXAsset.m_numTotalVertices,   // Rest lengths
+	};
+	const void* vertexData[] =
+	{
+		tressFXAsset.m_triangleIndices,    // Indices
+		tressFXAsset.m_positions,          // Position
+		tressFXAsset.m_tangents,           // Tangents
+		tressFXAsset.m_globalRotations,    // Global rotations
+		tressFXAsset.m_localRotations,     // Local rotations
+		tressFXAsset.m_refVectors,         // Ref vectors
+		tressFXAsset.m_followRootOffsets,  // Follow root offsets
+		tressFXAsset.m_strandUV,           // Strand UVs
+		tressFXAsset.m_strandTypes,        // Strand types
+		tressFXAsset.m_thicknessCoeffs,    // Thickness coeffs
+		tressFXAsset.m_restLengths,        // Rest lengths
+	};
+	const char* vertexNames[] =
+	{
+		"INDEX",             // Indices
+		"POSITION",          // Position
+		"TANGENT",           // Tangents
+		"TEXCOORD_0",        // Global rotations
+		"TEXCOORD_1",        // Local rotations
+		"TEXCOORD_2",        // Ref vectors
+		"TEXCOORD_3",        // Follow root offsets
+		"TEXCOORD_4",        // Strand UVs
+		"TEXCOORD_5",        // Strand types
+		"TEXCOORD_6",        // Thickness coeffs
+		"TEXCOORD_7",        // Rest lengths
+	};
+	const uint32_t count = sizeof(vertexData) / sizeof(vertexData[0]);
+
+	cgltf_buffer buffer = {};
+	cgltf_accessor accessors[count] = {};
+	cgltf_buffer_view views[count] = {};
+	cgltf_attribute attribs[count] = {};
+	cgltf_mesh mesh = {};
+	cgltf_primitive prim = {};
+	cgltf_size offset = 0;
+	FileStream* binFile = fsOpenFile(binFilePath, FM_WRITE_BINARY);
+	size_t fileSize = 0;
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		views[i].type = (i ? cgltf_buffer_view_type_vertices : cgltf_buffer_view_type_indices);
+		views[i].buffer = &buffer;
+		views[i].offset = offset;
+		views[i].size = vertexCounts[i] * vertexStrides[i];
+		accessors[i].component_type = vertexTypes[i].comp;
+		accessors[i].stride = vertexStrides[i];
+		accessors[i].count = vertexCounts[i];
+		accessors[i].offset = 0;
+		accessors[i].type = vertexTypes[i].type;
+		accessors[i].buffer_view = &views[i];
+
+		attribs[i].name = (char*)vertexNames[i];
+		attribs[i].data = &accessors[i];
+
+		fileSize += fsWriteToStream(binFile, vertexData[i], views[i].size);
+		offset += views[i].size;
+	}
+	fsCloseStream(binFile);
+
+	PathComponent fn = fsGetPathFileName(binFilePath);
+	char uri[2048] = {};
+	sprintf(uri, "%s", fn.buffer);
+	buffer.uri = uri;
+	buffer.size = fileSize;
+
+	prim.indices = accessors;
+	prim.attributes_count = count - 1;
+	prim.attributes = attribs + 1;
+	prim.type = cgltf_primitive_type_triangles;
+
+	mesh.primitives_count = 1;
+	mesh.primitives = &prim;
+
+	char extras[128] = {};
+	sprintf(extras, "{ \"%s\" : %d, \"%s\" : %d }",
+		"mVertexCountPerStrand", tressFXAsset.m_numVerticesPerStrand, "mGuideCountPerStrand", tressFXAsset.m_numGuideStrands);
+
+	char generator[] = "TressFX";
+	cgltf_data data = {};
+	data.asset.generator = generator;
+	data.buffers_count = 1;
+	data.buffers = &buffer;
+	data.buffer_views_count = count;
+	data.buffer_views = views;
+	data.accessors_count = count;
+	data.accessors = accessors;
+	data.meshes_count = 1;
+	data.meshes = &mesh;
+	data.file_data = extras;
+	data.asset.extras.start_offset = 0;
+	data.asset.extras.end_offset = strlen(extras);
+	cgltf_options options = {};
+	return cgltf_write_file(&options, fsGetPathAsNativeString(output), &data) == cgltf_result_success;
+}
+
+struct TFXTask
+{
+	eastl::vector<eastl::string> mNames;
+	eastl::vector<PathHandle>    mInputs;
+	eastl::vector<PathHandle>    mOutputs;
+	ProcessAssetsSettings*       pSettings;
+};
+
+static AssetTaskResult processTFXTask(void* pUserData, uint32_t index)
+{
+	TFXTask*               pTask = (TFXTask*)pUserData;
+	ProcessAssetsSettings* settings = pTask->pSettings;
+
+	const struct
+	{
+		uint32_t mFollowHairCount;
+		float    mMaxRadiusAroundGuideHair;
+		float    mTipSeperationFactor;
+	} tfxSettings = { settings->mFollowHairCount, settings->mMaxRadiusAroundGuideHair, settings->mTipSeperationFactor };
+
+	const uint64_t inputHash = hashAssetFile(pTask->mInputs[index], ASSET_HASH_SEED);
+	const uint64_t settingsHash = hashAssetSettings("ptfx", &tfxSettings, sizeof(tfxSettings));
+	const PathHandle outputs[2] = { pTask->mOutputs[index], fsReplacePathExtension(pTask->mOutputs[index], "bin") };
+	if (isAssetUpToDate(settings, pTask->mNames[index], inputHash, settingsHash, outputs, 2))
+		return ASSET_TASK_SKIPPED;
+
+	const bool success = processTFXFile(pTask->mInputs[index], pTask->mOutputs[index], settings);
+	recordAsset(settings, pTask->mNames[index], inputHash, settingsHash, success);
+	return success ? ASSET_TASK_PROCESSED : ASSET_TASK_FAILED;
+}
+
 bool AssetPipeline::ProcessTFX(const Path* textureDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings)
 {
 	// Check if directory exists
@@ -429,174 +1161,21 @@ bool AssetPipeline::ProcessTFX(const Path* textureDirectory, const Path* outputD
 		}
 	}
 
-	cgltf_result result = cgltf_result_success;
-
 	// Get all tfx files
 	eastl::vector<PathHandle> tfxFilesInDirectory;
 	tfxFilesInDirectory = fsGetFilesWithExtension(textureDirectory, ".tfx");
 
-#define RETURN_IF_TFX_ERROR(expression) if (!(expression)) { LOGF(eERROR, "Failed to load tfx"); return false; }
-
-	for (size_t i = 0; i < tfxFilesInDirectory.size(); ++i)
+	TFXTask task = {};
+	task.pSettings = settings;
+	for (const PathHandle& input : tfxFilesInDirectory)
 	{
-		PathHandle input = tfxFilesInDirectory[i];
 		PathHandle output = fsAppendPathComponent(outputDirectory, fsGetPathFileName(input).buffer);
-		output = fsReplacePathExtension(output, "gltf");
-		PathHandle binFilePath = fsReplacePathExtension(output, "bin");
-
-		FileStream* tfxFile = fsOpenFile(input, FM_READ_BINARY);
-		AMD::TressFXAsset tressFXAsset = {};
-		RETURN_IF_TFX_ERROR(tressFXAsset.LoadHairData(tfxFile))
-		fsCloseStream(tfxFile);
-
-		if (settings->mFollowHairCount)
-		{
-			RETURN_IF_TFX_ERROR(tressFXAsset.GenerateFollowHairs(settings->mFollowHairCount, settings->mTipSeperationFactor, settings->mMaxRadiusAroundGuideHair))
-		}
-
-		RETURN_IF_TFX_ERROR(tressFXAsset.ProcessAsset())
-
-		struct TypePair { cgltf_type type; cgltf_component_type comp; };
-		const TypePair vertexTypes[] =
-		{
-			{ cgltf_type_scalar, cgltf_component_type_r_32u },   // Indices
-			{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Position
-			{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Tangents
-			{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Global rotations
-			{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Local rotations
-			{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Ref vectors
-			{ cgltf_type_vec4,   cgltf_component_type_r_32f },   // Follow root offsets
-			{ cgltf_type_vec2,   cgltf_component_type_r_32f },   // Strand UVs
-			{ cgltf_type_scalar, cgltf_component_type_r_32u },   // Strand types
-			{ cgltf_type_scalar, cgltf_component_type_r_32f },   // Thickness coeffs
-			{ cgltf_type_scalar, cgltf_component_type_r_32f },   // Rest lengths
-		};
-		const uint32_t vertexStrides[] =
-		{
-			sizeof(uint32_t), // Indices
-			sizeof(float4),   // Position
-			sizeof(float4),   // Tangents
-			sizeof(float4),   // Global rotations
-			sizeof(float4),   // Local rotations
-			sizeof(float4),   // Ref vectors
-			sizeof(float4),   // Follow root offsets
-			sizeof(float2),   // Strand UVs
-			sizeof(uint32_t), // Strand types
-			sizeof(float),    // Thickness coeffs
-			sizeof(float),    // Rest lengths
-		};
-		const uint32_t vertexCounts[] =
-		{
-			(uint32_t)tressFXAsset.GetNumHairTriangleIndices(),   // Indices
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Position
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Tangents
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Global rotations
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Local rotations
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Ref vectors
-			(uint32_t)tressFXAsset.m_numTotalStrands,    // Follow root offsets
-			(uint32_t)tressFXAsset.m_numTotalStrands,    // Strand UVs
-			(uint32_t)tressFXAsset.m_numTotalStrands,    // Strand types
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Thickness coeffs
-			(uint32_t)tressFXAsset.m_numTotalVertices,   // Rest lengths
-		};
-		const void* vertexData[] =
-		{
-			tressFXAsset.m_triangleIndices,    // Indices
-			tressFXAsset.m_positions,          // Position
-			tressFXAsset.m_tangents,           // Tangents
-			tressFXAsset.m_globalRotations,    // Global rotations
-			tressFXAsset.m_localRotations,     // Local rotations
-			tressFXAsset.m_refVectors,         // Ref vectors
-			tressFXAsset.m_followRootOffsets,  // Follow root offsets
-			tressFXAsset.m_strandUV,           // Strand UVs
-			tressFXAsset.m_strandTypes,        // Strand types
-			tressFXAsset.m_thicknessCoeffs,    // Thickness coeffs
-			tressFXAsset.m_restLengths,        // Rest lengths
-		};
-		const char* vertexNames[] =
-		{
-			"INDEX",             // Indices
-			"POSITION",          // Position
-			"TANGENT",           // Tangents
-			"TEXCOORD_0",        // Global rotations
-			"TEXCOORD_1",        // Local rotations
-			"TEXCOORD_2",        // Ref vectors
-			"TEXCOORD_3",        // Follow root offsets
-			"TEXCOORD_4",        // Strand UVs
-			"TEXCOORD_5",        // Strand types
-			"TEXCOORD_6",        // Thickness coeffs
-			"TEXCOORD_7",        // Rest lengths
-		};
-		const uint32_t count = sizeof(vertexData) / sizeof(vertexData[0]);
-
-		cgltf_buffer buffer = {};
-		cgltf_accessor accessors[count] = {};
-		cgltf_buffer_view views[count] = {};
-		cgltf_attribute attribs[count] = {};
-		cgltf_mesh mesh = {};
-		cgltf_primitive prim = {};
-		cgltf_size offset = 0;
-		FileStream* binFile = fsOpenFile(binFilePath, FM_WRITE_BINARY);
-		size_t fileSize = 0;
+		task.mNames.push_back(eastl::string("ptfx:") + fsGetPathAsNativeString(input));
+		task.mInputs.push_back(input);
+		task.mOutputs.push_back(fsReplacePathExtension(output, "gltf"));
+	}
 
-		for (uint32_t i = 0; i < count; ++i)
-		{
-			views[i].type = (i ? cgltf_buffer_view_type_vertices : cgltf_buffer_view_type_indices);
-			views[i].buffer = &buffer;
-			views[i].offset = offset;
-			views[i].size = vertexCounts[i] * vertexStrides[i];
-			accessors[i].component_type = vertexTypes[i].comp;
-			accessors[i].stride = vertexStrides[i];
-			accessors[i].count = vertexCounts[i];
-			accessors[i].offset = 0;
-			accessors[i].type = vertexTypes[i].type;
-			accessors[i].buffer_view = &views[i];
-
-			attribs[i].name = (char*)vertexNames[i];
-			attribs[i].data = &accessors[i];
-
-			fileSize += fsWriteToStream(binFile, vertexData[i], views[i].size);
-			offset += views[i].size;
-		}
-		fsCloseStream(binFile);
-
-		PathComponent fn = fsGetPathFileName(binFilePath);
-		char uri[2048] = {};
-		sprintf(uri, "%s", fn.buffer);
-		buffer.uri = uri;
-		buffer.size = fileSize;
-
-		prim.indices = accessors;
-		prim.attributes_count = count - 1;
-		prim.attributes = attribs + 1;
-		prim.type = cgltf_primitive_type_triangles;
-
-		mesh.primitives_count = 1;
-		mesh.primitives = &prim;
-
-		char extras[128] = {};
-		sprintf(extras, "{ \"%s\" : %d, \"%s\" : %d }",
-			"mVertexCountPerStrand", tressFXAsset.m_numVerticesPerStrand, "mGuideCountPerStrand", tressFXAsset.m_numGuideStrands);
-
-		char generator[] = "TressFX";
-		cgltf_data data = {};
-		data.asset.generator = generator;
-		data.buffers_count = 1;
-		data.buffers = &buffer;
-		data.buffer_views_count = count;
-		data.buffer_views = views;
-		data.accessors_count = count;
-		data.accessors = accessors;
-		data.meshes_count = 1;
-		data.meshes = &mesh;
-		data.file_data = extras;
-		data.asset.extras.start_offset = 0;
-		data.asset.extras.end_offset = strlen(extras);
-		cgltf_options options = {};
-		result = cgltf_write_file(&options, fsGetPathAsNativeString(output), &data);
-	}
-
-	return result == cgltf_result_success;
+	return runAssetTasks(settings, task.mNames, processTFXTask, &task);
 }
 
 static uint32_t FindJoint(ozz::animation::Skeleton* skeleton, const char* name)
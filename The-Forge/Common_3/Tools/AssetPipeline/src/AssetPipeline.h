@@ -29,6 +29,9 @@
 #include "../../../ThirdParty/OpenSource/ozz-animation/include/ozz/animation/runtime/skeleton.h"
 #include "../../../ThirdParty/OpenSource/ozz-animation/include/ozz/animation/runtime/animation.h"
 
+struct ThreadSystem;
+struct AssetManifest;
+
 struct ProcessAssetsSettings
 {
 	bool quiet;                  // Only output warnings.
@@ -37,11 +40,15 @@ struct ProcessAssetsSettings
 	uint quantizePositionBits;   // N value for N-Bit position quantization.
 	uint quantizeNormalBits;     // N value for N-Bit normal and tangent quantization.
 	uint quantizeTexBits;        // N value for N-Bit texture coordinate quantization.
+	uint packDataAlignment;      // Alignment in bytes of every block in a package. Must be a power of two.
 
 	// TressFX settings
 	uint32_t    mFollowHairCount;
 	float       mMaxRadiusAroundGuideHair;
 	float       mTipSeperationFactor;
+
+	ThreadSystem*  pThreadSystem;    // Per-asset work is spread over this pool, assets are processed one by one when NULL.
+	AssetManifest* pManifest;        // Content hashes of the last build, every asset is processed when NULL.
 };
 
 class AssetPipeline
@@ -56,6 +63,14 @@ public:
 		const Path* animationOutput, ProcessAssetsSettings* settings);
 
 	static bool ProcessTextures(const Path* textureDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings);
+	static bool ProcessTexture(const Path* texturePath, const Path* outputPath, ProcessAssetsSettings* settings);
 	static bool ProcessVirtualTextures(const Path* textureDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings);
+	static bool ProcessVirtualTexture(const Path* texturePath, const Path* outputPath, ProcessAssetsSettings* settings);
 	static bool ProcessTFX(const Path* tfxDirectory, const Path* outputDirectory, ProcessAssetsSettings* settings);
+
+	static bool CreatePackage(const Path* inputDirectory, const Path* packagePath, ProcessAssetsSettings* settings);
+
+	// Reads the manifest of a previous build (if any). CloseManifest writes it back and frees it
+	static AssetManifest* OpenManifest(const Path* manifestPath);
+	static bool           CloseManifest(AssetManifest* pManifest);
 };
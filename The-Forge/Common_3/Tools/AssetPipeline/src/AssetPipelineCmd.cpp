@@ -1,6 +1,7 @@
 #include "AssetPipeline.h"
 #include "../../../ThirdParty/OpenSource/EASTL/string.h"
 #include "../../../OS/Interfaces/ILog.h"
+#include "../../../OS/Core/ThreadSystem.h"
 
 #include <cstdio>
 #include <sys/stat.h>
@@ -15,11 +16,18 @@ void PrintHelp()
 	printf("\nCommand: processanimations \"animation/directory/\" \"output/directory/\" [flags]\n");
 	printf("\t--quiet: Print only error messages.\n");
 	printf("\t--force: Force all assets to be processed. Including ones that are already up-to-date.\n");
+	printf("\t--serial: Process one asset at a time instead of spreading them over all cores.\n");
+	printf("\tAssets are up-to-date when their content and settings match the output directory's AssetPipeline.manifest.\n");
 	printf("\nCommand: processmeshes \"meshes/directory/\" \"output/directory/\" [arguments]\n");
 	printf("\t-posbits N: use N-bit quantization for positions (default: 16; N should be between 1 and 16)\n");
 	printf("\t-texbits N: use N-bit quantization for texture coordinates (default: 12; N should be between 1 and 16)\n");
 	printf("\t-normbits N: use N-bit quantization for normals and tangents (default: 8; N should be between 1 and 8)\n");
-	printf("\nCommand: processtextures \"textures/directory/\" \"output/directory/\" \n");
+	printf("\nCommand: -pt \"textures/directory/\" \"output/directory/\" [flags]\n");
+	printf("\tCompresses every png and jpg to a mipmapped dds, BC5 for files named *normal*, BC7 otherwise.\n");
+	printf("\t--quiet: Print only error messages.\n");
+	printf("\t--force: Force all textures to be processed. Including ones that are already up-to-date.\n");
+	printf("\nCommand: -pk \"input/directory/\" \"output/package.pak\" [arguments]\n");
+	printf("\t-packalign N: align every data block in the package to N bytes (default: 16; N should be a power of two)\n");
 	printf("\nOther:\n");
 	printf("\t-h or -help: Print usage information.\n");
 }
@@ -70,8 +78,10 @@ int AssetPipelineCmd(int argc, char** argv)
 	settings.quantizePositionBits = 16;
 	settings.quantizeTexBits = 16;
 	settings.quantizeNormalBits = 8;
+	settings.packDataAlignment = 0;
 
 	const char* command = argv[1];
+	bool        serial = false;
 
 	for (int i = 4; i < argc; ++i)
 	{
@@ -85,7 +95,11 @@ int AssetPipelineCmd(int argc, char** argv)
 		{
 			settings.force = true;
 		}
-		if (stricmp(arg, "-posbits") == 0)
+		else if (stricmp(arg, "--serial") == 0)
+		{
+			serial = true;
+		}
+		else if (stricmp(arg, "-posbits") == 0)
 		{
 			if (i + 1 < argc && isdigit(argv[i + 1][0]))
 				settings.quantizePositionBits = atoi(argv[++i]);
@@ -128,6 +142,20 @@ int AssetPipelineCmd(int argc, char** argv)
 				settings.quantizeNormalBits = 8;
 			}
 		}
+		else if (stricmp(arg, "-packalign") == 0)
+		{
+			if (i + 1 < argc && isdigit(argv[i + 1][0]))
+				settings.packDataAlignment = atoi(argv[++i]);
+			else
+				printf("WARNING: Argument expects a value: %s\n", arg);
+
+			if (settings.packDataAlignment & (settings.packDataAlignment - 1))
+			{
+				printf("WARNING: Argument is not a power of two: %s\n", arg);
+				printf("         Using default value\n");
+				settings.packDataAlignment = 0;
+			}
+		}
 		else if (stricmp(arg, "-followhaircount") == 0 || stricmp(arg, "--fhc") == 0)
 		{
 			if (i + 1 < argc && isdigit(argv[i + 1][0]))
@@ -149,32 +177,49 @@ int AssetPipelineCmd(int argc, char** argv)
 		}
 	}
 
+	if (!serial)
+		initThreadSystem(&settings.pThreadSystem);
+
+	// The package has a single output and keeps its timestamp check, every other command records what it built
+	PathHandle manifestPath = NULL;
+	if (stricmp(command, "-pk") != 0)
+	{
+		manifestPath = fsAppendPathComponent(outputDir, "AssetPipeline.manifest");
+		settings.pManifest = AssetPipeline::OpenManifest(manifestPath);
+	}
+
+	bool success = true;
 	if (stricmp(command, "-pa") == 0)
 	{
-		if (!AssetPipeline::ProcessAnimations(inputDir, outputDir, &settings))
-			return 1;
+		success = AssetPipeline::ProcessAnimations(inputDir, outputDir, &settings);
 	}
 	else if (stricmp(command, "-pt") == 0)
 	{
-		if (!AssetPipeline::ProcessTextures(inputDir, outputDir, &settings))
-			return 1;
+		success = AssetPipeline::ProcessTextures(inputDir, outputDir, &settings);
 	}
 	else if (stricmp(command, "-pvt") == 0)
 	{
-		if (!AssetPipeline::ProcessVirtualTextures(inputDir, outputDir, &settings))
-			return 1;
+		success = AssetPipeline::ProcessVirtualTextures(inputDir, outputDir, &settings);
 	}
 	else if (stricmp(command, "-ptfx") == 0)
 	{
-		if (!AssetPipeline::ProcessTFX(inputDir, outputDir, &settings))
-			return 1;
+		success = AssetPipeline::ProcessTFX(inputDir, outputDir, &settings);
+	}
+	else if (stricmp(command, "-pk") == 0)
+	{
+		success = AssetPipeline::CreatePackage(inputDir, outputDir, &settings);
 	}
 	else
 	{
 		printf("ERROR: Invalid command. %s\n", command);
 	}
 
-	return 0;
+	if (settings.pManifest && !AssetPipeline::CloseManifest(settings.pManifest))
+		success = false;
+	if (settings.pThreadSystem)
+		shutdownThreadSystem(settings.pThreadSystem);
+
+	return success ? 0 : 1;
 }
 
 int main(int argc, char** argv)
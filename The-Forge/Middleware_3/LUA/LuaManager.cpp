@@ -4,10 +4,10 @@
 #include "../../Common_3/OS/Interfaces/ILog.h"
 #include "../../Common_3/OS/Interfaces/IMemory.h"
 
-void LuaManager::Init()
+void LuaManager::Init(ThreadSystem* pThreadSystem, ScriptCallbackThread callbackThread)
 {
 	m_Impl = (LuaManagerImpl*)conf_calloc(1, sizeof(LuaManagerImpl));
-	conf_placement_new<LuaManagerImpl>(m_Impl);
+	conf_placement_new<LuaManagerImpl>(m_Impl, pThreadSystem, callbackThread);
 }
 
 void LuaManager::Exit()
@@ -28,6 +28,12 @@ void LuaManager::SetFunction(ILuaFunctionWrap* wrap)
 	m_Impl->SetFunction(wrap);
 }
 
+void LuaManager::SetBytecodeCacheDirectory(const Path* directory)
+{
+	ASSERT(m_Impl != nullptr);
+	m_Impl->SetBytecodeCacheDirectory(directory);
+}
+
 bool LuaManager::RunScript(const Path* scriptPath)
 {
 	ASSERT(m_Impl != nullptr);
@@ -69,3 +75,21 @@ bool LuaManager::Update(float deltaTime, const char* updateFunctionName)
 	ASSERT(m_Impl != nullptr);
 	return m_Impl->Update(deltaTime, updateFunctionName);
 }
+
+void LuaManager::SetGarbageCollectorStep(uint32_t stepSizeKB)
+{
+	ASSERT(m_Impl != nullptr);
+	m_Impl->SetGarbageCollectorStep(stepSizeKB);
+}
+
+void LuaManager::DispatchAsyncCallbacks()
+{
+	ASSERT(m_Impl != nullptr);
+	m_Impl->DispatchAsyncCallbacks();
+}
+
+void LuaManager::WaitForAsyncScripts()
+{
+	ASSERT(m_Impl != nullptr);
+	m_Impl->WaitForAsyncScripts();
+}
@@ -7,17 +7,23 @@
 #include "../../Common_3/OS/Interfaces/IMemory.h"
 
 class LuaManagerImpl;
+struct ThreadSystem;
 
 class LuaManager
 {
 	public:
-	void Init();
+	//Async scripts run on pThreadSystem. If it is NULL the manager creates its own.
+	void Init(ThreadSystem* pThreadSystem = NULL, ScriptCallbackThread callbackThread = SCRIPT_CALLBACK_WORKER_THREAD);
 	void Exit();
 	~LuaManager();
 
 	template <class T>
 	void SetFunction(const char* functionName, T function);
 
+	//Compiled scripts are always kept in memory. With a directory set, the bytecode is also stored there
+	//so later runs of the application skip compiling unchanged scripts. NULL disables the on-disk cache.
+	void SetBytecodeCacheDirectory(const Path* directory);
+
 	bool RunScript(const Path* scriptPath);
 	void AddAsyncScript(const Path* scriptPath, ScriptDoneCallback callback);
 	void AddAsyncScript(const Path* scriptPath);
@@ -30,8 +36,20 @@ class LuaManager
 	bool ReloadUpdatableScript();
 	//updateFunctionName - function that will be called.
 	//If nullptr then function from SetUpdateScript arg is used.
+	//In the Lua async mode of the benchmark harness (--lua-async, see IBenchmark.h) it also runs and times the benchmark scripts.
 	bool Update(float deltaTime, const char* updateFunctionName = nullptr);
 
+	//With stepSizeKB > 0 the updatable script no longer collects garbage while it allocates.
+	//Instead every Update() ends with one incremental GC step that pays off the frame's allocations plus stepSizeKB.
+	//0 restores the automatic collector.
+	void SetGarbageCollectorStep(uint32_t stepSizeKB);
+
+	//Invokes the callbacks of finished async scripts when they are delivered on SCRIPT_CALLBACK_UPDATE_THREAD.
+	//Update() calls it as well.
+	void DispatchAsyncCallbacks();
+	//Blocks until every queued async script has finished
+	void WaitForAsyncScripts();
+
 	private:
 	LuaManagerImpl* m_Impl;
 
@@ -11,6 +11,15 @@ enum ScriptState
 
 typedef void (*ScriptDoneCallback)(ScriptState state);
 
+//Thread on which the callbacks of async scripts are invoked
+enum ScriptCallbackThread
+{
+	//on the worker that ran the script, as soon as it finishes
+	SCRIPT_CALLBACK_WORKER_THREAD,
+	//on the thread that calls LuaManager::Update() or LuaManager::DispatchAsyncCallbacks()
+	SCRIPT_CALLBACK_UPDATE_THREAD,
+};
+
 struct ILuaStateWrap
 {
 	virtual int           GetArgumentsCount() = 0;
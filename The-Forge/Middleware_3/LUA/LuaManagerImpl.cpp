@@ -3,6 +3,11 @@
 #include "../../Common_3/ThirdParty/OpenSource/EASTL/string.h"
 #include "../../Common_3/OS/Interfaces/IFileSystem.h"
 #include "../../Common_3/OS/Interfaces/ICameraController.h"
+#include "../../Common_3/OS/Interfaces/IBenchmark.h"
+#include "../../Common_3/OS/Interfaces/ITime.h"
+#include "../../Common_3/OS/Core/ThreadSystem.h"
+#include "../../Common_3/OS/FileSystem/FileMapping.h"
+#include "../../Common_3/ThirdParty/OpenSource/murmurhash3/MurmurHash3_32.h"
 #include "../../Common_3/OS/Interfaces/IMemory.h"
 
 const char LuaManagerImpl::className[] = "LuaManager";
@@ -36,25 +41,209 @@ int luaopen_conffLib(lua_State* L)
 	return 1;
 }
 
+//Small-object arena used as the allocator of each lua_State.
+//Blocks up to LUA_ARENA_MAX_BLOCK_SIZE bytes come from per size class free lists carved out of pages.
+//A state is only used by one thread at a time, so the arena needs no locking.
+//Pages are kept until the state is closed, larger blocks go to the global heap.
+#define LUA_ARENA_GRANULARITY 16
+#define LUA_ARENA_MAX_BLOCK_SIZE 256
+//heap blocks are never smaller than this, so a heap block that keeps a small object has room for the retained list link
+#define LUA_ARENA_MIN_HEAP_BLOCK_SIZE (LUA_ARENA_MAX_BLOCK_SIZE + sizeof(LuaArenaBlock))
+#define LUA_ARENA_SIZE_CLASS_COUNT (LUA_ARENA_MAX_BLOCK_SIZE / LUA_ARENA_GRANULARITY)
+#define LUA_ARENA_PAGE_SIZE (16 * 1024)
+
+struct LuaArenaBlock
+{
+	LuaArenaBlock* pNext;
+};
+
+struct LuaArena
+{
+	LuaArenaBlock* pFreeBlocks[LUA_ARENA_SIZE_CLASS_COUNT];
+	//pages are linked through their first LUA_ARENA_GRANULARITY bytes
+	LuaArenaBlock* pPages;
+	//heap blocks kept for a small object because a shrinking realloc couldn't get an arena block,
+	//linked through the bytes after LUA_ARENA_MAX_BLOCK_SIZE
+	LuaArenaBlock* pRetainedHeapBlocks;
+};
+
+static inline LuaArenaBlock* luaArenaRetainedLink(void* ptr) { return (LuaArenaBlock*)((uint8_t*)ptr + LUA_ARENA_MAX_BLOCK_SIZE); }
+
+static inline uint32_t luaArenaSizeClass(size_t size)
+{
+	return size > LUA_ARENA_MAX_BLOCK_SIZE ? LUA_ARENA_SIZE_CLASS_COUNT : (uint32_t)((size + LUA_ARENA_GRANULARITY - 1) / LUA_ARENA_GRANULARITY) - 1;
+}
+
+static void* luaArenaAllocBlock(LuaArena* pArena, uint32_t sizeClass)
+{
+	LuaArenaBlock* pBlock = pArena->pFreeBlocks[sizeClass];
+	if (!pBlock)
+	{
+		uint8_t* pPage = (uint8_t*)conf_memalign(LUA_ARENA_GRANULARITY, LUA_ARENA_PAGE_SIZE);
+		if (!pPage)
+			return NULL;
+		((LuaArenaBlock*)pPage)->pNext = pArena->pPages;
+		pArena->pPages = (LuaArenaBlock*)pPage;
+
+		const size_t blockSize = (sizeClass + 1) * LUA_ARENA_GRANULARITY;
+		for (size_t offset = LUA_ARENA_GRANULARITY; offset + blockSize <= LUA_ARENA_PAGE_SIZE; offset += blockSize)
+		{
+			LuaArenaBlock* pNew = (LuaArenaBlock*)(pPage + offset);
+			pNew->pNext = pBlock;
+			pBlock = pNew;
+		}
+	}
+	pArena->pFreeBlocks[sizeClass] = pBlock->pNext;
+	return pBlock;
+}
+
+static void luaArenaFree(LuaArena* pArena, void* ptr, size_t size)
+{
+	const uint32_t sizeClass = luaArenaSizeClass(size);
+	if (sizeClass == LUA_ARENA_SIZE_CLASS_COUNT)
+	{
+		conf_free(ptr);
+		return;
+	}
+	//lua only knows the small size of a retained heap block
+	for (LuaArenaBlock** ppLink = &pArena->pRetainedHeapBlocks; *ppLink; ppLink = &(*ppLink)->pNext)
+	{
+		if (*ppLink == luaArenaRetainedLink(ptr))
+		{
+			*ppLink = (*ppLink)->pNext;
+			conf_free(ptr);
+			return;
+		}
+	}
+	LuaArenaBlock* pBlock = (LuaArenaBlock*)ptr;
+	pBlock->pNext = pArena->pFreeBlocks[sizeClass];
+	pArena->pFreeBlocks[sizeClass] = pBlock;
+}
+
+static void luaArenaDestroy(LuaArena* pArena)
+{
+	LuaArenaBlock* pPage = pArena->pPages;
+	while (pPage)
+	{
+		LuaArenaBlock* pNext = pPage->pNext;
+		conf_free(pPage);
+		pPage = pNext;
+	}
+	conf_free(pArena);
+}
+
+//allocate and free function. Used in lua_newstate and in lua_close
+static void* conf_l_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+	LuaArena* pArena = (LuaArena*)ud;
+	if (ptr == NULL)
+		osize = 0; /* osize holds the type of the new object */
+
+	if (nsize == 0)
+	{
+		if (ptr)
+			luaArenaFree(pArena, ptr, osize);
+		return NULL;
+	}
+
+	const uint32_t oldClass = luaArenaSizeClass(osize);
+	const uint32_t newClass = luaArenaSizeClass(nsize);
+	const size_t   heapSize = nsize > LUA_ARENA_MIN_HEAP_BLOCK_SIZE ? nsize : LUA_ARENA_MIN_HEAP_BLOCK_SIZE;
+	if (ptr && oldClass == newClass)
+	{
+		if (newClass != LUA_ARENA_SIZE_CLASS_COUNT)
+			return ptr;
+		void* pNew = conf_realloc(ptr, heapSize);
+		//a heap block that can't shrink stays as large as it is
+		return pNew || nsize > osize ? pNew : ptr;
+	}
+
+	void* pNew = newClass == LUA_ARENA_SIZE_CLASS_COUNT ? conf_malloc(heapSize) : luaArenaAllocBlock(pArena, newClass);
+	if (!pNew)
+	{
+		//lua expects shrinking to succeed, so the old block keeps the object. A smaller size class fits in any
+		//arena block, while a heap block is remembered so it goes back to the heap when freed
+		if (ptr && nsize <= osize)
+		{
+			if (oldClass == LUA_ARENA_SIZE_CLASS_COUNT)
+			{
+				LuaArenaBlock* pLink = luaArenaRetainedLink(ptr);
+				pLink->pNext = pArena->pRetainedHeapBlocks;
+				pArena->pRetainedHeapBlocks = pLink;
+			}
+			return ptr;
+		}
+		return NULL; /* Lua keeps using the old block */
+	}
+	if (ptr)
+	{
+		memcpy(pNew, ptr, osize < nsize ? osize : nsize);
+		luaArenaFree(pArena, ptr, osize);
+	}
+	return pNew;
+}
+
 Luna<LuaManagerImpl>::FunctionType LuaManagerImpl::methods[] = { { NULL, NULL } };
 
 Luna<LuaManagerImpl>::PropertyType LuaManagerImpl::properties[] = { { NULL, NULL } };
 
-LuaManagerImpl::LuaManagerImpl(lua_State* L): m_SyncLuaState(nullptr) { memset(m_AsyncLuaStates, 0, MAX_LUA_WORKERS * sizeof(lua_State*)); }
+LuaManagerImpl::LuaManagerImpl(lua_State* L):
+	m_UpdatableScriptLuaState(nullptr),
+	m_SyncLuaState(nullptr),
+	m_ThreadSystem(nullptr),
+	m_OwnsThreadSystem(false),
+	m_FreeAsyncLuaStatesCount(0),
+	m_AsyncScriptsInFlight(0),
+	m_GCStepSizeKB(0)
+{
+	memset(m_AsyncLuaStates, 0, MAX_LUA_WORKERS * sizeof(lua_State*));
+}
 
-LuaManagerImpl::LuaManagerImpl(): m_SyncLuaState(nullptr), m_AsyncScriptsCounter(0)
+LuaManagerImpl::LuaManagerImpl(ThreadSystem* pThreadSystem, ScriptCallbackThread callbackThread):
+	m_UpdatableScriptLuaState(nullptr),
+	m_SyncLuaState(nullptr),
+	m_ThreadSystem(pThreadSystem),
+	m_OwnsThreadSystem(false),
+	m_CallbackThread(callbackThread),
+	m_FreeAsyncLuaStatesCount(MAX_LUA_WORKERS),
+	m_AsyncScriptsInFlight(0),
+	m_GCStepSizeKB(0)
 {
 	memset(m_AsyncLuaStates, 0, MAX_LUA_WORKERS * sizeof(lua_State*));
 
 	Register();
-	
-	for (uint32_t i = 0; i <  MAX_LUA_WORKERS; ++i)
-		m_AsyncLuaStatesMutex[i].Init();
-	m_AddAsyncScriptMutex.Init();
+
+	if (m_ThreadSystem == nullptr)
+	{
+		initThreadSystem(&m_ThreadSystem);
+		m_OwnsThreadSystem = true;
+	}
+
+	for (uint32_t i = 0; i < MAX_LUA_WORKERS; ++i)
+		m_FreeAsyncLuaStates[i] = MAX_LUA_WORKERS - 1 - i;
+	m_AsyncScriptsMutex.Init();
+	m_FinishedAsyncScriptsMutex.Init();
+	m_BytecodeCacheMutex.Init();
 }
 
 LuaManagerImpl::~LuaManagerImpl()
 {
+	//async scripts use the registered functions and the lua states released below.
+	//Dispatched callbacks may queue further scripts, so drain until neither scripts nor callbacks are left
+	for (;;)
+	{
+		WaitForAsyncScripts();
+		{
+			MutexLock lock(m_FinishedAsyncScriptsMutex);
+			if (m_FinishedAsyncScripts.empty())
+				break;
+		}
+		DispatchAsyncCallbacks();
+	}
+	if (m_OwnsThreadSystem)
+		shutdownThreadSystem(m_ThreadSystem);
+	m_ThreadSystem = nullptr;
+
 	DestroyLuaState(m_SyncLuaState);
 	m_SyncLuaState = nullptr;
 
@@ -78,10 +267,14 @@ LuaManagerImpl::~LuaManagerImpl()
 		conf_free(m_Functions[i]);
 	}
 
-	for (uint32_t i = 0; i <  MAX_LUA_WORKERS; ++i)
-		m_AsyncLuaStatesMutex[i].Destroy();
-	m_AddAsyncScriptMutex.Destroy();
-	
+	for (eastl::hash_map<eastl::string, LuaBytecode*>::iterator it = m_BytecodeCache.begin(); it != m_BytecodeCache.end(); ++it)
+		conf_delete(it->second);
+	m_BytecodeCache.clear();
+
+	m_AsyncScriptsMutex.Destroy();
+	m_FinishedAsyncScriptsMutex.Destroy();
+	m_BytecodeCacheMutex.Destroy();
+
 	m_registered = false;
 }
 
@@ -94,7 +287,10 @@ void LuaManagerImpl::DestroyLuaState(lua_State* state)
 		lua_pushnil(state);
 		lua_setmetatable(state, -2);
 
+		void* pArena = NULL;
+		lua_getallocf(state, &pArena);
 		lua_close(state);
+		luaArenaDestroy((LuaArena*)pArena);
 	}
 }
 
@@ -115,35 +311,234 @@ static int msghandler(lua_State* L)
 	return 1; /* return the traceback */
 }
 
-const char* luaReaderFunction(lua_State *L, void *ud, size_t *sz)
+//Whole script source. Scripts on the system file system are mapped, others are read into memory in one go.
+struct LuaScriptSource
+{
+	FileMapping mapping;
+	char*       pBuffer;
+	const char* pData;
+	size_t      size;
+};
+
+static void closeScriptSource(LuaScriptSource* pSource)
+{
+	fsUnmapFile(&pSource->mapping);
+	conf_free(pSource->pBuffer);
+	memset(pSource, 0, sizeof(*pSource));
+}
+
+static bool openScriptSource(const Path* scriptPath, LuaScriptSource* pSource)
+{
+	memset(pSource, 0, sizeof(*pSource));
+
+	if (fsGetFileSystemKind(fsGetPathFileSystem(scriptPath)) == FSK_SYSTEM && fsMapFileReadOnly(scriptPath, &pSource->mapping))
+	{
+		pSource->pData = (const char*)pSource->mapping.pData;
+		pSource->size = pSource->mapping.mSize;
+		return true;
+	}
+
+	FileStream* fh = fsOpenFile(scriptPath, FM_READ_BINARY);
+	if (!fh)
+		return false;
+
+	ssize_t size = fsGetStreamFileSize(fh);
+	bool    valid = size >= 0;
+	if (size > 0)
+	{
+		pSource->pBuffer = (char*)conf_malloc((size_t)size);
+		pSource->size = fsReadFromStream(fh, pSource->pBuffer, (size_t)size);
+		pSource->pData = pSource->pBuffer;
+		valid = pSource->size == (size_t)size;
+	}
+	fsCloseStream(fh);
+	//an empty script is an empty chunk
+	if (!pSource->pData)
+		pSource->pData = "";
+	if (!valid)
+		closeScriptSource(pSource);
+	return valid;
+}
+
+//64-bit hash from two independently seeded MurmurHash3 passes, so a changed script is not mistaken for the cached one
+static uint64_t hashScriptData(const void* pData, size_t size)
+{
+	uint32_t hash[2] = {};
+	MurmurHash3_x86_32(pData, (int)size, 0, &hash[0]);
+	MurmurHash3_x86_32(pData, (int)size, 0x9747b28c, &hash[1]);
+	return ((uint64_t)hash[1] << 32) | hash[0];
+}
+
+// Cached bytecode files start with this header so a cache entry is only used for the exact source it was compiled from
+typedef struct LuaBytecodeFileHeader
+{
+	uint64_t mSourceHash;
+	uint64_t mSourceSize;
+} LuaBytecodeFileHeader;
+
+static int luaBytecodeWriter(lua_State* L, const void* p, size_t sz, void* ud)
+{
+	eastl::vector<char>* pBytecode = (eastl::vector<char>*)ud;
+	pBytecode->insert(pBytecode->end(), (const char*)p, (const char*)p + sz);
+	return 0;
+}
+
+//one file per script path, the bytecode embeds the chunk name so scripts with the same source don't share it
+static PathHandle getBytecodeCachePath(const Path* directory, const eastl::string& scriptName)
+{
+	char fileName[32];
+	sprintf(fileName, "%016llx.luac", (unsigned long long)hashScriptData(scriptName.data(), scriptName.size()));
+	return fsAppendPathComponent(directory, fileName);
+}
+
+static bool readBytecodeFile(const Path* cachePath, uint64_t sourceHash, uint32_t sourceSize, eastl::vector<char>& bytecode)
+{
+	if (!fsFileExists(cachePath))
+		return false;
+
+	FileStream* fh = fsOpenFile(cachePath, FM_READ_BINARY);
+	if (!fh)
+		return false;
+
+	LuaBytecodeFileHeader header = {};
+	const ssize_t size = fsGetStreamFileSize(fh);
+	bool valid = size > (ssize_t)sizeof(header) && fsReadFromStream(fh, &header, sizeof(header)) == sizeof(header) &&
+		header.mSourceHash == sourceHash && header.mSourceSize == sourceSize;
+	if (valid)
+	{
+		bytecode.resize(size - sizeof(header));
+		valid = fsReadFromStream(fh, bytecode.data(), bytecode.size()) == bytecode.size();
+	}
+	fsCloseStream(fh);
+
+	if (!valid)
+		bytecode.clear();
+	return valid;
+}
+
+static void writeBytecodeFile(const Path* cachePath, uint64_t sourceHash, uint32_t sourceSize, const eastl::vector<char>& bytecode)
 {
-	FileStream* pHandle = (FileStream*)ud;
-	const size_t size = 1024;
-	static char buffer[size];
-	//*sz = read_file((void*)buffer, size, pHandle);
-	*sz = fsReadFromStream(pHandle, buffer, size);
-	return buffer;
+	FileStream* fh = fsOpenFile(cachePath, FM_WRITE_BINARY);
+	if (!fh)
+	{
+		LOGF(eWARNING, "Can't write Lua bytecode cache %s", fsGetPathAsNativeString(cachePath));
+		return;
+	}
+	LuaBytecodeFileHeader header = { sourceHash, sourceSize };
+	fsWriteToStream(fh, &header, sizeof(header));
+	fsWriteToStream(fh, bytecode.data(), bytecode.size());
+	fsCloseStream(fh);
 }
 
-int RunScriptFile(const Path* scriptPath, lua_State* L)
+//Pushes the main chunk of the script onto the stack. Returns the lua_load status.
+//The source is only compiled when neither the in-memory cache nor the cache directory has bytecode for it.
+int LuaManagerImpl::LoadScriptChunk(const Path* scriptPath, lua_State* state)
 {
-	//int loadfile_error = luaL_loadfile(L, scriptPath);
-	lua_Reader reader = luaReaderFunction;
-    
-    FileStream* fh = fsOpenFile(scriptPath, FM_READ_BINARY);
-    
-    if (!fh)
-    {
-        return false;
-    }
-    
-	int loadfile_error = lua_load(L, reader, fh, NULL, NULL);
-	if (loadfile_error != 0)
+	LuaScriptSource source;
+	if (!openScriptSource(scriptPath, &source))
+	{
+		LOGF(eERROR, "Can't open script %s", fsGetPathAsNativeString(scriptPath));
+		lua_pushfstring(state, "can't open %s", fsGetPathAsNativeString(scriptPath));
+		return LUA_ERRFILE;
+	}
+
+	const uint64_t sourceHash = hashScriptData(source.pData, source.size);
+	const uint32_t sourceSize = (uint32_t)source.size;
+	const eastl::string scriptName = fsGetPathAsNativeString(scriptPath);
+	const eastl::string chunkName = "@" + scriptName;
+
+	{
+		//the entry may be evicted by another thread once the mutex is released, so it is loaded under the lock
+		MutexLock lock(m_BytecodeCacheMutex);
+		eastl::hash_map<eastl::string, LuaBytecode*>::iterator it = m_BytecodeCache.find(scriptName);
+		if (it != m_BytecodeCache.end() && it->second->sourceHash == sourceHash && it->second->sourceSize == sourceSize)
+		{
+			const LuaBytecode* pCached = it->second;
+			if (luaL_loadbufferx(state, pCached->bytecode.data(), pCached->bytecode.size(), chunkName.c_str(), "b") == LUA_OK)
+			{
+				closeScriptSource(&source);
+				return LUA_OK;
+			}
+			lua_pop(state, 1); /* remove error message */
+		}
+	}
+
+	LuaBytecode* pBytecode = conf_new(LuaBytecode);
+	pBytecode->sourceHash = sourceHash;
+	pBytecode->sourceSize = sourceSize;
+
+	PathHandle cachePath = m_BytecodeCacheDirectory ? getBytecodeCachePath(m_BytecodeCacheDirectory, scriptName) : PathHandle();
+	bool       loaded = false;
+	if (cachePath && readBytecodeFile(cachePath, sourceHash, sourceSize, pBytecode->bytecode))
 	{
-		LOGF(eERROR, "Can't load script %s\n", scriptPath);
+		//bytecode written by a different Lua build or a partially written file fails here and is compiled again
+		loaded = luaL_loadbufferx(state, pBytecode->bytecode.data(), pBytecode->bytecode.size(), chunkName.c_str(), "b") == LUA_OK;
+		if (!loaded)
+			lua_pop(state, 1); /* remove error message */
+	}
+
+	bool compiled = false;
+	if (!loaded)
+	{
+		int status = luaL_loadbufferx(state, source.pData, source.size, chunkName.c_str(), NULL);
+		if (status != LUA_OK)
+		{
+			LOGF(eERROR, "Can't load script %s: %s", fsGetPathAsNativeString(scriptPath), lua_tostring(state, -1));
+			closeScriptSource(&source);
+			conf_delete(pBytecode);
+			return status;
+		}
+		pBytecode->bytecode.clear();
+		lua_dump(state, luaBytecodeWriter, &pBytecode->bytecode, 0);
+		compiled = true;
+	}
+	closeScriptSource(&source);
+
+	bool inserted = false;
+	{
+		MutexLock lock(m_BytecodeCacheMutex);
+		eastl::hash_map<eastl::string, LuaBytecode*>::iterator it = m_BytecodeCache.find(scriptName);
+		if (it == m_BytecodeCache.end())
+		{
+			m_BytecodeCache.insert(eastl::make_pair(scriptName, pBytecode));
+			inserted = true;
+		}
+		else if (it->second->sourceHash != sourceHash || it->second->sourceSize != sourceSize)
+		{
+			//the script changed since the entry was added
+			conf_delete(it->second);
+			it->second = pBytecode;
+			inserted = true;
+		}
+	}
+
+	//only the thread that added the entry writes the file, concurrent loads of the same script don't race on it
+	if (inserted && compiled && cachePath)
+		writeBytecodeFile(cachePath, sourceHash, sourceSize, pBytecode->bytecode);
+	if (!inserted)
+		conf_delete(pBytecode);
+
+	return LUA_OK;
+}
+
+void LuaManagerImpl::EvictBytecode(const Path* scriptPath)
+{
+	MutexLock lock(m_BytecodeCacheMutex);
+	eastl::hash_map<eastl::string, LuaBytecode*>::iterator it = m_BytecodeCache.find(fsGetPathAsNativeString(scriptPath));
+	if (it != m_BytecodeCache.end())
+	{
+		conf_delete(it->second);
+		m_BytecodeCache.erase(it);
+	}
+}
+
+bool LuaManagerImpl::RunScriptFile(const Path* scriptPath, lua_State* L)
+{
+	if (LoadScriptChunk(scriptPath, L) != LUA_OK)
+	{
+		lua_pop(L, 1); /* remove error message */
 		return false;
 	}
-    fsCloseStream(fh);
 
 	int status;
 	int narg = 0;
@@ -182,26 +577,15 @@ bool LuaManagerImpl::SetUpdatableScript(const Path* scriptPath, const char* upda
 	m_UpdatableScriptLuaState = CreateLuaState();
 	RegisterLuaManagerForLuaState(m_UpdatableScriptLuaState);
 	RegisterFunctionsForState(m_UpdatableScriptLuaState);
+	if (m_GCStepSizeKB > 0)
+		lua_gc(m_UpdatableScriptLuaState, LUA_GCSTOP, 0);
 
 	m_UpdateFunctonName = updateFunctionName;
     m_UpdatableScriptPath = fsCopyPath(scriptPath);
 	m_UpdatableScriptExitName = exitFunctionName;
-	//int loadfile_error = luaL_loadfile(m_UpdatableScriptLuaState, m_UpdatableScriptName.c_str());
-	lua_Reader reader = luaReaderFunction;
-	//int loadfile_error = lua_load(m_UpdatableScriptLuaState, reader, open_file(scriptPath, "rb"), NULL, NULL);
-    
-    FileStream* fHandle = fsOpenFile(scriptPath, FM_READ_BINARY);
-    if (!fHandle)
-    {
-        return false;
-    }
-    
-	int loadfile_error = lua_load(m_UpdatableScriptLuaState, reader, fHandle, NULL, NULL);
-    fsCloseStream(fHandle);
-    
-	if (loadfile_error != 0)
-	{
-		LOGF(eERROR, "Can't load script %s\n", fsGetPathAsNativeString(scriptPath));
+	if (LoadScriptChunk(scriptPath, m_UpdatableScriptLuaState) != LUA_OK)
+	{
+		lua_pop(m_UpdatableScriptLuaState, 1); /* remove error message */
 		return false;
 	}
 	int narg = 0;
@@ -218,6 +602,8 @@ bool LuaManagerImpl::ReloadUpdatableScript()
 	ASSERT(m_UpdatableScriptPath);
 	if (!m_UpdatableScriptPath)
 		return false;
+	//reloading picks up edits, so don't keep the old bytecode around
+	EvictBytecode(m_UpdatableScriptPath);
 	return SetUpdatableScript(m_UpdatableScriptPath, m_UpdateFunctonName.c_str(), m_UpdatableScriptExitName.c_str());
 }
 
@@ -229,8 +615,30 @@ void LuaManagerImpl::RegisterFunctionsForState(lua_State* state)
 	}
 }
 
+//Lua async mode of the benchmark harness: runs the benchmark script on all async lua states and reports how long
+//the frame's copies took. Scripts the application queued before are waited for as well
+void LuaManagerImpl::RunBenchmarkAsyncScripts()
+{
+	uint32_t    scriptCount = 0;
+	const Path* scriptPath = getBenchmarkLuaAsyncScript(&scriptCount);
+	if (!scriptPath)
+		return;
+
+	const int64_t start = getUSec();
+	for (uint32_t i = 0; i < scriptCount; ++i)
+		AddAsyncScript(scriptPath);
+	WaitForAsyncScripts();
+	setBenchmarkLuaAsyncTime((float)(getUSec() - start) / 1000.0f);
+}
+
 bool LuaManagerImpl::Update(float deltaTime, const char* updateFunctionName)
 {
+	RunBenchmarkAsyncScripts();
+	DispatchAsyncCallbacks();
+
+	if (m_UpdatableScriptLuaState == nullptr)
+		return false;
+
 	int narg = 1;    //we are going to push "deltaTime"
 	int nres = 0;
 	int base = lua_gettop(m_UpdatableScriptLuaState) - narg; /* function index */
@@ -247,30 +655,35 @@ bool LuaManagerImpl::Update(float deltaTime, const char* updateFunctionName)
 	{
 		lua_pushnumber(m_UpdatableScriptLuaState, deltaTime);
 		int status = lua_pcall(m_UpdatableScriptLuaState, narg, nres, base);
+		//LUA_GCSTEP runs even while the collector is stopped
+		if (m_GCStepSizeKB > 0)
+			lua_gc(m_UpdatableScriptLuaState, LUA_GCSTEP, (int)m_GCStepSizeKB);
 		return status == 0;
 	}
 	return false;
 }
 
+void LuaManagerImpl::SetGarbageCollectorStep(uint32_t stepSizeKB)
+{
+	m_GCStepSizeKB = stepSizeKB;
+	if (m_UpdatableScriptLuaState != nullptr)
+		lua_gc(m_UpdatableScriptLuaState, m_GCStepSizeKB > 0 ? LUA_GCSTOP : LUA_GCRESTART, 0);
+}
+
 bool LuaManagerImpl::RunScript(const Path* scriptPath)
 {
-	int status = RunScriptFile(scriptPath, m_SyncLuaState);
-	return status == 0;
+	return RunScriptFile(scriptPath, m_SyncLuaState);
 }
 
-void AsyncScriptExecute(void* pData)
+static void InvokeScriptCallback(ScriptTaskInfo* info)
 {
-	ASSERT(pData != nullptr);
-	ScriptTaskInfo* info = (ScriptTaskInfo*)pData;
-	MutexLock       lock(*(info->mutex));
-	int             status = RunScriptFile(info->scriptPath, info->luaState);
 	if (info->callback)
 	{
-		info->callback(status == 0 ? FINISHED_OK : FINISHED_ERROR);
+		info->callback(info->result);
 	}
 	if (info->callbackLambda)
 	{
-		info->callbackLambda->ExecuteCallback(status == 0 ? FINISHED_OK : FINISHED_ERROR);
+		info->callbackLambda->ExecuteCallback(info->result);
 		info->callbackLambda->~IScriptCallbackWrap();
 		conf_free(info->callbackLambda);
 	}
@@ -279,60 +692,107 @@ void AsyncScriptExecute(void* pData)
 	conf_free(info);
 }
 
-void LuaManagerImpl::AddAsyncScript(const Path* scriptPath, IScriptCallbackWrap* callbackLambda)
+//Runs queued scripts on the lua state stateIndex until the queue is empty, then gives the state back
+void LuaManagerImpl::AsyncScriptTask(size_t stateIndex)
 {
-	ScriptTaskInfo* info = (ScriptTaskInfo*)conf_calloc(1, sizeof(ScriptTaskInfo));
-	info->scriptPath = fsCopyPath(scriptPath);
-	info->callback = nullptr;
+	lua_State* luaState = m_AsyncLuaStates[stateIndex];
+	for (;;)
+	{
+		ScriptTaskInfo* info = nullptr;
+		{
+			MutexLock lock(m_AsyncScriptsMutex);
+			if (m_PendingAsyncScripts.empty())
+			{
+				m_FreeAsyncLuaStates[m_FreeAsyncLuaStatesCount++] = (uint32_t)stateIndex;
+				return;
+			}
+			info = m_PendingAsyncScripts.front();
+			m_PendingAsyncScripts.pop_front();
+		}
 
-	info->callbackLambda = callbackLambda;
+		info->result = RunScriptFile(info->scriptPath, luaState) ? FINISHED_OK : FINISHED_ERROR;
+		//drop whatever the script left on the stack so the state can be reused
+		lua_settop(luaState, 0);
 
-	//ThreadDesc* pItem = (ThreadDesc*)conf_calloc(1, sizeof(*pItem));
+		if (m_CallbackThread == SCRIPT_CALLBACK_UPDATE_THREAD && (info->callback || info->callbackLambda))
+		{
+			MutexLock lock(m_FinishedAsyncScriptsMutex);
+			m_FinishedAsyncScripts.push_back(info);
+		}
+		else
+		{
+			InvokeScriptCallback(info);
+		}
+		//publishes what the script and its callback wrote to WaitForAsyncScripts
+		tfrg_atomic32_add_release(&m_AsyncScriptsInFlight, -1);
+	}
+}
 
-	//pItem->pFunc = AsyncScriptExecute;
-	//pItem->pData = info;
+void LuaManagerImpl::QueueAsyncScript(ScriptTaskInfo* info)
+{
+	tfrg_atomic32_add_relaxed(&m_AsyncScriptsInFlight, 1);
 
+	MutexLock lock(m_AsyncScriptsMutex);
+	m_PendingAsyncScripts.push_back(info);
+	//states are handed out by availability: a busy state picks the script up when it is done with its current one
+	if (m_FreeAsyncLuaStatesCount > 0)
 	{
-		MutexLock lock(m_AddAsyncScriptMutex);
-		info->luaState = m_AsyncLuaStates[m_AsyncScriptsCounter % MAX_LUA_WORKERS];
-		info->mutex = &m_AsyncLuaStatesMutex[m_AsyncScriptsCounter % MAX_LUA_WORKERS];
-		++m_AsyncScriptsCounter;
-
-		//for now we run scripts in synchronous way
-		//m_ThreadPool->AddWorkItem(pItem);
-		AsyncScriptExecute(info);
+		uint32_t stateIndex = m_FreeAsyncLuaStates[--m_FreeAsyncLuaStatesCount];
+		addThreadSystemTask(m_ThreadSystem, memberTaskFunc<LuaManagerImpl, &LuaManagerImpl::AsyncScriptTask>, this, stateIndex);
 	}
 }
 
+void LuaManagerImpl::AddAsyncScript(const Path* scriptPath, IScriptCallbackWrap* callbackLambda)
+{
+	ScriptTaskInfo* info = (ScriptTaskInfo*)conf_calloc(1, sizeof(ScriptTaskInfo));
+	conf_placement_new<ScriptTaskInfo>(info);
+	info->scriptPath = fsCopyPath(scriptPath);
+	info->callback = nullptr;
+	info->callbackLambda = callbackLambda;
+	QueueAsyncScript(info);
+}
+
 void LuaManagerImpl::AddAsyncScript(const Path* scriptPath, ScriptDoneCallback callback)
 {
 	ScriptTaskInfo* info = (ScriptTaskInfo*)conf_calloc(1, sizeof(ScriptTaskInfo));
-    info->scriptPath = fsCopyPath(scriptPath);
+	conf_placement_new<ScriptTaskInfo>(info);
+	info->scriptPath = fsCopyPath(scriptPath);
 	info->callback = callback;
 	info->callbackLambda = nullptr;
-	//ThreadDesc* pItem = (ThreadDesc*)conf_calloc(1, sizeof(*pItem));
+	QueueAsyncScript(info);
+}
 
-	//pItem->pFunc = AsyncScriptExecute;
-	//pItem->pData = info;
+void LuaManagerImpl::AddAsyncScript(const Path* scriptPath)
+{
+	ScriptDoneCallback cb = nullptr;
+	AddAsyncScript(scriptPath, cb);
+}
 
+void LuaManagerImpl::DispatchAsyncCallbacks()
+{
+	eastl::vector<ScriptTaskInfo*> finished;
 	{
-		MutexLock lock(m_AddAsyncScriptMutex);
-		info->luaState = m_AsyncLuaStates[m_AsyncScriptsCounter % MAX_LUA_WORKERS];
-		info->mutex = &m_AsyncLuaStatesMutex[m_AsyncScriptsCounter % MAX_LUA_WORKERS];
-		++m_AsyncScriptsCounter;
-		//m_ThreadPool->AddWorkItem(pItem);
-		AsyncScriptExecute(info);
+		MutexLock lock(m_FinishedAsyncScriptsMutex);
+		finished.swap(m_FinishedAsyncScripts);
 	}
+	//callbacks may queue new scripts, so they are invoked outside of the lock
+	for (size_t i = 0; i < finished.size(); ++i)
+		InvokeScriptCallback(finished[i]);
 }
 
-void LuaManagerImpl::AddAsyncScript(const Path* scriptPath)
+void LuaManagerImpl::WaitForAsyncScripts()
 {
-	ScriptDoneCallback cb = nullptr;
-	AddAsyncScript(scriptPath, cb);
+	while (tfrg_atomic32_load_acquire(&m_AsyncScriptsInFlight))
+		if (!assistThreadSystem(m_ThreadSystem))
+			Thread::Sleep(0);
 }
 
 void LuaManagerImpl::SetFunction(ILuaFunctionWrap* wrap)
 {
+	//m_Functions and the async lua states are used by running async scripts.
+	//Must not be called from an async script or from a callback invoked on a worker.
+	WaitForAsyncScripts();
+
 	//1. Check if function is already registered
 	//Since this shouldn't be called often then just
 	//use string compare. We can implement more fast search if needed
@@ -354,24 +814,20 @@ void LuaManagerImpl::SetFunction(ILuaFunctionWrap* wrap)
 	if (m_UpdatableScriptLuaState != nullptr)
 		Luna<LuaManagerImpl>::RegisterMethod(m_UpdatableScriptLuaState, wrap->functionName.c_str(), (int)m_Functions.size() - 1);
 	for (int i = 0; i < MAX_LUA_WORKERS; ++i)
-	{
-		MutexLock lock(m_AsyncLuaStatesMutex[i]);
 		Luna<LuaManagerImpl>::RegisterMethod(m_AsyncLuaStates[i], wrap->functionName.c_str(), (int)m_Functions.size() - 1);
-	}
 }
 
-//allocate and free function. Used in lua_newstate and in lua_close
-static void* conf_l_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
+void LuaManagerImpl::SetBytecodeCacheDirectory(const Path* directory)
 {
-	(void)ud;
-	(void)osize; /* not used */
-	if (nsize == 0)
+	//running scripts read m_BytecodeCacheDirectory
+	WaitForAsyncScripts();
+
+	m_BytecodeCacheDirectory = directory ? fsCopyPath(directory) : PathHandle();
+	if (m_BytecodeCacheDirectory && !fsDirectoryExists(m_BytecodeCacheDirectory) && !fsCreateDirectory(m_BytecodeCacheDirectory))
 	{
-		conf_free(ptr);
-		return NULL;
+		LOGF(eWARNING, "Can't create Lua bytecode cache directory %s", fsGetPathAsNativeString(m_BytecodeCacheDirectory));
+		m_BytecodeCacheDirectory = PathHandle();
 	}
-	else
-		return conf_realloc(ptr, nsize);
 }
 
 static int l_panic(lua_State* L)
@@ -405,9 +861,12 @@ void LuaManagerImpl::Register()
 
 lua_State* LuaManagerImpl::CreateLuaState()
 {
-	lua_State* lstate = lua_newstate(conf_l_alloc, NULL);
+	LuaArena* pArena = (LuaArena*)conf_calloc(1, sizeof(LuaArena));
+	lua_State* lstate = lua_newstate(conf_l_alloc, pArena);
 	if (lstate)
 		lua_atpanic(lstate, &l_panic);
+	else
+		luaArenaDestroy(pArena);
 	luaL_openlibs(lstate);
 	luaopen_debug(lstate);
 	return lstate;
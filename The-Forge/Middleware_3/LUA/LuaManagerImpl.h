@@ -9,6 +9,8 @@ extern "C"
 
 #include "../../Common_3/ThirdParty/OpenSource/EASTL/string.h"
 #include "../../Common_3/ThirdParty/OpenSource/EASTL/vector.h"
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/deque.h"
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/hash_map.h"
 
 #include "../../Common_3/OS/Interfaces/ILog.h"
 #include "LunaV.hpp"
@@ -16,6 +18,9 @@ extern "C"
 
 #include "../../Common_3/OS/Interfaces/IFileSystem.h"
 #include "../../Common_3/OS/Interfaces/IThread.h"
+#include "../../Common_3/OS/Core/Atomics.h"
+
+struct ThreadSystem;
 
 #define MAX_LUA_WORKERS 4
 
@@ -36,17 +41,24 @@ struct LuaStateWrap: public ILuaStateWrap
 
 struct ScriptTaskInfo
 {
-	lua_State*           luaState;
-	Mutex*               mutex;
-    PathHandle           scriptPath;
+	PathHandle           scriptPath;
 	ScriptDoneCallback   callback;
 	IScriptCallbackWrap* callbackLambda;
+	ScriptState          result;
+};
+
+//Compiled chunk of a script, keyed by the hash of the script source
+struct LuaBytecode
+{
+	uint64_t            sourceHash;
+	uint32_t            sourceSize;
+	eastl::vector<char> bytecode;
 };
 
 class LuaManagerImpl
 {
 	public:
-	LuaManagerImpl();
+	LuaManagerImpl(ThreadSystem* pThreadSystem, ScriptCallbackThread callbackThread);
 	~LuaManagerImpl();
 	bool RunScript(const Path* scriptPath);
 	void AddAsyncScript(const Path* scriptPath, ScriptDoneCallback callback);
@@ -54,6 +66,8 @@ class LuaManagerImpl
 	void AddAsyncScript(const Path* scriptPath, IScriptCallbackWrap* callbackLambda);
 
 	void SetFunction(ILuaFunctionWrap* wrap);
+	void SetBytecodeCacheDirectory(const Path* directory);
+	void SetGarbageCollectorStep(uint32_t stepSizeKB);
 
 	//updateFunctionName - function that will be called on Update()
 	bool SetUpdatableScript(const Path* scriptPath, const char* updateFunctionName, const char* exitFunctionName);
@@ -63,21 +77,40 @@ class LuaManagerImpl
 	//If nullptr then function from SetUpdateScript arg is used.
 	bool Update(float deltaTime, const char* updateFunctionName = nullptr);
 
+	void DispatchAsyncCallbacks();
+	void WaitForAsyncScripts();
+
 
 	private:
 	static bool m_registered;
 	lua_State*  m_UpdatableScriptLuaState;
 	lua_State*  m_SyncLuaState;
 	lua_State*  m_AsyncLuaStates[MAX_LUA_WORKERS];
-	Mutex       m_AsyncLuaStatesMutex[MAX_LUA_WORKERS];
-	Mutex       m_AddAsyncScriptMutex;
+
+	//Async scripts are queued in m_PendingAsyncScripts and drained by one task per
+	//free lua_State. Both the queue and the free list are guarded by m_AsyncScriptsMutex.
+	ThreadSystem*                  m_ThreadSystem;
+	bool                           m_OwnsThreadSystem;
+	ScriptCallbackThread           m_CallbackThread;
+	Mutex                          m_AsyncScriptsMutex;
+	eastl::deque<ScriptTaskInfo*>  m_PendingAsyncScripts;
+	uint32_t                       m_FreeAsyncLuaStates[MAX_LUA_WORKERS];
+	uint32_t                       m_FreeAsyncLuaStatesCount;
+	tfrg_atomic32_t                m_AsyncScriptsInFlight;
+	Mutex                          m_FinishedAsyncScriptsMutex;
+	eastl::vector<ScriptTaskInfo*> m_FinishedAsyncScripts;
+
+	//Keyed by script path. An entry is replaced when its script changes and evicted on reload,
+	//so chunks are loaded from it while holding the mutex
+	Mutex                                        m_BytecodeCacheMutex;
+	eastl::hash_map<eastl::string, LuaBytecode*> m_BytecodeCache;
+	PathHandle                                   m_BytecodeCacheDirectory;
 
 	eastl::vector<ILuaFunctionWrap*> m_Functions;
 	eastl::string                    m_UpdateFunctonName;
     PathHandle                       m_UpdatableScriptPath;
 	eastl::string                    m_UpdatableScriptExitName;
-
-	uint32_t m_AsyncScriptsCounter;
+	uint32_t                         m_GCStepSizeKB;
 
 	void       Register();
 	void       RegisterLuaManagerForLuaState(lua_State* state);
@@ -86,6 +119,12 @@ class LuaManagerImpl
 	void       DestroyLuaState(lua_State* state);
 	void       RegisterFunctionsForState(lua_State* state);
 	void       ExitScript(lua_State* state, const char* exitFunctionName);
+	int        LoadScriptChunk(const Path* scriptPath, lua_State* state);
+	void       EvictBytecode(const Path* scriptPath);
+	bool       RunScriptFile(const Path* scriptPath, lua_State* state);
+	void       QueueAsyncScript(ScriptTaskInfo* info);
+	void       AsyncScriptTask(size_t stateIndex);
+	void       RunBenchmarkAsyncScripts();
 
 	LuaManagerImpl(lua_State* L);
 	static const char                         className[];
@@ -0,0 +1,390 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#include "ParallelPrimitivesCPU.h"
+
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/algorithm.h"
+
+#include "../../Common_3/OS/Interfaces/IThread.h"
+#include "../../Common_3/OS/Core/Atomics.h"
+#include "../../Common_3/OS/Core/ThreadSystem.h"
+#include "../../Common_3/OS/Interfaces/ILog.h"
+
+#if defined(_M_X64) || defined(__x86_64__) || defined(__SSE2__)
+#include <emmintrin.h>
+#define PARALLEL_PRIMITIVES_SSE2 1
+#else
+#define PARALLEL_PRIMITIVES_SSE2 0
+#endif
+
+#include "../../Common_3/OS/Interfaces/IMemory.h"
+
+struct BlockTask {
+	void (*pFunc)(void* user, uintptr_t block);
+	void* pUser;
+	tfrg_atomic32_t mRemaining;
+};
+
+static void blockTaskFunc(void* user, uintptr_t block) {
+	BlockTask* task = (BlockTask*)user;
+	task->pFunc(task->pUser, block);
+	tfrg_atomic32_add_release(&task->mRemaining, -1);
+}
+
+static uint32_t sumRange(const uint32_t* input, uint32_t count) {
+	uint32_t i = 0;
+	uint32_t sum = 0;
+#if PARALLEL_PRIMITIVES_SSE2
+	__m128i sum4 = _mm_setzero_si128();
+	for (; i + 4 <= count; i += 4) {
+		sum4 = _mm_add_epi32(sum4, _mm_loadu_si128((const __m128i*)(input + i)));
+	}
+	sum4 = _mm_add_epi32(sum4, _mm_shuffle_epi32(sum4, _MM_SHUFFLE(1, 0, 3, 2)));
+	sum4 = _mm_add_epi32(sum4, _mm_shuffle_epi32(sum4, _MM_SHUFFLE(2, 3, 0, 1)));
+	sum = (uint32_t)_mm_cvtsi128_si32(sum4);
+#endif
+	for (; i < count; i += 1) {
+		sum += input[i];
+	}
+	return sum;
+}
+
+// Exclusive scan of one range starting from carry, input and output may alias.
+static void scanRange(const uint32_t* input, uint32_t* output, uint32_t count, uint32_t carry) {
+	uint32_t i = 0;
+#if PARALLEL_PRIMITIVES_SSE2
+	__m128i carry4 = _mm_set1_epi32((int)carry);
+	for (; i + 4 <= count; i += 4) {
+		__m128i x = _mm_loadu_si128((const __m128i*)(input + i));
+		__m128i inclusive = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+		inclusive = _mm_add_epi32(inclusive, _mm_slli_si128(inclusive, 8));
+		_mm_storeu_si128((__m128i*)(output + i), _mm_add_epi32(carry4, _mm_sub_epi32(inclusive, x)));
+		carry4 = _mm_add_epi32(carry4, _mm_shuffle_epi32(inclusive, _MM_SHUFFLE(3, 3, 3, 3)));
+	}
+	carry = (uint32_t)_mm_cvtsi128_si32(carry4);
+#endif
+	for (; i < count; i += 1) {
+		uint32_t value = input[i];
+		output[i] = carry;
+		carry += value;
+	}
+}
+
+struct ScanArgs {
+	const uint32_t* pInput;
+	uint32_t* pOutput;
+	uint32_t* pBlockSums;
+	uint32_t mElementCount;
+	uint32_t mBlockSize;
+};
+
+static void scanSumBlock(void* user, uintptr_t block) {
+	ScanArgs* args = (ScanArgs*)user;
+	uint32_t start = (uint32_t)block * args->mBlockSize;
+	uint32_t count = eastl::min(args->mBlockSize, args->mElementCount - start);
+	args->pBlockSums[block] = sumRange(args->pInput + start, count);
+}
+
+static void scanBlock(void* user, uintptr_t block) {
+	ScanArgs* args = (ScanArgs*)user;
+	uint32_t start = (uint32_t)block * args->mBlockSize;
+	uint32_t count = eastl::min(args->mBlockSize, args->mElementCount - start);
+	scanRange(args->pInput + start, args->pOutput + start, count, args->pBlockSums[block]);
+}
+
+struct RadixPass {
+	const uint32_t* pFromKeys;
+	const uint32_t* pFromValues;
+	uint32_t* pToKeys;
+	uint32_t* pToValues;
+	uint32_t* pBlockCounts;
+	uint32_t mElementCount;
+	uint32_t mBlockSize;
+	uint32_t mShift;
+};
+
+static void radixHistogramBlock(void* user, uintptr_t block) {
+	RadixPass* pass = (RadixPass*)user;
+	uint32_t start = (uint32_t)block * pass->mBlockSize;
+	uint32_t end = eastl::min(start + pass->mBlockSize, pass->mElementCount);
+	uint32_t* counts = pass->pBlockCounts + block * ParallelPrimitivesCPU::radixBucketCount;
+	const uint32_t shift = pass->mShift;
+	
+	memset(counts, 0, sizeof(uint32_t) * ParallelPrimitivesCPU::radixBucketCount);
+	for (uint32_t i = start; i < end; i += 1) {
+		counts[(pass->pFromKeys[i] >> shift) & (ParallelPrimitivesCPU::radixBucketCount - 1)] += 1;
+	}
+}
+
+static void radixScatterBlock(void* user, uintptr_t block) {
+	RadixPass* pass = (RadixPass*)user;
+	uint32_t start = (uint32_t)block * pass->mBlockSize;
+	uint32_t end = eastl::min(start + pass->mBlockSize, pass->mElementCount);
+	uint32_t offsets[ParallelPrimitivesCPU::radixBucketCount];
+	memcpy(offsets, pass->pBlockCounts + block * ParallelPrimitivesCPU::radixBucketCount, sizeof(offsets));
+	const uint32_t shift = pass->mShift;
+	
+	if (pass->pFromValues) {
+		for (uint32_t i = start; i < end; i += 1) {
+			uint32_t key = pass->pFromKeys[i];
+			uint32_t dst = offsets[(key >> shift) & (ParallelPrimitivesCPU::radixBucketCount - 1)]++;
+			pass->pToKeys[dst] = key;
+			pass->pToValues[dst] = pass->pFromValues[i];
+		}
+	} else {
+		for (uint32_t i = start; i < end; i += 1) {
+			uint32_t key = pass->pFromKeys[i];
+			pass->pToKeys[offsets[(key >> shift) & (ParallelPrimitivesCPU::radixBucketCount - 1)]++] = key;
+		}
+	}
+}
+
+struct OffsetBufferArgs {
+	const uint32_t* pSortedIndices;
+	uint32_t* pOffsetBuffer;
+	uint32_t mSortedIndicesCount;
+	uint32_t mCategoryCount;
+	uint32_t mBlockSize;
+};
+
+static void offsetBufferBlock(void* user, uintptr_t block) {
+	OffsetBufferArgs* args = (OffsetBufferArgs*)user;
+	// Boundaries are visited as (sortedIndices[i - 1], sortedIndices[i]) for i in [1, count], same as the GPU threads.
+	// Two boundaries never write different values to the same category, so blocks don't need to synchronize.
+	uint32_t start = 1 + (uint32_t)block * args->mBlockSize;
+	uint32_t end = eastl::min(start + args->mBlockSize, args->mSortedIndicesCount + 1);
+	const uint32_t categoryCount = args->mCategoryCount;
+	
+	for (uint32_t i = start; i < end; i += 1) {
+		uint32_t previousIndex = args->pSortedIndices[i - 1];
+		uint32_t currentIndex = i == args->mSortedIndicesCount ? categoryCount : args->pSortedIndices[i];
+		
+		if (previousIndex < currentIndex && previousIndex + 1 < categoryCount) {
+			args->pOffsetBuffer[previousIndex + 1] = i;
+			
+			if (currentIndex < categoryCount) {
+				args->pOffsetBuffer[currentIndex] = i;
+			}
+		}
+	}
+}
+
+ParallelPrimitivesCPU::ParallelPrimitivesCPU(ThreadSystem* threadSystem) : pThreadSystem(threadSystem), mMaxBlockCount(1) {
+	if (pThreadSystem) {
+		mMaxBlockCount = eastl::max(Thread::GetNumCPUCores(), 1u);
+	}
+}
+
+ParallelPrimitivesCPU::~ParallelPrimitivesCPU() {
+	mTemporaryKeys.set_capacity(0);
+	mTemporaryValues.set_capacity(0);
+	mBlockData.set_capacity(0);
+}
+
+uint32_t ParallelPrimitivesCPU::blockCount(uint32_t elementCount) const {
+	uint32_t count = (elementCount + ParallelPrimitivesCPU::minElementsPerBlock - 1) / ParallelPrimitivesCPU::minElementsPerBlock;
+	return eastl::max(eastl::min(count, mMaxBlockCount), 1u);
+}
+
+void ParallelPrimitivesCPU::runBlocks(void (*func)(void* user, uintptr_t block), void* user, uint32_t count) {
+	if (!pThreadSystem || count <= 1) {
+		for (uint32_t i = 0; i < count; i += 1) {
+			func(user, i);
+		}
+		return;
+	}
+	
+	BlockTask task = { func, user, count };
+	addThreadSystemRangeTask(pThreadSystem, blockTaskFunc, &task, count);
+	
+	// Help with the queue instead of waiting for the whole thread system to go idle, it may be busy with unrelated work.
+	while (tfrg_atomic32_load_acquire(&task.mRemaining)) {
+		if (!assistThreadSystem(pThreadSystem)) {
+			Thread::Sleep(0);
+		}
+	}
+}
+
+void ParallelPrimitivesCPU::scanExclusiveAdd(const uint32_t* input, uint32_t* output, uint32_t elementCount) {
+	if (elementCount == 0) {
+		return;
+	}
+	
+	uint32_t blocks = blockCount(elementCount);
+	if (blocks == 1) {
+		scanRange(input, output, elementCount, 0);
+		return;
+	}
+	
+	// Keep block boundaries on whole SIMD vectors.
+	uint32_t blockSize = (((elementCount + blocks - 1) / blocks) + 3) & ~3u;
+	blocks = (elementCount + blockSize - 1) / blockSize;
+	mBlockData.resize(blocks);
+	
+	ScanArgs args = { input, output, mBlockData.data(), elementCount, blockSize };
+	runBlocks(scanSumBlock, &args, blocks);
+	scanRange(args.pBlockSums, args.pBlockSums, blocks, 0);
+	runBlocks(scanBlock, &args, blocks);
+}
+
+void ParallelPrimitivesCPU::sortRadixInternal(const uint32_t* inputKeys, const uint32_t* inputValues, uint32_t* outputKeys, uint32_t* outputValues, uint32_t elementCount, uint32_t maxKey) {
+	if (elementCount == 0) {
+		return;
+	}
+	
+	uint32_t keyBits = 0;
+	while (keyBits < 32 && (maxKey >> keyBits)) {
+		keyBits += 1;
+	}
+	uint32_t passCount = (keyBits + ParallelPrimitivesCPU::radixBits - 1) / ParallelPrimitivesCPU::radixBits;
+	
+	uint32_t blocks = blockCount(elementCount);
+	uint32_t blockSize = (elementCount + blocks - 1) / blocks;
+	blocks = (elementCount + blockSize - 1) / blockSize;
+	
+	mBlockData.resize(blocks * ParallelPrimitivesCPU::radixBucketCount);
+	mTemporaryKeys.resize(elementCount);
+	if (inputValues) {
+		mTemporaryValues.resize(elementCount);
+	}
+	
+	RadixPass pass = {};
+	pass.pFromKeys = inputKeys;
+	pass.pFromValues = inputValues;
+	pass.pBlockCounts = mBlockData.data();
+	pass.mElementCount = elementCount;
+	pass.mBlockSize = blockSize;
+	
+	// Ping-pong so the last pass lands in the output, unless the input aliases it and the first pass can't write there.
+	bool aliased = inputKeys == outputKeys || (inputValues && inputValues == outputValues);
+	bool toOutput = !aliased && (passCount % 2 == 1);
+	
+	for (uint32_t digit = 0; digit < passCount; digit += 1) {
+		pass.mShift = digit * ParallelPrimitivesCPU::radixBits;
+		runBlocks(radixHistogramBlock, &pass, blocks);
+		
+		// Turn per block counts into scatter offsets, ordered by digit then block to keep the sort stable.
+		uint32_t offset = 0;
+		bool singleDigit = false;
+		for (uint32_t bucket = 0; bucket < ParallelPrimitivesCPU::radixBucketCount; bucket += 1) {
+			uint32_t bucketStart = offset;
+			for (uint32_t block = 0; block < blocks; block += 1) {
+				uint32_t* count = &pass.pBlockCounts[block * ParallelPrimitivesCPU::radixBucketCount + bucket];
+				uint32_t bucketCount = *count;
+				*count = offset;
+				offset += bucketCount;
+			}
+			singleDigit = singleDigit || (offset - bucketStart == elementCount);
+		}
+		
+		// All keys share this digit, the scatter would be an identity permutation.
+		if (singleDigit) {
+			continue;
+		}
+		
+		pass.pToKeys = toOutput ? outputKeys : mTemporaryKeys.data();
+		pass.pToValues = inputValues ? (toOutput ? outputValues : mTemporaryValues.data()) : NULL;
+		runBlocks(radixScatterBlock, &pass, blocks);
+		
+		pass.pFromKeys = pass.pToKeys;
+		pass.pFromValues = pass.pToValues;
+		toOutput = !toOutput;
+	}
+	
+	if (pass.pFromKeys != outputKeys) {
+		memcpy(outputKeys, pass.pFromKeys, sizeof(uint32_t) * elementCount);
+	}
+	if (inputValues && pass.pFromValues != outputValues) {
+		memcpy(outputValues, pass.pFromValues, sizeof(uint32_t) * elementCount);
+	}
+}
+
+void ParallelPrimitivesCPU::sortRadix(const uint32_t* inputKeys, uint32_t* outputKeys, uint32_t elementCount, uint32_t maxKey) {
+	sortRadixInternal(inputKeys, NULL, outputKeys, NULL, elementCount, maxKey);
+}
+
+void ParallelPrimitivesCPU::sortRadixKeysValues(const uint32_t* inputKeys, const uint32_t* inputValues, uint32_t* outputKeys, uint32_t* outputValues, uint32_t elementCount, uint32_t maxKey) {
+	ASSERT(inputValues && outputValues);
+	sortRadixInternal(inputKeys, inputValues, outputKeys, outputValues, elementCount, maxKey);
+}
+
+void ParallelPrimitivesCPU::generateOffsetBuffer(const uint32_t* sortedCategoryIndices, uint32_t* outputBuffer, uint32_t* totalCountOutputBuffer, uint32_t sortedIndicesCount, uint32_t categoryCount, uint32_t indirectThreadsPerThreadgroup) {
+	ASSERT(categoryCount > 0);
+	ASSERT(indirectThreadsPerThreadgroup > 0);
+	
+	memset(outputBuffer, 0xFF, sizeof(uint32_t) * categoryCount);
+	
+	if (sortedIndicesCount == 0) {
+		memset(totalCountOutputBuffer, 0, sizeof(uint32_t) * 4);
+		return;
+	}
+	
+	uint32_t blocks = blockCount(sortedIndicesCount);
+	uint32_t blockSize = (sortedIndicesCount + blocks - 1) / blocks;
+	blocks = (sortedIndicesCount + blockSize - 1) / blockSize;
+	
+	OffsetBufferArgs args = { sortedCategoryIndices, outputBuffer, sortedIndicesCount, categoryCount, blockSize };
+	runBlocks(offsetBufferBlock, &args, blocks);
+	
+	outputBuffer[0] = 0;
+	if (sortedCategoryIndices[0] < categoryCount) {
+		outputBuffer[sortedCategoryIndices[0]] = 0;
+	}
+	
+	// Indices at or past categoryCount are inactive and sorted to the end.
+	const uint32_t* firstInactive = eastl::lower_bound(sortedCategoryIndices, sortedCategoryIndices + sortedIndicesCount, categoryCount);
+	uint32_t activeCount = (uint32_t)(firstInactive - sortedCategoryIndices);
+	uint32_t threadgroupsX = (activeCount + indirectThreadsPerThreadgroup - 1) / indirectThreadsPerThreadgroup;
+	totalCountOutputBuffer[0] = activeCount;
+	totalCountOutputBuffer[1] = eastl::max(1u, threadgroupsX);
+	totalCountOutputBuffer[2] = 1;
+	totalCountOutputBuffer[3] = 1;
+}
+
+void ParallelPrimitivesCPU::generateIndirectArgumentsFromOffsetBuffer(const uint32_t* offsetBuffer, const uint32_t* activeIndexCountBuffer, uint32_t* outIndirectArgumentsBuffer, uint32_t categoryCount, uint32_t indirectThreadsPerThreadgroup) {
+	ASSERT(indirectThreadsPerThreadgroup > 0);
+	
+	const uint32_t totalIndexCount = activeIndexCountBuffer[0];
+	for (uint32_t categoryIndex = 0; categoryIndex < categoryCount; categoryIndex += 1) {
+		uint32_t threadIndexLowerBound = offsetBuffer[categoryIndex];
+		uint32_t threadIndexUpperBound;
+		if (threadIndexLowerBound == UINT32_MAX) {
+			threadIndexUpperBound = threadIndexLowerBound;
+		} else {
+			threadIndexUpperBound = (categoryIndex + 1 >= categoryCount) ? totalIndexCount : offsetBuffer[categoryIndex + 1];
+			if (threadIndexUpperBound == UINT32_MAX) {
+				threadIndexUpperBound = threadIndexLowerBound;
+			}
+		}
+		
+		uint32_t count = threadIndexUpperBound - threadIndexLowerBound;
+		
+		uint32_t* output = &outIndirectArgumentsBuffer[8 * categoryIndex];
+		output[0] = threadIndexLowerBound;
+		output[1] = count;
+		output[2] = (count + indirectThreadsPerThreadgroup - 1) / indirectThreadsPerThreadgroup;
+		output[3] = 1;
+		output[4] = 1;
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2018-2020 The Forge Interactive Inc.
+ *
+ * This file is part of The-Forge
+ * (see https://github.com/ConfettiFX/The-Forge).
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+*/
+
+#pragma once
+
+#include "../../Common_3/ThirdParty/OpenSource/EASTL/vector.h"
+
+struct ThreadSystem;
+
+// Host memory counterpart of ParallelPrimitives for headless and server builds.
+// Every primitive produces the same output as the GPU kernels (the radix sort is stable, the offset buffer and
+// indirect arguments use the same layout and sentinel values), so results can be compared against a GPU readback.
+// Work is split into blocks that run on the given thread system; the calling thread helps out until its own blocks
+// are done, so it must not be called from a task running on the same thread system. Without a thread system
+// everything runs on the calling thread.
+struct ParallelPrimitivesCPU {
+public:
+	static const uint32_t minElementsPerBlock = 16 * 1024;
+	static const uint32_t radixBits = 8;
+	static const uint32_t radixBucketCount = 1 << radixBits;
+
+	ParallelPrimitivesCPU(ThreadSystem* pThreadSystem = NULL);
+	~ParallelPrimitivesCPU();
+
+	// input and output may alias.
+	void scanExclusiveAdd(const uint32_t* input, uint32_t* output, uint32_t elementCount);
+	// Inputs may alias the outputs.
+	void sortRadix(const uint32_t* inputKeys, uint32_t* outputKeys, uint32_t elementCount, uint32_t maxKey = ~0u);
+	void sortRadixKeysValues(const uint32_t* inputKeys, const uint32_t* inputValues, uint32_t* outputKeys, uint32_t* outputValues, uint32_t elementCount, uint32_t maxKey = ~0u);
+
+	// outputBuffer holds categoryCount offsets (~0 for categories that never start a range), totalCountOutputBuffer
+	// holds four uints: the number of indices below categoryCount and the matching dispatch size.
+	void generateOffsetBuffer(const uint32_t* sortedCategoryIndices, uint32_t* outputBuffer, uint32_t* totalCountOutputBuffer, uint32_t sortedIndicesCount, uint32_t categoryCount, uint32_t indirectThreadsPerThreadgroup);
+
+	// Writes offset, count and threadgroups X/Y/Z per category with a stride of eight uints.
+	void generateIndirectArgumentsFromOffsetBuffer(const uint32_t* offsetBuffer, const uint32_t* activeIndexCountBuffer, uint32_t* outIndirectArgumentsBuffer, uint32_t categoryCount, uint32_t indirectThreadsPerThreadgroup);
+
+private:
+	ThreadSystem* pThreadSystem;
+	uint32_t mMaxBlockCount;
+
+	eastl::vector<uint32_t> mTemporaryKeys;
+	eastl::vector<uint32_t> mTemporaryValues;
+	eastl::vector<uint32_t> mBlockData;
+
+	uint32_t blockCount(uint32_t elementCount) const;
+	void runBlocks(void (*func)(void* user, uintptr_t block), void* user, uint32_t count);
+	void sortRadixInternal(const uint32_t* inputKeys, const uint32_t* inputValues, uint32_t* outputKeys, uint32_t* outputValues, uint32_t elementCount, uint32_t maxKey);
+};
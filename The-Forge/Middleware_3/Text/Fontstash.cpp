@@ -50,6 +50,10 @@
 
 ResourceDirectory RD_MIDDLEWARE_TEXT = RD_MIDDLEWARE_0;
 
+// Bound for every text draw so hash the names at compile time
+static constexpr DescriptorName UNIFORM_BLOCK_NAME("uniformBlock_rootcbv");
+static constexpr DescriptorName ROOT_CONSTANTS_NAME("uRootConstants");
+
 class _Impl_FontStash
 {
 public:
@@ -553,13 +557,13 @@ void _Impl_FontStash::fonsImplementationRenderText(
 		const uint32_t stride = sizeof(float4);
 
 		DescriptorData params[1] = {};
-		params[0].pName = "uniformBlock_rootcbv";
+		params[0].pName = UNIFORM_BLOCK_NAME;
 		params[0].ppBuffers = &uniformBlock.pBuffer;
 		params[0].pOffsets = &uniformBlock.mOffset;
 		params[0].pSizes = &size;
 		updateDescriptorSet(ctx->pRenderer, pipelineIndex, ctx->pDescriptorSets, 1, params);
 		cmdBindDescriptorSet(pCmd, pipelineIndex, ctx->pDescriptorSets);
-		cmdBindPushConstants(pCmd, ctx->pRootSignature, "uRootConstants", &data);
+		cmdBindPushConstants(pCmd, ctx->pRootSignature, ROOT_CONSTANTS_NAME, &data);
 		cmdBindVertexBuffer(pCmd, 1, &buffer.pBuffer, &stride, &buffer.mOffset);
 		cmdDraw(pCmd, nverts, 0);
 	}
@@ -567,7 +571,7 @@ void _Impl_FontStash::fonsImplementationRenderText(
 	{
 		const uint32_t stride = sizeof(float4);
 		cmdBindDescriptorSet(pCmd, pipelineIndex, ctx->pDescriptorSets);
-		cmdBindPushConstants(pCmd, ctx->pRootSignature, "uRootConstants", &data);
+		cmdBindPushConstants(pCmd, ctx->pRootSignature, ROOT_CONSTANTS_NAME, &data);
 		cmdBindVertexBuffer(pCmd, 1, &buffer.pBuffer, &stride, &buffer.mOffset);
 		cmdDraw(pCmd, nverts, 0);
 	}
@@ -46,6 +46,7 @@ extern void initGUIDriver(Renderer* pRenderer, GUIDriver** ppDriver);
 extern void removeGUIDriver(GUIDriver* pDriver);
 
 static TextDrawDesc       gDefaultTextDrawDesc = TextDrawDesc(0, 0xffffffff, 16);
+static constexpr DescriptorName ROOT_CONSTANTS_NAME("uRootConstants");
 
 static void CloneCallbacks(IWidget* pSrc, IWidget* pDst)
 {
@@ -823,7 +824,7 @@ void VirtualJoystickUI::Draw(Cmd* pCmd, const float4& color)
 	cmdBindDescriptorSet(pCmd, 0, pDescriptorSet);
 	data.color = color;
 	data.scaleBias = { 2.0f / (float)mRenderSize[0], -2.0f / (float)mRenderSize[1] };
-	cmdBindPushConstants(pCmd, pRootSignature, "uRootConstants", &data);
+	cmdBindPushConstants(pCmd, pRootSignature, ROOT_CONSTANTS_NAME, &data);
 
 	// Draw the camera controller's virtual joysticks.
 	float extSide = mOutsideRadius;
@@ -237,6 +237,7 @@ class ImguiGUIDriver: public GUIDriver
 	static void dealloc_func(void* ptr, void* user_data) { conf_free(ptr); }
 
 	protected:
+	void addGeometryBuffer(uint32_t frame, bool index, uint64_t size);
 	static const uint32_t MAX_FRAMES = 3;
 	ImGuiContext*           context;
 	eastl::vector<Texture*>  mFontTextures;
@@ -249,9 +250,15 @@ class ImguiGUIDriver: public GUIDriver
 	DescriptorSet*     pDescriptorSetUniforms;
 	DescriptorSet*     pDescriptorSetTexture;
 	Pipeline*          pPipelineTextured;
-	Buffer*            pVertexBuffer;
-	Buffer*            pIndexBuffer;
+	/// One vertex / index buffer per frame in flight, grown when the UI outgrows them
+	Buffer*            pVertexBuffer[MAX_FRAMES];
+	Buffer*            pIndexBuffer[MAX_FRAMES];
 	Buffer*            pUniformBuffer[MAX_FRAMES];
+	/// Hash of the last drawn UI and its generation, bumped whenever the hash changes
+	uint64_t           mDrawHash;
+	uint64_t           mDrawGeneration;
+	/// Generation of the UI the buffers and dynamic descriptor sets of each frame hold, 0 if they need a refresh
+	uint64_t           mFrameGeneration[MAX_FRAMES];
 	/// Default states
 	Sampler*         pDefaultSampler;
 	VertexLayout     mVertexLayoutTextured = {};
@@ -266,8 +273,11 @@ class ImguiGUIDriver: public GUIDriver
 	bool             mCustomShader;
 };
 
+// Initial size of the per frame buffers
 static const uint64_t VERTEX_BUFFER_SIZE = 1024 * 64 * sizeof(ImDrawVert);
 static const uint64_t INDEX_BUFFER_SIZE = 128 * 1024 * sizeof(ImDrawIdx);
+// Bound per draw command for user textures so hash the name at compile time
+static constexpr DescriptorName TEXTURE_NAME("uTex");
 
 void initGUIDriver(Renderer* pRenderer, GUIDriver** ppDriver)
 {
@@ -709,6 +719,9 @@ bool ImguiGUIDriver::init(Renderer* renderer, uint32_t const maxDynamicUIUpdates
 	pRenderer = renderer;
 	mMaxDynamicUIUpdatesPerBatch = maxDynamicUIUpdatesPerBatch;
 	mActive = true;
+	mDrawHash = 0;
+	mDrawGeneration = 1;
+	memset(mFrameGeneration, 0, sizeof(mFrameGeneration));
 	/************************************************************************/
 	// Rendering resources
 	/************************************************************************/
@@ -752,19 +765,11 @@ bool ImguiGUIDriver::init(Renderer* renderer, uint32_t const maxDynamicUIUpdates
 	setDesc = { pRootSignatureTextured, DESCRIPTOR_UPDATE_FREQ_NONE, MAX_FRAMES };
 	addDescriptorSet(pRenderer, &setDesc, &pDescriptorSetUniforms);
 
-	BufferLoadDesc vbDesc = {};
-	vbDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_VERTEX_BUFFER;
-	vbDesc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
-	vbDesc.mDesc.mSize = VERTEX_BUFFER_SIZE * MAX_FRAMES;
-	vbDesc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
-	vbDesc.ppBuffer = &pVertexBuffer;
-	addResource(&vbDesc, NULL, LOAD_PRIORITY_NORMAL);
-
-	BufferLoadDesc ibDesc = vbDesc;
-	ibDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_INDEX_BUFFER;
-	ibDesc.mDesc.mSize = INDEX_BUFFER_SIZE * MAX_FRAMES;
-	ibDesc.ppBuffer = &pIndexBuffer;
-	addResource(&ibDesc, NULL, LOAD_PRIORITY_NORMAL);
+	for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+	{
+		addGeometryBuffer(i, false, VERTEX_BUFFER_SIZE);
+		addGeometryBuffer(i, true, INDEX_BUFFER_SIZE);
+	}
 
 	BufferLoadDesc ubDesc = {};
 	ubDesc.mDesc.mDescriptors = DESCRIPTOR_TYPE_UNIFORM_BUFFER;
@@ -829,10 +834,12 @@ void ImguiGUIDriver::exit()
 	removeDescriptorSet(pRenderer, pDescriptorSetTexture);
 	removeDescriptorSet(pRenderer, pDescriptorSetUniforms);
 	removeRootSignature(pRenderer, pRootSignatureTextured);
-	removeResource(pVertexBuffer);
-	removeResource(pIndexBuffer);
 	for (uint32_t i = 0; i < MAX_FRAMES; ++i)
+	{
+		removeResource(pVertexBuffer[i]);
+		removeResource(pIndexBuffer[i]);
 		removeResource(pUniformBuffer[i]);
+	}
 
 	for (Texture*& pFontTexture : mFontTextures)
 		removeResource(pFontTexture);
@@ -1084,6 +1091,35 @@ bool ImguiGUIDriver::update(GUIUpdate* pGuiUpdate)
 	return ret;
 }
 
+// Word at a time FNV-1a variant. Reading the cached ImGui buffers is much cheaper than writing the write-combined
+// geometry buffers, so hashing them first pays off whenever the UI did not change
+static uint64_t hashDrawData(const void* pData, size_t size, uint64_t hash)
+{
+	const uint8_t* pBytes = (const uint8_t*)pData;
+	for (; size >= sizeof(uint64_t); size -= sizeof(uint64_t), pBytes += sizeof(uint64_t))
+	{
+		uint64_t word;
+		memcpy(&word, pBytes, sizeof(word));
+		hash = (hash ^ word) * 0x100000001b3ull;
+		hash ^= hash >> 29;
+	}
+	for (; size; --size, ++pBytes)
+		hash = (hash ^ *pBytes) * 0x100000001b3ull;
+	return hash;
+}
+
+void ImguiGUIDriver::addGeometryBuffer(uint32_t frame, bool index, uint64_t size)
+{
+	BufferLoadDesc desc = {};
+	desc.mDesc.mDescriptors = index ? DESCRIPTOR_TYPE_INDEX_BUFFER : DESCRIPTOR_TYPE_VERTEX_BUFFER;
+	desc.mDesc.mMemoryUsage = RESOURCE_MEMORY_USAGE_CPU_TO_GPU;
+	desc.mDesc.mSize = size;
+	desc.mDesc.mFlags = BUFFER_CREATION_FLAG_PERSISTENT_MAP_BIT | BUFFER_CREATION_FLAG_OWN_MEMORY_BIT;
+	desc.ppBuffer = index ? &pIndexBuffer[frame] : &pVertexBuffer[frame];
+	addResource(&desc, NULL, LOAD_PRIORITY_NORMAL);
+	mFrameGeneration[frame] = 0;
+}
+
 void ImguiGUIDriver::draw(Cmd* pCmd)
 {
 	/************************************************************************/
@@ -1096,55 +1132,94 @@ void ImguiGUIDriver::draw(Cmd* pCmd)
 
 	Pipeline*            pPipeline = pPipelineTextured;
 
-	uint32_t vSize = 0;
-	uint32_t iSize = 0;
+	// Everything the uploads and the dynamic descriptor sets depend on goes into the hash, field by field since
+	// ImDrawCmd has padding
+	uint64_t vSize = 0;
+	uint64_t iSize = 0;
+	const float display[4] = { draw_data->DisplayPos.x, draw_data->DisplayPos.y, draw_data->DisplaySize.x, draw_data->DisplaySize.y };
+	uint64_t hash = hashDrawData(display, sizeof(display), 0xcbf29ce484222325ull);
+	hash = hashDrawData(&draw_data->CmdListsCount, sizeof(draw_data->CmdListsCount), hash);
 	for (int n = 0; n < draw_data->CmdListsCount; n++)
 	{
 		const ImDrawList* cmd_list = draw_data->CmdLists[n];
-		vSize += (int)(cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		iSize += (int)(cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+		vSize += cmd_list->VtxBuffer.size() * sizeof(ImDrawVert);
+		iSize += cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx);
+
+		const int counts[3] = { cmd_list->VtxBuffer.size(), cmd_list->IdxBuffer.size(), cmd_list->CmdBuffer.size() };
+		hash = hashDrawData(counts, sizeof(counts), hash);
+		for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.size(); cmd_i++)
+		{
+			const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+			hash = hashDrawData(&pcmd->ElemCount, sizeof(pcmd->ElemCount), hash);
+			hash = hashDrawData(&pcmd->ClipRect, sizeof(pcmd->ClipRect), hash);
+			hash = hashDrawData(&pcmd->TextureId, sizeof(pcmd->TextureId), hash);
+			hash = hashDrawData(&pcmd->UserCallback, sizeof(pcmd->UserCallback), hash);
+			hash = hashDrawData(&pcmd->UserCallbackData, sizeof(pcmd->UserCallbackData), hash);
+		}
+		hash = hashDrawData(cmd_list->VtxBuffer.data(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert), hash);
+		hash = hashDrawData(cmd_list->IdxBuffer.data(), cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx), hash);
+	}
+	if (hash != mDrawHash)
+	{
+		mDrawHash = hash;
+		++mDrawGeneration;
 	}
 
-	vSize = min<uint32_t>(vSize, VERTEX_BUFFER_SIZE);
-	iSize = min<uint32_t>(iSize, INDEX_BUFFER_SIZE);
+	// The buffers of this frame were last read by the GPU MAX_FRAMES frames ago, so they can be replaced right away
+	if (vSize > pVertexBuffer[frameIdx]->mSize)
+	{
+		uint64_t size = max(vSize, (uint64_t)pVertexBuffer[frameIdx]->mSize * 2);
+		removeResource(pVertexBuffer[frameIdx]);
+		addGeometryBuffer(frameIdx, false, size);
+	}
+	if (iSize > pIndexBuffer[frameIdx]->mSize)
+	{
+		uint64_t size = max(iSize, (uint64_t)pIndexBuffer[frameIdx]->mSize * 2);
+		removeResource(pIndexBuffer[frameIdx]);
+		addGeometryBuffer(frameIdx, true, size);
+	}
 
-	// Copy and convert all vertices into a single contiguous buffer
-	uint64_t vOffset = frameIdx * VERTEX_BUFFER_SIZE;
-	uint64_t iOffset = frameIdx * INDEX_BUFFER_SIZE;
-	uint64_t vtx_dst = vOffset;
-	uint64_t idx_dst = iOffset;
-	for (int n = 0; n < draw_data->CmdListsCount; n++)
+	// The buffers of this frame rotate with frameIdx, so they may hold an older UI than the previous frame did
+	const bool refresh = mFrameGeneration[frameIdx] != mDrawGeneration;
+	if (refresh)
 	{
-		const ImDrawList* cmd_list = draw_data->CmdLists[n];
-		BufferUpdateDesc  update = { pVertexBuffer, vtx_dst };
-		beginUpdateResource(&update);
-		memcpy(update.pMappedData, cmd_list->VtxBuffer.data(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		endUpdateResource(&update, NULL);
+		// Copy and convert all vertices into a single contiguous buffer
+		uint64_t vtx_dst = 0;
+		uint64_t idx_dst = 0;
+		for (int n = 0; n < draw_data->CmdListsCount; n++)
+		{
+			const ImDrawList* cmd_list = draw_data->CmdLists[n];
+			BufferUpdateDesc  update = { pVertexBuffer[frameIdx], vtx_dst };
+			beginUpdateResource(&update);
+			memcpy(update.pMappedData, cmd_list->VtxBuffer.data(), cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
+			endUpdateResource(&update, NULL);
+
+			update = { pIndexBuffer[frameIdx], idx_dst };
+			beginUpdateResource(&update);
+			memcpy(update.pMappedData, cmd_list->IdxBuffer.data(), cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+			endUpdateResource(&update, NULL);
+
+			vtx_dst += (cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
+			idx_dst += (cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+		}
 
-		update = { pIndexBuffer, idx_dst };
+		float L = draw_data->DisplayPos.x;
+		float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
+		float T = draw_data->DisplayPos.y;
+		float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
+		float mvp[4][4] = {
+			{ 2.0f / (R - L), 0.0f, 0.0f, 0.0f },
+			{ 0.0f, 2.0f / (T - B), 0.0f, 0.0f },
+			{ 0.0f, 0.0f, 0.5f, 0.0f },
+			{ (R + L) / (L - R), (T + B) / (B - T), 0.5f, 1.0f },
+		};
+		BufferUpdateDesc update = { pUniformBuffer[frameIdx] };
 		beginUpdateResource(&update);
-		memcpy(update.pMappedData, cmd_list->IdxBuffer.data(), cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+		*((mat4*)update.pMappedData) = *(mat4*)mvp;
 		endUpdateResource(&update, NULL);
-
-		vtx_dst += (cmd_list->VtxBuffer.size() * sizeof(ImDrawVert));
-		idx_dst += (cmd_list->IdxBuffer.size() * sizeof(ImDrawIdx));
+		mFrameGeneration[frameIdx] = mDrawGeneration;
 	}
 
-	float L = draw_data->DisplayPos.x;
-	float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
-	float T = draw_data->DisplayPos.y;
-	float B = draw_data->DisplayPos.y + draw_data->DisplaySize.y;
-	float mvp[4][4] = {
-		{ 2.0f / (R - L), 0.0f, 0.0f, 0.0f },
-		{ 0.0f, 2.0f / (T - B), 0.0f, 0.0f },
-		{ 0.0f, 0.0f, 0.5f, 0.0f },
-		{ (R + L) / (L - R), (T + B) / (B - T), 0.5f, 1.0f },
-	};
-	BufferUpdateDesc update = { pUniformBuffer[frameIdx] };
-	beginUpdateResource(&update);
-	*((mat4*)update.pMappedData) = *(mat4*)mvp;
-	endUpdateResource(&update, NULL);
-
 	const uint32_t vertexStride = sizeof(ImDrawVert);
 
 	cmdSetViewport(pCmd, 0.0f, 0.0f, draw_data->DisplaySize.x, draw_data->DisplaySize.y, 0.0f, 1.0f);
@@ -1152,8 +1227,9 @@ void ImguiGUIDriver::draw(Cmd* pCmd)
 		pCmd, (uint32_t)draw_data->DisplayPos.x, (uint32_t)draw_data->DisplayPos.y, (uint32_t)draw_data->DisplaySize.x,
 		(uint32_t)draw_data->DisplaySize.y);
 	cmdBindPipeline(pCmd, pPipeline);
-	cmdBindIndexBuffer(pCmd, pIndexBuffer, INDEX_TYPE_UINT16, iOffset);
-	cmdBindVertexBuffer(pCmd, 1, &pVertexBuffer, &vertexStride, &vOffset);
+	const uint64_t vertexOffset = 0;
+	cmdBindIndexBuffer(pCmd, pIndexBuffer[frameIdx], INDEX_TYPE_UINT16, 0);
+	cmdBindVertexBuffer(pCmd, 1, &pVertexBuffer[frameIdx], &vertexStride, &vertexOffset);
 
 	cmdBindDescriptorSet(pCmd, frameIdx, pDescriptorSetUniforms);
 
@@ -1185,10 +1261,14 @@ void ImguiGUIDriver::draw(Cmd* pCmd)
 				if (id >= mFontTextures.size())
 				{
 					uint32_t setIndex = (uint32_t)mFontTextures.size() + (frameIdx * mMaxDynamicUIUpdatesPerBatch + mDynamicUIUpdates);
-					DescriptorData params[1] = {};
-					params[0].pName = "uTex";
-					params[0].ppTextures = (Texture**)&pcmd->TextureId;
-					updateDescriptorSet(pRenderer, setIndex, pDescriptorSetTexture, 1, params);
+					// The texture ids are part of the hash, so the sets of this frame still hold them if nothing changed
+					if (refresh)
+					{
+						DescriptorData params[1] = {};
+						params[0].pName = TEXTURE_NAME;
+						params[0].ppTextures = (Texture**)&pcmd->TextureId;
+						updateDescriptorSet(pRenderer, setIndex, pDescriptorSetTexture, 1, params);
+					}
 					cmdBindDescriptorSet(pCmd, setIndex, pDescriptorSetTexture);
 					++mDynamicUIUpdates;
 				}